@@ -20,9 +20,9 @@
 
 import { AST } from "./AST";
 import { Token } from "./Token";
-import { cxx } from "./cxx";
 import { ASTSlotKind } from "./ASTSlotKind";
 import { ASTSlot } from "./ASTSlot";
+import { FlatAST } from "./FlatAST";
 
 interface TranslationUnitLike {
   getUnitHandle(): number;
@@ -31,16 +31,21 @@ interface TranslationUnitLike {
 interface StackNode {
   node: AST | Token;
   name?: ASTSlot;
+  // the record of the node in the flattened AST.
+  record: number;
 }
 
 class StackEntry {
   #parser: TranslationUnitLike;
+  #tree: FlatAST;
   children?: Generator<StackNode, undefined>;
 
   constructor(
     readonly owner: StackNode,
+    tree: FlatAST,
     parser: TranslationUnitLike,
   ) {
+    this.#tree = tree;
     this.#parser = parser;
   }
 
@@ -53,26 +58,18 @@ class StackEntry {
       return undefined;
     }
 
-    const handle = this.owner.node.getHandle();
-    const slotCount = cxx.getASTSlotCount(handle, 0);
+    const tree = this.#tree;
 
-    for (let i = 0; i < slotCount; ++i) {
-      const slotKind = cxx.getASTSlotKind(handle, i);
-      const name = cxx.getASTSlotName(handle, i);
+    for (const record of tree.getChildren(this.owner.record)) {
+      const name = tree.getSlot(record);
+      const slotKind = tree.getSlotKind(record);
 
       if (slotKind === ASTSlotKind.Node) {
-        const node = AST.from(cxx.getASTSlot(handle, i), this.#parser);
-
-        if (node) yield { name, node };
-      } else if (slotKind === ASTSlotKind.NodeList) {
-        for (let it = cxx.getASTSlot(handle, i); it; it = cxx.getListNext(it)) {
-          const node = AST.from(cxx.getListValue(it), this.#parser);
-
-          if (node) yield { name, node };
-        }
+        const node = tree.getAST(record, this.#parser);
+        if (node) yield { name, node, record };
       } else if (slotKind === ASTSlotKind.Token) {
-        const token = Token.from(cxx.getASTSlot(handle, i), this.#parser);
-        if (token) yield { name, node: token };
+        const token = Token.from(tree.getValue(record), this.#parser);
+        if (token) yield { name, node: token, record };
       }
     }
   }
@@ -87,10 +84,12 @@ interface AcceptArgs {
 /**
  * AST cursor.
  *
- * A cursor is used to traverse the AST.
+ * A cursor is used to traverse the AST. The subtree of the root is
+ * flattened once, when the cursor is constructed.
  */
 export class ASTCursor {
   readonly #parser: TranslationUnitLike;
+  readonly #tree: FlatAST;
   readonly #stack: StackEntry[] = [];
 
   /**
@@ -104,7 +103,10 @@ export class ASTCursor {
     parser: TranslationUnitLike,
   ) {
     this.#parser = parser;
-    this.#stack.push(new StackEntry({ node: root }, this.#parser));
+    this.#tree = FlatAST.from(root, parser);
+    this.#stack.push(
+      new StackEntry({ node: root, record: 0 }, this.#tree, this.#parser),
+    );
   }
 
   /**
@@ -129,7 +131,7 @@ export class ASTCursor {
     if (!this.#current.children) return false;
     const { value: childNode } = this.#current.children.next();
     if (!childNode) return false;
-    this.#stack.push(new StackEntry(childNode, this.#parser));
+    this.#stack.push(new StackEntry(childNode, this.#tree, this.#parser));
     return true;
   }
 
@@ -142,7 +144,7 @@ export class ASTCursor {
     const { value: childNode } = this.#parent.children.next();
     if (!childNode) return false;
     this.#stack.pop();
-    this.#stack.push(new StackEntry(childNode, this.#parser));
+    this.#stack.push(new StackEntry(childNode, this.#tree, this.#parser));
     return true;
   }
 
@@ -24,4 +24,8 @@ export enum ASTSlotKind {
   Node,
   TokenList,
   NodeList,
+  IdentifierAttribute,
+  LiteralAttribute,
+  BoolAttribute,
+  IntAttribute,
 }
@@ -0,0 +1,223 @@
+// Copyright (c) 2023 Roberto Raggi <roberto.raggi@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+import { cxx } from "./cxx";
+import { AST } from "./AST";
+import { ASTKind } from "./ASTKind";
+import { ASTSlot } from "./ASTSlot";
+import { ASTSlotKind } from "./ASTSlotKind";
+import { TokenKind } from "./TokenKind";
+
+interface TranslationUnitLike {
+  getUnitHandle(): number;
+}
+
+// the layout of the buffer, see src/parser/cxx/flat_ast.h
+const VERSION = 1;
+const NONE = 0xffffffff;
+
+const HEADER_VERSION = 0;
+const HEADER_RECORD_COUNT = 1;
+const HEADER_STRING_COUNT = 2;
+const HEADER_STRING_TABLE = 3;
+const HEADER_SIZE = 4;
+
+const FIELD_SLOT_KIND = 0;
+const FIELD_KIND = 1;
+const FIELD_PARENT = 2;
+const FIELD_SLOT_NAME = 3;
+const FIELD_VALUE = 4;
+const FIELD_FIRST_TOKEN = 5;
+const FIELD_LAST_TOKEN = 6;
+const FIELD_HANDLE = 7;
+const RECORD_SIZE = 8;
+
+/**
+ * An AST, or a subtree of it, flattened in a single buffer.
+ *
+ * The records of the nodes, of their tokens and of their attributes are
+ * numbered in pre-order, starting with the root at 0. The children of a
+ * node are the records that follow it, up to the end of its subtree.
+ */
+export class FlatAST {
+  readonly #data: Uint32Array;
+  readonly #offsets: Uint32Array;
+  readonly #text: Uint8Array;
+  readonly #strings: (string | undefined)[];
+  readonly #decoder = new TextDecoder();
+
+  /**
+   * Flattens the subtree of the given node with a single call to the
+   * WASM module.
+   *
+   * @param ast the root of the subtree.
+   * @param parser the parser that owns the AST node.
+   */
+  static from(ast: AST, parser: TranslationUnitLike): FlatAST {
+    return new FlatAST(cxx.flattenAST(ast.getHandle(), parser.getUnitHandle()));
+  }
+
+  /**
+   * Constructs a flattened AST from the buffer returned by the WASM module.
+   *
+   * @param data the flattened AST.
+   */
+  constructor(data: Uint32Array) {
+    if (data[HEADER_VERSION] !== VERSION) {
+      throw new Error(`unsupported flat AST version ${data[HEADER_VERSION]}`);
+    }
+
+    const stringCount = data[HEADER_STRING_COUNT];
+    const stringTable = data[HEADER_STRING_TABLE];
+
+    this.#data = data;
+    this.#offsets = data.subarray(stringTable, stringTable + stringCount + 1);
+    this.#text = new Uint8Array(
+      data.buffer,
+      data.byteOffset + (stringTable + stringCount + 1) * 4,
+    );
+    this.#strings = new Array(stringCount);
+  }
+
+  /**
+   * Returns the number of records.
+   */
+  get recordCount(): number {
+    return this.#data[HEADER_RECORD_COUNT];
+  }
+
+  /**
+   * Returns the kind of the record, a node, a token or an attribute.
+   */
+  getSlotKind(record: number): ASTSlotKind {
+    return this.#field(record, FIELD_SLOT_KIND);
+  }
+
+  /**
+   * Returns the kind of a node.
+   */
+  getKind(record: number): ASTKind {
+    return this.#field(record, FIELD_KIND);
+  }
+
+  /**
+   * Returns the kind of a token.
+   */
+  getTokenKind(record: number): TokenKind {
+    return this.#field(record, FIELD_KIND);
+  }
+
+  /**
+   * Returns the parent node of the record, or undefined for the root.
+   */
+  getParent(record: number): number | undefined {
+    const parent = this.#field(record, FIELD_PARENT);
+    return parent !== NONE ? parent : undefined;
+  }
+
+  /**
+   * Returns the slot of the record in its parent, or undefined for the root.
+   */
+  getSlot(record: number): ASTSlot | undefined {
+    const slot = this.#field(record, FIELD_SLOT_NAME);
+    return slot !== NONE ? slot : undefined;
+  }
+
+  /**
+   * Returns the record that follows the subtree of the record.
+   */
+  getEnd(record: number): number {
+    return this.getSlotKind(record) === ASTSlotKind.Node
+      ? this.#field(record, FIELD_VALUE)
+      : record + 1;
+  }
+
+  /**
+   * Returns the handle of a token, or the value of a boolean or an integer
+   * attribute, e.g. the TokenKind of an operator.
+   */
+  getValue(record: number): number {
+    return this.#field(record, FIELD_VALUE);
+  }
+
+  /**
+   * Returns the spelling of an identifier or of a literal attribute.
+   */
+  getString(record: number): string | undefined {
+    switch (this.getSlotKind(record)) {
+      case ASTSlotKind.IdentifierAttribute:
+      case ASTSlotKind.LiteralAttribute:
+        break;
+      default:
+        return undefined;
+    } // switch
+
+    const id = this.#field(record, FIELD_VALUE);
+
+    let s = this.#strings[id];
+
+    if (s === undefined) {
+      s = this.#decoder.decode(
+        this.#text.subarray(this.#offsets[id], this.#offsets[id + 1]),
+      );
+      this.#strings[id] = s;
+    }
+
+    return s;
+  }
+
+  /**
+   * Returns the handles of the first and of the last token of a node, or
+   * undefined if the node has no tokens.
+   */
+  getTokenRange(record: number): [number, number] | undefined {
+    const lastToken = this.#field(record, FIELD_LAST_TOKEN);
+    if (!lastToken) return undefined;
+    return [this.#field(record, FIELD_FIRST_TOKEN), lastToken - 1];
+  }
+
+  /**
+   * Returns the handle of a node.
+   */
+  getHandle(record: number): number {
+    return this.#field(record, FIELD_HANDLE);
+  }
+
+  /**
+   * Returns the node of the record.
+   */
+  getAST(record: number, parser: TranslationUnitLike): AST | undefined {
+    return AST.from(this.getHandle(record), parser);
+  }
+
+  /**
+   * Returns the children of the record.
+   */
+  *getChildren(record: number): Generator<number> {
+    const end = this.getEnd(record);
+    for (let child = record + 1; child < end; child = this.getEnd(child)) {
+      yield child;
+    }
+  }
+
+  #field(record: number, field: number): number {
+    return this.#data[HEADER_SIZE + record * RECORD_SIZE + field];
+  }
+}
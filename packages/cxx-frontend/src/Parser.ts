@@ -91,6 +91,21 @@ export class Parser {
     this.#ast = AST.from(this.#unit.getHandle(), this);
   }
 
+  /**
+   * Replaces the source code of the parsed unit. When possible, only the
+   * declarations affected by the changes are parsed again.
+   *
+   * @returns false if the whole source code was parsed again
+   */
+  update(source: string): boolean {
+    if (!this.#unit) {
+      return false;
+    }
+    const incremental = this.#unit.update(source);
+    this.#ast = AST.from(this.#unit.getHandle(), this);
+    return incremental;
+  }
+
   dispose() {
     this.#unit?.delete();
     this.#unit = undefined;
@@ -23,6 +23,7 @@ import { Diagnostic } from "./Diagnostic";
 export interface Unit {
   delete(): void;
   parse(): boolean;
+  update(source: string): boolean;
   getHandle(): number;
   getUnitHandle(): number;
   getDiagnostics(): Diagnostic[];
@@ -96,6 +96,7 @@ export type CXX = {
   getASTSlotKind(handle: number, slot: number): ASTSlotKind;
   getASTSlotName(handle: number, slot: number): ASTSlot;
   getASTSlotCount(handle: number, slot: number): number;
+  flattenAST(handle: number, unitHandle: number): Uint32Array;
   getListValue(handle: number): number;
   getListNext(handle: number): number;
   getLiteralValue(handle: number): string | undefined;
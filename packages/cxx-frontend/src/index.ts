@@ -22,8 +22,10 @@ export * from "./AST";
 export * from "./ASTCursor";
 export * from "./ASTKind";
 export * from "./ASTSlot";
+export * from "./ASTSlotKind";
 export * from "./ASTVisitor";
 export * from "./Diagnostic";
+export * from "./FlatAST";
 export * from "./Lexer";
 export * from "./Parser";
 export * from "./Preprocessor";
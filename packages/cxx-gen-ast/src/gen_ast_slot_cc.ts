@@ -36,149 +36,156 @@ export function gen_ast_slot_cc({ ast, output }: { ast: AST; output: string }) {
 
   const allMemberSlotNames = getAllMemberSlotNames({ ast });
 
+  // the first and the last ASTKind of the nodes of the given type, a base
+  // or a node.
+  const getKindRange = (type: string) => {
+    const kindName = (name: string) => `ASTKind::${name.slice(0, -3)}`;
+    const derived = by_base.get(type);
+    if (derived) {
+      return `${kindName(derived[0].name)}, ${kindName(derived.at(-1)!.name)}`;
+    }
+    if (!ast.nodes.some((node) => node.name === type)) {
+      throw new Error(`unknown node type '${type}'`);
+    }
+    return `${kindName(type)}, ${kindName(type)}`;
+  };
+
+  const slotTables: string[] = [];
+  const layouts: string[] = [];
+
   emit(`namespace {`);
   emit(`std::string_view kMemberSlotNames[] = {`);
   allMemberSlotNames.forEach((name, nameIndex) => {
     emit(`  "${name}",`);
   });
   emit(`};`);
-  emit(`} // namespace`);
-
-  emit(`std::string_view to_string(SlotNameIndex index) {`);
-  emit(`  return kMemberSlotNames[int(index)];`);
-  emit(`}`);
 
   by_base.forEach((nodes) => {
     nodes.forEach(({ name, members }) => {
+      layouts.push(`  {sizeof(${name}), &constructAST<${name}>},`);
+
       const memberSlots = members.filter(
         (m) => classifyMemberSlot(m) !== undefined
       );
 
-      emit();
-      emit(`void ASTSlot::visit(${name}* ast) {`);
-      if (memberSlots.length > 0) {
-        emit(`  switch (slot_) {`);
-        memberSlots.forEach((m, slotCount) => {
-          const classification = classifyMemberSlot(m);
-          const slotNameIndex = allMemberSlotNames.indexOf(m.name);
-
-          switch (classification) {
-            case MemberSlotClassification.BoolAttribute:
-              emit(`  case ${slotCount}: // ${m.name}`);
-              emit(`    value_ = std::intptr_t(ast->${m.name} != 0);`);
-              emit(`    slotKind_ = ASTSlotKind::kBoolAttribute;`);
-              emit(`    slotNameIndex_ = SlotNameIndex{${slotNameIndex}};`);
-              emit(`    break;`);
-              break;
-            case MemberSlotClassification.IntAttribute:
-              emit(`  case ${slotCount}: // ${m.name}`);
-              emit(`    value_ = ast->${m.name};`);
-              emit(`    slotKind_ = ASTSlotKind::kIntAttribute;`);
-              emit(`    slotNameIndex_ = SlotNameIndex{${slotNameIndex}};`);
-              emit(`    break;`);
-              break;
-            case MemberSlotClassification.TokenKindAttribute:
-              emit(`  case ${slotCount}: // ${m.name}`);
-              emit(`    value_ = std::intptr_t(ast->${m.name});`);
-              emit(`    slotKind_ = ASTSlotKind::kIntAttribute;`);
-              emit(`    slotNameIndex_ = SlotNameIndex{${slotNameIndex}};`);
-              emit(`    break;`);
-              break;
-            case MemberSlotClassification.IdentifierAttribute:
-              emit(`  case ${slotCount}: // ${m.name}`);
-              emit(
-                `    value_ = reinterpret_cast<std::intptr_t>(ast->${m.name});`
-              );
-              emit(`    slotKind_ = ASTSlotKind::kIdentifierAttribute;`);
-              emit(`    slotNameIndex_ = SlotNameIndex{${slotNameIndex}};`);
-              emit(`    break;`);
-              break;
-            case MemberSlotClassification.LiteralAttribute:
-              emit(`  case ${slotCount}: // ${m.name}`);
-              emit(
-                `    value_ = reinterpret_cast<std::intptr_t>(ast->${m.name});`
-              );
-              emit(`    slotKind_ = ASTSlotKind::kLiteralAttribute;`);
-              emit(`    slotNameIndex_ = SlotNameIndex{${slotNameIndex}};`);
-              emit(`    break;`);
-              break;
-            case MemberSlotClassification.Token:
-              emit(`  case ${slotCount}: // ${m.name}`);
-              emit(`    value_ = ast->${m.name}.index();`);
-              emit(`    slotKind_ = ASTSlotKind::kToken;`);
-              emit(`    slotNameIndex_ = SlotNameIndex{${slotNameIndex}};`);
-              emit(`    break;`);
-              break;
-            case MemberSlotClassification.Node:
-              emit(`  case ${slotCount}: // ${m.name}`);
-              emit(
-                `    value_ = reinterpret_cast<std::intptr_t>(ast->${m.name});`
-              );
-              emit(`    slotKind_ = ASTSlotKind::kNode;`);
-              emit(`    slotNameIndex_ = SlotNameIndex{${slotNameIndex}};`);
-              emit(`    break;`);
-              break;
-            case MemberSlotClassification.NodeList:
-              emit(`  case ${slotCount}: // ${m.name}`);
-              emit(
-                `    value_ = reinterpret_cast<std::intptr_t>(ast->${m.name});`
-              );
-              emit(`    slotKind_ = ASTSlotKind::kNodeList;`);
-              emit(`    slotNameIndex_ = SlotNameIndex{${slotNameIndex}};`);
-              emit(`    break;`);
-              break;
-            case MemberSlotClassification.TokenList:
-              emit(`  case ${slotCount}: // ${m.name}`);
-              emit(`    value_ = 0; // not implemented yet`);
-              emit(`    slotKind_ = ASTSlotKind::kTokenList;`);
-              emit(`    slotNameIndex_ = SlotNameIndex{${slotNameIndex}};`);
-              emit(`    break;`);
-              break;
-            default:
-              break;
-          } // switch
-        });
-        emit(`  } // switch`);
-        emit();
-        emit(`  slotCount_ = ${memberSlots.length};`);
+      if (memberSlots.length === 0) {
+        slotTables.push(`  {}, // ${name}`);
+        return;
       }
-      emit(`}`);
+
+      const table = `k${name.slice(0, -3)}Slots`;
+      slotTables.push(`  ${table},`);
+
+      emit();
+      emit(`constexpr ASTSlotDescriptor ${table}[] = {`);
+      memberSlots.forEach((m) => {
+        const slotNameIndex = allMemberSlotNames.indexOf(m.name);
+        const [kind, storage] = getSlotKindAndStorage(classifyMemberSlot(m)!);
+        const kinds =
+          m.kind === "node" || m.kind === "node-list"
+            ? `, ${getKindRange(m.type)}`
+            : "";
+        emit(
+          `  {offsetof(${name}, ${m.name}), ASTSlotKind::${kind}, ASTSlotStorage::${storage}, SlotNameIndex{${slotNameIndex}}${kinds}},`
+        );
+      });
+      emit(`};`);
     });
   });
 
+  emit();
+  emit(`constexpr std::span<const ASTSlotDescriptor> kSlots[] = {`);
+  slotTables.forEach((line) => emit(line));
+  emit(`};`);
+
+  emit();
+  emit(`template <typename T>`);
+  emit(`auto constructAST(void* address) -> AST* {`);
+  emit(`  return ::new (address) T();`);
+  emit(`}`);
+
+  emit();
+  emit(`constexpr ASTLayout kLayouts[] = {`);
+  layouts.forEach((line) => emit(line));
+  emit(`};`);
+  emit(`} // namespace`);
+
+  emit();
+  emit(`std::string_view to_string(SlotNameIndex index) {`);
+  emit(`  return kMemberSlotNames[int(index)];`);
+  emit(`}`);
+
   const out = `${cpy_header}
 #include <cxx/ast_slot.h>
 #include <cxx/ast.h>
-#include <algorithm>
-#include <stdexcept>
+#include <cstddef>
+#include <iterator>
+#include <new>
+
+// the nodes are not standard-layout types, but offsetof is supported for
+// them by the compilers we use.
+#if defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Winvalid-offsetof"
+#endif
 
 namespace cxx {
 
-auto ASTSlot::operator()(AST* ast, int slot) -> SlotInfo {
-    std::intptr_t value = 0;
-    ASTSlotKind slotKind = ASTSlotKind::kInvalid;
-    SlotNameIndex slotNameIndex{};
-    int slotCount = 0;
-    if (ast) {
-      std::swap(slot_, slot);
-      std::swap(value_, value);
-      std::swap(slotKind_, slotKind);
-      std::swap(slotNameIndex_, slotNameIndex);
-      std::swap(slotCount_, slotCount);
-      ast->accept(this);
-      std::swap(slot_, slot);
-      std::swap(value_, value);
-      std::swap(slotKind_, slotKind);
-      std::swap(slotNameIndex_, slotNameIndex);
-      std::swap(slotCount_, slotCount);
-    }
-    return {value, slotKind, SlotNameIndex{slotNameIndex}, slotCount};
+${code.join("\n")}
+
+auto getASTSlots(ASTKind kind) -> std::span<const ASTSlotDescriptor> {
+  return kSlots[static_cast<int>(kind)];
 }
 
-${code.join("\n")}
+auto getASTLayout(ASTKind kind) -> const ASTLayout* {
+  const auto index = static_cast<std::size_t>(kind);
+  if (index >= std::size(kLayouts)) return nullptr;
+  return &kLayouts[index];
+}
+
+auto ASTSlot::operator()(AST* ast, int slot) -> SlotInfo {
+  if (!ast) return {0, ASTSlotKind::kInvalid, SlotNameIndex{}, 0};
+
+  const auto slots = getASTSlots(ast->kind());
+  const auto slotCount = static_cast<int>(slots.size());
+
+  if (slot < 0 || slot >= slotCount) {
+    return {0, ASTSlotKind::kInvalid, SlotNameIndex{}, slotCount};
+  }
+
+  const auto& descriptor = slots[slot];
+
+  return {getASTSlotValue(ast, descriptor), descriptor.kind,
+          descriptor.nameIndex, slotCount};
+}
 
 } // namespace cxx
 `;
 
   fs.writeFileSync(output, out);
 }
+
+function getSlotKindAndStorage(
+  classification: MemberSlotClassification
+): [kind: string, storage: string] {
+  switch (classification) {
+    case MemberSlotClassification.BoolAttribute:
+      return ["kBoolAttribute", "kBool"];
+    case MemberSlotClassification.IntAttribute:
+      return ["kIntAttribute", "kInt"];
+    case MemberSlotClassification.TokenKindAttribute:
+      return ["kIntAttribute", "kTokenKind"];
+    case MemberSlotClassification.IdentifierAttribute:
+      return ["kIdentifierAttribute", "kPointer"];
+    case MemberSlotClassification.LiteralAttribute:
+      return ["kLiteralAttribute", "kPointer"];
+    case MemberSlotClassification.Token:
+      return ["kToken", "kSourceLocation"];
+    case MemberSlotClassification.Node:
+      return ["kNode", "kPointer"];
+    case MemberSlotClassification.NodeList:
+      return ["kNodeList", "kPointer"];
+    case MemberSlotClassification.TokenList:
+      // not implemented yet
+      return ["kTokenList", "kNone"];
+  } // switch
+}
@@ -18,30 +18,21 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
-import { groupNodesByBaseType } from "./groupNodesByBaseType.js";
 import { AST } from "./parseAST.js";
 import { cpy_header } from "./cpy_header.js";
 import * as fs from "fs";
 
-export function gen_ast_slot_h({ ast, output }: { ast: AST; output: string }) {
-  const code: string[] = [];
-  const emit = (line = "") => code.push(line);
-
-  const by_base = groupNodesByBaseType(ast);
-
-  by_base.forEach((nodes) => {
-    emit();
-    nodes.forEach(({ name }) => {
-      emit(`  void visit(${name}* ast) override;`);
-    });
-  });
-
+export function gen_ast_slot_h({ output }: { ast: AST; output: string }) {
   const out = `${cpy_header}
 #pragma once
 
-#include <cxx/ast_visitor.h>
+#include <cxx/ast_fwd.h>
+#include <cxx/ast_kind.h>
+#include <cxx/token_fwd.h>
 #include <cstdint>
-#include <tuple>
+#include <cstring>
+#include <span>
+#include <string_view>
 
 namespace cxx {
 
@@ -59,7 +50,100 @@ enum ASTSlotKind {
 
 enum class SlotNameIndex : int {};
 
-class ASTSlot final : ASTVisitor {
+// the type of the member that holds the value of a slot.
+enum class ASTSlotStorage : std::uint8_t {
+  kNone,
+  kSourceLocation,
+  kPointer,
+  kBool,
+  kInt,
+  kTokenKind,
+};
+
+struct ASTSlotDescriptor {
+  std::uint32_t offset;
+  ASTSlotKind kind;
+  ASTSlotStorage storage;
+  SlotNameIndex nameIndex;
+  // the kinds of the nodes of a node or node list slot, the kinds of the
+  // nodes derived from the same base are contiguous.
+  ASTKind firstKind{};
+  ASTKind lastKind{};
+};
+
+// returns the slots of the nodes of the given kind, in declaration order.
+[[nodiscard]] auto getASTSlots(ASTKind kind)
+    -> std::span<const ASTSlotDescriptor>;
+
+// returns the value of the slot of the node, encoded as in ASTSlot::SlotInfo.
+[[nodiscard]] inline auto getASTSlotValue(const AST* ast,
+                                          const ASTSlotDescriptor& slot)
+    -> std::intptr_t {
+  auto member = reinterpret_cast<const char*>(ast) + slot.offset;
+
+  auto load = [member](auto value) {
+    std::memcpy(&value, member, sizeof(value));
+    return value;
+  };
+
+  switch (slot.storage) {
+    case ASTSlotStorage::kSourceLocation:
+      return load(0u);
+    case ASTSlotStorage::kPointer:
+      return load(std::intptr_t(0));
+    case ASTSlotStorage::kBool:
+      return load(false);
+    case ASTSlotStorage::kInt:
+      return load(0);
+    case ASTSlotStorage::kTokenKind:
+      return static_cast<std::intptr_t>(load(TokenKind{}));
+    default:
+      return 0;
+  }  // switch
+}
+
+// stores the value of the slot of the node, encoded as in ASTSlot::SlotInfo.
+inline void setASTSlotValue(AST* ast, const ASTSlotDescriptor& slot,
+                            std::intptr_t value) {
+  auto member = reinterpret_cast<char*>(ast) + slot.offset;
+
+  auto store = [member](auto value) {
+    std::memcpy(member, &value, sizeof(value));
+  };
+
+  switch (slot.storage) {
+    case ASTSlotStorage::kSourceLocation:
+      store(static_cast<unsigned>(value));
+      break;
+    case ASTSlotStorage::kPointer:
+      store(value);
+      break;
+    case ASTSlotStorage::kBool:
+      store(value != 0);
+      break;
+    case ASTSlotStorage::kInt:
+      store(static_cast<int>(value));
+      break;
+    case ASTSlotStorage::kTokenKind:
+      store(static_cast<TokenKind>(value));
+      break;
+    default:
+      break;
+  }  // switch
+}
+
+// the size of the nodes of a kind, and a function that constructs one, with
+// the default values of its members, at the given address.
+struct ASTLayout {
+  std::uint32_t size;
+  AST* (*construct)(void* address);
+};
+
+// returns the layout of the nodes of the given kind, or nullptr if the kind
+// is not valid.
+[[nodiscard]] auto getASTLayout(ASTKind kind) -> const ASTLayout*;
+
+class ASTSlot final {
 public:
   struct SlotInfo {
     std::intptr_t handle;
@@ -69,16 +153,6 @@ public:
   };
 
   auto operator()(AST* ast, int slot) -> SlotInfo;
-
-private:
-${code.join("\n")}
-
-private:
-  std::intptr_t value_ = 0;
-  int slot_ = 0;
-  ASTSlotKind slotKind_ = ASTSlotKind::kInvalid;
-  SlotNameIndex slotNameIndex_{};
-  int slotCount_ = 0;
 };
 
 std::string_view to_string(SlotNameIndex index);
@@ -19,36 +19,54 @@
 // SOFTWARE.
 
 import { FixedSizeList } from "react-window";
-import { AST, ASTKind, ASTSlot, Parser, TokenKind } from "cxx-frontend";
-import { CSSProperties, useEffect, useRef, useState } from "react";
+import {
+  ASTKind,
+  ASTSlot,
+  ASTSlotKind,
+  FlatAST,
+  Parser,
+  Token,
+  TokenKind,
+} from "cxx-frontend";
+import { CSSProperties, useEffect, useMemo, useRef, useState } from "react";
 import AutoSizer from "react-virtualized-auto-sizer";
 
-function hasOp(node: any): node is AST & { getOp(): TokenKind } {
-  return typeof node.getOp === "function" && node.getOp();
-}
-
-function hasAccessOp(node: any): node is AST & { getAccessOp(): TokenKind } {
-  return typeof node.getAccessOp === "function" && node.getAccessOp();
-}
-
-function hasAccessSpecifier(
-  node: any
-): node is AST & { getAccessSpecifier(): TokenKind } {
-  return (
-    typeof node.getAccessSpecifier === "function" && node.getAccessSpecifier()
-  );
-}
-
-function hasSpecifier(node: any): node is AST & { getSpecifier(): TokenKind } {
-  return typeof node.getSpecifier === "function" && node.getSpecifier();
-}
+// the attributes printed next to the kind of the nodes.
+const STRING_ATTRIBUTES = new Set([ASTSlot.identifier, ASTSlot.literal]);
+
+const TOKEN_KIND_ATTRIBUTES = new Set([
+  ASTSlot.op,
+  ASTSlot.accessOp,
+  ASTSlot.specifier,
+  ASTSlot.accessSpecifier,
+]);
+
+function describe(tree: FlatAST, record: number): string {
+  let extra = "";
+
+  for (const child of tree.getChildren(record)) {
+    const slot = tree.getSlot(child);
+    if (slot === undefined) continue;
+
+    switch (tree.getSlotKind(child)) {
+      case ASTSlotKind.IdentifierAttribute:
+      case ASTSlotKind.LiteralAttribute:
+        if (STRING_ATTRIBUTES.has(slot)) extra += ` (${tree.getString(child)})`;
+        break;
+
+      case ASTSlotKind.IntAttribute: {
+        const value = tree.getValue(child);
+        if (value && TOKEN_KIND_ATTRIBUTES.has(slot))
+          extra += ` (${TokenKind[value]})`;
+        break;
+      }
+    } // switch
+  }
 
-function hasIdentifier(node: any): node is AST & { getIdentifier(): string } {
-  return typeof node.getIdentifier === "function" && node.getIdentifier();
-}
+  const slot = tree.getSlot(record);
+  const member = slot !== undefined ? `${ASTSlot[slot]}: ` : "";
 
-function hasLiteral(node: any): node is AST & { getLiteral(): string } {
-  return typeof node.getLiteral === "function" && node.getLiteral();
+  return `${member}${ASTKind[tree.getKind(record)]}${extra}`;
 }
 
 interface SyntaxTreeProps {
@@ -58,63 +76,53 @@ interface SyntaxTreeProps {
 
 interface SyntaxTreeNode {
   description: string;
-  handle: number;
+  record: number;
   level: number;
-  slot?: ASTSlot;
 }
 
 export function SyntaxTree({ parser, cursorPosition }: SyntaxTreeProps) {
   const listRef = useRef<FixedSizeList>(null);
-  const [selectedNodeHandle, setSelectedNodeHandle] = useState(0);
-  const [nodes, setNodes] = useState<SyntaxTreeNode[]>([]);
-
-  useEffect(() => {
-    const nodes: SyntaxTreeNode[] = [];
+  const [selectedRecord, setSelectedRecord] = useState(-1);
 
+  // the whole AST is copied from the WASM module with a single call.
+  const tree = useMemo(() => {
     const ast = parser?.getAST();
+    return parser && ast ? FlatAST.from(ast, parser) : null;
+  }, [parser]);
 
-    ast?.walk().preVisit(({ node, slot, depth: level }) => {
-      if (!(node instanceof AST)) return;
+  const nodes = useMemo(() => {
+    const nodes: SyntaxTreeNode[] = [];
 
-      const kind = ASTKind[node.getKind()];
+    if (!tree) return nodes;
 
-      let extra = "";
-      if (hasIdentifier(node)) extra += ` (${node.getIdentifier()})`;
-      if (hasLiteral(node)) extra += ` (${node.getLiteral()})`;
-      if (hasOp(node)) extra += ` (${TokenKind[node.getOp()]})`;
-      if (hasAccessOp(node)) extra += ` (${TokenKind[node.getAccessOp()]})`;
-      if (hasSpecifier(node)) extra += ` (${TokenKind[node.getSpecifier()]})`;
-      if (hasAccessSpecifier(node))
-        extra += ` (${TokenKind[node.getAccessSpecifier()]})`;
+    const levels = new Uint32Array(tree.recordCount);
 
-      const member = slot !== undefined ? `${ASTSlot[slot]}: ` : "";
+    for (let record = 0; record < tree.recordCount; ++record) {
+      if (tree.getSlotKind(record) !== ASTSlotKind.Node) continue;
 
-      const description = `${member}${kind}${extra}`;
-      const handle = node.getHandle();
+      const parent = tree.getParent(record);
+      const level = parent !== undefined ? levels[parent] + 1 : 0;
+      levels[record] = level;
 
-      nodes.push({ description, slot, handle, level });
-    });
-    setNodes(nodes);
-  }, [parser]);
+      nodes.push({ description: describe(tree, record), record, level });
+    }
 
-  useEffect(() => {
-    const ast = parser?.getAST();
+    return nodes;
+  }, [tree]);
 
-    if (ast && cursorPosition) {
+  useEffect(() => {
+    if (parser && tree && tree.recordCount && cursorPosition) {
       const { line, column } = cursorPosition;
-      const node = ast ? findNodeAt(ast, line, column + 1) : null;
-      const selectedNodeHandle = node?.getHandle() ?? 0;
-      setSelectedNodeHandle(selectedNodeHandle);
+      const record = findNodeAt(parser, tree, 0, line, column + 1) ?? -1;
+      setSelectedRecord(record);
 
-      const index = nodes.findIndex(
-        (node) => node.handle === selectedNodeHandle
-      );
+      const index = nodes.findIndex((node) => node.record === record);
 
       if (index != -1) {
         listRef.current?.scrollToItem(index, "smart");
       }
     }
-  }, [parser, nodes, cursorPosition]);
+  }, [parser, tree, nodes, cursorPosition]);
 
   const basicStyle: CSSProperties = {
     fontFamily: "monospace",
@@ -122,9 +130,9 @@ export function SyntaxTree({ parser, cursorPosition }: SyntaxTreeProps) {
   };
 
   function Item({ index, style }: { index: number; style: CSSProperties }) {
-    const { description, level, handle } = nodes[index];
+    const { description, level, record } = nodes[index];
     const indent = " ".repeat(level * 4);
-    const isSelected = selectedNodeHandle === handle;
+    const isSelected = selectedRecord === record;
     const itemStyle: CSSProperties = isSelected
       ? { ...basicStyle, backgroundColor: "#ffb" }
       : basicStyle;
@@ -154,11 +162,20 @@ export function SyntaxTree({ parser, cursorPosition }: SyntaxTreeProps) {
   );
 }
 
-function isWithin(node: AST, line: number, column: number): boolean {
-  const start = node.getStartLocation();
+function isWithin(
+  parser: Parser,
+  tree: FlatAST,
+  record: number,
+  line: number,
+  column: number
+): boolean {
+  const range = tree.getTokenRange(record);
+  if (!range) return false;
+
+  const start = Token.from(range[0], parser)?.getLocation();
   if (!start) return false;
 
-  const end = node.getEndLocation();
+  const end = Token.from(range[1], parser)?.getLocation();
   if (!end) return false;
 
   const { startLine, startColumn } = start;
@@ -172,26 +189,26 @@ function isWithin(node: AST, line: number, column: number): boolean {
   return true;
 }
 
-function findNodeAt(root: AST, line: number, column: number): AST | null {
-  if (!isWithin(root, line, column)) {
+function findNodeAt(
+  parser: Parser,
+  tree: FlatAST,
+  record: number,
+  line: number,
+  column: number
+): number | null {
+  if (!isWithin(parser, tree, record, line, column)) {
     return null;
   }
 
-  const cursor = root.walk();
-
-  cursor.gotoFirstChild();
+  for (const child of tree.getChildren(record)) {
+    if (tree.getSlotKind(child) !== ASTSlotKind.Node) continue;
 
-  do {
-    const childNode = cursor.node;
+    const result = findNodeAt(parser, tree, child, line, column);
 
-    if (childNode instanceof AST) {
-      const result = findNodeAt(childNode, line, column);
-
-      if (result) {
-        return result;
-      }
+    if (result !== null) {
+      return result;
     }
-  } while (cursor.gotoNextSibling());
+  }
 
-  return root;
+  return record;
 }
@@ -149,8 +149,38 @@ std::vector<CLIOptionDescr> options{
     {"-fstatic-assert", "Enable static asserts", &CLI::opt_fstatic_assert,
      CLIOptionVisibility::kExperimental},
 
+    {"-fpackrat", "Use unbounded memoization tables in the parser",
+     &CLI::opt_fpackrat, CLIOptionVisibility::kExperimental},
+
+    {"-fskip-function-bodies", "Parse only the declarations",
+     &CLI::opt_fskip_function_bodies, CLIOptionVisibility::kExperimental},
+
     {"-emit-ast", "Emit AST files for source inputs", &CLI::opt_emit_ast},
 
+    {"-ast-format", "<format>",
+     "Emit the AST in <format>, 'flatbuffers' (the default) or 'image'",
+     CLIOptionDescrKind::kJoined},
+
+    {"-emit-pch", "Emit a precompiled header for the given prefix header",
+     &CLI::opt_emit_pch},
+
+    {"-include-pch", "<file>", "Include the precompiled header <file>",
+     CLIOptionDescrKind::kSeparated},
+
+    {"-ftoken-cache",
+     "Cache the tokens of the included headers in $XDG_CACHE_HOME/cxx",
+     &CLI::opt_ftoken_cache},
+
+    {"-ftoken-cache-dir", "<directory>",
+     "Cache the tokens of the included headers in <directory>",
+     CLIOptionDescrKind::kJoined},
+
+    {"-ftime-report", "Report the time spent in each phase",
+     &CLI::opt_ftime_report},
+
+    {"-fstats", "Report the work done by the preprocessor and the parser",
+     &CLI::opt_fstats},
+
     {"-ast-dump", "Build ASTs and then debug dump them", &CLI::opt_ast_dump},
 
     {"-ir-dump", "Dump the IR", &CLI::opt_ir_dump},
@@ -189,6 +219,9 @@ std::vector<CLIOptionDescr> options{
 
     {"-verify", "Verify the diagnostic messages", &CLI::opt_verify},
 
+    {"-j", "<N>", "Process the input files in parallel using <N> threads",
+     CLIOptionDescrKind::kSeparated},
+
     {"-v", "Show commands to run and use verbose output", &CLI::opt_v},
 
 };
@@ -68,9 +68,15 @@ class CLI {
   bool opt_fsyntax_only = false;
   bool opt_fstatic_assert = false;
   bool opt_fcheck = false;
+  bool opt_fpackrat = false;
+  bool opt_fskip_function_bodies = false;
   bool opt_verify = false;
   bool opt_v = false;
   bool opt_emit_ast = false;
+  bool opt_emit_pch = false;
+  bool opt_ftoken_cache = false;
+  bool opt_ftime_report = false;
+  bool opt_fstats = false;
 
   void parse(int& argc, char**& argv);
 
@@ -27,7 +27,9 @@
 #include <cxx/macos_toolchain.h>
 #include <cxx/preprocessor.h>
 #include <cxx/private/format.h>
+#include <cxx/private/memory_mapped_file.h>
 #include <cxx/private/path.h>
+#include <cxx/private/stopwatch.h>
 #include <cxx/recursive_ast_visitor.h>
 #include <cxx/scope.h>
 #include <cxx/symbol_printer.h>
@@ -45,13 +47,25 @@
 // std
 #include <algorithm>
 #include <cassert>
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <list>
+#include <memory>
+#include <optional>
 #include <regex>
 #include <sstream>
 #include <string>
+#include <string_view>
+
+#ifndef CXX_NO_THREADS
+#include <atomic>
+#include <future>
+#include <thread>
+#endif
 
 #include "cli.h"
 
@@ -70,15 +84,34 @@ auto readAll(const std::string& fileName, std::istream& in) -> std::string {
 
 auto readAll(const std::string& fileName) -> std::string {
   if (fileName == "-" || fileName.empty()) return readAll("<stdin>", std::cin);
-  std::ifstream stream(fileName);
-  return readAll(fileName, stream);
+  MemoryMappedFile file;
+  if (!file.open(fileName)) return {};
+  return std::string(file.text());
+}
+
+auto tokenCacheDirectory(const CLI& cli) -> std::string {
+  if (auto dirs = cli.get("-ftoken-cache-dir"); !dirs.empty()) {
+    return dirs.back();
+  }
+
+  if (!cli.opt_ftoken_cache) return {};
+
+  if (auto cacheHome = getenv("XDG_CACHE_HOME"); cacheHome && *cacheHome) {
+    return (fs::path(cacheHome) / "cxx").string();
+  }
+
+  if (auto home = getenv("HOME"); home && *home) {
+    return (fs::path(home) / ".cache" / "cxx").string();
+  }
+
+  return {};
 }
 
 void dumpTokens(const CLI& cli, TranslationUnit& unit, std::ostream& output) {
   std::string flags;
 
   for (SourceLocation loc(1);; loc = loc.next()) {
-    const auto& tk = unit.tokenAt(loc);
+    const auto tk = unit.tokenAt(loc);
 
     flags.clear();
 
@@ -101,20 +134,83 @@ void dumpTokens(const CLI& cli, TranslationUnit& unit, std::ostream& output) {
   }
 }
 
-auto runOnFile(const CLI& cli, const std::string& fileName) -> bool {
-  Control control;
-  VerifyDiagnosticsClient diagnosticsClient;
-  TranslationUnit unit(&control, &diagnosticsClient);
-
-  auto preprocesor = unit.preprocessor();
-
-  std::unique_ptr<Toolchain> toolchain;
+// the phases timed by the frontend, the others are timed by the translation
+// unit and its preprocessor.
+struct FrontendTimes {
+  // the preprocessing of -E and -emit-pch.
+  std::chrono::nanoseconds preprocess{};
+  // the dumps of the symbols and of the AST.
+  std::chrono::nanoseconds output{};
+  std::chrono::nanoseconds total{};
+};
+
+void printTimeReport(std::ostream& out, const std::string& fileName,
+                     const TranslationUnit& unit, const FrontendTimes& times) {
+  using Milliseconds = std::chrono::duration<double, std::milli>;
+
+  const auto& preprocessorStats = unit.preprocessor()->stats();
+  const auto stats = unit.stats();
+
+  // the lexing and the include resolution are part of the preprocessing.
+  const auto expansionTime =
+      std::max(stats.preprocessTime + times.preprocess -
+                   preprocessorStats.lexTime - preprocessorStats.includeTime,
+               std::chrono::nanoseconds{});
+
+  fmt::print(out, "time report for '{}':\n", fileName);
+
+  auto print = [&](std::string_view phase, std::chrono::nanoseconds time) {
+    const auto percent =
+        times.total.count() ? 100.0 * time.count() / times.total.count() : 0.0;
+    fmt::print(out, "  {:<28} {:>10.3f} ms {:>5.1f}%\n", phase,
+               Milliseconds(time).count(), percent);
+  };
+
+  print("lexing", preprocessorStats.lexTime);
+  print("include resolution", preprocessorStats.includeTime);
+  print("macro expansion", expansionTime);
+  print("parsing and type checking", stats.parseTime);
+  print("serialization", stats.serializeTime);
+  print("output", times.output);
+  print("total", times.total);
+}
 
-  if (cli.opt_verify) {
-    diagnosticsClient.setVerify(true);
-    preprocesor->setCommentHandler(&diagnosticsClient);
-  }
+void printStats(std::ostream& out, const std::string& fileName,
+                const TranslationUnit& unit) {
+  const auto& preprocessorStats = unit.preprocessor()->stats();
+  const auto& includeStats = unit.preprocessor()->includeCacheStats();
+  const auto stats = unit.stats();
+  const auto controlStats = unit.control()->stats();
+
+  fmt::print(out, "statistics for '{}':\n", fileName);
+
+  auto print = [&](std::string_view name, std::size_t value) {
+    fmt::print(out, "  {:<28} {:>12}\n", name, value);
+  };
+
+  print("tokens", preprocessorStats.tokens);
+  print("macro expansions", preprocessorStats.macroExpansions);
+  print("hidesets", preprocessorStats.hidesets);
+  print("token cache hits", preprocessorStats.tokenCacheHits);
+  print("token cache misses", preprocessorStats.tokenCacheMisses);
+  print("includes resolved", includeStats.hits + includeStats.misses);
+  print("includes skipped", includeStats.skippedIncludes);
+  print("include cache hits", includeStats.hits);
+  print("file exists calls", includeStats.fileExistsCalls);
+  print("lookaheads", stats.parser.lookaheads);
+  print("lookahead rewinds", stats.parser.rewinds);
+  print("reclaimed arena bytes", stats.parser.reclaimedBytes);
+  print("ast cache hits", stats.astCache.hits);
+  print("ast cache misses", stats.astCache.misses);
+  print("ast arena bytes", stats.arenaBytes);
+  print("interned names", controlStats.names);
+  print("interned types", controlStats.types);
+  print("interned literals", controlStats.literals);
+  print("symbols", controlStats.symbols);
+  print("control bytes", controlStats.bytes);
+}
 
+auto makeToolchain(const CLI& cli) -> std::unique_ptr<Toolchain> {
   auto toolchainId = cli.getSingle("-toolchain");
 
   if (!toolchainId) {
@@ -122,9 +218,11 @@ auto runOnFile(const CLI& cli, const std::string& fileName) -> bool {
   }
 
   if (toolchainId == "darwin" || toolchainId == "macos") {
-    toolchain = std::make_unique<MacOSToolchain>(preprocesor);
-  } else if (toolchainId == "wasm32") {
-    auto wasmToolchain = std::make_unique<Wasm32WasiToolchain>(preprocesor);
+    return std::make_unique<MacOSToolchain>(nullptr);
+  }
+
+  if (toolchainId == "wasm32") {
+    auto wasmToolchain = std::make_unique<Wasm32WasiToolchain>(nullptr);
 
     fs::path app_dir;
 
@@ -148,8 +246,10 @@ auto runOnFile(const CLI& cli, const std::string& fileName) -> bool {
       wasmToolchain->setSysroot(sysroot_dir.string());
     }
 
-    toolchain = std::move(wasmToolchain);
-  } else if (toolchainId == "linux") {
+    return wasmToolchain;
+  }
+
+  if (toolchainId == "linux") {
     std::string host;
 #ifdef __aarch64__
     host = "aarch64";
@@ -158,9 +258,11 @@ auto runOnFile(const CLI& cli, const std::string& fileName) -> bool {
 #endif
 
     std::string arch = cli.getSingle("-arch").value_or(host);
-    toolchain = std::make_unique<GCCLinuxToolchain>(preprocesor, arch);
-  } else if (toolchainId == "windows") {
-    auto windowsToolchain = std::make_unique<WindowsToolchain>(preprocesor);
+    return std::make_unique<GCCLinuxToolchain>(nullptr, arch);
+  }
+
+  if (toolchainId == "windows") {
+    auto windowsToolchain = std::make_unique<WindowsToolchain>(nullptr);
 
     if (auto paths = cli.get("-vctoolsdir"); !paths.empty()) {
       windowsToolchain->setVctoolsdir(paths.back());
@@ -174,30 +276,67 @@ auto runOnFile(const CLI& cli, const std::string& fileName) -> bool {
       windowsToolchain->setWinsdkversion(versions.back());
     }
 
-    toolchain = std::move(windowsToolchain);
+    return windowsToolchain;
   }
 
-  if (toolchain) {
-    control.setMemoryLayout(toolchain->memoryLayout());
+  return nullptr;
+}
+
+struct FileOutput {
+  std::ostream& output;  // the stream selected with -o
+  std::ostream& out;
+  std::ostream& err;
+};
+
+// the state of the toolchain, set up once in main() and only read by the
+// input files.
+struct SharedToolchain {
+  MemoryLayout* memoryLayout = nullptr;
+  const ToolchainConfiguration* configuration = nullptr;
+  // the include paths are the same for all the input files, so are the
+  // results of the file existence checks.
+  std::shared_ptr<FileSystemCache> fileSystemCache;
+};
+
+auto runOnFile(const CLI& cli, const std::string& fileName,
+               SharedToolchain shared, const FileOutput& files) -> bool {
+  const auto start = std::chrono::steady_clock::now();
+  FrontendTimes times;
 
-    if (!cli.opt_nostdinc) toolchain->addSystemIncludePaths();
+  Control control;
+  VerifyDiagnosticsClient diagnosticsClient;
+  diagnosticsClient.setOutput(files.err);
 
-    if (!cli.opt_nostdincpp) toolchain->addSystemCppIncludePaths();
+  TranslationUnit unit(&control, &diagnosticsClient);
 
-    toolchain->addPredefinedMacros();
+  auto preprocesor = unit.preprocessor();
+
+  if (shared.fileSystemCache) {
+    preprocesor->setFileSystemCache(shared.fileSystemCache);
+  }
+
+  if (cli.opt_verify) {
+    diagnosticsClient.setVerify(true);
+    preprocesor->setCommentHandler(&diagnosticsClient);
   }
 
+  if (shared.memoryLayout) control.setMemoryLayout(shared.memoryLayout);
+
+  if (shared.configuration) shared.configuration->apply(preprocesor);
+
+  preprocesor->setTokenCacheDirectory(tokenCacheDirectory(cli));
+
   for (const auto& path : cli.get("-I")) {
     preprocesor->addSystemIncludePath(path);
   }
 
   if (cli.opt_v) {
-    fmt::print(std::cerr, "#include <...> search starts here:\n");
+    fmt::print(files.err, "#include <...> search starts here:\n");
     const auto& paths = preprocesor->systemIncludePaths();
     for (auto it = rbegin(paths); it != rend(paths); ++it) {
-      fmt::print(std::cerr, " {}\n", *it);
+      fmt::print(files.err, " {}\n", *it);
     }
-    fmt::print(std::cerr, "End of search list.\n");
+    fmt::print(files.err, "End of search list.\n");
   }
 
   for (const auto& macro : cli.get("-D")) {
@@ -214,13 +353,19 @@ auto runOnFile(const CLI& cli, const std::string& fileName) -> bool {
     preprocesor->undefMacro(macro);
   }
 
-  auto outputs = cli.get("-o");
-
-  auto outfile = !outputs.empty() && outputs.back() != "-"
-                     ? std::optional{std::ofstream{outputs.back()}}
-                     : std::nullopt;
+  // the precompiled header is checked against the include paths and the
+  // macros of the command line.
+  if (auto pch = cli.getSingle("-include-pch")) {
+    MemoryMappedFile file;
+    if (!file.open(*pch) ||
+        !preprocesor->includePrecompiledHeader(file.text())) {
+      fmt::print(files.err, "cxx: invalid or stale precompiled header '{}'\n",
+                 *pch);
+      return false;
+    }
+  }
 
-  auto& output = outfile ? *outfile : std::cout;
+  auto& output = files.output;
 
   bool shouldExit = false;
 
@@ -232,11 +377,16 @@ auto runOnFile(const CLI& cli, const std::string& fileName) -> bool {
     preprocesor->setOnWillIncludeHeader(
         [&](const std::string& header, int level) {
           std::string fill(level, '.');
-          fmt::print(stdout, "{} {}\n", fill, header);
+          fmt::print(files.out, "{} {}\n", fill, header);
         });
   }
 
-  if (cli.opt_E && !cli.opt_dM) {
+  if (cli.opt_emit_pch) {
+    ScopedStopwatch stopwatch(times.preprocess);
+    preprocesor->precompileHeader(readAll(fileName), fileName, output);
+    shouldExit = true;
+  } else if (cli.opt_E && !cli.opt_dM) {
+    ScopedStopwatch stopwatch(times.preprocess);
     preprocesor->preprocess(readAll(fileName), fileName, output);
     shouldExit = true;
   } else {
@@ -260,27 +410,97 @@ auto runOnFile(const CLI& cli, const std::string& fileName) -> bool {
         .checkTypes = cli.opt_fcheck,
         .fuzzyTemplateResolution = true,
         .staticAssert = cli.opt_fstatic_assert || cli.opt_fcheck,
+        .packrat = cli.opt_fpackrat,
+        .skipFunctionBodies = cli.opt_fskip_function_bodies,
     });
 
     if (cli.opt_dump_symbols && unit.globalScope()) {
-      dump(std::cout, unit.globalScope()->owner());
+      ScopedStopwatch stopwatch(times.output);
+      dump(files.out, unit.globalScope()->owner());
     }
 
     if (cli.opt_emit_ast) {
-      unit.serialize(output);
+      if (cli.getSingle("-ast-format") == "image") {
+        const auto image = unit.serializeImage();
+        output.write(reinterpret_cast<const char*>(image.data()),
+                     static_cast<std::streamsize>(image.size()));
+      } else {
+        unit.serialize(output);
+      }
     }
 
     if (cli.opt_ast_dump) {
-      ASTPrinter printAST(&unit, std::cout);
+      ScopedStopwatch stopwatch(times.output);
+      ASTPrinter printAST(&unit, files.out);
       printAST(unit.ast());
     }
   }
 
   diagnosticsClient.verifyExpectedDiagnostics();
 
+  times.total = std::chrono::steady_clock::now() - start;
+
+  if (cli.opt_ftime_report) printTimeReport(files.err, fileName, unit, times);
+
+  if (cli.opt_fstats) printStats(files.err, fileName, unit);
+
   return !diagnosticsClient.hasErrors();
 }
 
+#ifndef CXX_NO_THREADS
+
+// Parses the input files on a pool of worker threads. Every file gets its own
+// Control and TranslationUnit, the toolchain is shared. The output and the
+// diagnostics of each file are buffered and flushed in command line order.
+auto runOnFilesInParallel(const CLI& cli,
+                          const std::vector<std::string>& inputFiles,
+                          SharedToolchain shared, std::ostream& output,
+                          int workerCount) -> bool {
+  struct Job {
+    std::ostringstream output;
+    std::ostringstream out;
+    std::ostringstream err;
+    bool succeeded = false;
+    std::promise<void> done;
+  };
+
+  std::vector<Job> jobs(inputFiles.size());
+  std::atomic_size_t nextJob{0};
+
+  auto worker = [&] {
+    for (auto index = nextJob++; index < jobs.size(); index = nextJob++) {
+      auto& job = jobs[index];
+
+      job.succeeded = runOnFile(cli, inputFiles[index], shared,
+                                FileOutput{job.output, job.out, job.err});
+
+      job.done.set_value();
+    }
+  };
+
+  std::vector<std::thread> workers;
+  workerCount = std::min(workerCount, static_cast<int>(jobs.size()));
+  for (int i = 0; i < workerCount; ++i) workers.emplace_back(worker);
+
+  bool succeeded = true;
+
+  for (auto& job : jobs) {
+    job.done.get_future().wait();
+
+    output << job.output.view();
+    std::cout << job.out.view();
+    std::cerr << job.err.view();
+
+    if (!job.succeeded) succeeded = false;
+  }
+
+  for (auto& thread : workers) thread.join();
+
+  return succeeded;
+}
+
+#endif
+
 }  // namespace
 
 auto main(int argc, char* argv[]) -> int {
@@ -302,10 +522,59 @@ auto main(int argc, char* argv[]) -> int {
     return EXIT_FAILURE;
   }
 
+  int workerCount = 1;
+
+  if (auto jobs = cli.getSingle("-j")) {
+    const auto first = jobs->data();
+    const auto last = first + jobs->size();
+    const auto [ptr, ec] = std::from_chars(first, last, workerCount);
+
+    if (ec != std::errc() || ptr != last || workerCount < 1) {
+      std::cerr << "cxx: invalid number of jobs '" << *jobs << "'"
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  auto toolchain = makeToolchain(cli);
+
+  auto outputs = cli.get("-o");
+
+  auto outfile = !outputs.empty() && outputs.back() != "-"
+                     ? std::optional{std::ofstream{outputs.back()}}
+                     : std::nullopt;
+
+  auto& output = outfile ? *outfile : std::cout;
+
+  // the include paths and the predefined macros are collected once, and
+  // copied to the preprocessor of each input file.
+  std::optional<ToolchainConfiguration> configuration;
+
+  SharedToolchain shared;
+  shared.fileSystemCache = std::make_shared<FileSystemCache>();
+
+  if (toolchain) {
+    configuration = toolchain->configuration(!cli.opt_nostdinc,
+                                             !cli.opt_nostdincpp);
+    shared.memoryLayout = toolchain->memoryLayout();
+    shared.configuration = &*configuration;
+  }
+
+#ifndef CXX_NO_THREADS
+  if (workerCount > 1 && inputFiles.size() > 1) {
+    if (!runOnFilesInParallel(cli, inputFiles, shared, output, workerCount)) {
+      return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+  }
+#endif
+
   int existStatus = EXIT_SUCCESS;
 
   for (const auto& fileName : inputFiles) {
-    if (!runOnFile(cli, fileName)) {
+    if (!runOnFile(cli, fileName, shared,
+                   FileOutput{output, std::cout, std::cerr})) {
       existStatus = EXIT_FAILURE;
     }
   }
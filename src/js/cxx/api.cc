@@ -21,6 +21,7 @@
 #include <cxx/ast.h>
 #include <cxx/ast_slot.h>
 #include <cxx/control.h>
+#include <cxx/flat_ast.h>
 #include <cxx/lexer.h>
 #include <cxx/literals.h>
 #include <cxx/names.h>
@@ -32,7 +33,9 @@
 #include <emscripten/bind.h>
 #include <emscripten/val.h>
 
+#include <algorithm>
 #include <sstream>
+#include <vector>
 
 using namespace emscripten;
 
@@ -41,56 +44,150 @@ namespace {
 cxx::ASTSlot getSlot;
 
 struct DiagnosticsClient final : cxx::DiagnosticsClient {
-  val messages = val::array();
+  std::vector<cxx::Diagnostic> diagnostics;
 
   void report(const cxx::Diagnostic& diag) override {
-    std::string_view fileName;
-    std::uint32_t line = 0;
-    std::uint32_t column = 0;
-
-    preprocessor()->getTokenStartPosition(diag.token(), &line, &column,
-                                          &fileName);
-
-    std::uint32_t endLine = 0;
-    std::uint32_t endColumn = 0;
-
-    preprocessor()->getTokenEndPosition(diag.token(), &endLine, &endColumn,
-                                        nullptr);
-
-    val d = val::object();
-    d.set("fileName", val(std::string(fileName)));
-    d.set("startLine", val(line));
-    d.set("startColumn", val(column));
-    d.set("endLine", val(endLine));
-    d.set("endColumn", val(endColumn));
-    d.set("message", val(diag.message()));
-    messages.call<void>("push", d);
+    diagnostics.push_back(diag);
+  }
+
+  // removes the first count diagnostics of the reparsed range of the file,
+  // and moves the ones following it.
+  void applyEdit(std::size_t count, std::uint32_t fileId, std::uint32_t start,
+                 std::uint32_t end, std::int64_t delta) {
+    std::vector<cxx::Diagnostic> result;
+
+    for (std::size_t i = 0; i < diagnostics.size(); ++i) {
+      const auto& diag = diagnostics[i];
+      const auto& tk = diag.token();
+
+      if (i >= count || tk.fileId() != fileId || tk.offset() < start) {
+        result.push_back(diag);
+        continue;
+      }
+
+      if (tk.offset() < end) continue;
+
+      cxx::Token token(tk.kind(), tk.offset() + delta, tk.length(),
+                       tk.value());
+      token.setFileId(tk.fileId());
+      result.emplace_back(diag.severity(), token, diag.message());
+    }
+
+    diagnostics = std::move(result);
+  }
+
+  val messages() const {
+    val messages = val::array();
+
+    for (const auto& diag : diagnostics) {
+      std::string_view fileName;
+      std::uint32_t line = 0;
+      std::uint32_t column = 0;
+
+      preprocessor()->getTokenStartPosition(diag.token(), &line, &column,
+                                            &fileName);
+
+      std::uint32_t endLine = 0;
+      std::uint32_t endColumn = 0;
+
+      preprocessor()->getTokenEndPosition(diag.token(), &endLine, &endColumn,
+                                          nullptr);
+
+      val d = val::object();
+      d.set("fileName", val(std::string(fileName)));
+      d.set("startLine", val(line));
+      d.set("startColumn", val(column));
+      d.set("endLine", val(endLine));
+      d.set("endColumn", val(endColumn));
+      d.set("message", val(diag.message()));
+      messages.call<void>("push", d);
+    }
+
+    return messages;
   }
 };
 
 struct WrappedUnit {
-  cxx::Control control;
+  std::unique_ptr<cxx::Control> control;
   std::unique_ptr<DiagnosticsClient> diagnosticsClient;
   std::unique_ptr<cxx::TranslationUnit> unit;
+  std::string source;
+  std::string filename;
 
-  WrappedUnit(std::string source, std::string filename) {
+  WrappedUnit(std::string source, std::string filename)
+      : source(std::move(source)), filename(std::move(filename)) {
     diagnosticsClient = std::make_unique<DiagnosticsClient>();
-    unit = std::make_unique<cxx::TranslationUnit>(&control,
+    createTranslationUnit();
+  }
+
+  void createTranslationUnit() {
+    diagnosticsClient->diagnostics.clear();
+
+    // the names, types and symbols of the previous unit are released with
+    // its Control.
+    unit.reset();
+    control = std::make_unique<cxx::Control>();
+
+    unit = std::make_unique<cxx::TranslationUnit>(control.get(),
                                                   diagnosticsClient.get());
     if (auto preprocessor = unit->preprocessor()) {
       preprocessor->setCanResolveFiles(false);
     }
 
-    unit->setSource(std::move(source), std::move(filename));
+    unit->setSource(source, filename);
   }
 
   std::intptr_t getUnitHandle() const { return (std::intptr_t)unit.get(); }
 
   std::intptr_t getHandle() const { return (std::intptr_t)unit->ast(); }
 
-  val getDiagnostics() const { return diagnosticsClient->messages; }
+  val getDiagnostics() const { return diagnosticsClient->messages(); }
+
+  // the units are parsed for editing, see update().
+  bool parse() {
+    return unit->parse(cxx::ParserConfiguration{.incremental = true});
+  }
+
+  // replaces the source of the unit, only the declarations touched by the
+  // changes are reparsed when possible. Returns false if the unit was
+  // parsed again from scratch.
+  bool update(std::string newSource) {
+    const auto size = std::min(source.size(), newSource.size());
+
+    std::size_t prefix = 0;
+    while (prefix < size && source[prefix] == newSource[prefix]) ++prefix;
+
+    std::size_t suffix = 0;
+    while (suffix < size - prefix &&
+           source[source.size() - suffix - 1] ==
+               newSource[newSource.size() - suffix - 1]) {
+      ++suffix;
+    }
+
+    const auto offset = static_cast<std::uint32_t>(prefix);
+    const auto length =
+        static_cast<std::uint32_t>(source.size() - prefix - suffix);
+    const auto text = std::string_view(newSource).substr(
+        prefix, newSource.size() - prefix - suffix);
 
-  bool parse() { return unit->parse(); }
+    const auto count = diagnosticsClient->diagnostics.size();
+    const auto range = unit->applyEdit(offset, length, text);
+
+    source = std::move(newSource);
+
+    if (!range) {
+      createTranslationUnit();
+      parse();
+      return false;
+    }
+
+    const auto [start, end] = *range;
+    const auto eof = unit->tokenAt(cxx::SourceLocation(unit->tokenCount() - 1));
+    const auto delta = std::int64_t(text.size()) - length;
+    diagnosticsClient->applyEdit(count, eof.fileId(), start, end, delta);
+
+    return true;
+  }
 };
 
 std::string getTokenText(std::intptr_t handle, std::intptr_t unitHandle) {
@@ -192,6 +289,15 @@ int getASTSlotCount(std::intptr_t handle, int slot) {
   return static_cast<int>(slotCount);
 }
 
+// flattens the subtree of the node, or the whole AST when handle is 0, and
+// copies it to a Uint32Array, see FlatAST.
+val flattenAST(std::intptr_t handle, std::intptr_t unitHandle) {
+  auto unit = reinterpret_cast<cxx::TranslationUnit*>(unitHandle);
+  const auto data = unit->flatten(reinterpret_cast<cxx::AST*>(handle));
+  return val::global("Uint32Array")
+      .new_(typed_memory_view(data.size(), data.data()));
+}
+
 WrappedUnit* createUnit(std::string source, std::string filename) {
   auto wrapped = new WrappedUnit(std::move(source), std::move(filename));
 
@@ -304,6 +410,7 @@ EMSCRIPTEN_BINDINGS(my_module) {
 
   class_<WrappedUnit>("Unit")
       .function("parse", &WrappedUnit::parse)
+      .function("update", &WrappedUnit::update)
       .function("getHandle", &WrappedUnit::getHandle)
       .function("getUnitHandle", &WrappedUnit::getUnitHandle)
       .function("getDiagnostics", &WrappedUnit::getDiagnostics);
@@ -316,6 +423,7 @@ EMSCRIPTEN_BINDINGS(my_module) {
   function("getASTSlotKind", &getASTSlotKind);
   function("getASTSlotName", &getASTSlotName);
   function("getASTSlotCount", &getASTSlotCount);
+  function("flattenAST", &flattenAST);
   function("getTokenKind", &getTokenKind);
   function("getTokenText", &getTokenText);
   function("getTokenLocation", &getTokenLocation);
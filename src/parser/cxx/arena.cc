@@ -0,0 +1,127 @@
+// Copyright (c) 2023 Roberto Raggi <roberto.raggi@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <cxx/arena.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(__wasi__) && \
+    !defined(__EMSCRIPTEN__)
+#define CXX_HAS_MMAP 1
+#include <sys/mman.h>
+#endif
+
+namespace cxx {
+
+namespace {
+
+void freeBlock(char* data, std::size_t size, bool mapped) {
+#ifdef CXX_HAS_MMAP
+  if (mapped) {
+    munmap(data, size);
+    return;
+  }
+#endif
+  std::free(data);
+}
+
+}  // namespace
+
+void Arena::reset() {
+  for (const auto& block : blocks_) {
+    freeBlock(block.data, block.size, block.mapped);
+  }
+
+  blocks_.clear();
+  ptr_ = end_ = nullptr;
+  nextBlockSize_ = kMinBlockSize;
+  bytesAllocated_ = 0;
+  bytesWasted_ = 0;
+}
+
+void Arena::rollback(const Mark& mark) {
+  while (blocks_.size() > mark.blockCount) {
+    const auto& block = blocks_.back();
+    freeBlock(block.data, block.size, block.mapped);
+    blocks_.pop_back();
+  }
+
+#ifndef NDEBUG
+  // make the use of the released objects fail early.
+  if (mark.ptr && mark.end == end_) {
+    std::memset(mark.ptr, 0xcd, ptr_ - mark.ptr);
+  }
+#endif
+
+  ptr_ = mark.ptr;
+  end_ = mark.end;
+  nextBlockSize_ = mark.nextBlockSize;
+  bytesAllocated_ = mark.bytesAllocated;
+  bytesWasted_ = mark.bytesWasted;
+}
+
+auto Arena::allocateSlow(std::size_t size) noexcept -> void* {
+  if (size > kLargeAllocationSize) {
+    // oversized allocations get a dedicated block, the current block
+    // stays available for the next small allocations.
+    auto data = newBlock(size);
+    bytesAllocated_ += size;
+    return data;
+  }
+
+  bytesWasted_ += end_ - ptr_;
+
+  const auto blockSize = std::max(nextBlockSize_, size);
+  nextBlockSize_ = std::min(nextBlockSize_ * 2, kMaxBlockSize);
+
+  ptr_ = newBlock(blockSize);
+  end_ = ptr_ + blockSize;
+
+  return allocate(size);
+}
+
+auto Arena::newBlock(std::size_t size) noexcept -> char* {
+#ifdef CXX_HAS_MMAP
+  if (useMmap_ && size >= kMaxBlockSize) {
+    void* addr = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (addr != MAP_FAILED) {
+#ifdef MADV_HUGEPAGE
+      madvise(addr, size, MADV_HUGEPAGE);
+#endif
+      auto data = static_cast<char*>(addr);
+      blocks_.push_back(Block{data, size, true});
+      return data;
+    }
+  }
+#endif
+
+  auto data = static_cast<char*>(std::malloc(size));
+  if (!data) std::abort();
+
+  blocks_.push_back(Block{data, size, false});
+  return data;
+}
+
+}  // namespace cxx
@@ -24,55 +24,95 @@
 
 #include <cstddef>
 #include <cstdint>
-#include <cstdlib>
 #include <new>
 #include <vector>
 
 namespace cxx {
 
+// A bump allocator. The blocks grow geometrically from kMinBlockSize to
+// kMaxBlockSize, and allocations larger than kLargeAllocationSize get a
+// block of their own, so they never waste the tail of the current block.
 class Arena {
-  struct Block {
-    static const std::size_t SIZE = 16 * 1024;
-
-    char* data;
-    char* ptr;
-
-    Block(const Block&) = delete;
-    auto operator=(const Block&) -> Block& = delete;
-
-    Block() { ptr = data = static_cast<char*>(std::malloc(SIZE)); }
-
-    ~Block() {
-      if (data) std::free(data);
-    }
+ public:
+  static constexpr std::size_t kMinBlockSize = 4 * 1024;
+  static constexpr std::size_t kMaxBlockSize = 1024 * 1024;
+  static constexpr std::size_t kLargeAllocationSize = 8 * 1024;
+
+  // a position in the arena, see mark() and rollback().
+  struct Mark {
+    std::size_t blockCount = 0;
+    char* ptr = nullptr;
+    char* end = nullptr;
+    std::size_t nextBlockSize = kMinBlockSize;
+    std::size_t bytesAllocated = 0;
+    std::size_t bytesWasted = 0;
   };
 
-  std::vector<Block*> blocks;
-
- public:
   Arena(const Arena& other) = delete;
   auto operator=(const Arena& other) -> Arena& = delete;
   Arena() = default;
   ~Arena() { reset(); }
 
-  void reset() {
-    for (auto&& block : blocks) delete block;
-    blocks.clear();
-  }
+  void reset();
 
   auto allocate(std::size_t size) noexcept -> void* {
-    if (!blocks.empty()) {
-      constexpr auto align = alignof(std::max_align_t) - 1;
-
-      auto block = blocks.back();
-      block->ptr = (char*)((std::intptr_t(block->ptr) + align) & ~align);
-      void* addr = block->ptr;
-      block->ptr += size;
-      if (block->ptr < block->data + Block::SIZE) return addr;
+    constexpr auto align = alignof(std::max_align_t) - 1;
+    auto addr = (char*)((std::intptr_t(ptr_) + align) & ~align);
+    if (ptr_ && addr <= end_ && size <= std::size_t(end_ - addr)) {
+      bytesAllocated_ += size;
+      bytesWasted_ += addr - ptr_;
+      ptr_ = addr + size;
+      return addr;
     }
-    blocks.push_back(::new Block());
-    return allocate(size);
+    return allocateSlow(size);
   }
+
+  [[nodiscard]] auto mark() const -> Mark {
+    return Mark{blocks_.size(), ptr_,           end_,
+                nextBlockSize_, bytesAllocated_, bytesWasted_};
+  }
+
+  // releases the memory allocated after the given mark. The objects
+  // allocated after the mark must not be used anymore, and their
+  // destructors are not called.
+  void rollback(const Mark& mark);
+
+  // when enabled, the blocks of kMaxBlockSize bytes or more are mapped
+  // directly from the operating system instead of using malloc.
+  [[nodiscard]] auto useMmap() const -> bool { return useMmap_; }
+  void setUseMmap(bool useMmap) { useMmap_ = useMmap; }
+
+  // the number of bytes returned by allocate.
+  [[nodiscard]] auto bytesAllocated() const -> std::size_t {
+    return bytesAllocated_;
+  }
+
+  // the number of bytes lost to alignment and to unused block tails.
+  [[nodiscard]] auto bytesWasted() const -> std::size_t {
+    return bytesWasted_;
+  }
+
+  [[nodiscard]] auto blockCount() const -> std::size_t {
+    return blocks_.size();
+  }
+
+ private:
+  struct Block {
+    char* data;
+    std::size_t size;
+    bool mapped;
+  };
+
+  auto allocateSlow(std::size_t size) noexcept -> void*;
+  auto newBlock(std::size_t size) noexcept -> char*;
+
+  std::vector<Block> blocks_;
+  char* ptr_ = nullptr;
+  char* end_ = nullptr;
+  std::size_t nextBlockSize_ = kMinBlockSize;
+  std::size_t bytesAllocated_ = 0;
+  std::size_t bytesWasted_ = 0;
+  bool useMmap_ = false;
 };
 
 struct Managed {
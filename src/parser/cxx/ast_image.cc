@@ -0,0 +1,977 @@
+// Copyright (c) 2023 Roberto Raggi <roberto.raggi@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cxx/ast_image.h>
+
+// cxx
+#include <cxx/arena.h>
+#include <cxx/ast.h>
+#include <cxx/ast_slot.h>
+#include <cxx/control.h>
+#include <cxx/literals.h>
+#include <cxx/names.h>
+#include <cxx/token.h>
+#include <cxx/translation_unit.h>
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <new>
+
+namespace cxx {
+
+namespace {
+
+#define TOKEN_COUNT(tk, _) +1
+constexpr std::uint32_t kTokenKindCount = 0 FOR_EACH_TOKEN(TOKEN_COUNT);
+constexpr std::uint64_t kBuiltinKindCount = 1 FOR_EACH_BUILTIN(TOKEN_COUNT);
+#undef TOKEN_COUNT
+
+auto alignTo(std::size_t size) -> std::size_t {
+  return (size + ASTImage::kAlignment - 1) & ~(ASTImage::kAlignment - 1);
+}
+
+auto zigzag(std::int64_t value) -> std::uint64_t {
+  return (static_cast<std::uint64_t>(value) << 1) ^
+         static_cast<std::uint64_t>(value >> 63);
+}
+
+auto unzigzag(std::uint64_t value) -> std::int64_t {
+  return static_cast<std::int64_t>(value >> 1) ^
+         -static_cast<std::int64_t>(value & 1);
+}
+
+void writeVarint(std::vector<std::uint8_t>& out, std::uint64_t value) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<std::uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<std::uint8_t>(value));
+}
+
+class VarintReader {
+ public:
+  explicit VarintReader(std::span<const std::uint8_t> data)
+      : it_(data.data()), end_(data.data() + data.size()) {}
+
+  [[nodiscard]] auto ok() const -> bool { return ok_; }
+
+  auto operator()() -> std::uint64_t {
+    std::uint64_t value = 0;
+    for (int shift = 0; shift < 64 && it_ != end_; shift += 7) {
+      const auto byte = *it_++;
+      value |= std::uint64_t(byte & 0x7f) << shift;
+      if (!(byte & 0x80)) return value;
+    }
+    ok_ = false;
+    return 0;
+  }
+
+ private:
+  const std::uint8_t* it_;
+  const std::uint8_t* end_;
+  bool ok_ = true;
+};
+
+auto loadWord(std::span<const std::uint8_t> data, std::size_t index)
+    -> std::uint32_t {
+  std::uint32_t value = 0;
+  std::memcpy(&value, data.data() + index * sizeof(value), sizeof(value));
+  return value;
+}
+
+auto isLiteralAtom(TokenKind kind) -> bool {
+  return kind != TokenKind::T_EOF_SYMBOL && kind != TokenKind::T_IDENTIFIER;
+}
+
+auto internLiteral(Control* control, TokenKind kind, std::string_view text)
+    -> const Literal* {
+  switch (kind) {
+    case TokenKind::T_CHARACTER_LITERAL:
+      return control->charLiteral(text);
+    case TokenKind::T_FLOATING_POINT_LITERAL:
+      return control->floatLiteral(text);
+    case TokenKind::T_INTEGER_LITERAL:
+      return control->integerLiteral(text);
+    case TokenKind::T_STRING_LITERAL:
+    case TokenKind::T_USER_DEFINED_STRING_LITERAL:
+      return control->stringLiteral(text);
+    case TokenKind::T_UTF8_STRING_LITERAL:
+      return control->utf8StringLiteral(text);
+    case TokenKind::T_UTF16_STRING_LITERAL:
+      return control->utf16StringLiteral(text);
+    case TokenKind::T_UTF32_STRING_LITERAL:
+      return control->utf32StringLiteral(text);
+    case TokenKind::T_WIDE_STRING_LITERAL:
+      return control->wideStringLiteral(text);
+    case TokenKind::T_COMMENT:
+      return control->commentLiteral(text);
+    default:
+      return nullptr;
+  }  // switch
+}
+
+}  // namespace
+
+auto ASTImage::layoutHash() -> std::uint32_t {
+  static const std::uint32_t hash = [] {
+    // FNV-1a, one word at a time.
+    std::uint32_t h = 2166136261u;
+    auto add = [&h](std::size_t value) {
+      h = (h ^ static_cast<std::uint32_t>(value)) * 16777619u;
+    };
+
+    add(sizeof(void*));
+    add(sizeof(List<AST*>));
+    add(offsetof(List<AST*>, value));
+    add(offsetof(List<AST*>, next));
+
+    for (int kind = 0;; ++kind) {
+      auto layout = getASTLayout(static_cast<ASTKind>(kind));
+      if (!layout) break;
+
+      add(layout->size);
+
+      for (const auto& slot : getASTSlots(static_cast<ASTKind>(kind))) {
+        add(slot.offset);
+        add(slot.kind);
+        add(static_cast<std::size_t>(slot.storage));
+      }
+    }
+
+    return h;
+  }();
+
+  return hash;
+}
+
+auto ASTImageWriter::operator()(UnitAST* root) -> std::vector<std::uint8_t> {
+  atomOffsets_.assign(1, 0);
+
+  writeTokens();
+
+  ASTImage::Header header{};
+  std::memcpy(header.magic, ASTImage::kMagic, sizeof(header.magic));
+  header.version = ASTImage::kVersion;
+  header.layoutHash = ASTImage::layoutHash();
+  header.tokenKindCount = kTokenKindCount;
+  header.root = writeNode(root);
+
+  if (const auto& fileName = unit_->fileName(); !fileName.empty()) {
+    header.fileName =
+        atom(fileName.data(), TokenKind::T_EOF_SYMBOL, fileName) + 1;
+  }
+
+  header.atomCount = static_cast<std::uint32_t>(atomKinds_.size());
+  header.atomTextSize = static_cast<std::uint32_t>(atomText_.size());
+  header.tokenCount = static_cast<std::uint32_t>(tokenKinds_.size());
+  header.tokenValuesSize = static_cast<std::uint32_t>(tokenValues_.size());
+  header.tokenPositionsSize =
+      static_cast<std::uint32_t>(tokenPositions_.size());
+  header.nodeCount = static_cast<std::uint32_t>(nodeTable_.size() / 2);
+  header.nodesSize = static_cast<std::uint32_t>(nodes_.size());
+  header.listCount =
+      static_cast<std::uint32_t>(lists_.size() / sizeof(List<AST*>));
+
+  std::vector<std::uint8_t> data;
+
+  auto append = [&data](const void* bytes, std::size_t size) {
+    data.resize(alignTo(data.size()));
+    if (!size) return;
+    const auto start = data.size();
+    data.resize(start + size);
+    std::memcpy(data.data() + start, bytes, size);
+  };
+
+  append(&header, sizeof(header));
+  append(atomKinds_.data(), atomKinds_.size());
+  append(atomOffsets_.data(), atomOffsets_.size() * sizeof(std::uint32_t));
+  append(atomText_.data(), atomText_.size());
+  append(tokenKinds_.data(), tokenKinds_.size());
+  append(tokenFlags_.data(), tokenFlags_.size());
+  append(tokenValues_.data(), tokenValues_.size());
+  append(tokenPositions_.data(), tokenPositions_.size());
+  append(nodeTable_.data(), nodeTable_.size() * sizeof(std::uint32_t));
+  append(nodes_.data(), nodes_.size());
+  append(lists_.data(), lists_.size());
+  data.resize(alignTo(data.size()));
+
+  return data;
+}
+
+void ASTImageWriter::writeTokens() {
+  const auto tokenCount = unit_->tokenCount();
+
+  tokenKinds_.reserve(tokenCount);
+  tokenFlags_.reserve(tokenCount);
+
+  std::int64_t previousLine = 0;
+  std::string_view previousFileName;
+
+  for (unsigned index = 0; index < tokenCount; ++index) {
+    const SourceLocation loc(index);
+    const auto tk = unit_->tokenAt(loc);
+    const auto kind = tk.kind();
+
+    tokenKinds_.push_back(static_cast<std::uint8_t>(kind));
+
+    std::uint8_t flags = 0;
+    if (tk.startOfLine()) flags |= ASTImage::kStartOfLine;
+    if (tk.leadingSpace()) flags |= ASTImage::kLeadingSpace;
+    tokenFlags_.push_back(flags);
+
+    if (Token::hasValue(kind)) {
+      const auto value = tk.value();
+      std::uint32_t encoded = 0;
+
+      if (kind == TokenKind::T_BUILTIN) {
+        encoded = static_cast<std::uint32_t>(value.intValue);
+      } else if (kind == TokenKind::T_IDENTIFIER) {
+        if (auto id = value.idValue) {
+          encoded = atom(id, kind, id->name()) + 1;
+        }
+      } else if (auto literal = value.literalValue) {
+        encoded = atom(literal, kind, literal->value()) + 1;
+      }
+
+      writeVarint(tokenValues_, encoded);
+    }
+
+    unsigned line = 0, column = 0, endLine = 0, endColumn = 0;
+    std::string_view fileName;
+    unit_->getTokenStartPosition(loc, &line, &column, &fileName);
+    unit_->getTokenEndPosition(loc, &endLine, &endColumn);
+
+    // the lowest bit of the line delta tells if the file changed.
+    const bool fileChanged = fileName.data() != previousFileName.data() ||
+                             fileName.size() != previousFileName.size();
+
+    writeVarint(tokenPositions_,
+                zigzag(std::int64_t(line) - previousLine) << 1 | fileChanged);
+
+    if (fileChanged) {
+      std::uint32_t fileAtom = 0;
+      if (!fileName.empty()) {
+        fileAtom =
+            atom(fileName.data(), TokenKind::T_EOF_SYMBOL, fileName) + 1;
+      }
+      writeVarint(tokenPositions_, fileAtom);
+    }
+
+    writeVarint(tokenPositions_, column);
+    writeVarint(tokenPositions_, zigzag(std::int64_t(endLine) - line));
+    writeVarint(tokenPositions_, endColumn);
+    writeVarint(tokenPositions_, tk.length());
+
+    previousLine = line;
+    previousFileName = fileName;
+  }
+}
+
+auto ASTImageWriter::writeNode(AST* ast) -> std::uint32_t {
+  if (!ast) return 0;
+
+  const auto index = static_cast<std::uint32_t>(nodeTable_.size() / 2) + 1;
+
+  if (auto [it, inserted] = nodeIndices_.emplace(ast, index); !inserted) {
+    return it->second;
+  }
+
+  const auto layout = getASTLayout(ast->kind());
+  const auto offset = alignTo(nodes_.size());
+  nodes_.resize(offset + layout->size);
+
+  nodeTable_.push_back(static_cast<std::uint32_t>(offset));
+  nodeTable_.push_back(static_cast<std::uint32_t>(ast->kind()));
+
+  for (const auto& slot : getASTSlots(ast->kind())) {
+    auto value = getASTSlotValue(ast, slot);
+
+    switch (slot.kind) {
+      case ASTSlotKind::kNode:
+        value = writeNode(reinterpret_cast<AST*>(value));
+        break;
+
+      case ASTSlotKind::kNodeList:
+        value = writeList(reinterpret_cast<List<AST*>*>(value));
+        break;
+
+      case ASTSlotKind::kIdentifierAttribute:
+        if (auto id = reinterpret_cast<const Identifier*>(value)) {
+          value = atom(id, TokenKind::T_IDENTIFIER, id->name()) + 1;
+        }
+        break;
+
+      case ASTSlotKind::kLiteralAttribute:
+        value = literalAtom(reinterpret_cast<const Literal*>(value));
+        break;
+
+      default:
+        break;
+    }  // switch
+
+    // the children are written first, they can move the nodes.
+    setASTSlotValue(reinterpret_cast<AST*>(nodes_.data() + offset), slot,
+                    value);
+  }
+
+  return index;
+}
+
+auto ASTImageWriter::writeList(List<AST*>* list) -> std::uint32_t {
+  std::uint32_t head = 0;
+  std::size_t previous = 0;
+
+  auto link = [&](std::uint32_t index) {
+    if (!head) {
+      head = index;
+      return;
+    }
+    const auto next = std::intptr_t(index);
+    std::memcpy(lists_.data() + previous + offsetof(List<AST*>, next), &next,
+                sizeof(next));
+  };
+
+  for (auto it = list; it; it = it->next) {
+    if (auto known = listIndices_.find(it); known != listIndices_.end()) {
+      link(known->second);
+      break;
+    }
+
+    const auto offset = lists_.size();
+    const auto index =
+        static_cast<std::uint32_t>(offset / sizeof(List<AST*>)) + 1;
+    lists_.resize(offset + sizeof(List<AST*>));
+    listIndices_.emplace(it, index);
+
+    link(index);
+
+    const auto value = std::intptr_t(writeNode(it->value));
+    std::memcpy(lists_.data() + offset + offsetof(List<AST*>, value), &value,
+                sizeof(value));
+
+    previous = offset;
+  }
+
+  return head;
+}
+
+auto ASTImageWriter::atom(const void* key, TokenKind kind,
+                          std::string_view text) -> std::uint32_t {
+  auto [it, inserted] =
+      atoms_.emplace(key, static_cast<std::uint32_t>(atomKinds_.size()));
+
+  if (inserted) {
+    atomKinds_.push_back(static_cast<std::uint8_t>(kind));
+    atomText_.append(text);
+    atomOffsets_.push_back(static_cast<std::uint32_t>(atomText_.size()));
+  }
+
+  return it->second;
+}
+
+auto ASTImageWriter::literalAtom(const Literal* literal) -> std::uint32_t {
+  if (!literal) return 0;
+
+  // the literals of the nodes are the values of their tokens, so their kind
+  // is known when the nodes are written.
+  if (auto it = atoms_.find(literal); it != atoms_.end()) {
+    return it->second + 1;
+  }
+
+  return atom(literal, TokenKind::T_STRING_LITERAL, literal->value()) + 1;
+}
+
+ASTImageView::ASTImageView(std::span<const std::uint8_t> data) {
+  if (data.size() < sizeof(header_)) return;
+
+  std::memcpy(&header_, data.data(), sizeof(header_));
+
+  if (std::memcmp(header_.magic, ASTImage::kMagic, sizeof(header_.magic)))
+    return;
+
+  if (header_.version != ASTImage::kVersion) return;
+  if (header_.layoutHash != ASTImage::layoutHash()) return;
+  if (header_.tokenKindCount != kTokenKindCount) return;
+  if (header_.tokenCount == 0) return;
+  if (header_.fileName > header_.atomCount) return;
+  if (header_.root > header_.nodeCount) return;
+
+  std::size_t offset = sizeof(header_);
+  bool ok = true;
+
+  auto section = [&](std::size_t size) -> std::span<const std::uint8_t> {
+    offset = alignTo(offset);
+    if (offset > data.size() || size > data.size() - offset) {
+      ok = false;
+      return {};
+    }
+    auto result = data.subspan(offset, size);
+    offset += size;
+    return result;
+  };
+
+  const std::size_t atomCount = header_.atomCount;
+  const std::size_t tokenCount = header_.tokenCount;
+  const std::size_t nodeCount = header_.nodeCount;
+  const std::size_t nodesSize = header_.nodesSize;
+
+  atomKinds_ = section(atomCount);
+  atomOffsets_ = section((atomCount + 1) * sizeof(std::uint32_t));
+  atomText_ = section(header_.atomTextSize);
+  tokenKinds_ = section(tokenCount);
+  tokenFlags_ = section(tokenCount);
+  tokenValues_ = section(header_.tokenValuesSize);
+  tokenPositions_ = section(header_.tokenPositionsSize);
+  nodeTable_ = section(nodeCount * 2 * sizeof(std::uint32_t));
+  nodes_ = section(alignTo(nodesSize) +
+                   std::size_t(header_.listCount) * sizeof(List<AST*>));
+
+  if (!ok) return;
+
+  // the kinds and the offsets of the nodes are checked once, so the nodes
+  // can be read without checking them again.
+  std::size_t end = 0;
+
+  for (std::size_t i = 0; i < nodeCount; ++i) {
+    const std::size_t offset = loadWord(nodeTable_, i * 2);
+    const auto kind = static_cast<ASTKind>(loadWord(nodeTable_, i * 2 + 1));
+    const auto layout = getASTLayout(kind);
+
+    if (!layout) return;
+    if (offset % ASTImage::kAlignment || offset < end) return;
+    if (offset > nodesSize || layout->size > nodesSize - offset) return;
+
+    end = offset + layout->size;
+  }
+
+  valid_ = true;
+}
+
+auto ASTImageView::isNode(std::uint32_t node) const -> bool {
+  return valid_ && node && node <= header_.nodeCount;
+}
+
+auto ASTImageView::kind(std::uint32_t node) const -> ASTKind {
+  if (!isNode(node)) return ASTKind{};
+  return static_cast<ASTKind>(loadWord(nodeTable_, (node - 1) * 2 + 1));
+}
+
+auto ASTImageView::nodeOffset(std::uint32_t node) const -> std::size_t {
+  assert(isNode(node));
+  return loadWord(nodeTable_, (node - 1) * 2);
+}
+
+auto ASTImageView::slotValue(std::uint32_t node,
+                             const ASTSlotDescriptor& slot) const
+    -> std::intptr_t {
+  if (!isNode(node)) return 0;
+  const auto address = nodes_.data() + nodeOffset(node);
+  return getASTSlotValue(reinterpret_cast<const AST*>(address), slot);
+}
+
+auto ASTImageView::atomText(std::uint32_t atom) const -> std::string_view {
+  if (!atom || atom > header_.atomCount) return {};
+  const auto start = loadWord(atomOffsets_, atom - 1);
+  const auto end = loadWord(atomOffsets_, atom);
+  if (end < start || end > atomText_.size()) return {};
+  return std::string_view(
+      reinterpret_cast<const char*>(atomText_.data()) + start, end - start);
+}
+
+auto ASTImageView::identifier(std::uint32_t node) const -> std::string_view {
+  for (const auto& slot : getASTSlots(kind(node))) {
+    if (slot.kind != ASTSlotKind::kIdentifierAttribute) continue;
+    const auto atom = static_cast<std::uintptr_t>(slotValue(node, slot));
+    if (atom > header_.atomCount) return {};
+    return atomText(static_cast<std::uint32_t>(atom));
+  }
+  return {};
+}
+
+auto ASTImageView::listCell(std::uint32_t list) const
+    -> std::pair<std::uint32_t, std::uint32_t> {
+  const auto cell = nodes_.data() + alignTo(header_.nodesSize) +
+                    (list - 1) * sizeof(List<AST*>);
+
+  std::uintptr_t value = 0;
+  std::uintptr_t next = 0;
+  std::memcpy(&value, cell + offsetof(List<AST*>, value), sizeof(value));
+  std::memcpy(&next, cell + offsetof(List<AST*>, next), sizeof(next));
+
+  if (value > header_.nodeCount) value = 0;
+  if (next > header_.listCount) next = 0;
+
+  return {std::uint32_t(value), std::uint32_t(next)};
+}
+
+auto ASTImageReader::operator()(std::span<const std::uint8_t> data, bool lazy)
+    -> bool {
+  unit_->setAST(nullptr);
+
+  image_ = ASTImageView(data);
+  lazy_ = lazy;
+  deferBodies_ = lazy;
+
+  if (!image_.isValid()) return false;
+
+  if (!readAtoms()) return false;
+  if (!readTokens()) return false;
+  if (!readNodes()) return false;
+
+  const auto& header = image_.header();
+
+  unit_->fileName_.clear();
+  if (header.fileName) unit_->fileName_ = atomTexts_[header.fileName - 1];
+
+  return true;
+}
+
+auto ASTImageReader::readAtoms() -> bool {
+  const auto kinds = image_.atomKinds_;
+  const auto offsets = image_.atomOffsets_;
+  const auto text = image_.atomText_;
+  const auto control = unit_->control();
+  const auto chars = reinterpret_cast<const char*>(text.data());
+
+  atomKinds_.resize(kinds.size());
+  atomTexts_.resize(kinds.size());
+  atomValues_.resize(kinds.size());
+  fileIndices_.assign(kinds.size(), 0);
+
+  std::uint32_t start = loadWord(offsets, 0);
+
+  for (std::size_t i = 0; i < kinds.size(); ++i) {
+    const auto end = loadWord(offsets, i + 1);
+
+    if (kinds[i] >= kTokenKindCount) return false;
+    if (end < start || end > text.size()) return false;
+
+    const auto kind = static_cast<TokenKind>(kinds[i]);
+    const std::string_view atomText(chars + start, end - start);
+
+    atomKinds_[i] = kind;
+    atomTexts_[i] = atomText;
+
+    if (kind == TokenKind::T_IDENTIFIER) {
+      atomValues_[i] = control->getIdentifier(atomText);
+    } else if (isLiteralAtom(kind)) {
+      atomValues_[i] = internLiteral(control, kind, atomText);
+      if (!atomValues_[i]) return false;
+    }
+
+    start = end;
+  }
+
+  return true;
+}
+
+auto ASTImageReader::readTokens() -> bool {
+  const auto kinds = image_.tokenKinds_;
+  const auto flags = image_.tokenFlags_;
+  auto unit = unit_;
+
+  unit->tokenKinds_.clear();
+  unit->tokenLocations_.clear();
+  unit->tokenValues_.clear();
+  unit->tokenValueBlocks_.clear();
+  unit->tokenFileIds_.clear();
+  unit->replacedBuiltins_.clear();
+  unit->tokenPositions_.clear();
+  unit->tokenFileNames_.clear();
+
+  unit->tokenKinds_.reserve(kinds.size());
+  unit->tokenLocations_.reserve(kinds.size());
+  unit->tokenPositions_.reserve(kinds.size());
+
+  VarintReader readValue(image_.tokenValues_);
+  VarintReader readPosition(image_.tokenPositions_);
+
+  std::int64_t line = 0;
+  std::uint32_t file = 0;
+
+  for (std::size_t i = 0; i < kinds.size(); ++i) {
+    if (kinds[i] >= kTokenKindCount) return false;
+
+    const auto kind = static_cast<TokenKind>(kinds[i]);
+
+    TokenValue value{};
+
+    if (Token::hasValue(kind)) {
+      const auto encoded = readValue();
+
+      if (kind == TokenKind::T_BUILTIN) {
+        if (encoded >= kBuiltinKindCount) return false;
+        value.intValue = static_cast<int>(encoded);
+      } else if (encoded) {
+        if (encoded > atomKinds_.size()) return false;
+
+        const auto atomKind = atomKinds_[encoded - 1];
+        const auto atomValue = atomValues_[encoded - 1];
+
+        if (kind == TokenKind::T_IDENTIFIER) {
+          if (atomKind != TokenKind::T_IDENTIFIER) return false;
+          value.idValue = static_cast<const Identifier*>(atomValue);
+        } else {
+          if (!isLiteralAtom(atomKind)) return false;
+          value.literalValue = static_cast<const Literal*>(atomValue);
+        }
+      }
+    }
+
+    const auto head = readPosition();
+    line += unzigzag(head >> 1);
+
+    if (head & 1) {
+      const auto fileAtom = readPosition();
+      if (fileAtom > atomKinds_.size()) return false;
+      file = fileAtom ? fileIndex(static_cast<std::uint32_t>(fileAtom)) : 0;
+      if (file == kInvalidFile) return false;
+    }
+
+    const auto column = readPosition();
+    const auto endLine = line + unzigzag(readPosition());
+    const auto endColumn = readPosition();
+    const auto length = readPosition();
+
+    Token tk(kind, 0, static_cast<unsigned>(length), value);
+    tk.setStartOfLine(flags[i] & ASTImage::kStartOfLine);
+    tk.setLeadingSpace(flags[i] & ASTImage::kLeadingSpace);
+    unit->appendToken(tk);
+
+    unit->tokenPositions_.push_back({
+        .fileIndex = file,
+        .line = static_cast<std::uint32_t>(line),
+        .column = static_cast<std::uint32_t>(column),
+        .endLine = static_cast<std::uint32_t>(endLine),
+        .endColumn = static_cast<std::uint32_t>(endColumn),
+    });
+  }
+
+  if (!readValue.ok() || !readPosition.ok()) return false;
+
+  unit->endOfFile_ = static_cast<std::uint32_t>(kinds.size() - 1);
+  unit->garbageTokens_ = 0;
+
+  return true;
+}
+
+auto ASTImageReader::fileIndex(std::uint32_t atom) -> std::uint32_t {
+  if (atomKinds_[atom - 1] != TokenKind::T_EOF_SYMBOL) return kInvalidFile;
+
+  auto& index = fileIndices_[atom - 1];
+
+  if (!index) {
+    unit_->tokenFileNames_.emplace_back(atomTexts_[atom - 1]);
+    index = static_cast<std::uint32_t>(unit_->tokenFileNames_.size());
+  }
+
+  return index;
+}
+
+auto ASTImageReader::readNodes() -> bool {
+  const auto& header = image_.header();
+
+  nodes_ = nullptr;
+  lists_ = nullptr;
+  nodeAddresses_.clear();
+  listAddresses_.clear();
+  pendingNodes_.clear();
+  pendingLists_.clear();
+  bodyStatements_.clear();
+  deferredStatements_.clear();
+
+  if (header.root) {
+    const auto kind = image_.kind(header.root);
+    if (kind != ASTKind::TranslationUnit && kind != ASTKind::ModuleUnit)
+      return false;
+  }
+
+  if (lazy_) {
+    // only the nodes reachable without entering the function bodies are
+    // copied.
+    nodeAddresses_.resize(header.nodeCount);
+    listAddresses_.resize(header.listCount);
+
+    AST* root = header.root ? nodeAt(header.root) : nullptr;
+    if (!fixPending()) return false;
+
+    if (root) unit_->setAST(static_cast<UnitAST*>(root));
+    return true;
+  }
+
+  // the nodes and the list cells are copied with a single memcpy and fixed
+  // up in place.
+  const auto nodes = image_.nodes_;
+  nodes_ = static_cast<char*>(unit_->arena()->allocate(nodes.size()));
+  std::memcpy(nodes_, nodes.data(), nodes.size());
+  lists_ = nodes_ + alignTo(header.nodesSize);
+
+  for (std::uint32_t node = 1; node <= header.nodeCount; ++node) {
+    if (!fixNode(node)) return false;
+  }
+
+  for (std::uint32_t list = 1; list <= header.listCount; ++list) {
+    if (!fixList(list)) return false;
+  }
+
+  if (header.root) {
+    unit_->setAST(static_cast<UnitAST*>(nodeAt(header.root)));
+  }
+
+  return true;
+}
+
+auto ASTImageReader::nodeAt(std::uint32_t node) -> AST* {
+  if (!lazy_) {
+    return reinterpret_cast<AST*>(nodes_ + image_.nodeOffset(node));
+  }
+
+  auto& address = nodeAddresses_[node - 1];
+
+  if (!address) {
+    const auto size = getASTLayout(image_.kind(node))->size;
+    auto memory = unit_->arena()->allocate(size);
+    std::memcpy(memory, image_.nodes_.data() + image_.nodeOffset(node), size);
+    address = static_cast<AST*>(memory);
+    pendingNodes_.push_back(node);
+  }
+
+  return address;
+}
+
+auto ASTImageReader::listAt(std::uint32_t list) -> List<AST*>* {
+  const auto offset = alignTo(image_.header().nodesSize) +
+                      (list - 1) * sizeof(List<AST*>);
+
+  if (!lazy_) return reinterpret_cast<List<AST*>*>(nodes_ + offset);
+
+  auto& address = listAddresses_[list - 1];
+
+  if (!address) {
+    auto memory = unit_->arena()->allocate(sizeof(List<AST*>));
+    std::memcpy(memory, image_.nodes_.data() + offset, sizeof(List<AST*>));
+    address = static_cast<List<AST*>*>(memory);
+    pendingLists_.push_back(list);
+  }
+
+  return address;
+}
+
+auto ASTImageReader::fixPending() -> bool {
+  while (!pendingNodes_.empty() || !pendingLists_.empty()) {
+    if (!pendingNodes_.empty()) {
+      const auto node = pendingNodes_.back();
+      pendingNodes_.pop_back();
+      if (!fixNode(node)) return false;
+    } else {
+      const auto list = pendingLists_.back();
+      pendingLists_.pop_back();
+      if (!fixList(list)) return false;
+    }
+  }
+
+  return true;
+}
+
+auto ASTImageReader::fixNode(std::uint32_t node) -> bool {
+  const auto& header = image_.header();
+  const std::uintptr_t nodeCount = header.nodeCount;
+  const std::uintptr_t listCount = header.listCount;
+  const std::uintptr_t tokenCount = header.tokenCount;
+
+  const auto kind = image_.kind(node);
+  const auto address = nodeAt(node);
+  const auto slots = getASTSlots(kind);
+
+  // the slots are saved before the node is constructed, the constructor
+  // resets them to their default values.
+  slotValues_.resize(slots.size());
+  for (std::size_t i = 0; i < slots.size(); ++i) {
+    slotValues_[i] = getASTSlotValue(address, slots[i]);
+  }
+
+  auto ast = getASTLayout(kind)->construct(address);
+
+  // when the function bodies are deferred, the statements of their compound
+  // statements stay in the image.
+  std::ptrdiff_t bodyStatement = -1;
+  std::ptrdiff_t deferredStatements = -1;
+
+  if (deferBodies_) {
+    auto offsetOf = [ast](const void* member) {
+      return static_cast<const char*>(member) -
+             reinterpret_cast<const char*>(ast);
+    };
+
+    if (auto body = ast_cast<CompoundStatementFunctionBodyAST>(ast)) {
+      bodyStatement = offsetOf(&body->statement);
+    } else if (auto statement = ast_cast<CompoundStatementAST>(ast);
+               statement && bodyStatements_.erase(node)) {
+      deferredStatements = offsetOf(&statement->statementList);
+    }
+  }
+
+  for (std::size_t i = 0; i < slots.size(); ++i) {
+    const auto& slot = slots[i];
+    auto value = slotValues_[i];
+    const auto index = static_cast<std::uintptr_t>(value);
+
+    switch (slot.kind) {
+      case ASTSlotKind::kToken:
+        if (index >= tokenCount) return false;
+        break;
+
+      case ASTSlotKind::kNode:
+        if (index > nodeCount) return false;
+        if (!index) break;
+        if (!checkChild(node, std::uint32_t(index), slot)) return false;
+        if (bodyStatement == std::ptrdiff_t(slot.offset)) {
+          if (image_.kind(std::uint32_t(index)) != ASTKind::CompoundStatement)
+            return false;
+          bodyStatements_.insert(std::uint32_t(index));
+        }
+        value = reinterpret_cast<std::intptr_t>(nodeAt(std::uint32_t(index)));
+        break;
+
+      case ASTSlotKind::kNodeList:
+        if (index > listCount) return false;
+        if (!index) break;
+        if (!checkList(node, std::uint32_t(index), slot)) return false;
+        if (deferredStatements == std::ptrdiff_t(slot.offset)) {
+          deferredStatements_.emplace(ast, std::uint32_t(index));
+          value = 0;
+          break;
+        }
+        value = reinterpret_cast<std::intptr_t>(listAt(std::uint32_t(index)));
+        break;
+
+      case ASTSlotKind::kIdentifierAttribute:
+        if (index > atomKinds_.size()) return false;
+        if (!index) break;
+        if (atomKinds_[index - 1] != TokenKind::T_IDENTIFIER) return false;
+        value = reinterpret_cast<std::intptr_t>(atomValues_[index - 1]);
+        break;
+
+      case ASTSlotKind::kLiteralAttribute:
+        if (index > atomKinds_.size()) return false;
+        if (!index) break;
+        if (!isLiteralAtom(atomKinds_[index - 1])) return false;
+        value = reinterpret_cast<std::intptr_t>(atomValues_[index - 1]);
+        break;
+
+      default:
+        if (slot.storage == ASTSlotStorage::kTokenKind &&
+            index >= kTokenKindCount)
+          return false;
+        break;
+    }  // switch
+
+    setASTSlotValue(ast, slot, value);
+  }
+
+  return true;
+}
+
+auto ASTImageReader::checkChild(std::uint32_t node, std::uint32_t child,
+                                const ASTSlotDescriptor& slot) const -> bool {
+  // the nodes are written in pre-order, a child before its parent would
+  // make a cycle.
+  if (child <= node) return false;
+
+  const auto kind = image_.kind(child);
+  return kind >= slot.firstKind && kind <= slot.lastKind;
+}
+
+auto ASTImageReader::checkList(std::uint32_t node, std::uint32_t list,
+                               const ASTSlotDescriptor& slot) const -> bool {
+  const auto& header = image_.header();
+
+  // the cells are written in order, a cell before the previous one would
+  // make a cycle.
+  for (std::uint32_t cell = list; cell;) {
+    if (cell > header.listCount) return false;
+
+    const auto [child, next] = image_.listCell(cell);
+    if (child && !checkChild(node, child, slot)) return false;
+    if (next && next <= cell) return false;
+
+    cell = next;
+  }
+
+  return true;
+}
+
+auto ASTImageReader::fixList(std::uint32_t list) -> bool {
+  const auto& header = image_.header();
+  const auto address = listAt(list);
+  const auto cell = reinterpret_cast<const char*>(address);
+
+  std::uintptr_t value = 0;
+  std::uintptr_t next = 0;
+  std::memcpy(&value, cell + offsetof(List<AST*>, value), sizeof(value));
+  std::memcpy(&next, cell + offsetof(List<AST*>, next), sizeof(next));
+
+  if (value > header.nodeCount || next > header.listCount) return false;
+  if (next && next <= list) return false;
+
+  ::new (address)
+      List<AST*>(value ? nodeAt(std::uint32_t(value)) : nullptr,
+                 next ? listAt(std::uint32_t(next)) : nullptr);
+
+  return true;
+}
+
+auto ASTImageReader::loadFunctionBody(FunctionDefinitionAST* ast) -> bool {
+  auto body = ast_cast<CompoundStatementFunctionBodyAST>(ast->functionBody);
+  if (!body || !body->statement) return false;
+
+  auto it = deferredStatements_.find(body->statement);
+  if (it == deferredStatements_.end()) return false;
+
+  const auto list = it->second;
+  deferredStatements_.erase(it);
+
+  // the nested function definitions, e.g. the members of the local classes,
+  // are loaded with the body.
+  deferBodies_ = false;
+
+  const auto statements = listAt(list);
+  const auto loaded = fixPending();
+
+  deferBodies_ = true;
+
+  if (!loaded) {
+    // the nodes copied by the failed fix-up are not constructed, they are
+    // not linked to the AST, and the other bodies, which could share them,
+    // are not loaded.
+    pendingNodes_.clear();
+    pendingLists_.clear();
+    deferredStatements_.clear();
+    return false;
+  }
+
+  body->statement->statementList =
+      reinterpret_cast<List<StatementAST*>*>(statements);
+
+  return true;
+}
+
+}  // namespace cxx
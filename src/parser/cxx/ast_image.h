@@ -0,0 +1,285 @@
+// Copyright (c) 2023 Roberto Raggi <roberto.raggi@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cxx/ast_fwd.h>
+#include <cxx/ast_slot.h>
+#include <cxx/literals_fwd.h>
+#include <cxx/token_fwd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace cxx {
+
+class TranslationUnit;
+
+// An AST and its tokens stored in the memory layout of the nodes. The image
+// is loaded by copying the nodes into the arena with a single memcpy and
+// fixing them up in place, instead of allocating and decoding them one by
+// one.
+//
+// The image starts with a Header, followed by these sections, each aligned
+// to kAlignment bytes:
+//
+//   - the atoms, i.e. the identifiers, the literals and the file names: the
+//     TokenKind of each atom, the byte offsets of the atomCount + 1 texts,
+//     and the UTF-8 texts.
+//   - the tokens, one column at a time: the kinds, the flags, the values of
+//     the tokens that have one, and the positions. The values and the
+//     positions are varint encoded, the lines relative to the previous
+//     token.
+//   - the node table, the offset and the ASTKind of each node.
+//   - the nodes, followed by the cells of the node lists.
+//
+// In the nodes and in the list cells, the pointers to the nodes and to the
+// cells are stored as their index plus one, and the identifiers and the
+// literals as their atom plus one, zero being nullptr. The semantic members
+// of the nodes, e.g. their symbols and their types, are not stored.
+//
+// The layout of the nodes depends on the compiler and on the version of the
+// library, the images written by another build are rejected, see
+// layoutHash().
+struct ASTImage {
+  static constexpr char kMagic[8] = {'c', 'x', 'x', 'a', 's', 't', 0, 0};
+  static constexpr std::uint32_t kVersion = 1;
+  static constexpr std::size_t kAlignment = alignof(std::max_align_t);
+
+  struct Header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t layoutHash;
+    std::uint32_t tokenKindCount;
+    // the atom of the name of the main source file, plus one.
+    std::uint32_t fileName;
+    std::uint32_t atomCount;
+    std::uint32_t atomTextSize;
+    std::uint32_t tokenCount;
+    std::uint32_t tokenValuesSize;
+    std::uint32_t tokenPositionsSize;
+    std::uint32_t nodeCount;
+    std::uint32_t nodesSize;
+    std::uint32_t listCount;
+    // the index of the root node, plus one.
+    std::uint32_t root;
+  };
+
+  // the flags of the tokens.
+  static constexpr std::uint8_t kStartOfLine = 1 << 0;
+  static constexpr std::uint8_t kLeadingSpace = 1 << 1;
+
+  // a hash of the size and of the slots of every kind of node.
+  [[nodiscard]] static auto layoutHash() -> std::uint32_t;
+};
+
+class ASTImageWriter {
+ public:
+  explicit ASTImageWriter(const TranslationUnit* unit) : unit_(unit) {}
+
+  auto operator()(UnitAST* root) -> std::vector<std::uint8_t>;
+
+ private:
+  void writeTokens();
+
+  auto writeNode(AST* ast) -> std::uint32_t;
+  auto writeList(List<AST*>* list) -> std::uint32_t;
+
+  auto atom(const void* key, TokenKind kind, std::string_view text)
+      -> std::uint32_t;
+  auto literalAtom(const Literal* literal) -> std::uint32_t;
+
+ private:
+  const TranslationUnit* unit_;
+  std::vector<std::uint8_t> atomKinds_;
+  std::vector<std::uint32_t> atomOffsets_;
+  std::string atomText_;
+  std::unordered_map<const void*, std::uint32_t> atoms_;
+  std::vector<std::uint8_t> tokenKinds_;
+  std::vector<std::uint8_t> tokenFlags_;
+  std::vector<std::uint8_t> tokenValues_;
+  std::vector<std::uint8_t> tokenPositions_;
+  std::vector<std::uint32_t> nodeTable_;
+  std::vector<std::uint8_t> nodes_;
+  std::vector<std::uint8_t> lists_;
+  std::unordered_map<const AST*, std::uint32_t> nodeIndices_;
+  std::unordered_map<const List<AST*>*, std::uint32_t> listIndices_;
+};
+
+// A read-only view of an image. The kinds and the children of the nodes
+// are read from the image itself, without loading them in a unit, e.g. to
+// index the declarations of many units. The nodes are the indices of the
+// node table plus one, zero being no node.
+class ASTImageView {
+ public:
+  ASTImageView() = default;
+  explicit ASTImageView(std::span<const std::uint8_t> data);
+
+  // false if the image is malformed or it was written by another build.
+  [[nodiscard]] auto isValid() const -> bool { return valid_; }
+
+  [[nodiscard]] auto header() const -> const ASTImage::Header& {
+    return header_;
+  }
+
+  [[nodiscard]] auto nodeCount() const -> std::uint32_t {
+    return header_.nodeCount;
+  }
+
+  [[nodiscard]] auto root() const -> std::uint32_t { return header_.root; }
+
+  // the kind of the node, ASTKind{} if the node is not in the image, e.g. the
+  // root of an image without one.
+  [[nodiscard]] auto kind(std::uint32_t node) const -> ASTKind;
+
+  // the value of the slot as stored in the image, see ASTImage, 0 if the
+  // node is not in the image.
+  [[nodiscard]] auto slotValue(std::uint32_t node,
+                               const ASTSlotDescriptor& slot) const
+      -> std::intptr_t;
+
+  // the text of the first identifier of the node, e.g. of a NameIdAST.
+  [[nodiscard]] auto identifier(std::uint32_t node) const -> std::string_view;
+
+  // calls f with the children of the node, in the order of the slots and
+  // of the elements of the lists.
+  template <typename F>
+  void forEachChild(std::uint32_t node, const F& f) const;
+
+ private:
+  friend class ASTImageReader;
+
+  [[nodiscard]] auto atomText(std::uint32_t atom) const -> std::string_view;
+
+  // the node and the next cell of a list cell.
+  [[nodiscard]] auto listCell(std::uint32_t list) const
+      -> std::pair<std::uint32_t, std::uint32_t>;
+
+  [[nodiscard]] auto isNode(std::uint32_t node) const -> bool;
+
+  [[nodiscard]] auto nodeOffset(std::uint32_t node) const -> std::size_t;
+
+ private:
+  ASTImage::Header header_{};
+  std::span<const std::uint8_t> atomKinds_;
+  std::span<const std::uint8_t> atomOffsets_;
+  std::span<const std::uint8_t> atomText_;
+  std::span<const std::uint8_t> tokenKinds_;
+  std::span<const std::uint8_t> tokenFlags_;
+  std::span<const std::uint8_t> tokenValues_;
+  std::span<const std::uint8_t> tokenPositions_;
+  std::span<const std::uint8_t> nodeTable_;
+  std::span<const std::uint8_t> nodes_;
+  bool valid_ = false;
+};
+
+class ASTImageReader {
+ public:
+  explicit ASTImageReader(TranslationUnit* unit) : unit_(unit) {}
+
+  // when lazy, the nodes are copied in the arena as they are reached from
+  // the root, and the statements of the function bodies are left in the
+  // image until they are requested with loadFunctionBody(). The data must
+  // outlive the reader.
+  auto operator()(std::span<const std::uint8_t> data, bool lazy = false)
+      -> bool;
+
+  // loads the statements of a function body left in the image. Returns
+  // false if the body was not deferred or it was already loaded.
+  auto loadFunctionBody(FunctionDefinitionAST* ast) -> bool;
+
+ private:
+  auto readAtoms() -> bool;
+  auto readTokens() -> bool;
+  auto readNodes() -> bool;
+
+  [[nodiscard]] auto fileIndex(std::uint32_t atom) -> std::uint32_t;
+
+  [[nodiscard]] auto nodeAt(std::uint32_t node) -> AST*;
+  [[nodiscard]] auto listAt(std::uint32_t list) -> List<AST*>*;
+
+  // checks that a child of the node, or the cells of one of its lists,
+  // come after it and have the kinds of the slot.
+  [[nodiscard]] auto checkChild(std::uint32_t node, std::uint32_t child,
+                                const ASTSlotDescriptor& slot) const -> bool;
+  [[nodiscard]] auto checkList(std::uint32_t node, std::uint32_t list,
+                               const ASTSlotDescriptor& slot) const -> bool;
+
+  auto fixNode(std::uint32_t node) -> bool;
+  auto fixList(std::uint32_t list) -> bool;
+  auto fixPending() -> bool;
+
+ private:
+  static constexpr std::uint32_t kInvalidFile = ~std::uint32_t(0);
+
+  TranslationUnit* unit_;
+  ASTImageView image_;
+  std::vector<TokenKind> atomKinds_;
+  std::vector<std::string_view> atomTexts_;
+  std::vector<const void*> atomValues_;
+  // the index plus one of the file name of each atom in the unit.
+  std::vector<std::uint32_t> fileIndices_;
+  std::vector<std::intptr_t> slotValues_;
+  // the nodes and the list cells copied in the arena all at once.
+  char* nodes_ = nullptr;
+  char* lists_ = nullptr;
+  // when lazy, the nodes and the list cells copied so far, and the ones
+  // not fixed up yet.
+  std::vector<AST*> nodeAddresses_;
+  std::vector<List<AST*>*> listAddresses_;
+  std::vector<std::uint32_t> pendingNodes_;
+  std::vector<std::uint32_t> pendingLists_;
+  // the compound statements of the function bodies, and the statements
+  // left in the image.
+  std::unordered_set<std::uint32_t> bodyStatements_;
+  std::unordered_map<const AST*, std::uint32_t> deferredStatements_;
+  bool lazy_ = false;
+  bool deferBodies_ = false;
+};
+
+template <typename F>
+void ASTImageView::forEachChild(std::uint32_t node, const F& f) const {
+  for (const auto& slot : getASTSlots(kind(node))) {
+    const auto value = static_cast<std::uintptr_t>(slotValue(node, slot));
+
+    // only the children after the node, the ones of a malformed image can
+    // make cycles.
+    if (slot.kind == ASTSlotKind::kNode) {
+      if (value > node && value <= header_.nodeCount) f(std::uint32_t(value));
+    } else if (slot.kind == ASTSlotKind::kNodeList) {
+      std::uintptr_t list = value;
+      while (list && list <= header_.listCount) {
+        const auto [child, next] = listCell(std::uint32_t(list));
+        if (child > node) f(child);
+        if (next <= list) break;
+        list = next;
+      }
+    }
+  }
+}
+
+}  // namespace cxx
@@ -21,33 +21,20 @@
 #include <cxx/ast.h>
 #include <cxx/ast_slot.h>
 
-#include <algorithm>
-#include <stdexcept>
+#include <cstddef>
+#include <iterator>
+#include <new>
 
-namespace cxx {
+// the nodes are not standard-layout types, but offsetof is supported for
+// them by the compilers we use.
+#if defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Winvalid-offsetof"
+#endif
 
-auto ASTSlot::operator()(AST* ast, int slot) -> SlotInfo {
-  std::intptr_t value = 0;
-  ASTSlotKind slotKind = ASTSlotKind::kInvalid;
-  SlotNameIndex slotNameIndex{};
-  int slotCount = 0;
-  if (ast) {
-    std::swap(slot_, slot);
-    std::swap(value_, value);
-    std::swap(slotKind_, slotKind);
-    std::swap(slotNameIndex_, slotNameIndex);
-    std::swap(slotCount_, slotCount);
-    ast->accept(this);
-    std::swap(slot_, slot);
-    std::swap(value_, value);
-    std::swap(slotKind_, slotKind);
-    std::swap(slotNameIndex_, slotNameIndex);
-    std::swap(slotCount_, slotCount);
-  }
-  return {value, slotKind, SlotNameIndex{slotNameIndex}, slotCount};
-}
+namespace cxx {
 
 namespace {
+
 std::string_view kMemberSlotNames[] = {
     "accessLoc",
     "accessOp",
@@ -270,5638 +257,3127 @@ std::string_view kMemberSlotNames[] = {
     "whileLoc",
     "yieldLoc",
 };
-}  // namespace
-std::string_view to_string(SlotNameIndex index) {
-  return kMemberSlotNames[int(index)];
-}
-
-void ASTSlot::visit(TranslationUnitAST* ast) {
-  switch (slot_) {
-    case 0:  // declarationList
-      value_ = reinterpret_cast<std::intptr_t>(ast->declarationList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{53};
-      break;
-  }  // switch
-
-  slotCount_ = 1;
-}
-
-void ASTSlot::visit(ModuleUnitAST* ast) {
-  switch (slot_) {
-    case 0:  // globalModuleFragment
-      value_ = reinterpret_cast<std::intptr_t>(ast->globalModuleFragment);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{86};
-      break;
-    case 1:  // moduleDeclaration
-      value_ = reinterpret_cast<std::intptr_t>(ast->moduleDeclaration);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{131};
-      break;
-    case 2:  // declarationList
-      value_ = reinterpret_cast<std::intptr_t>(ast->declarationList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{53};
-      break;
-    case 3:  // privateModuleFragment
-      value_ = reinterpret_cast<std::intptr_t>(ast->privateModuleFragment);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{153};
-      break;
-  }  // switch
-
-  slotCount_ = 4;
-}
-
-void ASTSlot::visit(SimpleDeclarationAST* ast) {
-  switch (slot_) {
-    case 0:  // attributeList
-      value_ = reinterpret_cast<std::intptr_t>(ast->attributeList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{11};
-      break;
-    case 1:  // declSpecifierList
-      value_ = reinterpret_cast<std::intptr_t>(ast->declSpecifierList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{51};
-      break;
-    case 2:  // initDeclaratorList
-      value_ = reinterpret_cast<std::intptr_t>(ast->initDeclaratorList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{102};
-      break;
-    case 3:  // requiresClause
-      value_ = reinterpret_cast<std::intptr_t>(ast->requiresClause);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{167};
-      break;
-    case 4:  // semicolonLoc
-      value_ = ast->semicolonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{175};
-      break;
-  }  // switch
-
-  slotCount_ = 5;
-}
-
-void ASTSlot::visit(AsmDeclarationAST* ast) {
-  switch (slot_) {
-    case 0:  // attributeList
-      value_ = reinterpret_cast<std::intptr_t>(ast->attributeList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{11};
-      break;
-    case 1:  // asmQualifierList
-      value_ = reinterpret_cast<std::intptr_t>(ast->asmQualifierList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{8};
-      break;
-    case 2:  // asmLoc
-      value_ = ast->asmLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{7};
-      break;
-    case 3:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 4:  // literalLoc
-      value_ = ast->literalLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{124};
-      break;
-    case 5:  // outputOperandList
-      value_ = reinterpret_cast<std::intptr_t>(ast->outputOperandList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{149};
-      break;
-    case 6:  // inputOperandList
-      value_ = reinterpret_cast<std::intptr_t>(ast->inputOperandList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{105};
-      break;
-    case 7:  // clobberList
-      value_ = reinterpret_cast<std::intptr_t>(ast->clobberList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{33};
-      break;
-    case 8:  // gotoLabelList
-      value_ = reinterpret_cast<std::intptr_t>(ast->gotoLabelList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{87};
-      break;
-    case 9:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-    case 10:  // semicolonLoc
-      value_ = ast->semicolonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{175};
-      break;
-    case 11:  // literal
-      value_ = reinterpret_cast<std::intptr_t>(ast->literal);
-      slotKind_ = ASTSlotKind::kLiteralAttribute;
-      slotNameIndex_ = SlotNameIndex{123};
-      break;
-  }  // switch
-
-  slotCount_ = 12;
-}
-
-void ASTSlot::visit(NamespaceAliasDefinitionAST* ast) {
-  switch (slot_) {
-    case 0:  // namespaceLoc
-      value_ = ast->namespaceLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{137};
-      break;
-    case 1:  // identifierLoc
-      value_ = ast->identifierLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{95};
-      break;
-    case 2:  // equalLoc
-      value_ = ast->equalLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{69};
-      break;
-    case 3:  // nestedNameSpecifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->nestedNameSpecifier);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{138};
-      break;
-    case 4:  // unqualifiedId
-      value_ = reinterpret_cast<std::intptr_t>(ast->unqualifiedId);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{212};
-      break;
-    case 5:  // semicolonLoc
-      value_ = ast->semicolonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{175};
-      break;
-    case 6:  // identifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->identifier);
-      slotKind_ = ASTSlotKind::kIdentifierAttribute;
-      slotNameIndex_ = SlotNameIndex{94};
-      break;
-  }  // switch
-
-  slotCount_ = 7;
-}
-
-void ASTSlot::visit(UsingDeclarationAST* ast) {
-  switch (slot_) {
-    case 0:  // usingLoc
-      value_ = ast->usingLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{214};
-      break;
-    case 1:  // usingDeclaratorList
-      value_ = reinterpret_cast<std::intptr_t>(ast->usingDeclaratorList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{213};
-      break;
-    case 2:  // semicolonLoc
-      value_ = ast->semicolonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{175};
-      break;
-  }  // switch
-
-  slotCount_ = 3;
-}
-
-void ASTSlot::visit(UsingEnumDeclarationAST* ast) {
-  switch (slot_) {
-    case 0:  // usingLoc
-      value_ = ast->usingLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{214};
-      break;
-    case 1:  // enumTypeSpecifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->enumTypeSpecifier);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{67};
-      break;
-    case 2:  // semicolonLoc
-      value_ = ast->semicolonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{175};
-      break;
-  }  // switch
-
-  slotCount_ = 3;
-}
-
-void ASTSlot::visit(UsingDirectiveAST* ast) {
-  switch (slot_) {
-    case 0:  // attributeList
-      value_ = reinterpret_cast<std::intptr_t>(ast->attributeList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{11};
-      break;
-    case 1:  // usingLoc
-      value_ = ast->usingLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{214};
-      break;
-    case 2:  // namespaceLoc
-      value_ = ast->namespaceLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{137};
-      break;
-    case 3:  // nestedNameSpecifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->nestedNameSpecifier);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{138};
-      break;
-    case 4:  // unqualifiedId
-      value_ = reinterpret_cast<std::intptr_t>(ast->unqualifiedId);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{212};
-      break;
-    case 5:  // semicolonLoc
-      value_ = ast->semicolonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{175};
-      break;
-  }  // switch
-
-  slotCount_ = 6;
-}
-
-void ASTSlot::visit(StaticAssertDeclarationAST* ast) {
-  switch (slot_) {
-    case 0:  // staticAssertLoc
-      value_ = ast->staticAssertLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{183};
-      break;
-    case 1:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 2:  // expression
-      value_ = reinterpret_cast<std::intptr_t>(ast->expression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{76};
-      break;
-    case 3:  // commaLoc
-      value_ = ast->commaLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{36};
-      break;
-    case 4:  // literalLoc
-      value_ = ast->literalLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{124};
-      break;
-    case 5:  // literal
-      value_ = reinterpret_cast<std::intptr_t>(ast->literal);
-      slotKind_ = ASTSlotKind::kLiteralAttribute;
-      slotNameIndex_ = SlotNameIndex{123};
-      break;
-    case 6:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-    case 7:  // semicolonLoc
-      value_ = ast->semicolonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{175};
-      break;
-  }  // switch
-
-  slotCount_ = 8;
-}
 
-void ASTSlot::visit(AliasDeclarationAST* ast) {
-  switch (slot_) {
-    case 0:  // usingLoc
-      value_ = ast->usingLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{214};
-      break;
-    case 1:  // identifierLoc
-      value_ = ast->identifierLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{95};
-      break;
-    case 2:  // attributeList
-      value_ = reinterpret_cast<std::intptr_t>(ast->attributeList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{11};
-      break;
-    case 3:  // equalLoc
-      value_ = ast->equalLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{69};
-      break;
-    case 4:  // typeId
-      value_ = reinterpret_cast<std::intptr_t>(ast->typeId);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{203};
-      break;
-    case 5:  // semicolonLoc
-      value_ = ast->semicolonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{175};
-      break;
-    case 6:  // identifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->identifier);
-      slotKind_ = ASTSlotKind::kIdentifierAttribute;
-      slotNameIndex_ = SlotNameIndex{94};
-      break;
-  }  // switch
-
-  slotCount_ = 7;
-}
-
-void ASTSlot::visit(OpaqueEnumDeclarationAST* ast) {
-  switch (slot_) {
-    case 0:  // enumLoc
-      value_ = ast->enumLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{66};
-      break;
-    case 1:  // classLoc
-      value_ = ast->classLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{32};
-      break;
-    case 2:  // attributeList
-      value_ = reinterpret_cast<std::intptr_t>(ast->attributeList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{11};
-      break;
-    case 3:  // nestedNameSpecifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->nestedNameSpecifier);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{138};
-      break;
-    case 4:  // unqualifiedId
-      value_ = reinterpret_cast<std::intptr_t>(ast->unqualifiedId);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{212};
-      break;
-    case 5:  // colonLoc
-      value_ = ast->colonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{35};
-      break;
-    case 6:  // typeSpecifierList
-      value_ = reinterpret_cast<std::intptr_t>(ast->typeSpecifierList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{206};
-      break;
-    case 7:  // emicolonLoc
-      value_ = ast->emicolonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{65};
-      break;
-  }  // switch
-
-  slotCount_ = 8;
-}
-
-void ASTSlot::visit(FunctionDefinitionAST* ast) {
-  switch (slot_) {
-    case 0:  // attributeList
-      value_ = reinterpret_cast<std::intptr_t>(ast->attributeList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{11};
-      break;
-    case 1:  // declSpecifierList
-      value_ = reinterpret_cast<std::intptr_t>(ast->declSpecifierList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{51};
-      break;
-    case 2:  // declarator
-      value_ = reinterpret_cast<std::intptr_t>(ast->declarator);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{54};
-      break;
-    case 3:  // requiresClause
-      value_ = reinterpret_cast<std::intptr_t>(ast->requiresClause);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{167};
-      break;
-    case 4:  // functionBody
-      value_ = reinterpret_cast<std::intptr_t>(ast->functionBody);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{85};
-      break;
-  }  // switch
-
-  slotCount_ = 5;
-}
-
-void ASTSlot::visit(TemplateDeclarationAST* ast) {
-  switch (slot_) {
-    case 0:  // templateLoc
-      value_ = ast->templateLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{192};
-      break;
-    case 1:  // lessLoc
-      value_ = ast->lessLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{122};
-      break;
-    case 2:  // templateParameterList
-      value_ = reinterpret_cast<std::intptr_t>(ast->templateParameterList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{193};
-      break;
-    case 3:  // greaterLoc
-      value_ = ast->greaterLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{89};
-      break;
-    case 4:  // requiresClause
-      value_ = reinterpret_cast<std::intptr_t>(ast->requiresClause);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{167};
-      break;
-    case 5:  // declaration
-      value_ = reinterpret_cast<std::intptr_t>(ast->declaration);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{52};
-      break;
-  }  // switch
-
-  slotCount_ = 6;
-}
-
-void ASTSlot::visit(ConceptDefinitionAST* ast) {
-  switch (slot_) {
-    case 0:  // conceptLoc
-      value_ = ast->conceptLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{38};
-      break;
-    case 1:  // identifierLoc
-      value_ = ast->identifierLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{95};
-      break;
-    case 2:  // equalLoc
-      value_ = ast->equalLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{69};
-      break;
-    case 3:  // expression
-      value_ = reinterpret_cast<std::intptr_t>(ast->expression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{76};
-      break;
-    case 4:  // semicolonLoc
-      value_ = ast->semicolonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{175};
-      break;
-    case 5:  // identifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->identifier);
-      slotKind_ = ASTSlotKind::kIdentifierAttribute;
-      slotNameIndex_ = SlotNameIndex{94};
-      break;
-  }  // switch
-
-  slotCount_ = 6;
-}
-
-void ASTSlot::visit(DeductionGuideAST* ast) {
-  switch (slot_) {
-    case 0:  // explicitSpecifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->explicitSpecifier);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{74};
-      break;
-    case 1:  // identifierLoc
-      value_ = ast->identifierLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{95};
-      break;
-    case 2:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 3:  // parameterDeclarationClause
-      value_ = reinterpret_cast<std::intptr_t>(ast->parameterDeclarationClause);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{150};
-      break;
-    case 4:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-    case 5:  // arrowLoc
-      value_ = ast->arrowLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{6};
-      break;
-    case 6:  // templateId
-      value_ = reinterpret_cast<std::intptr_t>(ast->templateId);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{191};
-      break;
-    case 7:  // semicolonLoc
-      value_ = ast->semicolonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{175};
-      break;
-    case 8:  // identifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->identifier);
-      slotKind_ = ASTSlotKind::kIdentifierAttribute;
-      slotNameIndex_ = SlotNameIndex{94};
-      break;
-  }  // switch
-
-  slotCount_ = 9;
-}
-
-void ASTSlot::visit(ExplicitInstantiationAST* ast) {
-  switch (slot_) {
-    case 0:  // externLoc
-      value_ = ast->externLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{78};
-      break;
-    case 1:  // templateLoc
-      value_ = ast->templateLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{192};
-      break;
-    case 2:  // declaration
-      value_ = reinterpret_cast<std::intptr_t>(ast->declaration);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{52};
-      break;
-  }  // switch
-
-  slotCount_ = 3;
-}
-
-void ASTSlot::visit(ExportDeclarationAST* ast) {
-  switch (slot_) {
-    case 0:  // exportLoc
-      value_ = ast->exportLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{75};
-      break;
-    case 1:  // declaration
-      value_ = reinterpret_cast<std::intptr_t>(ast->declaration);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{52};
-      break;
-  }  // switch
-
-  slotCount_ = 2;
-}
-
-void ASTSlot::visit(ExportCompoundDeclarationAST* ast) {
-  switch (slot_) {
-    case 0:  // exportLoc
-      value_ = ast->exportLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{75};
-      break;
-    case 1:  // lbraceLoc
-      value_ = ast->lbraceLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{118};
-      break;
-    case 2:  // declarationList
-      value_ = reinterpret_cast<std::intptr_t>(ast->declarationList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{53};
-      break;
-    case 3:  // rbraceLoc
-      value_ = ast->rbraceLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{160};
-      break;
-  }  // switch
-
-  slotCount_ = 4;
-}
-
-void ASTSlot::visit(LinkageSpecificationAST* ast) {
-  switch (slot_) {
-    case 0:  // externLoc
-      value_ = ast->externLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{78};
-      break;
-    case 1:  // stringliteralLoc
-      value_ = ast->stringliteralLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{186};
-      break;
-    case 2:  // lbraceLoc
-      value_ = ast->lbraceLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{118};
-      break;
-    case 3:  // declarationList
-      value_ = reinterpret_cast<std::intptr_t>(ast->declarationList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{53};
-      break;
-    case 4:  // rbraceLoc
-      value_ = ast->rbraceLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{160};
-      break;
-    case 5:  // stringLiteral
-      value_ = reinterpret_cast<std::intptr_t>(ast->stringLiteral);
-      slotKind_ = ASTSlotKind::kLiteralAttribute;
-      slotNameIndex_ = SlotNameIndex{185};
-      break;
-  }  // switch
-
-  slotCount_ = 6;
-}
-
-void ASTSlot::visit(NamespaceDefinitionAST* ast) {
-  switch (slot_) {
-    case 0:  // inlineLoc
-      value_ = ast->inlineLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{104};
-      break;
-    case 1:  // namespaceLoc
-      value_ = ast->namespaceLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{137};
-      break;
-    case 2:  // attributeList
-      value_ = reinterpret_cast<std::intptr_t>(ast->attributeList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{11};
-      break;
-    case 3:  // nestedNamespaceSpecifierList
-      value_ =
-          reinterpret_cast<std::intptr_t>(ast->nestedNamespaceSpecifierList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{139};
-      break;
-    case 4:  // identifierLoc
-      value_ = ast->identifierLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{95};
-      break;
-    case 5:  // extraAttributeList
-      value_ = reinterpret_cast<std::intptr_t>(ast->extraAttributeList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{79};
-      break;
-    case 6:  // lbraceLoc
-      value_ = ast->lbraceLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{118};
-      break;
-    case 7:  // declarationList
-      value_ = reinterpret_cast<std::intptr_t>(ast->declarationList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{53};
-      break;
-    case 8:  // rbraceLoc
-      value_ = ast->rbraceLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{160};
-      break;
-    case 9:  // identifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->identifier);
-      slotKind_ = ASTSlotKind::kIdentifierAttribute;
-      slotNameIndex_ = SlotNameIndex{94};
-      break;
-    case 10:  // isInline
-      value_ = std::intptr_t(ast->isInline != 0);
-      slotKind_ = ASTSlotKind::kBoolAttribute;
-      slotNameIndex_ = SlotNameIndex{107};
-      break;
-  }  // switch
-
-  slotCount_ = 11;
-}
+constexpr ASTSlotDescriptor kTranslationUnitSlots[] = {
+    {offsetof(TranslationUnitAST, declarationList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{53}, ASTKind::SimpleDeclaration,
+     ASTKind::AsmGotoLabel},
+};
 
-void ASTSlot::visit(EmptyDeclarationAST* ast) {
-  switch (slot_) {
-    case 0:  // semicolonLoc
-      value_ = ast->semicolonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{175};
-      break;
-  }  // switch
+constexpr ASTSlotDescriptor kModuleUnitSlots[] = {
+    {offsetof(ModuleUnitAST, globalModuleFragment), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{86}, ASTKind::GlobalModuleFragment,
+     ASTKind::GlobalModuleFragment},
+    {offsetof(ModuleUnitAST, moduleDeclaration), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{131}, ASTKind::ModuleDeclaration,
+     ASTKind::ModuleDeclaration},
+    {offsetof(ModuleUnitAST, declarationList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{53}, ASTKind::SimpleDeclaration,
+     ASTKind::AsmGotoLabel},
+    {offsetof(ModuleUnitAST, privateModuleFragment), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{153},
+     ASTKind::PrivateModuleFragment, ASTKind::PrivateModuleFragment},
+};
 
-  slotCount_ = 1;
-}
+constexpr ASTSlotDescriptor kSimpleDeclarationSlots[] = {
+    {offsetof(SimpleDeclarationAST, attributeList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{11}, ASTKind::CxxAttribute,
+     ASTKind::AsmAttribute},
+    {offsetof(SimpleDeclarationAST, declSpecifierList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{51}, ASTKind::TypedefSpecifier,
+     ASTKind::TypenameSpecifier},
+    {offsetof(SimpleDeclarationAST, initDeclaratorList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{102}, ASTKind::InitDeclarator,
+     ASTKind::InitDeclarator},
+    {offsetof(SimpleDeclarationAST, requiresClause), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{167}, ASTKind::RequiresClause,
+     ASTKind::RequiresClause},
+    {offsetof(SimpleDeclarationAST, semicolonLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{175}},
+};
 
-void ASTSlot::visit(AttributeDeclarationAST* ast) {
-  switch (slot_) {
-    case 0:  // attributeList
-      value_ = reinterpret_cast<std::intptr_t>(ast->attributeList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{11};
-      break;
-    case 1:  // semicolonLoc
-      value_ = ast->semicolonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{175};
-      break;
-  }  // switch
-
-  slotCount_ = 2;
-}
+constexpr ASTSlotDescriptor kAsmDeclarationSlots[] = {
+    {offsetof(AsmDeclarationAST, attributeList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{11}, ASTKind::CxxAttribute,
+     ASTKind::AsmAttribute},
+    {offsetof(AsmDeclarationAST, asmQualifierList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{8}, ASTKind::AsmQualifier,
+     ASTKind::AsmQualifier},
+    {offsetof(AsmDeclarationAST, asmLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{7}},
+    {offsetof(AsmDeclarationAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(AsmDeclarationAST, literalLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{124}},
+    {offsetof(AsmDeclarationAST, outputOperandList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{149}, ASTKind::AsmOperand,
+     ASTKind::AsmOperand},
+    {offsetof(AsmDeclarationAST, inputOperandList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{105}, ASTKind::AsmOperand,
+     ASTKind::AsmOperand},
+    {offsetof(AsmDeclarationAST, clobberList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{33}, ASTKind::AsmClobber,
+     ASTKind::AsmClobber},
+    {offsetof(AsmDeclarationAST, gotoLabelList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{87}, ASTKind::AsmGotoLabel,
+     ASTKind::AsmGotoLabel},
+    {offsetof(AsmDeclarationAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+    {offsetof(AsmDeclarationAST, semicolonLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{175}},
+    {offsetof(AsmDeclarationAST, literal), ASTSlotKind::kLiteralAttribute,
+     ASTSlotStorage::kPointer, SlotNameIndex{123}},
+};
 
-void ASTSlot::visit(ModuleImportDeclarationAST* ast) {
-  switch (slot_) {
-    case 0:  // importLoc
-      value_ = ast->importLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{99};
-      break;
-    case 1:  // importName
-      value_ = reinterpret_cast<std::intptr_t>(ast->importName);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{100};
-      break;
-    case 2:  // attributeList
-      value_ = reinterpret_cast<std::intptr_t>(ast->attributeList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{11};
-      break;
-    case 3:  // semicolonLoc
-      value_ = ast->semicolonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{175};
-      break;
-  }  // switch
-
-  slotCount_ = 4;
-}
+constexpr ASTSlotDescriptor kNamespaceAliasDefinitionSlots[] = {
+    {offsetof(NamespaceAliasDefinitionAST, namespaceLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{137}},
+    {offsetof(NamespaceAliasDefinitionAST, identifierLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{95}},
+    {offsetof(NamespaceAliasDefinitionAST, equalLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{69}},
+    {offsetof(NamespaceAliasDefinitionAST, nestedNameSpecifier),
+     ASTSlotKind::kNode, ASTSlotStorage::kPointer, SlotNameIndex{138},
+     ASTKind::GlobalNestedNameSpecifier, ASTKind::TemplateNestedNameSpecifier},
+    {offsetof(NamespaceAliasDefinitionAST, unqualifiedId), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{212}, ASTKind::NameId,
+     ASTKind::NameId},
+    {offsetof(NamespaceAliasDefinitionAST, semicolonLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{175}},
+    {offsetof(NamespaceAliasDefinitionAST, identifier),
+     ASTSlotKind::kIdentifierAttribute, ASTSlotStorage::kPointer,
+     SlotNameIndex{94}},
+};
 
-void ASTSlot::visit(ParameterDeclarationAST* ast) {
-  switch (slot_) {
-    case 0:  // attributeList
-      value_ = reinterpret_cast<std::intptr_t>(ast->attributeList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{11};
-      break;
-    case 1:  // thisLoc
-      value_ = ast->thisLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{195};
-      break;
-    case 2:  // typeSpecifierList
-      value_ = reinterpret_cast<std::intptr_t>(ast->typeSpecifierList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{206};
-      break;
-    case 3:  // declarator
-      value_ = reinterpret_cast<std::intptr_t>(ast->declarator);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{54};
-      break;
-    case 4:  // equalLoc
-      value_ = ast->equalLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{69};
-      break;
-    case 5:  // expression
-      value_ = reinterpret_cast<std::intptr_t>(ast->expression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{76};
-      break;
-    case 6:  // identifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->identifier);
-      slotKind_ = ASTSlotKind::kIdentifierAttribute;
-      slotNameIndex_ = SlotNameIndex{94};
-      break;
-    case 7:  // isThisIntroduced
-      value_ = std::intptr_t(ast->isThisIntroduced != 0);
-      slotKind_ = ASTSlotKind::kBoolAttribute;
-      slotNameIndex_ = SlotNameIndex{113};
-      break;
-    case 8:  // isPack
-      value_ = std::intptr_t(ast->isPack != 0);
-      slotKind_ = ASTSlotKind::kBoolAttribute;
-      slotNameIndex_ = SlotNameIndex{110};
-      break;
-  }  // switch
-
-  slotCount_ = 9;
-}
+constexpr ASTSlotDescriptor kUsingDeclarationSlots[] = {
+    {offsetof(UsingDeclarationAST, usingLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{214}},
+    {offsetof(UsingDeclarationAST, usingDeclaratorList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{213}, ASTKind::UsingDeclarator,
+     ASTKind::UsingDeclarator},
+    {offsetof(UsingDeclarationAST, semicolonLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{175}},
+};
 
-void ASTSlot::visit(AccessDeclarationAST* ast) {
-  switch (slot_) {
-    case 0:  // accessLoc
-      value_ = ast->accessLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{0};
-      break;
-    case 1:  // colonLoc
-      value_ = ast->colonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{35};
-      break;
-    case 2:  // accessSpecifier
-      value_ = std::intptr_t(ast->accessSpecifier);
-      slotKind_ = ASTSlotKind::kIntAttribute;
-      slotNameIndex_ = SlotNameIndex{2};
-      break;
-  }  // switch
-
-  slotCount_ = 3;
-}
+constexpr ASTSlotDescriptor kUsingEnumDeclarationSlots[] = {
+    {offsetof(UsingEnumDeclarationAST, usingLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{214}},
+    {offsetof(UsingEnumDeclarationAST, enumTypeSpecifier), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{67},
+     ASTKind::ElaboratedTypeSpecifier, ASTKind::ElaboratedTypeSpecifier},
+    {offsetof(UsingEnumDeclarationAST, semicolonLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{175}},
+};
 
-void ASTSlot::visit(ForRangeDeclarationAST* ast) {}
-
-void ASTSlot::visit(StructuredBindingDeclarationAST* ast) {
-  switch (slot_) {
-    case 0:  // attributeList
-      value_ = reinterpret_cast<std::intptr_t>(ast->attributeList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{11};
-      break;
-    case 1:  // declSpecifierList
-      value_ = reinterpret_cast<std::intptr_t>(ast->declSpecifierList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{51};
-      break;
-    case 2:  // refQualifierLoc
-      value_ = ast->refQualifierLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{165};
-      break;
-    case 3:  // lbracketLoc
-      value_ = ast->lbracketLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{120};
-      break;
-    case 4:  // bindingList
-      value_ = reinterpret_cast<std::intptr_t>(ast->bindingList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{21};
-      break;
-    case 5:  // rbracketLoc
-      value_ = ast->rbracketLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{162};
-      break;
-    case 6:  // initializer
-      value_ = reinterpret_cast<std::intptr_t>(ast->initializer);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{103};
-      break;
-    case 7:  // semicolonLoc
-      value_ = ast->semicolonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{175};
-      break;
-  }  // switch
-
-  slotCount_ = 8;
-}
+constexpr ASTSlotDescriptor kUsingDirectiveSlots[] = {
+    {offsetof(UsingDirectiveAST, attributeList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{11}, ASTKind::CxxAttribute,
+     ASTKind::AsmAttribute},
+    {offsetof(UsingDirectiveAST, usingLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{214}},
+    {offsetof(UsingDirectiveAST, namespaceLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{137}},
+    {offsetof(UsingDirectiveAST, nestedNameSpecifier), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{138},
+     ASTKind::GlobalNestedNameSpecifier, ASTKind::TemplateNestedNameSpecifier},
+    {offsetof(UsingDirectiveAST, unqualifiedId), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{212}, ASTKind::NameId,
+     ASTKind::NameId},
+    {offsetof(UsingDirectiveAST, semicolonLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{175}},
+};
 
-void ASTSlot::visit(AsmOperandAST* ast) {
-  switch (slot_) {
-    case 0:  // lbracketLoc
-      value_ = ast->lbracketLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{120};
-      break;
-    case 1:  // symbolicNameLoc
-      value_ = ast->symbolicNameLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{189};
-      break;
-    case 2:  // rbracketLoc
-      value_ = ast->rbracketLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{162};
-      break;
-    case 3:  // constraintLiteralLoc
-      value_ = ast->constraintLiteralLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{45};
-      break;
-    case 4:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 5:  // expression
-      value_ = reinterpret_cast<std::intptr_t>(ast->expression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{76};
-      break;
-    case 6:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-    case 7:  // symbolicName
-      value_ = reinterpret_cast<std::intptr_t>(ast->symbolicName);
-      slotKind_ = ASTSlotKind::kIdentifierAttribute;
-      slotNameIndex_ = SlotNameIndex{188};
-      break;
-    case 8:  // constraintLiteral
-      value_ = reinterpret_cast<std::intptr_t>(ast->constraintLiteral);
-      slotKind_ = ASTSlotKind::kLiteralAttribute;
-      slotNameIndex_ = SlotNameIndex{44};
-      break;
-  }  // switch
-
-  slotCount_ = 9;
-}
+constexpr ASTSlotDescriptor kStaticAssertDeclarationSlots[] = {
+    {offsetof(StaticAssertDeclarationAST, staticAssertLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{183}},
+    {offsetof(StaticAssertDeclarationAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(StaticAssertDeclarationAST, expression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{76},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(StaticAssertDeclarationAST, commaLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{36}},
+    {offsetof(StaticAssertDeclarationAST, literalLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{124}},
+    {offsetof(StaticAssertDeclarationAST, literal),
+     ASTSlotKind::kLiteralAttribute, ASTSlotStorage::kPointer,
+     SlotNameIndex{123}},
+    {offsetof(StaticAssertDeclarationAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+    {offsetof(StaticAssertDeclarationAST, semicolonLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{175}},
+};
 
-void ASTSlot::visit(AsmQualifierAST* ast) {
-  switch (slot_) {
-    case 0:  // qualifierLoc
-      value_ = ast->qualifierLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{156};
-      break;
-    case 1:  // qualifier
-      value_ = std::intptr_t(ast->qualifier);
-      slotKind_ = ASTSlotKind::kIntAttribute;
-      slotNameIndex_ = SlotNameIndex{155};
-      break;
-  }  // switch
-
-  slotCount_ = 2;
-}
+constexpr ASTSlotDescriptor kAliasDeclarationSlots[] = {
+    {offsetof(AliasDeclarationAST, usingLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{214}},
+    {offsetof(AliasDeclarationAST, identifierLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{95}},
+    {offsetof(AliasDeclarationAST, attributeList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{11}, ASTKind::CxxAttribute,
+     ASTKind::AsmAttribute},
+    {offsetof(AliasDeclarationAST, equalLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{69}},
+    {offsetof(AliasDeclarationAST, typeId), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{203}, ASTKind::TypeId,
+     ASTKind::TypeId},
+    {offsetof(AliasDeclarationAST, semicolonLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{175}},
+    {offsetof(AliasDeclarationAST, identifier),
+     ASTSlotKind::kIdentifierAttribute, ASTSlotStorage::kPointer,
+     SlotNameIndex{94}},
+};
 
-void ASTSlot::visit(AsmClobberAST* ast) {
-  switch (slot_) {
-    case 0:  // literalLoc
-      value_ = ast->literalLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{124};
-      break;
-    case 1:  // literal
-      value_ = reinterpret_cast<std::intptr_t>(ast->literal);
-      slotKind_ = ASTSlotKind::kLiteralAttribute;
-      slotNameIndex_ = SlotNameIndex{123};
-      break;
-  }  // switch
-
-  slotCount_ = 2;
-}
+constexpr ASTSlotDescriptor kOpaqueEnumDeclarationSlots[] = {
+    {offsetof(OpaqueEnumDeclarationAST, enumLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{66}},
+    {offsetof(OpaqueEnumDeclarationAST, classLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{32}},
+    {offsetof(OpaqueEnumDeclarationAST, attributeList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{11}, ASTKind::CxxAttribute,
+     ASTKind::AsmAttribute},
+    {offsetof(OpaqueEnumDeclarationAST, nestedNameSpecifier),
+     ASTSlotKind::kNode, ASTSlotStorage::kPointer, SlotNameIndex{138},
+     ASTKind::GlobalNestedNameSpecifier, ASTKind::TemplateNestedNameSpecifier},
+    {offsetof(OpaqueEnumDeclarationAST, unqualifiedId), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{212}, ASTKind::NameId,
+     ASTKind::NameId},
+    {offsetof(OpaqueEnumDeclarationAST, colonLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{35}},
+    {offsetof(OpaqueEnumDeclarationAST, typeSpecifierList),
+     ASTSlotKind::kNodeList, ASTSlotStorage::kPointer, SlotNameIndex{206},
+     ASTKind::TypedefSpecifier, ASTKind::TypenameSpecifier},
+    {offsetof(OpaqueEnumDeclarationAST, emicolonLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{65}},
+};
 
-void ASTSlot::visit(AsmGotoLabelAST* ast) {
-  switch (slot_) {
-    case 0:  // identifierLoc
-      value_ = ast->identifierLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{95};
-      break;
-    case 1:  // identifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->identifier);
-      slotKind_ = ASTSlotKind::kIdentifierAttribute;
-      slotNameIndex_ = SlotNameIndex{94};
-      break;
-  }  // switch
-
-  slotCount_ = 2;
-}
+constexpr ASTSlotDescriptor kFunctionDefinitionSlots[] = {
+    {offsetof(FunctionDefinitionAST, attributeList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{11}, ASTKind::CxxAttribute,
+     ASTKind::AsmAttribute},
+    {offsetof(FunctionDefinitionAST, declSpecifierList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{51}, ASTKind::TypedefSpecifier,
+     ASTKind::TypenameSpecifier},
+    {offsetof(FunctionDefinitionAST, declarator), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{54}, ASTKind::Declarator,
+     ASTKind::Declarator},
+    {offsetof(FunctionDefinitionAST, requiresClause), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{167}, ASTKind::RequiresClause,
+     ASTKind::RequiresClause},
+    {offsetof(FunctionDefinitionAST, functionBody), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{85}, ASTKind::DefaultFunctionBody,
+     ASTKind::DeleteFunctionBody},
+};
 
-void ASTSlot::visit(LabeledStatementAST* ast) {
-  switch (slot_) {
-    case 0:  // identifierLoc
-      value_ = ast->identifierLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{95};
-      break;
-    case 1:  // colonLoc
-      value_ = ast->colonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{35};
-      break;
-    case 2:  // identifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->identifier);
-      slotKind_ = ASTSlotKind::kIdentifierAttribute;
-      slotNameIndex_ = SlotNameIndex{94};
-      break;
-  }  // switch
-
-  slotCount_ = 3;
-}
+constexpr ASTSlotDescriptor kTemplateDeclarationSlots[] = {
+    {offsetof(TemplateDeclarationAST, templateLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{192}},
+    {offsetof(TemplateDeclarationAST, lessLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{122}},
+    {offsetof(TemplateDeclarationAST, templateParameterList),
+     ASTSlotKind::kNodeList, ASTSlotStorage::kPointer, SlotNameIndex{193},
+     ASTKind::TemplateTypeParameter, ASTKind::ConstraintTypeParameter},
+    {offsetof(TemplateDeclarationAST, greaterLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{89}},
+    {offsetof(TemplateDeclarationAST, requiresClause), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{167}, ASTKind::RequiresClause,
+     ASTKind::RequiresClause},
+    {offsetof(TemplateDeclarationAST, declaration), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{52}, ASTKind::SimpleDeclaration,
+     ASTKind::AsmGotoLabel},
+};
 
-void ASTSlot::visit(CaseStatementAST* ast) {
-  switch (slot_) {
-    case 0:  // caseLoc
-      value_ = ast->caseLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{27};
-      break;
-    case 1:  // expression
-      value_ = reinterpret_cast<std::intptr_t>(ast->expression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{76};
-      break;
-    case 2:  // colonLoc
-      value_ = ast->colonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{35};
-      break;
-  }  // switch
-
-  slotCount_ = 3;
-}
+constexpr ASTSlotDescriptor kConceptDefinitionSlots[] = {
+    {offsetof(ConceptDefinitionAST, conceptLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{38}},
+    {offsetof(ConceptDefinitionAST, identifierLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{95}},
+    {offsetof(ConceptDefinitionAST, equalLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{69}},
+    {offsetof(ConceptDefinitionAST, expression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{76},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(ConceptDefinitionAST, semicolonLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{175}},
+    {offsetof(ConceptDefinitionAST, identifier),
+     ASTSlotKind::kIdentifierAttribute, ASTSlotStorage::kPointer,
+     SlotNameIndex{94}},
+};
 
-void ASTSlot::visit(DefaultStatementAST* ast) {
-  switch (slot_) {
-    case 0:  // defaultLoc
-      value_ = ast->defaultLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{58};
-      break;
-    case 1:  // colonLoc
-      value_ = ast->colonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{35};
-      break;
-  }  // switch
-
-  slotCount_ = 2;
-}
+constexpr ASTSlotDescriptor kDeductionGuideSlots[] = {
+    {offsetof(DeductionGuideAST, explicitSpecifier), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{74}, ASTKind::TypedefSpecifier,
+     ASTKind::TypenameSpecifier},
+    {offsetof(DeductionGuideAST, identifierLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{95}},
+    {offsetof(DeductionGuideAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(DeductionGuideAST, parameterDeclarationClause),
+     ASTSlotKind::kNode, ASTSlotStorage::kPointer, SlotNameIndex{150},
+     ASTKind::ParameterDeclarationClause, ASTKind::ParameterDeclarationClause},
+    {offsetof(DeductionGuideAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+    {offsetof(DeductionGuideAST, arrowLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{6}},
+    {offsetof(DeductionGuideAST, templateId), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{191}, ASTKind::SimpleTemplateId,
+     ASTKind::SimpleTemplateId},
+    {offsetof(DeductionGuideAST, semicolonLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{175}},
+    {offsetof(DeductionGuideAST, identifier), ASTSlotKind::kIdentifierAttribute,
+     ASTSlotStorage::kPointer, SlotNameIndex{94}},
+};
 
-void ASTSlot::visit(ExpressionStatementAST* ast) {
-  switch (slot_) {
-    case 0:  // expression
-      value_ = reinterpret_cast<std::intptr_t>(ast->expression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{76};
-      break;
-    case 1:  // semicolonLoc
-      value_ = ast->semicolonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{175};
-      break;
-  }  // switch
-
-  slotCount_ = 2;
-}
+constexpr ASTSlotDescriptor kExplicitInstantiationSlots[] = {
+    {offsetof(ExplicitInstantiationAST, externLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{78}},
+    {offsetof(ExplicitInstantiationAST, templateLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{192}},
+    {offsetof(ExplicitInstantiationAST, declaration), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{52}, ASTKind::SimpleDeclaration,
+     ASTKind::AsmGotoLabel},
+};
 
-void ASTSlot::visit(CompoundStatementAST* ast) {
-  switch (slot_) {
-    case 0:  // lbraceLoc
-      value_ = ast->lbraceLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{118};
-      break;
-    case 1:  // statementList
-      value_ = reinterpret_cast<std::intptr_t>(ast->statementList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{182};
-      break;
-    case 2:  // rbraceLoc
-      value_ = ast->rbraceLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{160};
-      break;
-  }  // switch
-
-  slotCount_ = 3;
-}
+constexpr ASTSlotDescriptor kExportDeclarationSlots[] = {
+    {offsetof(ExportDeclarationAST, exportLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{75}},
+    {offsetof(ExportDeclarationAST, declaration), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{52}, ASTKind::SimpleDeclaration,
+     ASTKind::AsmGotoLabel},
+};
 
-void ASTSlot::visit(IfStatementAST* ast) {
-  switch (slot_) {
-    case 0:  // ifLoc
-      value_ = ast->ifLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{96};
-      break;
-    case 1:  // constexprLoc
-      value_ = ast->constexprLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{42};
-      break;
-    case 2:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 3:  // initializer
-      value_ = reinterpret_cast<std::intptr_t>(ast->initializer);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{103};
-      break;
-    case 4:  // condition
-      value_ = reinterpret_cast<std::intptr_t>(ast->condition);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{39};
-      break;
-    case 5:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-    case 6:  // statement
-      value_ = reinterpret_cast<std::intptr_t>(ast->statement);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{181};
-      break;
-    case 7:  // elseLoc
-      value_ = ast->elseLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{63};
-      break;
-    case 8:  // elseStatement
-      value_ = reinterpret_cast<std::intptr_t>(ast->elseStatement);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{64};
-      break;
-  }  // switch
-
-  slotCount_ = 9;
-}
+constexpr ASTSlotDescriptor kExportCompoundDeclarationSlots[] = {
+    {offsetof(ExportCompoundDeclarationAST, exportLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{75}},
+    {offsetof(ExportCompoundDeclarationAST, lbraceLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{118}},
+    {offsetof(ExportCompoundDeclarationAST, declarationList),
+     ASTSlotKind::kNodeList, ASTSlotStorage::kPointer, SlotNameIndex{53},
+     ASTKind::SimpleDeclaration, ASTKind::AsmGotoLabel},
+    {offsetof(ExportCompoundDeclarationAST, rbraceLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{160}},
+};
 
-void ASTSlot::visit(ConstevalIfStatementAST* ast) {
-  switch (slot_) {
-    case 0:  // ifLoc
-      value_ = ast->ifLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{96};
-      break;
-    case 1:  // exclaimLoc
-      value_ = ast->exclaimLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{72};
-      break;
-    case 2:  // constvalLoc
-      value_ = ast->constvalLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{46};
-      break;
-    case 3:  // statement
-      value_ = reinterpret_cast<std::intptr_t>(ast->statement);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{181};
-      break;
-    case 4:  // elseLoc
-      value_ = ast->elseLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{63};
-      break;
-    case 5:  // elseStatement
-      value_ = reinterpret_cast<std::intptr_t>(ast->elseStatement);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{64};
-      break;
-    case 6:  // isNot
-      value_ = std::intptr_t(ast->isNot != 0);
-      slotKind_ = ASTSlotKind::kBoolAttribute;
-      slotNameIndex_ = SlotNameIndex{108};
-      break;
-  }  // switch
-
-  slotCount_ = 7;
-}
+constexpr ASTSlotDescriptor kLinkageSpecificationSlots[] = {
+    {offsetof(LinkageSpecificationAST, externLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{78}},
+    {offsetof(LinkageSpecificationAST, stringliteralLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{186}},
+    {offsetof(LinkageSpecificationAST, lbraceLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{118}},
+    {offsetof(LinkageSpecificationAST, declarationList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{53}, ASTKind::SimpleDeclaration,
+     ASTKind::AsmGotoLabel},
+    {offsetof(LinkageSpecificationAST, rbraceLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{160}},
+    {offsetof(LinkageSpecificationAST, stringLiteral),
+     ASTSlotKind::kLiteralAttribute, ASTSlotStorage::kPointer,
+     SlotNameIndex{185}},
+};
 
-void ASTSlot::visit(SwitchStatementAST* ast) {
-  switch (slot_) {
-    case 0:  // switchLoc
-      value_ = ast->switchLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{187};
-      break;
-    case 1:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 2:  // initializer
-      value_ = reinterpret_cast<std::intptr_t>(ast->initializer);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{103};
-      break;
-    case 3:  // condition
-      value_ = reinterpret_cast<std::intptr_t>(ast->condition);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{39};
-      break;
-    case 4:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-    case 5:  // statement
-      value_ = reinterpret_cast<std::intptr_t>(ast->statement);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{181};
-      break;
-  }  // switch
-
-  slotCount_ = 6;
-}
+constexpr ASTSlotDescriptor kNamespaceDefinitionSlots[] = {
+    {offsetof(NamespaceDefinitionAST, inlineLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{104}},
+    {offsetof(NamespaceDefinitionAST, namespaceLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{137}},
+    {offsetof(NamespaceDefinitionAST, attributeList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{11}, ASTKind::CxxAttribute,
+     ASTKind::AsmAttribute},
+    {offsetof(NamespaceDefinitionAST, nestedNamespaceSpecifierList),
+     ASTSlotKind::kNodeList, ASTSlotStorage::kPointer, SlotNameIndex{139},
+     ASTKind::NestedNamespaceSpecifier, ASTKind::NestedNamespaceSpecifier},
+    {offsetof(NamespaceDefinitionAST, identifierLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{95}},
+    {offsetof(NamespaceDefinitionAST, extraAttributeList),
+     ASTSlotKind::kNodeList, ASTSlotStorage::kPointer, SlotNameIndex{79},
+     ASTKind::CxxAttribute, ASTKind::AsmAttribute},
+    {offsetof(NamespaceDefinitionAST, lbraceLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{118}},
+    {offsetof(NamespaceDefinitionAST, declarationList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{53}, ASTKind::SimpleDeclaration,
+     ASTKind::AsmGotoLabel},
+    {offsetof(NamespaceDefinitionAST, rbraceLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{160}},
+    {offsetof(NamespaceDefinitionAST, identifier),
+     ASTSlotKind::kIdentifierAttribute, ASTSlotStorage::kPointer,
+     SlotNameIndex{94}},
+    {offsetof(NamespaceDefinitionAST, isInline), ASTSlotKind::kBoolAttribute,
+     ASTSlotStorage::kBool, SlotNameIndex{107}},
+};
 
-void ASTSlot::visit(WhileStatementAST* ast) {
-  switch (slot_) {
-    case 0:  // whileLoc
-      value_ = ast->whileLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{218};
-      break;
-    case 1:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 2:  // condition
-      value_ = reinterpret_cast<std::intptr_t>(ast->condition);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{39};
-      break;
-    case 3:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-    case 4:  // statement
-      value_ = reinterpret_cast<std::intptr_t>(ast->statement);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{181};
-      break;
-  }  // switch
-
-  slotCount_ = 5;
-}
+constexpr ASTSlotDescriptor kEmptyDeclarationSlots[] = {
+    {offsetof(EmptyDeclarationAST, semicolonLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{175}},
+};
 
-void ASTSlot::visit(DoStatementAST* ast) {
-  switch (slot_) {
-    case 0:  // doLoc
-      value_ = ast->doLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{60};
-      break;
-    case 1:  // statement
-      value_ = reinterpret_cast<std::intptr_t>(ast->statement);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{181};
-      break;
-    case 2:  // whileLoc
-      value_ = ast->whileLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{218};
-      break;
-    case 3:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 4:  // expression
-      value_ = reinterpret_cast<std::intptr_t>(ast->expression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{76};
-      break;
-    case 5:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-    case 6:  // semicolonLoc
-      value_ = ast->semicolonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{175};
-      break;
-  }  // switch
-
-  slotCount_ = 7;
-}
+constexpr ASTSlotDescriptor kAttributeDeclarationSlots[] = {
+    {offsetof(AttributeDeclarationAST, attributeList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{11}, ASTKind::CxxAttribute,
+     ASTKind::AsmAttribute},
+    {offsetof(AttributeDeclarationAST, semicolonLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{175}},
+};
 
-void ASTSlot::visit(ForRangeStatementAST* ast) {
-  switch (slot_) {
-    case 0:  // forLoc
-      value_ = ast->forLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{83};
-      break;
-    case 1:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 2:  // initializer
-      value_ = reinterpret_cast<std::intptr_t>(ast->initializer);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{103};
-      break;
-    case 3:  // rangeDeclaration
-      value_ = reinterpret_cast<std::intptr_t>(ast->rangeDeclaration);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{158};
-      break;
-    case 4:  // colonLoc
-      value_ = ast->colonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{35};
-      break;
-    case 5:  // rangeInitializer
-      value_ = reinterpret_cast<std::intptr_t>(ast->rangeInitializer);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{159};
-      break;
-    case 6:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-    case 7:  // statement
-      value_ = reinterpret_cast<std::intptr_t>(ast->statement);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{181};
-      break;
-  }  // switch
-
-  slotCount_ = 8;
-}
+constexpr ASTSlotDescriptor kModuleImportDeclarationSlots[] = {
+    {offsetof(ModuleImportDeclarationAST, importLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{99}},
+    {offsetof(ModuleImportDeclarationAST, importName), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{100}, ASTKind::ImportName,
+     ASTKind::ImportName},
+    {offsetof(ModuleImportDeclarationAST, attributeList),
+     ASTSlotKind::kNodeList, ASTSlotStorage::kPointer, SlotNameIndex{11},
+     ASTKind::CxxAttribute, ASTKind::AsmAttribute},
+    {offsetof(ModuleImportDeclarationAST, semicolonLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{175}},
+};
 
-void ASTSlot::visit(ForStatementAST* ast) {
-  switch (slot_) {
-    case 0:  // forLoc
-      value_ = ast->forLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{83};
-      break;
-    case 1:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 2:  // initializer
-      value_ = reinterpret_cast<std::intptr_t>(ast->initializer);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{103};
-      break;
-    case 3:  // condition
-      value_ = reinterpret_cast<std::intptr_t>(ast->condition);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{39};
-      break;
-    case 4:  // semicolonLoc
-      value_ = ast->semicolonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{175};
-      break;
-    case 5:  // expression
-      value_ = reinterpret_cast<std::intptr_t>(ast->expression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{76};
-      break;
-    case 6:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-    case 7:  // statement
-      value_ = reinterpret_cast<std::intptr_t>(ast->statement);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{181};
-      break;
-  }  // switch
-
-  slotCount_ = 8;
-}
+constexpr ASTSlotDescriptor kParameterDeclarationSlots[] = {
+    {offsetof(ParameterDeclarationAST, attributeList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{11}, ASTKind::CxxAttribute,
+     ASTKind::AsmAttribute},
+    {offsetof(ParameterDeclarationAST, thisLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{195}},
+    {offsetof(ParameterDeclarationAST, typeSpecifierList),
+     ASTSlotKind::kNodeList, ASTSlotStorage::kPointer, SlotNameIndex{206},
+     ASTKind::TypedefSpecifier, ASTKind::TypenameSpecifier},
+    {offsetof(ParameterDeclarationAST, declarator), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{54}, ASTKind::Declarator,
+     ASTKind::Declarator},
+    {offsetof(ParameterDeclarationAST, equalLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{69}},
+    {offsetof(ParameterDeclarationAST, expression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{76},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(ParameterDeclarationAST, identifier),
+     ASTSlotKind::kIdentifierAttribute, ASTSlotStorage::kPointer,
+     SlotNameIndex{94}},
+    {offsetof(ParameterDeclarationAST, isThisIntroduced),
+     ASTSlotKind::kBoolAttribute, ASTSlotStorage::kBool, SlotNameIndex{113}},
+    {offsetof(ParameterDeclarationAST, isPack), ASTSlotKind::kBoolAttribute,
+     ASTSlotStorage::kBool, SlotNameIndex{110}},
+};
 
-void ASTSlot::visit(BreakStatementAST* ast) {
-  switch (slot_) {
-    case 0:  // breakLoc
-      value_ = ast->breakLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{23};
-      break;
-    case 1:  // semicolonLoc
-      value_ = ast->semicolonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{175};
-      break;
-  }  // switch
-
-  slotCount_ = 2;
-}
+constexpr ASTSlotDescriptor kAccessDeclarationSlots[] = {
+    {offsetof(AccessDeclarationAST, accessLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{0}},
+    {offsetof(AccessDeclarationAST, colonLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{35}},
+    {offsetof(AccessDeclarationAST, accessSpecifier),
+     ASTSlotKind::kIntAttribute, ASTSlotStorage::kTokenKind, SlotNameIndex{2}},
+};
 
-void ASTSlot::visit(ContinueStatementAST* ast) {
-  switch (slot_) {
-    case 0:  // continueLoc
-      value_ = ast->continueLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{47};
-      break;
-    case 1:  // semicolonLoc
-      value_ = ast->semicolonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{175};
-      break;
-  }  // switch
-
-  slotCount_ = 2;
-}
+constexpr ASTSlotDescriptor kStructuredBindingDeclarationSlots[] = {
+    {offsetof(StructuredBindingDeclarationAST, attributeList),
+     ASTSlotKind::kNodeList, ASTSlotStorage::kPointer, SlotNameIndex{11},
+     ASTKind::CxxAttribute, ASTKind::AsmAttribute},
+    {offsetof(StructuredBindingDeclarationAST, declSpecifierList),
+     ASTSlotKind::kNodeList, ASTSlotStorage::kPointer, SlotNameIndex{51},
+     ASTKind::TypedefSpecifier, ASTKind::TypenameSpecifier},
+    {offsetof(StructuredBindingDeclarationAST, refQualifierLoc),
+     ASTSlotKind::kToken, ASTSlotStorage::kSourceLocation, SlotNameIndex{165}},
+    {offsetof(StructuredBindingDeclarationAST, lbracketLoc),
+     ASTSlotKind::kToken, ASTSlotStorage::kSourceLocation, SlotNameIndex{120}},
+    {offsetof(StructuredBindingDeclarationAST, bindingList),
+     ASTSlotKind::kNodeList, ASTSlotStorage::kPointer, SlotNameIndex{21},
+     ASTKind::NameId, ASTKind::NameId},
+    {offsetof(StructuredBindingDeclarationAST, rbracketLoc),
+     ASTSlotKind::kToken, ASTSlotStorage::kSourceLocation, SlotNameIndex{162}},
+    {offsetof(StructuredBindingDeclarationAST, initializer), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{103},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(StructuredBindingDeclarationAST, semicolonLoc),
+     ASTSlotKind::kToken, ASTSlotStorage::kSourceLocation, SlotNameIndex{175}},
+};
 
-void ASTSlot::visit(ReturnStatementAST* ast) {
-  switch (slot_) {
-    case 0:  // returnLoc
-      value_ = ast->returnLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{170};
-      break;
-    case 1:  // expression
-      value_ = reinterpret_cast<std::intptr_t>(ast->expression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{76};
-      break;
-    case 2:  // semicolonLoc
-      value_ = ast->semicolonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{175};
-      break;
-  }  // switch
-
-  slotCount_ = 3;
-}
+constexpr ASTSlotDescriptor kAsmOperandSlots[] = {
+    {offsetof(AsmOperandAST, lbracketLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{120}},
+    {offsetof(AsmOperandAST, symbolicNameLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{189}},
+    {offsetof(AsmOperandAST, rbracketLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{162}},
+    {offsetof(AsmOperandAST, constraintLiteralLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{45}},
+    {offsetof(AsmOperandAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(AsmOperandAST, expression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{76},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(AsmOperandAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+    {offsetof(AsmOperandAST, symbolicName), ASTSlotKind::kIdentifierAttribute,
+     ASTSlotStorage::kPointer, SlotNameIndex{188}},
+    {offsetof(AsmOperandAST, constraintLiteral), ASTSlotKind::kLiteralAttribute,
+     ASTSlotStorage::kPointer, SlotNameIndex{44}},
+};
 
-void ASTSlot::visit(CoroutineReturnStatementAST* ast) {
-  switch (slot_) {
-    case 0:  // coreturnLoc
-      value_ = ast->coreturnLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{49};
-      break;
-    case 1:  // expression
-      value_ = reinterpret_cast<std::intptr_t>(ast->expression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{76};
-      break;
-    case 2:  // semicolonLoc
-      value_ = ast->semicolonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{175};
-      break;
-  }  // switch
-
-  slotCount_ = 3;
-}
+constexpr ASTSlotDescriptor kAsmQualifierSlots[] = {
+    {offsetof(AsmQualifierAST, qualifierLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{156}},
+    {offsetof(AsmQualifierAST, qualifier), ASTSlotKind::kIntAttribute,
+     ASTSlotStorage::kTokenKind, SlotNameIndex{155}},
+};
 
-void ASTSlot::visit(GotoStatementAST* ast) {
-  switch (slot_) {
-    case 0:  // gotoLoc
-      value_ = ast->gotoLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{88};
-      break;
-    case 1:  // identifierLoc
-      value_ = ast->identifierLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{95};
-      break;
-    case 2:  // semicolonLoc
-      value_ = ast->semicolonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{175};
-      break;
-    case 3:  // identifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->identifier);
-      slotKind_ = ASTSlotKind::kIdentifierAttribute;
-      slotNameIndex_ = SlotNameIndex{94};
-      break;
-  }  // switch
-
-  slotCount_ = 4;
-}
+constexpr ASTSlotDescriptor kAsmClobberSlots[] = {
+    {offsetof(AsmClobberAST, literalLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{124}},
+    {offsetof(AsmClobberAST, literal), ASTSlotKind::kLiteralAttribute,
+     ASTSlotStorage::kPointer, SlotNameIndex{123}},
+};
 
-void ASTSlot::visit(DeclarationStatementAST* ast) {
-  switch (slot_) {
-    case 0:  // declaration
-      value_ = reinterpret_cast<std::intptr_t>(ast->declaration);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{52};
-      break;
-  }  // switch
+constexpr ASTSlotDescriptor kAsmGotoLabelSlots[] = {
+    {offsetof(AsmGotoLabelAST, identifierLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{95}},
+    {offsetof(AsmGotoLabelAST, identifier), ASTSlotKind::kIdentifierAttribute,
+     ASTSlotStorage::kPointer, SlotNameIndex{94}},
+};
 
-  slotCount_ = 1;
-}
+constexpr ASTSlotDescriptor kLabeledStatementSlots[] = {
+    {offsetof(LabeledStatementAST, identifierLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{95}},
+    {offsetof(LabeledStatementAST, colonLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{35}},
+    {offsetof(LabeledStatementAST, identifier),
+     ASTSlotKind::kIdentifierAttribute, ASTSlotStorage::kPointer,
+     SlotNameIndex{94}},
+};
 
-void ASTSlot::visit(TryBlockStatementAST* ast) {
-  switch (slot_) {
-    case 0:  // tryLoc
-      value_ = ast->tryLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{201};
-      break;
-    case 1:  // statement
-      value_ = reinterpret_cast<std::intptr_t>(ast->statement);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{181};
-      break;
-    case 2:  // handlerList
-      value_ = reinterpret_cast<std::intptr_t>(ast->handlerList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{90};
-      break;
-  }  // switch
-
-  slotCount_ = 3;
-}
+constexpr ASTSlotDescriptor kCaseStatementSlots[] = {
+    {offsetof(CaseStatementAST, caseLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{27}},
+    {offsetof(CaseStatementAST, expression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{76},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(CaseStatementAST, colonLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{35}},
+};
 
-void ASTSlot::visit(CharLiteralExpressionAST* ast) {
-  switch (slot_) {
-    case 0:  // literalLoc
-      value_ = ast->literalLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{124};
-      break;
-    case 1:  // literal
-      value_ = reinterpret_cast<std::intptr_t>(ast->literal);
-      slotKind_ = ASTSlotKind::kLiteralAttribute;
-      slotNameIndex_ = SlotNameIndex{123};
-      break;
-  }  // switch
-
-  slotCount_ = 2;
-}
+constexpr ASTSlotDescriptor kDefaultStatementSlots[] = {
+    {offsetof(DefaultStatementAST, defaultLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{58}},
+    {offsetof(DefaultStatementAST, colonLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{35}},
+};
 
-void ASTSlot::visit(BoolLiteralExpressionAST* ast) {
-  switch (slot_) {
-    case 0:  // literalLoc
-      value_ = ast->literalLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{124};
-      break;
-    case 1:  // isTrue
-      value_ = std::intptr_t(ast->isTrue != 0);
-      slotKind_ = ASTSlotKind::kBoolAttribute;
-      slotNameIndex_ = SlotNameIndex{114};
-      break;
-  }  // switch
-
-  slotCount_ = 2;
-}
+constexpr ASTSlotDescriptor kExpressionStatementSlots[] = {
+    {offsetof(ExpressionStatementAST, expression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{76},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(ExpressionStatementAST, semicolonLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{175}},
+};
 
-void ASTSlot::visit(IntLiteralExpressionAST* ast) {
-  switch (slot_) {
-    case 0:  // literalLoc
-      value_ = ast->literalLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{124};
-      break;
-    case 1:  // literal
-      value_ = reinterpret_cast<std::intptr_t>(ast->literal);
-      slotKind_ = ASTSlotKind::kLiteralAttribute;
-      slotNameIndex_ = SlotNameIndex{123};
-      break;
-  }  // switch
-
-  slotCount_ = 2;
-}
+constexpr ASTSlotDescriptor kCompoundStatementSlots[] = {
+    {offsetof(CompoundStatementAST, lbraceLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{118}},
+    {offsetof(CompoundStatementAST, statementList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{182}, ASTKind::LabeledStatement,
+     ASTKind::TryBlockStatement},
+    {offsetof(CompoundStatementAST, rbraceLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{160}},
+};
 
-void ASTSlot::visit(FloatLiteralExpressionAST* ast) {
-  switch (slot_) {
-    case 0:  // literalLoc
-      value_ = ast->literalLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{124};
-      break;
-    case 1:  // literal
-      value_ = reinterpret_cast<std::intptr_t>(ast->literal);
-      slotKind_ = ASTSlotKind::kLiteralAttribute;
-      slotNameIndex_ = SlotNameIndex{123};
-      break;
-  }  // switch
-
-  slotCount_ = 2;
-}
+constexpr ASTSlotDescriptor kIfStatementSlots[] = {
+    {offsetof(IfStatementAST, ifLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{96}},
+    {offsetof(IfStatementAST, constexprLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{42}},
+    {offsetof(IfStatementAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(IfStatementAST, initializer), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{103}, ASTKind::LabeledStatement,
+     ASTKind::TryBlockStatement},
+    {offsetof(IfStatementAST, condition), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{39},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(IfStatementAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+    {offsetof(IfStatementAST, statement), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{181}, ASTKind::LabeledStatement,
+     ASTKind::TryBlockStatement},
+    {offsetof(IfStatementAST, elseLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{63}},
+    {offsetof(IfStatementAST, elseStatement), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{64}, ASTKind::LabeledStatement,
+     ASTKind::TryBlockStatement},
+};
 
-void ASTSlot::visit(NullptrLiteralExpressionAST* ast) {
-  switch (slot_) {
-    case 0:  // literalLoc
-      value_ = ast->literalLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{124};
-      break;
-    case 1:  // literal
-      value_ = std::intptr_t(ast->literal);
-      slotKind_ = ASTSlotKind::kIntAttribute;
-      slotNameIndex_ = SlotNameIndex{123};
-      break;
-  }  // switch
-
-  slotCount_ = 2;
-}
+constexpr ASTSlotDescriptor kConstevalIfStatementSlots[] = {
+    {offsetof(ConstevalIfStatementAST, ifLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{96}},
+    {offsetof(ConstevalIfStatementAST, exclaimLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{72}},
+    {offsetof(ConstevalIfStatementAST, constvalLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{46}},
+    {offsetof(ConstevalIfStatementAST, statement), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{181}, ASTKind::LabeledStatement,
+     ASTKind::TryBlockStatement},
+    {offsetof(ConstevalIfStatementAST, elseLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{63}},
+    {offsetof(ConstevalIfStatementAST, elseStatement), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{64}, ASTKind::LabeledStatement,
+     ASTKind::TryBlockStatement},
+    {offsetof(ConstevalIfStatementAST, isNot), ASTSlotKind::kBoolAttribute,
+     ASTSlotStorage::kBool, SlotNameIndex{108}},
+};
 
-void ASTSlot::visit(StringLiteralExpressionAST* ast) {
-  switch (slot_) {
-    case 0:  // literalLoc
-      value_ = ast->literalLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{124};
-      break;
-    case 1:  // literal
-      value_ = reinterpret_cast<std::intptr_t>(ast->literal);
-      slotKind_ = ASTSlotKind::kLiteralAttribute;
-      slotNameIndex_ = SlotNameIndex{123};
-      break;
-  }  // switch
-
-  slotCount_ = 2;
-}
+constexpr ASTSlotDescriptor kSwitchStatementSlots[] = {
+    {offsetof(SwitchStatementAST, switchLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{187}},
+    {offsetof(SwitchStatementAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(SwitchStatementAST, initializer), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{103}, ASTKind::LabeledStatement,
+     ASTKind::TryBlockStatement},
+    {offsetof(SwitchStatementAST, condition), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{39},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(SwitchStatementAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+    {offsetof(SwitchStatementAST, statement), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{181}, ASTKind::LabeledStatement,
+     ASTKind::TryBlockStatement},
+};
 
-void ASTSlot::visit(UserDefinedStringLiteralExpressionAST* ast) {
-  switch (slot_) {
-    case 0:  // literalLoc
-      value_ = ast->literalLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{124};
-      break;
-    case 1:  // literal
-      value_ = reinterpret_cast<std::intptr_t>(ast->literal);
-      slotKind_ = ASTSlotKind::kLiteralAttribute;
-      slotNameIndex_ = SlotNameIndex{123};
-      break;
-  }  // switch
-
-  slotCount_ = 2;
-}
+constexpr ASTSlotDescriptor kWhileStatementSlots[] = {
+    {offsetof(WhileStatementAST, whileLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{218}},
+    {offsetof(WhileStatementAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(WhileStatementAST, condition), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{39},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(WhileStatementAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+    {offsetof(WhileStatementAST, statement), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{181}, ASTKind::LabeledStatement,
+     ASTKind::TryBlockStatement},
+};
 
-void ASTSlot::visit(ThisExpressionAST* ast) {
-  switch (slot_) {
-    case 0:  // thisLoc
-      value_ = ast->thisLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{195};
-      break;
-  }  // switch
+constexpr ASTSlotDescriptor kDoStatementSlots[] = {
+    {offsetof(DoStatementAST, doLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{60}},
+    {offsetof(DoStatementAST, statement), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{181}, ASTKind::LabeledStatement,
+     ASTKind::TryBlockStatement},
+    {offsetof(DoStatementAST, whileLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{218}},
+    {offsetof(DoStatementAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(DoStatementAST, expression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{76},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(DoStatementAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+    {offsetof(DoStatementAST, semicolonLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{175}},
+};
 
-  slotCount_ = 1;
-}
+constexpr ASTSlotDescriptor kForRangeStatementSlots[] = {
+    {offsetof(ForRangeStatementAST, forLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{83}},
+    {offsetof(ForRangeStatementAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(ForRangeStatementAST, initializer), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{103}, ASTKind::LabeledStatement,
+     ASTKind::TryBlockStatement},
+    {offsetof(ForRangeStatementAST, rangeDeclaration), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{158}, ASTKind::SimpleDeclaration,
+     ASTKind::AsmGotoLabel},
+    {offsetof(ForRangeStatementAST, colonLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{35}},
+    {offsetof(ForRangeStatementAST, rangeInitializer), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{159},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(ForRangeStatementAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+    {offsetof(ForRangeStatementAST, statement), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{181}, ASTKind::LabeledStatement,
+     ASTKind::TryBlockStatement},
+};
 
-void ASTSlot::visit(NestedExpressionAST* ast) {
-  switch (slot_) {
-    case 0:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 1:  // expression
-      value_ = reinterpret_cast<std::intptr_t>(ast->expression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{76};
-      break;
-    case 2:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-  }  // switch
-
-  slotCount_ = 3;
-}
+constexpr ASTSlotDescriptor kForStatementSlots[] = {
+    {offsetof(ForStatementAST, forLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{83}},
+    {offsetof(ForStatementAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(ForStatementAST, initializer), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{103}, ASTKind::LabeledStatement,
+     ASTKind::TryBlockStatement},
+    {offsetof(ForStatementAST, condition), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{39},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(ForStatementAST, semicolonLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{175}},
+    {offsetof(ForStatementAST, expression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{76},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(ForStatementAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+    {offsetof(ForStatementAST, statement), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{181}, ASTKind::LabeledStatement,
+     ASTKind::TryBlockStatement},
+};
 
-void ASTSlot::visit(IdExpressionAST* ast) {
-  switch (slot_) {
-    case 0:  // nestedNameSpecifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->nestedNameSpecifier);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{138};
-      break;
-    case 1:  // templateLoc
-      value_ = ast->templateLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{192};
-      break;
-    case 2:  // unqualifiedId
-      value_ = reinterpret_cast<std::intptr_t>(ast->unqualifiedId);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{212};
-      break;
-    case 3:  // isTemplateIntroduced
-      value_ = std::intptr_t(ast->isTemplateIntroduced != 0);
-      slotKind_ = ASTSlotKind::kBoolAttribute;
-      slotNameIndex_ = SlotNameIndex{112};
-      break;
-  }  // switch
-
-  slotCount_ = 4;
-}
+constexpr ASTSlotDescriptor kBreakStatementSlots[] = {
+    {offsetof(BreakStatementAST, breakLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{23}},
+    {offsetof(BreakStatementAST, semicolonLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{175}},
+};
 
-void ASTSlot::visit(LambdaExpressionAST* ast) {
-  switch (slot_) {
-    case 0:  // lbracketLoc
-      value_ = ast->lbracketLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{120};
-      break;
-    case 1:  // captureDefaultLoc
-      value_ = ast->captureDefaultLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{25};
-      break;
-    case 2:  // captureList
-      value_ = reinterpret_cast<std::intptr_t>(ast->captureList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{26};
-      break;
-    case 3:  // rbracketLoc
-      value_ = ast->rbracketLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{162};
-      break;
-    case 4:  // lessLoc
-      value_ = ast->lessLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{122};
-      break;
-    case 5:  // templateParameterList
-      value_ = reinterpret_cast<std::intptr_t>(ast->templateParameterList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{193};
-      break;
-    case 6:  // greaterLoc
-      value_ = ast->greaterLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{89};
-      break;
-    case 7:  // templateRequiresClause
-      value_ = reinterpret_cast<std::intptr_t>(ast->templateRequiresClause);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{194};
-      break;
-    case 8:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 9:  // parameterDeclarationClause
-      value_ = reinterpret_cast<std::intptr_t>(ast->parameterDeclarationClause);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{150};
-      break;
-    case 10:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-    case 11:  // lambdaSpecifierList
-      value_ = reinterpret_cast<std::intptr_t>(ast->lambdaSpecifierList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{117};
-      break;
-    case 12:  // exceptionSpecifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->exceptionSpecifier);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{71};
-      break;
-    case 13:  // attributeList
-      value_ = reinterpret_cast<std::intptr_t>(ast->attributeList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{11};
-      break;
-    case 14:  // trailingReturnType
-      value_ = reinterpret_cast<std::intptr_t>(ast->trailingReturnType);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{200};
-      break;
-    case 15:  // requiresClause
-      value_ = reinterpret_cast<std::intptr_t>(ast->requiresClause);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{167};
-      break;
-    case 16:  // statement
-      value_ = reinterpret_cast<std::intptr_t>(ast->statement);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{181};
-      break;
-    case 17:  // captureDefault
-      value_ = std::intptr_t(ast->captureDefault);
-      slotKind_ = ASTSlotKind::kIntAttribute;
-      slotNameIndex_ = SlotNameIndex{24};
-      break;
-  }  // switch
-
-  slotCount_ = 18;
-}
+constexpr ASTSlotDescriptor kContinueStatementSlots[] = {
+    {offsetof(ContinueStatementAST, continueLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{47}},
+    {offsetof(ContinueStatementAST, semicolonLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{175}},
+};
 
-void ASTSlot::visit(FoldExpressionAST* ast) {
-  switch (slot_) {
-    case 0:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 1:  // leftExpression
-      value_ = reinterpret_cast<std::intptr_t>(ast->leftExpression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{121};
-      break;
-    case 2:  // opLoc
-      value_ = ast->opLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{145};
-      break;
-    case 3:  // ellipsisLoc
-      value_ = ast->ellipsisLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{62};
-      break;
-    case 4:  // foldOpLoc
-      value_ = ast->foldOpLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{82};
-      break;
-    case 5:  // rightExpression
-      value_ = reinterpret_cast<std::intptr_t>(ast->rightExpression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{171};
-      break;
-    case 6:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-    case 7:  // op
-      value_ = std::intptr_t(ast->op);
-      slotKind_ = ASTSlotKind::kIntAttribute;
-      slotNameIndex_ = SlotNameIndex{144};
-      break;
-    case 8:  // foldOp
-      value_ = std::intptr_t(ast->foldOp);
-      slotKind_ = ASTSlotKind::kIntAttribute;
-      slotNameIndex_ = SlotNameIndex{81};
-      break;
-  }  // switch
-
-  slotCount_ = 9;
-}
+constexpr ASTSlotDescriptor kReturnStatementSlots[] = {
+    {offsetof(ReturnStatementAST, returnLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{170}},
+    {offsetof(ReturnStatementAST, expression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{76},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(ReturnStatementAST, semicolonLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{175}},
+};
 
-void ASTSlot::visit(RightFoldExpressionAST* ast) {
-  switch (slot_) {
-    case 0:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 1:  // expression
-      value_ = reinterpret_cast<std::intptr_t>(ast->expression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{76};
-      break;
-    case 2:  // opLoc
-      value_ = ast->opLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{145};
-      break;
-    case 3:  // ellipsisLoc
-      value_ = ast->ellipsisLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{62};
-      break;
-    case 4:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-    case 5:  // op
-      value_ = std::intptr_t(ast->op);
-      slotKind_ = ASTSlotKind::kIntAttribute;
-      slotNameIndex_ = SlotNameIndex{144};
-      break;
-  }  // switch
-
-  slotCount_ = 6;
-}
+constexpr ASTSlotDescriptor kCoroutineReturnStatementSlots[] = {
+    {offsetof(CoroutineReturnStatementAST, coreturnLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{49}},
+    {offsetof(CoroutineReturnStatementAST, expression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{76},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(CoroutineReturnStatementAST, semicolonLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{175}},
+};
 
-void ASTSlot::visit(LeftFoldExpressionAST* ast) {
-  switch (slot_) {
-    case 0:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 1:  // ellipsisLoc
-      value_ = ast->ellipsisLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{62};
-      break;
-    case 2:  // opLoc
-      value_ = ast->opLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{145};
-      break;
-    case 3:  // expression
-      value_ = reinterpret_cast<std::intptr_t>(ast->expression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{76};
-      break;
-    case 4:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-    case 5:  // op
-      value_ = std::intptr_t(ast->op);
-      slotKind_ = ASTSlotKind::kIntAttribute;
-      slotNameIndex_ = SlotNameIndex{144};
-      break;
-  }  // switch
-
-  slotCount_ = 6;
-}
+constexpr ASTSlotDescriptor kGotoStatementSlots[] = {
+    {offsetof(GotoStatementAST, gotoLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{88}},
+    {offsetof(GotoStatementAST, identifierLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{95}},
+    {offsetof(GotoStatementAST, semicolonLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{175}},
+    {offsetof(GotoStatementAST, identifier), ASTSlotKind::kIdentifierAttribute,
+     ASTSlotStorage::kPointer, SlotNameIndex{94}},
+};
 
-void ASTSlot::visit(RequiresExpressionAST* ast) {
-  switch (slot_) {
-    case 0:  // requiresLoc
-      value_ = ast->requiresLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{168};
-      break;
-    case 1:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 2:  // parameterDeclarationClause
-      value_ = reinterpret_cast<std::intptr_t>(ast->parameterDeclarationClause);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{150};
-      break;
-    case 3:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-    case 4:  // lbraceLoc
-      value_ = ast->lbraceLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{118};
-      break;
-    case 5:  // requirementList
-      value_ = reinterpret_cast<std::intptr_t>(ast->requirementList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{166};
-      break;
-    case 6:  // rbraceLoc
-      value_ = ast->rbraceLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{160};
-      break;
-  }  // switch
-
-  slotCount_ = 7;
-}
+constexpr ASTSlotDescriptor kDeclarationStatementSlots[] = {
+    {offsetof(DeclarationStatementAST, declaration), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{52}, ASTKind::SimpleDeclaration,
+     ASTKind::AsmGotoLabel},
+};
 
-void ASTSlot::visit(SubscriptExpressionAST* ast) {
-  switch (slot_) {
-    case 0:  // baseExpression
-      value_ = reinterpret_cast<std::intptr_t>(ast->baseExpression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{19};
-      break;
-    case 1:  // lbracketLoc
-      value_ = ast->lbracketLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{120};
-      break;
-    case 2:  // indexExpression
-      value_ = reinterpret_cast<std::intptr_t>(ast->indexExpression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{101};
-      break;
-    case 3:  // rbracketLoc
-      value_ = ast->rbracketLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{162};
-      break;
-  }  // switch
-
-  slotCount_ = 4;
-}
+constexpr ASTSlotDescriptor kTryBlockStatementSlots[] = {
+    {offsetof(TryBlockStatementAST, tryLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{201}},
+    {offsetof(TryBlockStatementAST, statement), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{181}, ASTKind::CompoundStatement,
+     ASTKind::CompoundStatement},
+    {offsetof(TryBlockStatementAST, handlerList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{90}, ASTKind::Handler,
+     ASTKind::Handler},
+};
 
-void ASTSlot::visit(CallExpressionAST* ast) {
-  switch (slot_) {
-    case 0:  // baseExpression
-      value_ = reinterpret_cast<std::intptr_t>(ast->baseExpression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{19};
-      break;
-    case 1:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 2:  // expressionList
-      value_ = reinterpret_cast<std::intptr_t>(ast->expressionList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{77};
-      break;
-    case 3:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-  }  // switch
-
-  slotCount_ = 4;
-}
+constexpr ASTSlotDescriptor kCharLiteralExpressionSlots[] = {
+    {offsetof(CharLiteralExpressionAST, literalLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{124}},
+    {offsetof(CharLiteralExpressionAST, literal),
+     ASTSlotKind::kLiteralAttribute, ASTSlotStorage::kPointer,
+     SlotNameIndex{123}},
+};
 
-void ASTSlot::visit(TypeConstructionAST* ast) {
-  switch (slot_) {
-    case 0:  // typeSpecifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->typeSpecifier);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{205};
-      break;
-    case 1:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 2:  // expressionList
-      value_ = reinterpret_cast<std::intptr_t>(ast->expressionList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{77};
-      break;
-    case 3:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-  }  // switch
-
-  slotCount_ = 4;
-}
+constexpr ASTSlotDescriptor kBoolLiteralExpressionSlots[] = {
+    {offsetof(BoolLiteralExpressionAST, literalLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{124}},
+    {offsetof(BoolLiteralExpressionAST, isTrue), ASTSlotKind::kBoolAttribute,
+     ASTSlotStorage::kBool, SlotNameIndex{114}},
+};
 
-void ASTSlot::visit(BracedTypeConstructionAST* ast) {
-  switch (slot_) {
-    case 0:  // typeSpecifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->typeSpecifier);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{205};
-      break;
-    case 1:  // bracedInitList
-      value_ = reinterpret_cast<std::intptr_t>(ast->bracedInitList);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{22};
-      break;
-  }  // switch
-
-  slotCount_ = 2;
-}
+constexpr ASTSlotDescriptor kIntLiteralExpressionSlots[] = {
+    {offsetof(IntLiteralExpressionAST, literalLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{124}},
+    {offsetof(IntLiteralExpressionAST, literal), ASTSlotKind::kLiteralAttribute,
+     ASTSlotStorage::kPointer, SlotNameIndex{123}},
+};
 
-void ASTSlot::visit(MemberExpressionAST* ast) {
-  switch (slot_) {
-    case 0:  // baseExpression
-      value_ = reinterpret_cast<std::intptr_t>(ast->baseExpression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{19};
-      break;
-    case 1:  // accessLoc
-      value_ = ast->accessLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{0};
-      break;
-    case 2:  // memberId
-      value_ = reinterpret_cast<std::intptr_t>(ast->memberId);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{129};
-      break;
-    case 3:  // accessOp
-      value_ = std::intptr_t(ast->accessOp);
-      slotKind_ = ASTSlotKind::kIntAttribute;
-      slotNameIndex_ = SlotNameIndex{1};
-      break;
-  }  // switch
-
-  slotCount_ = 4;
-}
+constexpr ASTSlotDescriptor kFloatLiteralExpressionSlots[] = {
+    {offsetof(FloatLiteralExpressionAST, literalLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{124}},
+    {offsetof(FloatLiteralExpressionAST, literal),
+     ASTSlotKind::kLiteralAttribute, ASTSlotStorage::kPointer,
+     SlotNameIndex{123}},
+};
 
-void ASTSlot::visit(PostIncrExpressionAST* ast) {
-  switch (slot_) {
-    case 0:  // baseExpression
-      value_ = reinterpret_cast<std::intptr_t>(ast->baseExpression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{19};
-      break;
-    case 1:  // opLoc
-      value_ = ast->opLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{145};
-      break;
-    case 2:  // op
-      value_ = std::intptr_t(ast->op);
-      slotKind_ = ASTSlotKind::kIntAttribute;
-      slotNameIndex_ = SlotNameIndex{144};
-      break;
-  }  // switch
-
-  slotCount_ = 3;
-}
+constexpr ASTSlotDescriptor kNullptrLiteralExpressionSlots[] = {
+    {offsetof(NullptrLiteralExpressionAST, literalLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{124}},
+    {offsetof(NullptrLiteralExpressionAST, literal), ASTSlotKind::kIntAttribute,
+     ASTSlotStorage::kTokenKind, SlotNameIndex{123}},
+};
 
-void ASTSlot::visit(CppCastExpressionAST* ast) {
-  switch (slot_) {
-    case 0:  // castLoc
-      value_ = ast->castLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{28};
-      break;
-    case 1:  // lessLoc
-      value_ = ast->lessLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{122};
-      break;
-    case 2:  // typeId
-      value_ = reinterpret_cast<std::intptr_t>(ast->typeId);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{203};
-      break;
-    case 3:  // greaterLoc
-      value_ = ast->greaterLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{89};
-      break;
-    case 4:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 5:  // expression
-      value_ = reinterpret_cast<std::intptr_t>(ast->expression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{76};
-      break;
-    case 6:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-  }  // switch
-
-  slotCount_ = 7;
-}
+constexpr ASTSlotDescriptor kStringLiteralExpressionSlots[] = {
+    {offsetof(StringLiteralExpressionAST, literalLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{124}},
+    {offsetof(StringLiteralExpressionAST, literal),
+     ASTSlotKind::kLiteralAttribute, ASTSlotStorage::kPointer,
+     SlotNameIndex{123}},
+};
 
-void ASTSlot::visit(BuiltinBitCastExpressionAST* ast) {
-  switch (slot_) {
-    case 0:  // castLoc
-      value_ = ast->castLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{28};
-      break;
-    case 1:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 2:  // typeId
-      value_ = reinterpret_cast<std::intptr_t>(ast->typeId);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{203};
-      break;
-    case 3:  // commaLoc
-      value_ = ast->commaLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{36};
-      break;
-    case 4:  // expression
-      value_ = reinterpret_cast<std::intptr_t>(ast->expression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{76};
-      break;
-    case 5:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-  }  // switch
-
-  slotCount_ = 6;
-}
+constexpr ASTSlotDescriptor kUserDefinedStringLiteralExpressionSlots[] = {
+    {offsetof(UserDefinedStringLiteralExpressionAST, literalLoc),
+     ASTSlotKind::kToken, ASTSlotStorage::kSourceLocation, SlotNameIndex{124}},
+    {offsetof(UserDefinedStringLiteralExpressionAST, literal),
+     ASTSlotKind::kLiteralAttribute, ASTSlotStorage::kPointer,
+     SlotNameIndex{123}},
+};
 
-void ASTSlot::visit(TypeidExpressionAST* ast) {
-  switch (slot_) {
-    case 0:  // typeidLoc
-      value_ = ast->typeidLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{209};
-      break;
-    case 1:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 2:  // expression
-      value_ = reinterpret_cast<std::intptr_t>(ast->expression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{76};
-      break;
-    case 3:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-  }  // switch
-
-  slotCount_ = 4;
-}
+constexpr ASTSlotDescriptor kThisExpressionSlots[] = {
+    {offsetof(ThisExpressionAST, thisLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{195}},
+};
 
-void ASTSlot::visit(TypeidOfTypeExpressionAST* ast) {
-  switch (slot_) {
-    case 0:  // typeidLoc
-      value_ = ast->typeidLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{209};
-      break;
-    case 1:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 2:  // typeId
-      value_ = reinterpret_cast<std::intptr_t>(ast->typeId);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{203};
-      break;
-    case 3:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-  }  // switch
-
-  slotCount_ = 4;
-}
+constexpr ASTSlotDescriptor kNestedExpressionSlots[] = {
+    {offsetof(NestedExpressionAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(NestedExpressionAST, expression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{76},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(NestedExpressionAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+};
 
-void ASTSlot::visit(UnaryExpressionAST* ast) {
-  switch (slot_) {
-    case 0:  // opLoc
-      value_ = ast->opLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{145};
-      break;
-    case 1:  // expression
-      value_ = reinterpret_cast<std::intptr_t>(ast->expression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{76};
-      break;
-    case 2:  // op
-      value_ = std::intptr_t(ast->op);
-      slotKind_ = ASTSlotKind::kIntAttribute;
-      slotNameIndex_ = SlotNameIndex{144};
-      break;
-  }  // switch
-
-  slotCount_ = 3;
-}
+constexpr ASTSlotDescriptor kIdExpressionSlots[] = {
+    {offsetof(IdExpressionAST, nestedNameSpecifier), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{138},
+     ASTKind::GlobalNestedNameSpecifier, ASTKind::TemplateNestedNameSpecifier},
+    {offsetof(IdExpressionAST, templateLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{192}},
+    {offsetof(IdExpressionAST, unqualifiedId), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{212}, ASTKind::NameId,
+     ASTKind::OperatorFunctionTemplateId},
+    {offsetof(IdExpressionAST, isTemplateIntroduced),
+     ASTSlotKind::kBoolAttribute, ASTSlotStorage::kBool, SlotNameIndex{112}},
+};
 
-void ASTSlot::visit(AwaitExpressionAST* ast) {
-  switch (slot_) {
-    case 0:  // awaitLoc
-      value_ = ast->awaitLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{18};
-      break;
-    case 1:  // expression
-      value_ = reinterpret_cast<std::intptr_t>(ast->expression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{76};
-      break;
-  }  // switch
-
-  slotCount_ = 2;
-}
+constexpr ASTSlotDescriptor kLambdaExpressionSlots[] = {
+    {offsetof(LambdaExpressionAST, lbracketLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{120}},
+    {offsetof(LambdaExpressionAST, captureDefaultLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{25}},
+    {offsetof(LambdaExpressionAST, captureList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{26}, ASTKind::ThisLambdaCapture,
+     ASTKind::InitLambdaCapture},
+    {offsetof(LambdaExpressionAST, rbracketLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{162}},
+    {offsetof(LambdaExpressionAST, lessLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{122}},
+    {offsetof(LambdaExpressionAST, templateParameterList),
+     ASTSlotKind::kNodeList, ASTSlotStorage::kPointer, SlotNameIndex{193},
+     ASTKind::TemplateTypeParameter, ASTKind::ConstraintTypeParameter},
+    {offsetof(LambdaExpressionAST, greaterLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{89}},
+    {offsetof(LambdaExpressionAST, templateRequiresClause), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{194}, ASTKind::RequiresClause,
+     ASTKind::RequiresClause},
+    {offsetof(LambdaExpressionAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(LambdaExpressionAST, parameterDeclarationClause),
+     ASTSlotKind::kNode, ASTSlotStorage::kPointer, SlotNameIndex{150},
+     ASTKind::ParameterDeclarationClause, ASTKind::ParameterDeclarationClause},
+    {offsetof(LambdaExpressionAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+    {offsetof(LambdaExpressionAST, lambdaSpecifierList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{117}, ASTKind::LambdaSpecifier,
+     ASTKind::LambdaSpecifier},
+    {offsetof(LambdaExpressionAST, exceptionSpecifier), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{71},
+     ASTKind::ThrowExceptionSpecifier, ASTKind::NoexceptSpecifier},
+    {offsetof(LambdaExpressionAST, attributeList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{11}, ASTKind::CxxAttribute,
+     ASTKind::AsmAttribute},
+    {offsetof(LambdaExpressionAST, trailingReturnType), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{200}, ASTKind::TrailingReturnType,
+     ASTKind::TrailingReturnType},
+    {offsetof(LambdaExpressionAST, requiresClause), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{167}, ASTKind::RequiresClause,
+     ASTKind::RequiresClause},
+    {offsetof(LambdaExpressionAST, statement), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{181}, ASTKind::CompoundStatement,
+     ASTKind::CompoundStatement},
+    {offsetof(LambdaExpressionAST, captureDefault), ASTSlotKind::kIntAttribute,
+     ASTSlotStorage::kTokenKind, SlotNameIndex{24}},
+};
 
-void ASTSlot::visit(SizeofExpressionAST* ast) {
-  switch (slot_) {
-    case 0:  // sizeofLoc
-      value_ = ast->sizeofLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{177};
-      break;
-    case 1:  // expression
-      value_ = reinterpret_cast<std::intptr_t>(ast->expression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{76};
-      break;
-  }  // switch
-
-  slotCount_ = 2;
-}
+constexpr ASTSlotDescriptor kFoldExpressionSlots[] = {
+    {offsetof(FoldExpressionAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(FoldExpressionAST, leftExpression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{121},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(FoldExpressionAST, opLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{145}},
+    {offsetof(FoldExpressionAST, ellipsisLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{62}},
+    {offsetof(FoldExpressionAST, foldOpLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{82}},
+    {offsetof(FoldExpressionAST, rightExpression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{171},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(FoldExpressionAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+    {offsetof(FoldExpressionAST, op), ASTSlotKind::kIntAttribute,
+     ASTSlotStorage::kTokenKind, SlotNameIndex{144}},
+    {offsetof(FoldExpressionAST, foldOp), ASTSlotKind::kIntAttribute,
+     ASTSlotStorage::kTokenKind, SlotNameIndex{81}},
+};
 
-void ASTSlot::visit(SizeofTypeExpressionAST* ast) {
-  switch (slot_) {
-    case 0:  // sizeofLoc
-      value_ = ast->sizeofLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{177};
-      break;
-    case 1:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 2:  // typeId
-      value_ = reinterpret_cast<std::intptr_t>(ast->typeId);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{203};
-      break;
-    case 3:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-  }  // switch
-
-  slotCount_ = 4;
-}
+constexpr ASTSlotDescriptor kRightFoldExpressionSlots[] = {
+    {offsetof(RightFoldExpressionAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(RightFoldExpressionAST, expression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{76},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(RightFoldExpressionAST, opLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{145}},
+    {offsetof(RightFoldExpressionAST, ellipsisLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{62}},
+    {offsetof(RightFoldExpressionAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+    {offsetof(RightFoldExpressionAST, op), ASTSlotKind::kIntAttribute,
+     ASTSlotStorage::kTokenKind, SlotNameIndex{144}},
+};
 
-void ASTSlot::visit(SizeofPackExpressionAST* ast) {
-  switch (slot_) {
-    case 0:  // sizeofLoc
-      value_ = ast->sizeofLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{177};
-      break;
-    case 1:  // ellipsisLoc
-      value_ = ast->ellipsisLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{62};
-      break;
-    case 2:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 3:  // identifierLoc
-      value_ = ast->identifierLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{95};
-      break;
-    case 4:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-    case 5:  // identifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->identifier);
-      slotKind_ = ASTSlotKind::kIdentifierAttribute;
-      slotNameIndex_ = SlotNameIndex{94};
-      break;
-  }  // switch
-
-  slotCount_ = 6;
-}
+constexpr ASTSlotDescriptor kLeftFoldExpressionSlots[] = {
+    {offsetof(LeftFoldExpressionAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(LeftFoldExpressionAST, ellipsisLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{62}},
+    {offsetof(LeftFoldExpressionAST, opLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{145}},
+    {offsetof(LeftFoldExpressionAST, expression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{76},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(LeftFoldExpressionAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+    {offsetof(LeftFoldExpressionAST, op), ASTSlotKind::kIntAttribute,
+     ASTSlotStorage::kTokenKind, SlotNameIndex{144}},
+};
 
-void ASTSlot::visit(AlignofTypeExpressionAST* ast) {
-  switch (slot_) {
-    case 0:  // alignofLoc
-      value_ = ast->alignofLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{4};
-      break;
-    case 1:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 2:  // typeId
-      value_ = reinterpret_cast<std::intptr_t>(ast->typeId);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{203};
-      break;
-    case 3:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-  }  // switch
-
-  slotCount_ = 4;
-}
+constexpr ASTSlotDescriptor kRequiresExpressionSlots[] = {
+    {offsetof(RequiresExpressionAST, requiresLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{168}},
+    {offsetof(RequiresExpressionAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(RequiresExpressionAST, parameterDeclarationClause),
+     ASTSlotKind::kNode, ASTSlotStorage::kPointer, SlotNameIndex{150},
+     ASTKind::ParameterDeclarationClause, ASTKind::ParameterDeclarationClause},
+    {offsetof(RequiresExpressionAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+    {offsetof(RequiresExpressionAST, lbraceLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{118}},
+    {offsetof(RequiresExpressionAST, requirementList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{166}, ASTKind::SimpleRequirement,
+     ASTKind::NestedRequirement},
+    {offsetof(RequiresExpressionAST, rbraceLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{160}},
+};
 
-void ASTSlot::visit(AlignofExpressionAST* ast) {
-  switch (slot_) {
-    case 0:  // alignofLoc
-      value_ = ast->alignofLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{4};
-      break;
-    case 1:  // expression
-      value_ = reinterpret_cast<std::intptr_t>(ast->expression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{76};
-      break;
-  }  // switch
-
-  slotCount_ = 2;
-}
+constexpr ASTSlotDescriptor kSubscriptExpressionSlots[] = {
+    {offsetof(SubscriptExpressionAST, baseExpression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{19},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(SubscriptExpressionAST, lbracketLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{120}},
+    {offsetof(SubscriptExpressionAST, indexExpression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{101},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(SubscriptExpressionAST, rbracketLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{162}},
+};
 
-void ASTSlot::visit(NoexceptExpressionAST* ast) {
-  switch (slot_) {
-    case 0:  // noexceptLoc
-      value_ = ast->noexceptLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{143};
-      break;
-    case 1:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 2:  // expression
-      value_ = reinterpret_cast<std::intptr_t>(ast->expression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{76};
-      break;
-    case 3:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-  }  // switch
-
-  slotCount_ = 4;
-}
+constexpr ASTSlotDescriptor kCallExpressionSlots[] = {
+    {offsetof(CallExpressionAST, baseExpression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{19},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(CallExpressionAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(CallExpressionAST, expressionList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{77},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(CallExpressionAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+};
 
-void ASTSlot::visit(NewExpressionAST* ast) {
-  switch (slot_) {
-    case 0:  // scopeLoc
-      value_ = ast->scopeLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{174};
-      break;
-    case 1:  // newLoc
-      value_ = ast->newLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{141};
-      break;
-    case 2:  // newPlacement
-      value_ = reinterpret_cast<std::intptr_t>(ast->newPlacement);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{142};
-      break;
-    case 3:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 4:  // typeSpecifierList
-      value_ = reinterpret_cast<std::intptr_t>(ast->typeSpecifierList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{206};
-      break;
-    case 5:  // declarator
-      value_ = reinterpret_cast<std::intptr_t>(ast->declarator);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{54};
-      break;
-    case 6:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-    case 7:  // newInitalizer
-      value_ = reinterpret_cast<std::intptr_t>(ast->newInitalizer);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{140};
-      break;
-  }  // switch
-
-  slotCount_ = 8;
-}
+constexpr ASTSlotDescriptor kTypeConstructionSlots[] = {
+    {offsetof(TypeConstructionAST, typeSpecifier), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{205}, ASTKind::TypedefSpecifier,
+     ASTKind::TypenameSpecifier},
+    {offsetof(TypeConstructionAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(TypeConstructionAST, expressionList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{77},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(TypeConstructionAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+};
 
-void ASTSlot::visit(DeleteExpressionAST* ast) {
-  switch (slot_) {
-    case 0:  // scopeLoc
-      value_ = ast->scopeLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{174};
-      break;
-    case 1:  // deleteLoc
-      value_ = ast->deleteLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{59};
-      break;
-    case 2:  // lbracketLoc
-      value_ = ast->lbracketLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{120};
-      break;
-    case 3:  // rbracketLoc
-      value_ = ast->rbracketLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{162};
-      break;
-    case 4:  // expression
-      value_ = reinterpret_cast<std::intptr_t>(ast->expression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{76};
-      break;
-  }  // switch
-
-  slotCount_ = 5;
-}
+constexpr ASTSlotDescriptor kBracedTypeConstructionSlots[] = {
+    {offsetof(BracedTypeConstructionAST, typeSpecifier), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{205}, ASTKind::TypedefSpecifier,
+     ASTKind::TypenameSpecifier},
+    {offsetof(BracedTypeConstructionAST, bracedInitList), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{22}, ASTKind::BracedInitList,
+     ASTKind::BracedInitList},
+};
 
-void ASTSlot::visit(CastExpressionAST* ast) {
-  switch (slot_) {
-    case 0:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 1:  // typeId
-      value_ = reinterpret_cast<std::intptr_t>(ast->typeId);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{203};
-      break;
-    case 2:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-    case 3:  // expression
-      value_ = reinterpret_cast<std::intptr_t>(ast->expression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{76};
-      break;
-  }  // switch
-
-  slotCount_ = 4;
-}
+constexpr ASTSlotDescriptor kMemberExpressionSlots[] = {
+    {offsetof(MemberExpressionAST, baseExpression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{19},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(MemberExpressionAST, accessLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{0}},
+    {offsetof(MemberExpressionAST, memberId), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{129}, ASTKind::IdExpression,
+     ASTKind::IdExpression},
+    {offsetof(MemberExpressionAST, accessOp), ASTSlotKind::kIntAttribute,
+     ASTSlotStorage::kTokenKind, SlotNameIndex{1}},
+};
 
-void ASTSlot::visit(ImplicitCastExpressionAST* ast) {
-  switch (slot_) {
-    case 0:  // expression
-      value_ = reinterpret_cast<std::intptr_t>(ast->expression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{76};
-      break;
-  }  // switch
+constexpr ASTSlotDescriptor kPostIncrExpressionSlots[] = {
+    {offsetof(PostIncrExpressionAST, baseExpression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{19},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(PostIncrExpressionAST, opLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{145}},
+    {offsetof(PostIncrExpressionAST, op), ASTSlotKind::kIntAttribute,
+     ASTSlotStorage::kTokenKind, SlotNameIndex{144}},
+};
 
-  slotCount_ = 1;
-}
+constexpr ASTSlotDescriptor kCppCastExpressionSlots[] = {
+    {offsetof(CppCastExpressionAST, castLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{28}},
+    {offsetof(CppCastExpressionAST, lessLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{122}},
+    {offsetof(CppCastExpressionAST, typeId), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{203}, ASTKind::TypeId,
+     ASTKind::TypeId},
+    {offsetof(CppCastExpressionAST, greaterLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{89}},
+    {offsetof(CppCastExpressionAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(CppCastExpressionAST, expression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{76},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(CppCastExpressionAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+};
 
-void ASTSlot::visit(BinaryExpressionAST* ast) {
-  switch (slot_) {
-    case 0:  // leftExpression
-      value_ = reinterpret_cast<std::intptr_t>(ast->leftExpression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{121};
-      break;
-    case 1:  // opLoc
-      value_ = ast->opLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{145};
-      break;
-    case 2:  // rightExpression
-      value_ = reinterpret_cast<std::intptr_t>(ast->rightExpression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{171};
-      break;
-    case 3:  // op
-      value_ = std::intptr_t(ast->op);
-      slotKind_ = ASTSlotKind::kIntAttribute;
-      slotNameIndex_ = SlotNameIndex{144};
-      break;
-  }  // switch
-
-  slotCount_ = 4;
-}
+constexpr ASTSlotDescriptor kBuiltinBitCastExpressionSlots[] = {
+    {offsetof(BuiltinBitCastExpressionAST, castLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{28}},
+    {offsetof(BuiltinBitCastExpressionAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(BuiltinBitCastExpressionAST, typeId), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{203}, ASTKind::TypeId,
+     ASTKind::TypeId},
+    {offsetof(BuiltinBitCastExpressionAST, commaLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{36}},
+    {offsetof(BuiltinBitCastExpressionAST, expression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{76},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(BuiltinBitCastExpressionAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+};
 
-void ASTSlot::visit(ConditionalExpressionAST* ast) {
-  switch (slot_) {
-    case 0:  // condition
-      value_ = reinterpret_cast<std::intptr_t>(ast->condition);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{39};
-      break;
-    case 1:  // questionLoc
-      value_ = ast->questionLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{157};
-      break;
-    case 2:  // iftrueExpression
-      value_ = reinterpret_cast<std::intptr_t>(ast->iftrueExpression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{98};
-      break;
-    case 3:  // colonLoc
-      value_ = ast->colonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{35};
-      break;
-    case 4:  // iffalseExpression
-      value_ = reinterpret_cast<std::intptr_t>(ast->iffalseExpression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{97};
-      break;
-  }  // switch
-
-  slotCount_ = 5;
-}
+constexpr ASTSlotDescriptor kTypeidExpressionSlots[] = {
+    {offsetof(TypeidExpressionAST, typeidLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{209}},
+    {offsetof(TypeidExpressionAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(TypeidExpressionAST, expression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{76},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(TypeidExpressionAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+};
 
-void ASTSlot::visit(YieldExpressionAST* ast) {
-  switch (slot_) {
-    case 0:  // yieldLoc
-      value_ = ast->yieldLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{219};
-      break;
-    case 1:  // expression
-      value_ = reinterpret_cast<std::intptr_t>(ast->expression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{76};
-      break;
-  }  // switch
-
-  slotCount_ = 2;
-}
+constexpr ASTSlotDescriptor kTypeidOfTypeExpressionSlots[] = {
+    {offsetof(TypeidOfTypeExpressionAST, typeidLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{209}},
+    {offsetof(TypeidOfTypeExpressionAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(TypeidOfTypeExpressionAST, typeId), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{203}, ASTKind::TypeId,
+     ASTKind::TypeId},
+    {offsetof(TypeidOfTypeExpressionAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+};
 
-void ASTSlot::visit(ThrowExpressionAST* ast) {
-  switch (slot_) {
-    case 0:  // throwLoc
-      value_ = ast->throwLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{198};
-      break;
-    case 1:  // expression
-      value_ = reinterpret_cast<std::intptr_t>(ast->expression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{76};
-      break;
-  }  // switch
-
-  slotCount_ = 2;
-}
+constexpr ASTSlotDescriptor kUnaryExpressionSlots[] = {
+    {offsetof(UnaryExpressionAST, opLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{145}},
+    {offsetof(UnaryExpressionAST, expression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{76},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(UnaryExpressionAST, op), ASTSlotKind::kIntAttribute,
+     ASTSlotStorage::kTokenKind, SlotNameIndex{144}},
+};
 
-void ASTSlot::visit(AssignmentExpressionAST* ast) {
-  switch (slot_) {
-    case 0:  // leftExpression
-      value_ = reinterpret_cast<std::intptr_t>(ast->leftExpression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{121};
-      break;
-    case 1:  // opLoc
-      value_ = ast->opLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{145};
-      break;
-    case 2:  // rightExpression
-      value_ = reinterpret_cast<std::intptr_t>(ast->rightExpression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{171};
-      break;
-    case 3:  // op
-      value_ = std::intptr_t(ast->op);
-      slotKind_ = ASTSlotKind::kIntAttribute;
-      slotNameIndex_ = SlotNameIndex{144};
-      break;
-  }  // switch
-
-  slotCount_ = 4;
-}
+constexpr ASTSlotDescriptor kAwaitExpressionSlots[] = {
+    {offsetof(AwaitExpressionAST, awaitLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{18}},
+    {offsetof(AwaitExpressionAST, expression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{76},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+};
 
-void ASTSlot::visit(PackExpansionExpressionAST* ast) {
-  switch (slot_) {
-    case 0:  // expression
-      value_ = reinterpret_cast<std::intptr_t>(ast->expression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{76};
-      break;
-    case 1:  // ellipsisLoc
-      value_ = ast->ellipsisLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{62};
-      break;
-  }  // switch
-
-  slotCount_ = 2;
-}
+constexpr ASTSlotDescriptor kSizeofExpressionSlots[] = {
+    {offsetof(SizeofExpressionAST, sizeofLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{177}},
+    {offsetof(SizeofExpressionAST, expression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{76},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+};
 
-void ASTSlot::visit(DesignatedInitializerClauseAST* ast) {
-  switch (slot_) {
-    case 0:  // dotLoc
-      value_ = ast->dotLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{61};
-      break;
-    case 1:  // identifierLoc
-      value_ = ast->identifierLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{95};
-      break;
-    case 2:  // identifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->identifier);
-      slotKind_ = ASTSlotKind::kIdentifierAttribute;
-      slotNameIndex_ = SlotNameIndex{94};
-      break;
-    case 3:  // initializer
-      value_ = reinterpret_cast<std::intptr_t>(ast->initializer);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{103};
-      break;
-  }  // switch
-
-  slotCount_ = 4;
-}
+constexpr ASTSlotDescriptor kSizeofTypeExpressionSlots[] = {
+    {offsetof(SizeofTypeExpressionAST, sizeofLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{177}},
+    {offsetof(SizeofTypeExpressionAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(SizeofTypeExpressionAST, typeId), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{203}, ASTKind::TypeId,
+     ASTKind::TypeId},
+    {offsetof(SizeofTypeExpressionAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+};
 
-void ASTSlot::visit(TypeTraitsExpressionAST* ast) {
-  switch (slot_) {
-    case 0:  // typeTraitsLoc
-      value_ = ast->typeTraitsLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{207};
-      break;
-    case 1:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 2:  // typeIdList
-      value_ = reinterpret_cast<std::intptr_t>(ast->typeIdList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{204};
-      break;
-    case 3:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-  }  // switch
-
-  slotCount_ = 4;
-}
+constexpr ASTSlotDescriptor kSizeofPackExpressionSlots[] = {
+    {offsetof(SizeofPackExpressionAST, sizeofLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{177}},
+    {offsetof(SizeofPackExpressionAST, ellipsisLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{62}},
+    {offsetof(SizeofPackExpressionAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(SizeofPackExpressionAST, identifierLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{95}},
+    {offsetof(SizeofPackExpressionAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+    {offsetof(SizeofPackExpressionAST, identifier),
+     ASTSlotKind::kIdentifierAttribute, ASTSlotStorage::kPointer,
+     SlotNameIndex{94}},
+};
 
-void ASTSlot::visit(ConditionExpressionAST* ast) {
-  switch (slot_) {
-    case 0:  // attributeList
-      value_ = reinterpret_cast<std::intptr_t>(ast->attributeList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{11};
-      break;
-    case 1:  // declSpecifierList
-      value_ = reinterpret_cast<std::intptr_t>(ast->declSpecifierList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{51};
-      break;
-    case 2:  // declarator
-      value_ = reinterpret_cast<std::intptr_t>(ast->declarator);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{54};
-      break;
-    case 3:  // initializer
-      value_ = reinterpret_cast<std::intptr_t>(ast->initializer);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{103};
-      break;
-  }  // switch
-
-  slotCount_ = 4;
-}
+constexpr ASTSlotDescriptor kAlignofTypeExpressionSlots[] = {
+    {offsetof(AlignofTypeExpressionAST, alignofLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{4}},
+    {offsetof(AlignofTypeExpressionAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(AlignofTypeExpressionAST, typeId), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{203}, ASTKind::TypeId,
+     ASTKind::TypeId},
+    {offsetof(AlignofTypeExpressionAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+};
 
-void ASTSlot::visit(EqualInitializerAST* ast) {
-  switch (slot_) {
-    case 0:  // equalLoc
-      value_ = ast->equalLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{69};
-      break;
-    case 1:  // expression
-      value_ = reinterpret_cast<std::intptr_t>(ast->expression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{76};
-      break;
-  }  // switch
-
-  slotCount_ = 2;
-}
+constexpr ASTSlotDescriptor kAlignofExpressionSlots[] = {
+    {offsetof(AlignofExpressionAST, alignofLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{4}},
+    {offsetof(AlignofExpressionAST, expression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{76},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+};
 
-void ASTSlot::visit(BracedInitListAST* ast) {
-  switch (slot_) {
-    case 0:  // lbraceLoc
-      value_ = ast->lbraceLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{118};
-      break;
-    case 1:  // expressionList
-      value_ = reinterpret_cast<std::intptr_t>(ast->expressionList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{77};
-      break;
-    case 2:  // commaLoc
-      value_ = ast->commaLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{36};
-      break;
-    case 3:  // rbraceLoc
-      value_ = ast->rbraceLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{160};
-      break;
-  }  // switch
-
-  slotCount_ = 4;
-}
+constexpr ASTSlotDescriptor kNoexceptExpressionSlots[] = {
+    {offsetof(NoexceptExpressionAST, noexceptLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{143}},
+    {offsetof(NoexceptExpressionAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(NoexceptExpressionAST, expression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{76},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(NoexceptExpressionAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+};
 
-void ASTSlot::visit(ParenInitializerAST* ast) {
-  switch (slot_) {
-    case 0:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 1:  // expressionList
-      value_ = reinterpret_cast<std::intptr_t>(ast->expressionList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{77};
-      break;
-    case 2:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-  }  // switch
-
-  slotCount_ = 3;
-}
+constexpr ASTSlotDescriptor kNewExpressionSlots[] = {
+    {offsetof(NewExpressionAST, scopeLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{174}},
+    {offsetof(NewExpressionAST, newLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{141}},
+    {offsetof(NewExpressionAST, newPlacement), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{142}, ASTKind::NewPlacement,
+     ASTKind::NewPlacement},
+    {offsetof(NewExpressionAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(NewExpressionAST, typeSpecifierList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{206}, ASTKind::TypedefSpecifier,
+     ASTKind::TypenameSpecifier},
+    {offsetof(NewExpressionAST, declarator), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{54}, ASTKind::Declarator,
+     ASTKind::Declarator},
+    {offsetof(NewExpressionAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+    {offsetof(NewExpressionAST, newInitalizer), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{140}, ASTKind::NewParenInitializer,
+     ASTKind::NewBracedInitializer},
+};
 
-void ASTSlot::visit(TemplateTypeParameterAST* ast) {
-  switch (slot_) {
-    case 0:  // templateLoc
-      value_ = ast->templateLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{192};
-      break;
-    case 1:  // lessLoc
-      value_ = ast->lessLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{122};
-      break;
-    case 2:  // templateParameterList
-      value_ = reinterpret_cast<std::intptr_t>(ast->templateParameterList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{193};
-      break;
-    case 3:  // greaterLoc
-      value_ = ast->greaterLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{89};
-      break;
-    case 4:  // requiresClause
-      value_ = reinterpret_cast<std::intptr_t>(ast->requiresClause);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{167};
-      break;
-    case 5:  // classKeyLoc
-      value_ = ast->classKeyLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{31};
-      break;
-    case 6:  // ellipsisLoc
-      value_ = ast->ellipsisLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{62};
-      break;
-    case 7:  // identifierLoc
-      value_ = ast->identifierLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{95};
-      break;
-    case 8:  // equalLoc
-      value_ = ast->equalLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{69};
-      break;
-    case 9:  // idExpression
-      value_ = reinterpret_cast<std::intptr_t>(ast->idExpression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{93};
-      break;
-    case 10:  // identifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->identifier);
-      slotKind_ = ASTSlotKind::kIdentifierAttribute;
-      slotNameIndex_ = SlotNameIndex{94};
-      break;
-    case 11:  // isPack
-      value_ = std::intptr_t(ast->isPack != 0);
-      slotKind_ = ASTSlotKind::kBoolAttribute;
-      slotNameIndex_ = SlotNameIndex{110};
-      break;
-  }  // switch
-
-  slotCount_ = 12;
-}
+constexpr ASTSlotDescriptor kDeleteExpressionSlots[] = {
+    {offsetof(DeleteExpressionAST, scopeLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{174}},
+    {offsetof(DeleteExpressionAST, deleteLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{59}},
+    {offsetof(DeleteExpressionAST, lbracketLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{120}},
+    {offsetof(DeleteExpressionAST, rbracketLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{162}},
+    {offsetof(DeleteExpressionAST, expression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{76},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+};
 
-void ASTSlot::visit(NonTypeTemplateParameterAST* ast) {
-  switch (slot_) {
-    case 0:  // declaration
-      value_ = reinterpret_cast<std::intptr_t>(ast->declaration);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{52};
-      break;
-  }  // switch
+constexpr ASTSlotDescriptor kCastExpressionSlots[] = {
+    {offsetof(CastExpressionAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(CastExpressionAST, typeId), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{203}, ASTKind::TypeId,
+     ASTKind::TypeId},
+    {offsetof(CastExpressionAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+    {offsetof(CastExpressionAST, expression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{76},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+};
 
-  slotCount_ = 1;
-}
+constexpr ASTSlotDescriptor kImplicitCastExpressionSlots[] = {
+    {offsetof(ImplicitCastExpressionAST, expression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{76},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+};
 
-void ASTSlot::visit(TypenameTypeParameterAST* ast) {
-  switch (slot_) {
-    case 0:  // classKeyLoc
-      value_ = ast->classKeyLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{31};
-      break;
-    case 1:  // ellipsisLoc
-      value_ = ast->ellipsisLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{62};
-      break;
-    case 2:  // identifierLoc
-      value_ = ast->identifierLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{95};
-      break;
-    case 3:  // equalLoc
-      value_ = ast->equalLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{69};
-      break;
-    case 4:  // typeId
-      value_ = reinterpret_cast<std::intptr_t>(ast->typeId);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{203};
-      break;
-    case 5:  // identifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->identifier);
-      slotKind_ = ASTSlotKind::kIdentifierAttribute;
-      slotNameIndex_ = SlotNameIndex{94};
-      break;
-    case 6:  // isPack
-      value_ = std::intptr_t(ast->isPack != 0);
-      slotKind_ = ASTSlotKind::kBoolAttribute;
-      slotNameIndex_ = SlotNameIndex{110};
-      break;
-  }  // switch
-
-  slotCount_ = 7;
-}
+constexpr ASTSlotDescriptor kBinaryExpressionSlots[] = {
+    {offsetof(BinaryExpressionAST, leftExpression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{121},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(BinaryExpressionAST, opLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{145}},
+    {offsetof(BinaryExpressionAST, rightExpression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{171},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(BinaryExpressionAST, op), ASTSlotKind::kIntAttribute,
+     ASTSlotStorage::kTokenKind, SlotNameIndex{144}},
+};
 
-void ASTSlot::visit(ConstraintTypeParameterAST* ast) {
-  switch (slot_) {
-    case 0:  // typeConstraint
-      value_ = reinterpret_cast<std::intptr_t>(ast->typeConstraint);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{202};
-      break;
-    case 1:  // ellipsisLoc
-      value_ = ast->ellipsisLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{62};
-      break;
-    case 2:  // identifierLoc
-      value_ = ast->identifierLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{95};
-      break;
-    case 3:  // equalLoc
-      value_ = ast->equalLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{69};
-      break;
-    case 4:  // typeId
-      value_ = reinterpret_cast<std::intptr_t>(ast->typeId);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{203};
-      break;
-    case 5:  // identifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->identifier);
-      slotKind_ = ASTSlotKind::kIdentifierAttribute;
-      slotNameIndex_ = SlotNameIndex{94};
-      break;
-  }  // switch
-
-  slotCount_ = 6;
-}
+constexpr ASTSlotDescriptor kConditionalExpressionSlots[] = {
+    {offsetof(ConditionalExpressionAST, condition), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{39},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(ConditionalExpressionAST, questionLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{157}},
+    {offsetof(ConditionalExpressionAST, iftrueExpression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{98},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(ConditionalExpressionAST, colonLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{35}},
+    {offsetof(ConditionalExpressionAST, iffalseExpression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{97},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+};
 
-void ASTSlot::visit(TypedefSpecifierAST* ast) {
-  switch (slot_) {
-    case 0:  // typedefLoc
-      value_ = ast->typedefLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{208};
-      break;
-  }  // switch
+constexpr ASTSlotDescriptor kYieldExpressionSlots[] = {
+    {offsetof(YieldExpressionAST, yieldLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{219}},
+    {offsetof(YieldExpressionAST, expression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{76},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+};
 
-  slotCount_ = 1;
-}
+constexpr ASTSlotDescriptor kThrowExpressionSlots[] = {
+    {offsetof(ThrowExpressionAST, throwLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{198}},
+    {offsetof(ThrowExpressionAST, expression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{76},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+};
 
-void ASTSlot::visit(FriendSpecifierAST* ast) {
-  switch (slot_) {
-    case 0:  // friendLoc
-      value_ = ast->friendLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{84};
-      break;
-  }  // switch
+constexpr ASTSlotDescriptor kAssignmentExpressionSlots[] = {
+    {offsetof(AssignmentExpressionAST, leftExpression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{121},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(AssignmentExpressionAST, opLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{145}},
+    {offsetof(AssignmentExpressionAST, rightExpression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{171},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(AssignmentExpressionAST, op), ASTSlotKind::kIntAttribute,
+     ASTSlotStorage::kTokenKind, SlotNameIndex{144}},
+};
 
-  slotCount_ = 1;
-}
+constexpr ASTSlotDescriptor kPackExpansionExpressionSlots[] = {
+    {offsetof(PackExpansionExpressionAST, expression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{76},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(PackExpansionExpressionAST, ellipsisLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{62}},
+};
 
-void ASTSlot::visit(ConstevalSpecifierAST* ast) {
-  switch (slot_) {
-    case 0:  // constevalLoc
-      value_ = ast->constevalLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{41};
-      break;
-  }  // switch
+constexpr ASTSlotDescriptor kDesignatedInitializerClauseSlots[] = {
+    {offsetof(DesignatedInitializerClauseAST, dotLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{61}},
+    {offsetof(DesignatedInitializerClauseAST, identifierLoc),
+     ASTSlotKind::kToken, ASTSlotStorage::kSourceLocation, SlotNameIndex{95}},
+    {offsetof(DesignatedInitializerClauseAST, identifier),
+     ASTSlotKind::kIdentifierAttribute, ASTSlotStorage::kPointer,
+     SlotNameIndex{94}},
+    {offsetof(DesignatedInitializerClauseAST, initializer), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{103},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+};
 
-  slotCount_ = 1;
-}
+constexpr ASTSlotDescriptor kTypeTraitsExpressionSlots[] = {
+    {offsetof(TypeTraitsExpressionAST, typeTraitsLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{207}},
+    {offsetof(TypeTraitsExpressionAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(TypeTraitsExpressionAST, typeIdList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{204}, ASTKind::TypeId,
+     ASTKind::TypeId},
+    {offsetof(TypeTraitsExpressionAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+};
 
-void ASTSlot::visit(ConstinitSpecifierAST* ast) {
-  switch (slot_) {
-    case 0:  // constinitLoc
-      value_ = ast->constinitLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{43};
-      break;
-  }  // switch
+constexpr ASTSlotDescriptor kConditionExpressionSlots[] = {
+    {offsetof(ConditionExpressionAST, attributeList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{11}, ASTKind::CxxAttribute,
+     ASTKind::AsmAttribute},
+    {offsetof(ConditionExpressionAST, declSpecifierList),
+     ASTSlotKind::kNodeList, ASTSlotStorage::kPointer, SlotNameIndex{51},
+     ASTKind::TypedefSpecifier, ASTKind::TypenameSpecifier},
+    {offsetof(ConditionExpressionAST, declarator), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{54}, ASTKind::Declarator,
+     ASTKind::Declarator},
+    {offsetof(ConditionExpressionAST, initializer), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{103},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+};
 
-  slotCount_ = 1;
-}
+constexpr ASTSlotDescriptor kEqualInitializerSlots[] = {
+    {offsetof(EqualInitializerAST, equalLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{69}},
+    {offsetof(EqualInitializerAST, expression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{76},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+};
 
-void ASTSlot::visit(ConstexprSpecifierAST* ast) {
-  switch (slot_) {
-    case 0:  // constexprLoc
-      value_ = ast->constexprLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{42};
-      break;
-  }  // switch
+constexpr ASTSlotDescriptor kBracedInitListSlots[] = {
+    {offsetof(BracedInitListAST, lbraceLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{118}},
+    {offsetof(BracedInitListAST, expressionList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{77},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(BracedInitListAST, commaLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{36}},
+    {offsetof(BracedInitListAST, rbraceLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{160}},
+};
 
-  slotCount_ = 1;
-}
+constexpr ASTSlotDescriptor kParenInitializerSlots[] = {
+    {offsetof(ParenInitializerAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(ParenInitializerAST, expressionList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{77},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(ParenInitializerAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+};
 
-void ASTSlot::visit(InlineSpecifierAST* ast) {
-  switch (slot_) {
-    case 0:  // inlineLoc
-      value_ = ast->inlineLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{104};
-      break;
-  }  // switch
+constexpr ASTSlotDescriptor kTemplateTypeParameterSlots[] = {
+    {offsetof(TemplateTypeParameterAST, templateLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{192}},
+    {offsetof(TemplateTypeParameterAST, lessLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{122}},
+    {offsetof(TemplateTypeParameterAST, templateParameterList),
+     ASTSlotKind::kNodeList, ASTSlotStorage::kPointer, SlotNameIndex{193},
+     ASTKind::TemplateTypeParameter, ASTKind::ConstraintTypeParameter},
+    {offsetof(TemplateTypeParameterAST, greaterLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{89}},
+    {offsetof(TemplateTypeParameterAST, requiresClause), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{167}, ASTKind::RequiresClause,
+     ASTKind::RequiresClause},
+    {offsetof(TemplateTypeParameterAST, classKeyLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{31}},
+    {offsetof(TemplateTypeParameterAST, ellipsisLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{62}},
+    {offsetof(TemplateTypeParameterAST, identifierLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{95}},
+    {offsetof(TemplateTypeParameterAST, equalLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{69}},
+    {offsetof(TemplateTypeParameterAST, idExpression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{93}, ASTKind::IdExpression,
+     ASTKind::IdExpression},
+    {offsetof(TemplateTypeParameterAST, identifier),
+     ASTSlotKind::kIdentifierAttribute, ASTSlotStorage::kPointer,
+     SlotNameIndex{94}},
+    {offsetof(TemplateTypeParameterAST, isPack), ASTSlotKind::kBoolAttribute,
+     ASTSlotStorage::kBool, SlotNameIndex{110}},
+};
 
-  slotCount_ = 1;
-}
+constexpr ASTSlotDescriptor kNonTypeTemplateParameterSlots[] = {
+    {offsetof(NonTypeTemplateParameterAST, declaration), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{52}, ASTKind::ParameterDeclaration,
+     ASTKind::ParameterDeclaration},
+};
 
-void ASTSlot::visit(StaticSpecifierAST* ast) {
-  switch (slot_) {
-    case 0:  // staticLoc
-      value_ = ast->staticLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{184};
-      break;
-  }  // switch
+constexpr ASTSlotDescriptor kTypenameTypeParameterSlots[] = {
+    {offsetof(TypenameTypeParameterAST, classKeyLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{31}},
+    {offsetof(TypenameTypeParameterAST, ellipsisLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{62}},
+    {offsetof(TypenameTypeParameterAST, identifierLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{95}},
+    {offsetof(TypenameTypeParameterAST, equalLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{69}},
+    {offsetof(TypenameTypeParameterAST, typeId), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{203}, ASTKind::TypeId,
+     ASTKind::TypeId},
+    {offsetof(TypenameTypeParameterAST, identifier),
+     ASTSlotKind::kIdentifierAttribute, ASTSlotStorage::kPointer,
+     SlotNameIndex{94}},
+    {offsetof(TypenameTypeParameterAST, isPack), ASTSlotKind::kBoolAttribute,
+     ASTSlotStorage::kBool, SlotNameIndex{110}},
+};
 
-  slotCount_ = 1;
-}
+constexpr ASTSlotDescriptor kConstraintTypeParameterSlots[] = {
+    {offsetof(ConstraintTypeParameterAST, typeConstraint), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{202}, ASTKind::TypeConstraint,
+     ASTKind::TypeConstraint},
+    {offsetof(ConstraintTypeParameterAST, ellipsisLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{62}},
+    {offsetof(ConstraintTypeParameterAST, identifierLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{95}},
+    {offsetof(ConstraintTypeParameterAST, equalLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{69}},
+    {offsetof(ConstraintTypeParameterAST, typeId), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{203}, ASTKind::TypeId,
+     ASTKind::TypeId},
+    {offsetof(ConstraintTypeParameterAST, identifier),
+     ASTSlotKind::kIdentifierAttribute, ASTSlotStorage::kPointer,
+     SlotNameIndex{94}},
+};
 
-void ASTSlot::visit(ExternSpecifierAST* ast) {
-  switch (slot_) {
-    case 0:  // externLoc
-      value_ = ast->externLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{78};
-      break;
-  }  // switch
+constexpr ASTSlotDescriptor kTypedefSpecifierSlots[] = {
+    {offsetof(TypedefSpecifierAST, typedefLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{208}},
+};
 
-  slotCount_ = 1;
-}
+constexpr ASTSlotDescriptor kFriendSpecifierSlots[] = {
+    {offsetof(FriendSpecifierAST, friendLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{84}},
+};
 
-void ASTSlot::visit(ThreadLocalSpecifierAST* ast) {
-  switch (slot_) {
-    case 0:  // threadLocalLoc
-      value_ = ast->threadLocalLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{197};
-      break;
-  }  // switch
+constexpr ASTSlotDescriptor kConstevalSpecifierSlots[] = {
+    {offsetof(ConstevalSpecifierAST, constevalLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{41}},
+};
 
-  slotCount_ = 1;
-}
+constexpr ASTSlotDescriptor kConstinitSpecifierSlots[] = {
+    {offsetof(ConstinitSpecifierAST, constinitLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{43}},
+};
 
-void ASTSlot::visit(ThreadSpecifierAST* ast) {
-  switch (slot_) {
-    case 0:  // threadLoc
-      value_ = ast->threadLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{196};
-      break;
-  }  // switch
+constexpr ASTSlotDescriptor kConstexprSpecifierSlots[] = {
+    {offsetof(ConstexprSpecifierAST, constexprLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{42}},
+};
 
-  slotCount_ = 1;
-}
+constexpr ASTSlotDescriptor kInlineSpecifierSlots[] = {
+    {offsetof(InlineSpecifierAST, inlineLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{104}},
+};
 
-void ASTSlot::visit(MutableSpecifierAST* ast) {
-  switch (slot_) {
-    case 0:  // mutableLoc
-      value_ = ast->mutableLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{136};
-      break;
-  }  // switch
+constexpr ASTSlotDescriptor kStaticSpecifierSlots[] = {
+    {offsetof(StaticSpecifierAST, staticLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{184}},
+};
 
-  slotCount_ = 1;
-}
+constexpr ASTSlotDescriptor kExternSpecifierSlots[] = {
+    {offsetof(ExternSpecifierAST, externLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{78}},
+};
 
-void ASTSlot::visit(VirtualSpecifierAST* ast) {
-  switch (slot_) {
-    case 0:  // virtualLoc
-      value_ = ast->virtualLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{215};
-      break;
-  }  // switch
+constexpr ASTSlotDescriptor kThreadLocalSpecifierSlots[] = {
+    {offsetof(ThreadLocalSpecifierAST, threadLocalLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{197}},
+};
 
-  slotCount_ = 1;
-}
+constexpr ASTSlotDescriptor kThreadSpecifierSlots[] = {
+    {offsetof(ThreadSpecifierAST, threadLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{196}},
+};
 
-void ASTSlot::visit(ExplicitSpecifierAST* ast) {
-  switch (slot_) {
-    case 0:  // explicitLoc
-      value_ = ast->explicitLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{73};
-      break;
-    case 1:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 2:  // expression
-      value_ = reinterpret_cast<std::intptr_t>(ast->expression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{76};
-      break;
-    case 3:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-  }  // switch
-
-  slotCount_ = 4;
-}
+constexpr ASTSlotDescriptor kMutableSpecifierSlots[] = {
+    {offsetof(MutableSpecifierAST, mutableLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{136}},
+};
 
-void ASTSlot::visit(AutoTypeSpecifierAST* ast) {
-  switch (slot_) {
-    case 0:  // autoLoc
-      value_ = ast->autoLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{17};
-      break;
-  }  // switch
+constexpr ASTSlotDescriptor kVirtualSpecifierSlots[] = {
+    {offsetof(VirtualSpecifierAST, virtualLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{215}},
+};
 
-  slotCount_ = 1;
-}
+constexpr ASTSlotDescriptor kExplicitSpecifierSlots[] = {
+    {offsetof(ExplicitSpecifierAST, explicitLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{73}},
+    {offsetof(ExplicitSpecifierAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(ExplicitSpecifierAST, expression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{76},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(ExplicitSpecifierAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+};
 
-void ASTSlot::visit(VoidTypeSpecifierAST* ast) {
-  switch (slot_) {
-    case 0:  // voidLoc
-      value_ = ast->voidLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{216};
-      break;
-  }  // switch
+constexpr ASTSlotDescriptor kAutoTypeSpecifierSlots[] = {
+    {offsetof(AutoTypeSpecifierAST, autoLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{17}},
+};
 
-  slotCount_ = 1;
-}
+constexpr ASTSlotDescriptor kVoidTypeSpecifierSlots[] = {
+    {offsetof(VoidTypeSpecifierAST, voidLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{216}},
+};
 
-void ASTSlot::visit(SizeTypeSpecifierAST* ast) {
-  switch (slot_) {
-    case 0:  // specifierLoc
-      value_ = ast->specifierLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{179};
-      break;
-    case 1:  // specifier
-      value_ = std::intptr_t(ast->specifier);
-      slotKind_ = ASTSlotKind::kIntAttribute;
-      slotNameIndex_ = SlotNameIndex{178};
-      break;
-  }  // switch
-
-  slotCount_ = 2;
-}
+constexpr ASTSlotDescriptor kSizeTypeSpecifierSlots[] = {
+    {offsetof(SizeTypeSpecifierAST, specifierLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{179}},
+    {offsetof(SizeTypeSpecifierAST, specifier), ASTSlotKind::kIntAttribute,
+     ASTSlotStorage::kTokenKind, SlotNameIndex{178}},
+};
 
-void ASTSlot::visit(SignTypeSpecifierAST* ast) {
-  switch (slot_) {
-    case 0:  // specifierLoc
-      value_ = ast->specifierLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{179};
-      break;
-    case 1:  // specifier
-      value_ = std::intptr_t(ast->specifier);
-      slotKind_ = ASTSlotKind::kIntAttribute;
-      slotNameIndex_ = SlotNameIndex{178};
-      break;
-  }  // switch
-
-  slotCount_ = 2;
-}
+constexpr ASTSlotDescriptor kSignTypeSpecifierSlots[] = {
+    {offsetof(SignTypeSpecifierAST, specifierLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{179}},
+    {offsetof(SignTypeSpecifierAST, specifier), ASTSlotKind::kIntAttribute,
+     ASTSlotStorage::kTokenKind, SlotNameIndex{178}},
+};
 
-void ASTSlot::visit(VaListTypeSpecifierAST* ast) {
-  switch (slot_) {
-    case 0:  // specifierLoc
-      value_ = ast->specifierLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{179};
-      break;
-    case 1:  // specifier
-      value_ = std::intptr_t(ast->specifier);
-      slotKind_ = ASTSlotKind::kIntAttribute;
-      slotNameIndex_ = SlotNameIndex{178};
-      break;
-  }  // switch
-
-  slotCount_ = 2;
-}
+constexpr ASTSlotDescriptor kVaListTypeSpecifierSlots[] = {
+    {offsetof(VaListTypeSpecifierAST, specifierLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{179}},
+    {offsetof(VaListTypeSpecifierAST, specifier), ASTSlotKind::kIntAttribute,
+     ASTSlotStorage::kTokenKind, SlotNameIndex{178}},
+};
 
-void ASTSlot::visit(IntegralTypeSpecifierAST* ast) {
-  switch (slot_) {
-    case 0:  // specifierLoc
-      value_ = ast->specifierLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{179};
-      break;
-    case 1:  // specifier
-      value_ = std::intptr_t(ast->specifier);
-      slotKind_ = ASTSlotKind::kIntAttribute;
-      slotNameIndex_ = SlotNameIndex{178};
-      break;
-  }  // switch
-
-  slotCount_ = 2;
-}
+constexpr ASTSlotDescriptor kIntegralTypeSpecifierSlots[] = {
+    {offsetof(IntegralTypeSpecifierAST, specifierLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{179}},
+    {offsetof(IntegralTypeSpecifierAST, specifier), ASTSlotKind::kIntAttribute,
+     ASTSlotStorage::kTokenKind, SlotNameIndex{178}},
+};
 
-void ASTSlot::visit(FloatingPointTypeSpecifierAST* ast) {
-  switch (slot_) {
-    case 0:  // specifierLoc
-      value_ = ast->specifierLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{179};
-      break;
-    case 1:  // specifier
-      value_ = std::intptr_t(ast->specifier);
-      slotKind_ = ASTSlotKind::kIntAttribute;
-      slotNameIndex_ = SlotNameIndex{178};
-      break;
-  }  // switch
-
-  slotCount_ = 2;
-}
+constexpr ASTSlotDescriptor kFloatingPointTypeSpecifierSlots[] = {
+    {offsetof(FloatingPointTypeSpecifierAST, specifierLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{179}},
+    {offsetof(FloatingPointTypeSpecifierAST, specifier),
+     ASTSlotKind::kIntAttribute, ASTSlotStorage::kTokenKind,
+     SlotNameIndex{178}},
+};
 
-void ASTSlot::visit(ComplexTypeSpecifierAST* ast) {
-  switch (slot_) {
-    case 0:  // complexLoc
-      value_ = ast->complexLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{37};
-      break;
-  }  // switch
+constexpr ASTSlotDescriptor kComplexTypeSpecifierSlots[] = {
+    {offsetof(ComplexTypeSpecifierAST, complexLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{37}},
+};
 
-  slotCount_ = 1;
-}
+constexpr ASTSlotDescriptor kNamedTypeSpecifierSlots[] = {
+    {offsetof(NamedTypeSpecifierAST, nestedNameSpecifier), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{138},
+     ASTKind::GlobalNestedNameSpecifier, ASTKind::TemplateNestedNameSpecifier},
+    {offsetof(NamedTypeSpecifierAST, templateLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{192}},
+    {offsetof(NamedTypeSpecifierAST, unqualifiedId), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{212}, ASTKind::NameId,
+     ASTKind::OperatorFunctionTemplateId},
+    {offsetof(NamedTypeSpecifierAST, isTemplateIntroduced),
+     ASTSlotKind::kBoolAttribute, ASTSlotStorage::kBool, SlotNameIndex{112}},
+};
 
-void ASTSlot::visit(NamedTypeSpecifierAST* ast) {
-  switch (slot_) {
-    case 0:  // nestedNameSpecifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->nestedNameSpecifier);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{138};
-      break;
-    case 1:  // templateLoc
-      value_ = ast->templateLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{192};
-      break;
-    case 2:  // unqualifiedId
-      value_ = reinterpret_cast<std::intptr_t>(ast->unqualifiedId);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{212};
-      break;
-    case 3:  // isTemplateIntroduced
-      value_ = std::intptr_t(ast->isTemplateIntroduced != 0);
-      slotKind_ = ASTSlotKind::kBoolAttribute;
-      slotNameIndex_ = SlotNameIndex{112};
-      break;
-  }  // switch
-
-  slotCount_ = 4;
-}
+constexpr ASTSlotDescriptor kAtomicTypeSpecifierSlots[] = {
+    {offsetof(AtomicTypeSpecifierAST, atomicLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{9}},
+    {offsetof(AtomicTypeSpecifierAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(AtomicTypeSpecifierAST, typeId), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{203}, ASTKind::TypeId,
+     ASTKind::TypeId},
+    {offsetof(AtomicTypeSpecifierAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+};
 
-void ASTSlot::visit(AtomicTypeSpecifierAST* ast) {
-  switch (slot_) {
-    case 0:  // atomicLoc
-      value_ = ast->atomicLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{9};
-      break;
-    case 1:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 2:  // typeId
-      value_ = reinterpret_cast<std::intptr_t>(ast->typeId);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{203};
-      break;
-    case 3:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-  }  // switch
-
-  slotCount_ = 4;
-}
+constexpr ASTSlotDescriptor kUnderlyingTypeSpecifierSlots[] = {
+    {offsetof(UnderlyingTypeSpecifierAST, underlyingTypeLoc),
+     ASTSlotKind::kToken, ASTSlotStorage::kSourceLocation, SlotNameIndex{211}},
+    {offsetof(UnderlyingTypeSpecifierAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(UnderlyingTypeSpecifierAST, typeId), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{203}, ASTKind::TypeId,
+     ASTKind::TypeId},
+    {offsetof(UnderlyingTypeSpecifierAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+};
 
-void ASTSlot::visit(UnderlyingTypeSpecifierAST* ast) {
-  switch (slot_) {
-    case 0:  // underlyingTypeLoc
-      value_ = ast->underlyingTypeLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{211};
-      break;
-    case 1:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 2:  // typeId
-      value_ = reinterpret_cast<std::intptr_t>(ast->typeId);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{203};
-      break;
-    case 3:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-  }  // switch
-
-  slotCount_ = 4;
-}
+constexpr ASTSlotDescriptor kElaboratedTypeSpecifierSlots[] = {
+    {offsetof(ElaboratedTypeSpecifierAST, classLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{32}},
+    {offsetof(ElaboratedTypeSpecifierAST, attributeList),
+     ASTSlotKind::kNodeList, ASTSlotStorage::kPointer, SlotNameIndex{11},
+     ASTKind::CxxAttribute, ASTKind::AsmAttribute},
+    {offsetof(ElaboratedTypeSpecifierAST, nestedNameSpecifier),
+     ASTSlotKind::kNode, ASTSlotStorage::kPointer, SlotNameIndex{138},
+     ASTKind::GlobalNestedNameSpecifier, ASTKind::TemplateNestedNameSpecifier},
+    {offsetof(ElaboratedTypeSpecifierAST, templateLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{192}},
+    {offsetof(ElaboratedTypeSpecifierAST, unqualifiedId), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{212}, ASTKind::NameId,
+     ASTKind::OperatorFunctionTemplateId},
+    {offsetof(ElaboratedTypeSpecifierAST, classKey), ASTSlotKind::kIntAttribute,
+     ASTSlotStorage::kTokenKind, SlotNameIndex{30}},
+    {offsetof(ElaboratedTypeSpecifierAST, isTemplateIntroduced),
+     ASTSlotKind::kBoolAttribute, ASTSlotStorage::kBool, SlotNameIndex{112}},
+};
 
-void ASTSlot::visit(ElaboratedTypeSpecifierAST* ast) {
-  switch (slot_) {
-    case 0:  // classLoc
-      value_ = ast->classLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{32};
-      break;
-    case 1:  // attributeList
-      value_ = reinterpret_cast<std::intptr_t>(ast->attributeList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{11};
-      break;
-    case 2:  // nestedNameSpecifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->nestedNameSpecifier);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{138};
-      break;
-    case 3:  // templateLoc
-      value_ = ast->templateLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{192};
-      break;
-    case 4:  // unqualifiedId
-      value_ = reinterpret_cast<std::intptr_t>(ast->unqualifiedId);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{212};
-      break;
-    case 5:  // classKey
-      value_ = std::intptr_t(ast->classKey);
-      slotKind_ = ASTSlotKind::kIntAttribute;
-      slotNameIndex_ = SlotNameIndex{30};
-      break;
-    case 6:  // isTemplateIntroduced
-      value_ = std::intptr_t(ast->isTemplateIntroduced != 0);
-      slotKind_ = ASTSlotKind::kBoolAttribute;
-      slotNameIndex_ = SlotNameIndex{112};
-      break;
-  }  // switch
-
-  slotCount_ = 7;
-}
+constexpr ASTSlotDescriptor kDecltypeAutoSpecifierSlots[] = {
+    {offsetof(DecltypeAutoSpecifierAST, decltypeLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{56}},
+    {offsetof(DecltypeAutoSpecifierAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(DecltypeAutoSpecifierAST, autoLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{17}},
+    {offsetof(DecltypeAutoSpecifierAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+};
 
-void ASTSlot::visit(DecltypeAutoSpecifierAST* ast) {
-  switch (slot_) {
-    case 0:  // decltypeLoc
-      value_ = ast->decltypeLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{56};
-      break;
-    case 1:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 2:  // autoLoc
-      value_ = ast->autoLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{17};
-      break;
-    case 3:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-  }  // switch
-
-  slotCount_ = 4;
-}
+constexpr ASTSlotDescriptor kDecltypeSpecifierSlots[] = {
+    {offsetof(DecltypeSpecifierAST, decltypeLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{56}},
+    {offsetof(DecltypeSpecifierAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(DecltypeSpecifierAST, expression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{76},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(DecltypeSpecifierAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+};
 
-void ASTSlot::visit(DecltypeSpecifierAST* ast) {
-  switch (slot_) {
-    case 0:  // decltypeLoc
-      value_ = ast->decltypeLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{56};
-      break;
-    case 1:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 2:  // expression
-      value_ = reinterpret_cast<std::intptr_t>(ast->expression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{76};
-      break;
-    case 3:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-  }  // switch
-
-  slotCount_ = 4;
-}
+constexpr ASTSlotDescriptor kPlaceholderTypeSpecifierSlots[] = {
+    {offsetof(PlaceholderTypeSpecifierAST, typeConstraint), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{202}, ASTKind::TypeConstraint,
+     ASTKind::TypeConstraint},
+    {offsetof(PlaceholderTypeSpecifierAST, specifier), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{178}, ASTKind::TypedefSpecifier,
+     ASTKind::TypenameSpecifier},
+};
 
-void ASTSlot::visit(PlaceholderTypeSpecifierAST* ast) {
-  switch (slot_) {
-    case 0:  // typeConstraint
-      value_ = reinterpret_cast<std::intptr_t>(ast->typeConstraint);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{202};
-      break;
-    case 1:  // specifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->specifier);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{178};
-      break;
-  }  // switch
-
-  slotCount_ = 2;
-}
+constexpr ASTSlotDescriptor kConstQualifierSlots[] = {
+    {offsetof(ConstQualifierAST, constLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{40}},
+};
 
-void ASTSlot::visit(ConstQualifierAST* ast) {
-  switch (slot_) {
-    case 0:  // constLoc
-      value_ = ast->constLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{40};
-      break;
-  }  // switch
+constexpr ASTSlotDescriptor kVolatileQualifierSlots[] = {
+    {offsetof(VolatileQualifierAST, volatileLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{217}},
+};
 
-  slotCount_ = 1;
-}
+constexpr ASTSlotDescriptor kRestrictQualifierSlots[] = {
+    {offsetof(RestrictQualifierAST, restrictLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{169}},
+};
 
-void ASTSlot::visit(VolatileQualifierAST* ast) {
-  switch (slot_) {
-    case 0:  // volatileLoc
-      value_ = ast->volatileLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{217};
-      break;
-  }  // switch
+constexpr ASTSlotDescriptor kEnumSpecifierSlots[] = {
+    {offsetof(EnumSpecifierAST, enumLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{66}},
+    {offsetof(EnumSpecifierAST, classLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{32}},
+    {offsetof(EnumSpecifierAST, attributeList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{11}, ASTKind::CxxAttribute,
+     ASTKind::AsmAttribute},
+    {offsetof(EnumSpecifierAST, nestedNameSpecifier), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{138},
+     ASTKind::GlobalNestedNameSpecifier, ASTKind::TemplateNestedNameSpecifier},
+    {offsetof(EnumSpecifierAST, unqualifiedId), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{212}, ASTKind::NameId,
+     ASTKind::NameId},
+    {offsetof(EnumSpecifierAST, colonLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{35}},
+    {offsetof(EnumSpecifierAST, typeSpecifierList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{206}, ASTKind::TypedefSpecifier,
+     ASTKind::TypenameSpecifier},
+    {offsetof(EnumSpecifierAST, lbraceLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{118}},
+    {offsetof(EnumSpecifierAST, commaLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{36}},
+    {offsetof(EnumSpecifierAST, enumeratorList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{68}, ASTKind::Enumerator,
+     ASTKind::Enumerator},
+    {offsetof(EnumSpecifierAST, rbraceLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{160}},
+};
 
-  slotCount_ = 1;
-}
+constexpr ASTSlotDescriptor kClassSpecifierSlots[] = {
+    {offsetof(ClassSpecifierAST, classLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{32}},
+    {offsetof(ClassSpecifierAST, attributeList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{11}, ASTKind::CxxAttribute,
+     ASTKind::AsmAttribute},
+    {offsetof(ClassSpecifierAST, nestedNameSpecifier), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{138},
+     ASTKind::GlobalNestedNameSpecifier, ASTKind::TemplateNestedNameSpecifier},
+    {offsetof(ClassSpecifierAST, unqualifiedId), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{212}, ASTKind::NameId,
+     ASTKind::OperatorFunctionTemplateId},
+    {offsetof(ClassSpecifierAST, finalLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{80}},
+    {offsetof(ClassSpecifierAST, colonLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{35}},
+    {offsetof(ClassSpecifierAST, baseSpecifierList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{20}, ASTKind::BaseSpecifier,
+     ASTKind::BaseSpecifier},
+    {offsetof(ClassSpecifierAST, lbraceLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{118}},
+    {offsetof(ClassSpecifierAST, declarationList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{53}, ASTKind::SimpleDeclaration,
+     ASTKind::AsmGotoLabel},
+    {offsetof(ClassSpecifierAST, rbraceLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{160}},
+    {offsetof(ClassSpecifierAST, classKey), ASTSlotKind::kIntAttribute,
+     ASTSlotStorage::kTokenKind, SlotNameIndex{30}},
+    {offsetof(ClassSpecifierAST, isFinal), ASTSlotKind::kBoolAttribute,
+     ASTSlotStorage::kBool, SlotNameIndex{106}},
+};
 
-void ASTSlot::visit(RestrictQualifierAST* ast) {
-  switch (slot_) {
-    case 0:  // restrictLoc
-      value_ = ast->restrictLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{169};
-      break;
-  }  // switch
+constexpr ASTSlotDescriptor kTypenameSpecifierSlots[] = {
+    {offsetof(TypenameSpecifierAST, typenameLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{210}},
+    {offsetof(TypenameSpecifierAST, nestedNameSpecifier), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{138},
+     ASTKind::GlobalNestedNameSpecifier, ASTKind::TemplateNestedNameSpecifier},
+    {offsetof(TypenameSpecifierAST, unqualifiedId), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{212}, ASTKind::NameId,
+     ASTKind::OperatorFunctionTemplateId},
+};
 
-  slotCount_ = 1;
-}
+constexpr ASTSlotDescriptor kPointerOperatorSlots[] = {
+    {offsetof(PointerOperatorAST, starLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{180}},
+    {offsetof(PointerOperatorAST, attributeList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{11}, ASTKind::CxxAttribute,
+     ASTKind::AsmAttribute},
+    {offsetof(PointerOperatorAST, cvQualifierList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{50}, ASTKind::TypedefSpecifier,
+     ASTKind::TypenameSpecifier},
+};
 
-void ASTSlot::visit(EnumSpecifierAST* ast) {
-  switch (slot_) {
-    case 0:  // enumLoc
-      value_ = ast->enumLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{66};
-      break;
-    case 1:  // classLoc
-      value_ = ast->classLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{32};
-      break;
-    case 2:  // attributeList
-      value_ = reinterpret_cast<std::intptr_t>(ast->attributeList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{11};
-      break;
-    case 3:  // nestedNameSpecifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->nestedNameSpecifier);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{138};
-      break;
-    case 4:  // unqualifiedId
-      value_ = reinterpret_cast<std::intptr_t>(ast->unqualifiedId);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{212};
-      break;
-    case 5:  // colonLoc
-      value_ = ast->colonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{35};
-      break;
-    case 6:  // typeSpecifierList
-      value_ = reinterpret_cast<std::intptr_t>(ast->typeSpecifierList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{206};
-      break;
-    case 7:  // lbraceLoc
-      value_ = ast->lbraceLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{118};
-      break;
-    case 8:  // commaLoc
-      value_ = ast->commaLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{36};
-      break;
-    case 9:  // enumeratorList
-      value_ = reinterpret_cast<std::intptr_t>(ast->enumeratorList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{68};
-      break;
-    case 10:  // rbraceLoc
-      value_ = ast->rbraceLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{160};
-      break;
-  }  // switch
-
-  slotCount_ = 11;
-}
+constexpr ASTSlotDescriptor kReferenceOperatorSlots[] = {
+    {offsetof(ReferenceOperatorAST, refLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{163}},
+    {offsetof(ReferenceOperatorAST, attributeList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{11}, ASTKind::CxxAttribute,
+     ASTKind::AsmAttribute},
+    {offsetof(ReferenceOperatorAST, refOp), ASTSlotKind::kIntAttribute,
+     ASTSlotStorage::kTokenKind, SlotNameIndex{164}},
+};
 
-void ASTSlot::visit(ClassSpecifierAST* ast) {
-  switch (slot_) {
-    case 0:  // classLoc
-      value_ = ast->classLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{32};
-      break;
-    case 1:  // attributeList
-      value_ = reinterpret_cast<std::intptr_t>(ast->attributeList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{11};
-      break;
-    case 2:  // nestedNameSpecifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->nestedNameSpecifier);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{138};
-      break;
-    case 3:  // unqualifiedId
-      value_ = reinterpret_cast<std::intptr_t>(ast->unqualifiedId);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{212};
-      break;
-    case 4:  // finalLoc
-      value_ = ast->finalLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{80};
-      break;
-    case 5:  // colonLoc
-      value_ = ast->colonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{35};
-      break;
-    case 6:  // baseSpecifierList
-      value_ = reinterpret_cast<std::intptr_t>(ast->baseSpecifierList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{20};
-      break;
-    case 7:  // lbraceLoc
-      value_ = ast->lbraceLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{118};
-      break;
-    case 8:  // declarationList
-      value_ = reinterpret_cast<std::intptr_t>(ast->declarationList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{53};
-      break;
-    case 9:  // rbraceLoc
-      value_ = ast->rbraceLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{160};
-      break;
-    case 10:  // classKey
-      value_ = std::intptr_t(ast->classKey);
-      slotKind_ = ASTSlotKind::kIntAttribute;
-      slotNameIndex_ = SlotNameIndex{30};
-      break;
-    case 11:  // isFinal
-      value_ = std::intptr_t(ast->isFinal != 0);
-      slotKind_ = ASTSlotKind::kBoolAttribute;
-      slotNameIndex_ = SlotNameIndex{106};
-      break;
-  }  // switch
-
-  slotCount_ = 12;
-}
+constexpr ASTSlotDescriptor kPtrToMemberOperatorSlots[] = {
+    {offsetof(PtrToMemberOperatorAST, nestedNameSpecifier), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{138},
+     ASTKind::GlobalNestedNameSpecifier, ASTKind::TemplateNestedNameSpecifier},
+    {offsetof(PtrToMemberOperatorAST, starLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{180}},
+    {offsetof(PtrToMemberOperatorAST, attributeList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{11}, ASTKind::CxxAttribute,
+     ASTKind::AsmAttribute},
+    {offsetof(PtrToMemberOperatorAST, cvQualifierList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{50}, ASTKind::TypedefSpecifier,
+     ASTKind::TypenameSpecifier},
+};
 
-void ASTSlot::visit(TypenameSpecifierAST* ast) {
-  switch (slot_) {
-    case 0:  // typenameLoc
-      value_ = ast->typenameLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{210};
-      break;
-    case 1:  // nestedNameSpecifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->nestedNameSpecifier);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{138};
-      break;
-    case 2:  // unqualifiedId
-      value_ = reinterpret_cast<std::intptr_t>(ast->unqualifiedId);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{212};
-      break;
-  }  // switch
-
-  slotCount_ = 3;
-}
+constexpr ASTSlotDescriptor kBitfieldDeclaratorSlots[] = {
+    {offsetof(BitfieldDeclaratorAST, unqualifiedId), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{212}, ASTKind::NameId,
+     ASTKind::NameId},
+    {offsetof(BitfieldDeclaratorAST, colonLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{35}},
+    {offsetof(BitfieldDeclaratorAST, sizeExpression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{176},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+};
 
-void ASTSlot::visit(PointerOperatorAST* ast) {
-  switch (slot_) {
-    case 0:  // starLoc
-      value_ = ast->starLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{180};
-      break;
-    case 1:  // attributeList
-      value_ = reinterpret_cast<std::intptr_t>(ast->attributeList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{11};
-      break;
-    case 2:  // cvQualifierList
-      value_ = reinterpret_cast<std::intptr_t>(ast->cvQualifierList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{50};
-      break;
-  }  // switch
-
-  slotCount_ = 3;
-}
+constexpr ASTSlotDescriptor kParameterPackSlots[] = {
+    {offsetof(ParameterPackAST, ellipsisLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{62}},
+    {offsetof(ParameterPackAST, coreDeclarator), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{48}, ASTKind::BitfieldDeclarator,
+     ASTKind::NestedDeclarator},
+};
 
-void ASTSlot::visit(ReferenceOperatorAST* ast) {
-  switch (slot_) {
-    case 0:  // refLoc
-      value_ = ast->refLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{163};
-      break;
-    case 1:  // attributeList
-      value_ = reinterpret_cast<std::intptr_t>(ast->attributeList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{11};
-      break;
-    case 2:  // refOp
-      value_ = std::intptr_t(ast->refOp);
-      slotKind_ = ASTSlotKind::kIntAttribute;
-      slotNameIndex_ = SlotNameIndex{164};
-      break;
-  }  // switch
-
-  slotCount_ = 3;
-}
+constexpr ASTSlotDescriptor kIdDeclaratorSlots[] = {
+    {offsetof(IdDeclaratorAST, nestedNameSpecifier), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{138},
+     ASTKind::GlobalNestedNameSpecifier, ASTKind::TemplateNestedNameSpecifier},
+    {offsetof(IdDeclaratorAST, templateLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{192}},
+    {offsetof(IdDeclaratorAST, unqualifiedId), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{212}, ASTKind::NameId,
+     ASTKind::OperatorFunctionTemplateId},
+    {offsetof(IdDeclaratorAST, attributeList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{11}, ASTKind::CxxAttribute,
+     ASTKind::AsmAttribute},
+    {offsetof(IdDeclaratorAST, isTemplateIntroduced),
+     ASTSlotKind::kBoolAttribute, ASTSlotStorage::kBool, SlotNameIndex{112}},
+};
 
-void ASTSlot::visit(PtrToMemberOperatorAST* ast) {
-  switch (slot_) {
-    case 0:  // nestedNameSpecifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->nestedNameSpecifier);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{138};
-      break;
-    case 1:  // starLoc
-      value_ = ast->starLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{180};
-      break;
-    case 2:  // attributeList
-      value_ = reinterpret_cast<std::intptr_t>(ast->attributeList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{11};
-      break;
-    case 3:  // cvQualifierList
-      value_ = reinterpret_cast<std::intptr_t>(ast->cvQualifierList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{50};
-      break;
-  }  // switch
-
-  slotCount_ = 4;
-}
+constexpr ASTSlotDescriptor kNestedDeclaratorSlots[] = {
+    {offsetof(NestedDeclaratorAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(NestedDeclaratorAST, declarator), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{54}, ASTKind::Declarator,
+     ASTKind::Declarator},
+    {offsetof(NestedDeclaratorAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+};
 
-void ASTSlot::visit(BitfieldDeclaratorAST* ast) {
-  switch (slot_) {
-    case 0:  // unqualifiedId
-      value_ = reinterpret_cast<std::intptr_t>(ast->unqualifiedId);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{212};
-      break;
-    case 1:  // colonLoc
-      value_ = ast->colonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{35};
-      break;
-    case 2:  // sizeExpression
-      value_ = reinterpret_cast<std::intptr_t>(ast->sizeExpression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{176};
-      break;
-  }  // switch
-
-  slotCount_ = 3;
-}
+constexpr ASTSlotDescriptor kFunctionDeclaratorChunkSlots[] = {
+    {offsetof(FunctionDeclaratorChunkAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(FunctionDeclaratorChunkAST, parameterDeclarationClause),
+     ASTSlotKind::kNode, ASTSlotStorage::kPointer, SlotNameIndex{150},
+     ASTKind::ParameterDeclarationClause, ASTKind::ParameterDeclarationClause},
+    {offsetof(FunctionDeclaratorChunkAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+    {offsetof(FunctionDeclaratorChunkAST, cvQualifierList),
+     ASTSlotKind::kNodeList, ASTSlotStorage::kPointer, SlotNameIndex{50},
+     ASTKind::TypedefSpecifier, ASTKind::TypenameSpecifier},
+    {offsetof(FunctionDeclaratorChunkAST, refLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{163}},
+    {offsetof(FunctionDeclaratorChunkAST, exceptionSpecifier),
+     ASTSlotKind::kNode, ASTSlotStorage::kPointer, SlotNameIndex{71},
+     ASTKind::ThrowExceptionSpecifier, ASTKind::NoexceptSpecifier},
+    {offsetof(FunctionDeclaratorChunkAST, attributeList),
+     ASTSlotKind::kNodeList, ASTSlotStorage::kPointer, SlotNameIndex{11},
+     ASTKind::CxxAttribute, ASTKind::AsmAttribute},
+    {offsetof(FunctionDeclaratorChunkAST, trailingReturnType),
+     ASTSlotKind::kNode, ASTSlotStorage::kPointer, SlotNameIndex{200},
+     ASTKind::TrailingReturnType, ASTKind::TrailingReturnType},
+    {offsetof(FunctionDeclaratorChunkAST, isFinal), ASTSlotKind::kBoolAttribute,
+     ASTSlotStorage::kBool, SlotNameIndex{106}},
+    {offsetof(FunctionDeclaratorChunkAST, isOverride),
+     ASTSlotKind::kBoolAttribute, ASTSlotStorage::kBool, SlotNameIndex{109}},
+    {offsetof(FunctionDeclaratorChunkAST, isPure), ASTSlotKind::kBoolAttribute,
+     ASTSlotStorage::kBool, SlotNameIndex{111}},
+};
 
-void ASTSlot::visit(ParameterPackAST* ast) {
-  switch (slot_) {
-    case 0:  // ellipsisLoc
-      value_ = ast->ellipsisLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{62};
-      break;
-    case 1:  // coreDeclarator
-      value_ = reinterpret_cast<std::intptr_t>(ast->coreDeclarator);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{48};
-      break;
-  }  // switch
-
-  slotCount_ = 2;
-}
+constexpr ASTSlotDescriptor kArrayDeclaratorChunkSlots[] = {
+    {offsetof(ArrayDeclaratorChunkAST, lbracketLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{120}},
+    {offsetof(ArrayDeclaratorChunkAST, expression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{76},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(ArrayDeclaratorChunkAST, rbracketLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{162}},
+    {offsetof(ArrayDeclaratorChunkAST, attributeList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{11}, ASTKind::CxxAttribute,
+     ASTKind::AsmAttribute},
+};
 
-void ASTSlot::visit(IdDeclaratorAST* ast) {
-  switch (slot_) {
-    case 0:  // nestedNameSpecifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->nestedNameSpecifier);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{138};
-      break;
-    case 1:  // templateLoc
-      value_ = ast->templateLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{192};
-      break;
-    case 2:  // unqualifiedId
-      value_ = reinterpret_cast<std::intptr_t>(ast->unqualifiedId);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{212};
-      break;
-    case 3:  // attributeList
-      value_ = reinterpret_cast<std::intptr_t>(ast->attributeList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{11};
-      break;
-    case 4:  // isTemplateIntroduced
-      value_ = std::intptr_t(ast->isTemplateIntroduced != 0);
-      slotKind_ = ASTSlotKind::kBoolAttribute;
-      slotNameIndex_ = SlotNameIndex{112};
-      break;
-  }  // switch
-
-  slotCount_ = 5;
-}
+constexpr ASTSlotDescriptor kNameIdSlots[] = {
+    {offsetof(NameIdAST, identifierLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{95}},
+    {offsetof(NameIdAST, identifier), ASTSlotKind::kIdentifierAttribute,
+     ASTSlotStorage::kPointer, SlotNameIndex{94}},
+};
 
-void ASTSlot::visit(NestedDeclaratorAST* ast) {
-  switch (slot_) {
-    case 0:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 1:  // declarator
-      value_ = reinterpret_cast<std::intptr_t>(ast->declarator);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{54};
-      break;
-    case 2:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-  }  // switch
-
-  slotCount_ = 3;
-}
+constexpr ASTSlotDescriptor kDestructorIdSlots[] = {
+    {offsetof(DestructorIdAST, tildeLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{199}},
+    {offsetof(DestructorIdAST, id), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{92}, ASTKind::NameId,
+     ASTKind::OperatorFunctionTemplateId},
+};
 
-void ASTSlot::visit(FunctionDeclaratorChunkAST* ast) {
-  switch (slot_) {
-    case 0:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 1:  // parameterDeclarationClause
-      value_ = reinterpret_cast<std::intptr_t>(ast->parameterDeclarationClause);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{150};
-      break;
-    case 2:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-    case 3:  // cvQualifierList
-      value_ = reinterpret_cast<std::intptr_t>(ast->cvQualifierList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{50};
-      break;
-    case 4:  // refLoc
-      value_ = ast->refLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{163};
-      break;
-    case 5:  // exceptionSpecifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->exceptionSpecifier);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{71};
-      break;
-    case 6:  // attributeList
-      value_ = reinterpret_cast<std::intptr_t>(ast->attributeList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{11};
-      break;
-    case 7:  // trailingReturnType
-      value_ = reinterpret_cast<std::intptr_t>(ast->trailingReturnType);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{200};
-      break;
-    case 8:  // isFinal
-      value_ = std::intptr_t(ast->isFinal != 0);
-      slotKind_ = ASTSlotKind::kBoolAttribute;
-      slotNameIndex_ = SlotNameIndex{106};
-      break;
-    case 9:  // isOverride
-      value_ = std::intptr_t(ast->isOverride != 0);
-      slotKind_ = ASTSlotKind::kBoolAttribute;
-      slotNameIndex_ = SlotNameIndex{109};
-      break;
-    case 10:  // isPure
-      value_ = std::intptr_t(ast->isPure != 0);
-      slotKind_ = ASTSlotKind::kBoolAttribute;
-      slotNameIndex_ = SlotNameIndex{111};
-      break;
-  }  // switch
-
-  slotCount_ = 11;
-}
+constexpr ASTSlotDescriptor kDecltypeIdSlots[] = {
+    {offsetof(DecltypeIdAST, decltypeSpecifier), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{57}, ASTKind::DecltypeSpecifier,
+     ASTKind::DecltypeSpecifier},
+};
 
-void ASTSlot::visit(ArrayDeclaratorChunkAST* ast) {
-  switch (slot_) {
-    case 0:  // lbracketLoc
-      value_ = ast->lbracketLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{120};
-      break;
-    case 1:  // expression
-      value_ = reinterpret_cast<std::intptr_t>(ast->expression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{76};
-      break;
-    case 2:  // rbracketLoc
-      value_ = ast->rbracketLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{162};
-      break;
-    case 3:  // attributeList
-      value_ = reinterpret_cast<std::intptr_t>(ast->attributeList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{11};
-      break;
-  }  // switch
-
-  slotCount_ = 4;
-}
+constexpr ASTSlotDescriptor kOperatorFunctionIdSlots[] = {
+    {offsetof(OperatorFunctionIdAST, operatorLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{148}},
+    {offsetof(OperatorFunctionIdAST, opLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{145}},
+    {offsetof(OperatorFunctionIdAST, openLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{146}},
+    {offsetof(OperatorFunctionIdAST, closeLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{34}},
+    {offsetof(OperatorFunctionIdAST, op), ASTSlotKind::kIntAttribute,
+     ASTSlotStorage::kTokenKind, SlotNameIndex{144}},
+};
 
-void ASTSlot::visit(NameIdAST* ast) {
-  switch (slot_) {
-    case 0:  // identifierLoc
-      value_ = ast->identifierLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{95};
-      break;
-    case 1:  // identifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->identifier);
-      slotKind_ = ASTSlotKind::kIdentifierAttribute;
-      slotNameIndex_ = SlotNameIndex{94};
-      break;
-  }  // switch
-
-  slotCount_ = 2;
-}
+constexpr ASTSlotDescriptor kLiteralOperatorIdSlots[] = {
+    {offsetof(LiteralOperatorIdAST, operatorLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{148}},
+    {offsetof(LiteralOperatorIdAST, literalLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{124}},
+    {offsetof(LiteralOperatorIdAST, identifierLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{95}},
+    {offsetof(LiteralOperatorIdAST, literal), ASTSlotKind::kLiteralAttribute,
+     ASTSlotStorage::kPointer, SlotNameIndex{123}},
+    {offsetof(LiteralOperatorIdAST, identifier),
+     ASTSlotKind::kIdentifierAttribute, ASTSlotStorage::kPointer,
+     SlotNameIndex{94}},
+};
 
-void ASTSlot::visit(DestructorIdAST* ast) {
-  switch (slot_) {
-    case 0:  // tildeLoc
-      value_ = ast->tildeLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{199};
-      break;
-    case 1:  // id
-      value_ = reinterpret_cast<std::intptr_t>(ast->id);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{92};
-      break;
-  }  // switch
-
-  slotCount_ = 2;
-}
+constexpr ASTSlotDescriptor kConversionFunctionIdSlots[] = {
+    {offsetof(ConversionFunctionIdAST, operatorLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{148}},
+    {offsetof(ConversionFunctionIdAST, typeId), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{203}, ASTKind::TypeId,
+     ASTKind::TypeId},
+};
 
-void ASTSlot::visit(DecltypeIdAST* ast) {
-  switch (slot_) {
-    case 0:  // decltypeSpecifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->decltypeSpecifier);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{57};
-      break;
-  }  // switch
+constexpr ASTSlotDescriptor kSimpleTemplateIdSlots[] = {
+    {offsetof(SimpleTemplateIdAST, identifierLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{95}},
+    {offsetof(SimpleTemplateIdAST, lessLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{122}},
+    {offsetof(SimpleTemplateIdAST, templateArgumentList),
+     ASTSlotKind::kNodeList, ASTSlotStorage::kPointer, SlotNameIndex{190},
+     ASTKind::TypeTemplateArgument, ASTKind::ExpressionTemplateArgument},
+    {offsetof(SimpleTemplateIdAST, greaterLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{89}},
+    {offsetof(SimpleTemplateIdAST, identifier),
+     ASTSlotKind::kIdentifierAttribute, ASTSlotStorage::kPointer,
+     SlotNameIndex{94}},
+};
 
-  slotCount_ = 1;
-}
+constexpr ASTSlotDescriptor kLiteralOperatorTemplateIdSlots[] = {
+    {offsetof(LiteralOperatorTemplateIdAST, literalOperatorId),
+     ASTSlotKind::kNode, ASTSlotStorage::kPointer, SlotNameIndex{125},
+     ASTKind::LiteralOperatorId, ASTKind::LiteralOperatorId},
+    {offsetof(LiteralOperatorTemplateIdAST, lessLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{122}},
+    {offsetof(LiteralOperatorTemplateIdAST, templateArgumentList),
+     ASTSlotKind::kNodeList, ASTSlotStorage::kPointer, SlotNameIndex{190},
+     ASTKind::TypeTemplateArgument, ASTKind::ExpressionTemplateArgument},
+    {offsetof(LiteralOperatorTemplateIdAST, greaterLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{89}},
+};
 
-void ASTSlot::visit(OperatorFunctionIdAST* ast) {
-  switch (slot_) {
-    case 0:  // operatorLoc
-      value_ = ast->operatorLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{148};
-      break;
-    case 1:  // opLoc
-      value_ = ast->opLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{145};
-      break;
-    case 2:  // openLoc
-      value_ = ast->openLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{146};
-      break;
-    case 3:  // closeLoc
-      value_ = ast->closeLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{34};
-      break;
-    case 4:  // op
-      value_ = std::intptr_t(ast->op);
-      slotKind_ = ASTSlotKind::kIntAttribute;
-      slotNameIndex_ = SlotNameIndex{144};
-      break;
-  }  // switch
-
-  slotCount_ = 5;
-}
+constexpr ASTSlotDescriptor kOperatorFunctionTemplateIdSlots[] = {
+    {offsetof(OperatorFunctionTemplateIdAST, operatorFunctionId),
+     ASTSlotKind::kNode, ASTSlotStorage::kPointer, SlotNameIndex{147},
+     ASTKind::OperatorFunctionId, ASTKind::OperatorFunctionId},
+    {offsetof(OperatorFunctionTemplateIdAST, lessLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{122}},
+    {offsetof(OperatorFunctionTemplateIdAST, templateArgumentList),
+     ASTSlotKind::kNodeList, ASTSlotStorage::kPointer, SlotNameIndex{190},
+     ASTKind::TypeTemplateArgument, ASTKind::ExpressionTemplateArgument},
+    {offsetof(OperatorFunctionTemplateIdAST, greaterLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{89}},
+};
 
-void ASTSlot::visit(LiteralOperatorIdAST* ast) {
-  switch (slot_) {
-    case 0:  // operatorLoc
-      value_ = ast->operatorLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{148};
-      break;
-    case 1:  // literalLoc
-      value_ = ast->literalLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{124};
-      break;
-    case 2:  // identifierLoc
-      value_ = ast->identifierLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{95};
-      break;
-    case 3:  // literal
-      value_ = reinterpret_cast<std::intptr_t>(ast->literal);
-      slotKind_ = ASTSlotKind::kLiteralAttribute;
-      slotNameIndex_ = SlotNameIndex{123};
-      break;
-    case 4:  // identifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->identifier);
-      slotKind_ = ASTSlotKind::kIdentifierAttribute;
-      slotNameIndex_ = SlotNameIndex{94};
-      break;
-  }  // switch
-
-  slotCount_ = 5;
-}
+constexpr ASTSlotDescriptor kGlobalNestedNameSpecifierSlots[] = {
+    {offsetof(GlobalNestedNameSpecifierAST, scopeLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{174}},
+};
 
-void ASTSlot::visit(ConversionFunctionIdAST* ast) {
-  switch (slot_) {
-    case 0:  // operatorLoc
-      value_ = ast->operatorLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{148};
-      break;
-    case 1:  // typeId
-      value_ = reinterpret_cast<std::intptr_t>(ast->typeId);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{203};
-      break;
-  }  // switch
-
-  slotCount_ = 2;
-}
+constexpr ASTSlotDescriptor kSimpleNestedNameSpecifierSlots[] = {
+    {offsetof(SimpleNestedNameSpecifierAST, nestedNameSpecifier),
+     ASTSlotKind::kNode, ASTSlotStorage::kPointer, SlotNameIndex{138},
+     ASTKind::GlobalNestedNameSpecifier, ASTKind::TemplateNestedNameSpecifier},
+    {offsetof(SimpleNestedNameSpecifierAST, identifierLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{95}},
+    {offsetof(SimpleNestedNameSpecifierAST, identifier),
+     ASTSlotKind::kIdentifierAttribute, ASTSlotStorage::kPointer,
+     SlotNameIndex{94}},
+    {offsetof(SimpleNestedNameSpecifierAST, scopeLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{174}},
+};
 
-void ASTSlot::visit(SimpleTemplateIdAST* ast) {
-  switch (slot_) {
-    case 0:  // identifierLoc
-      value_ = ast->identifierLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{95};
-      break;
-    case 1:  // lessLoc
-      value_ = ast->lessLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{122};
-      break;
-    case 2:  // templateArgumentList
-      value_ = reinterpret_cast<std::intptr_t>(ast->templateArgumentList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{190};
-      break;
-    case 3:  // greaterLoc
-      value_ = ast->greaterLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{89};
-      break;
-    case 4:  // identifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->identifier);
-      slotKind_ = ASTSlotKind::kIdentifierAttribute;
-      slotNameIndex_ = SlotNameIndex{94};
-      break;
-  }  // switch
-
-  slotCount_ = 5;
-}
+constexpr ASTSlotDescriptor kDecltypeNestedNameSpecifierSlots[] = {
+    {offsetof(DecltypeNestedNameSpecifierAST, nestedNameSpecifier),
+     ASTSlotKind::kNode, ASTSlotStorage::kPointer, SlotNameIndex{138},
+     ASTKind::GlobalNestedNameSpecifier, ASTKind::TemplateNestedNameSpecifier},
+    {offsetof(DecltypeNestedNameSpecifierAST, decltypeSpecifier),
+     ASTSlotKind::kNode, ASTSlotStorage::kPointer, SlotNameIndex{57},
+     ASTKind::DecltypeSpecifier, ASTKind::DecltypeSpecifier},
+    {offsetof(DecltypeNestedNameSpecifierAST, scopeLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{174}},
+};
 
-void ASTSlot::visit(LiteralOperatorTemplateIdAST* ast) {
-  switch (slot_) {
-    case 0:  // literalOperatorId
-      value_ = reinterpret_cast<std::intptr_t>(ast->literalOperatorId);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{125};
-      break;
-    case 1:  // lessLoc
-      value_ = ast->lessLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{122};
-      break;
-    case 2:  // templateArgumentList
-      value_ = reinterpret_cast<std::intptr_t>(ast->templateArgumentList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{190};
-      break;
-    case 3:  // greaterLoc
-      value_ = ast->greaterLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{89};
-      break;
-  }  // switch
-
-  slotCount_ = 4;
-}
+constexpr ASTSlotDescriptor kTemplateNestedNameSpecifierSlots[] = {
+    {offsetof(TemplateNestedNameSpecifierAST, nestedNameSpecifier),
+     ASTSlotKind::kNode, ASTSlotStorage::kPointer, SlotNameIndex{138},
+     ASTKind::GlobalNestedNameSpecifier, ASTKind::TemplateNestedNameSpecifier},
+    {offsetof(TemplateNestedNameSpecifierAST, templateLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{192}},
+    {offsetof(TemplateNestedNameSpecifierAST, templateId), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{191}, ASTKind::SimpleTemplateId,
+     ASTKind::SimpleTemplateId},
+    {offsetof(TemplateNestedNameSpecifierAST, scopeLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{174}},
+    {offsetof(TemplateNestedNameSpecifierAST, isTemplateIntroduced),
+     ASTSlotKind::kBoolAttribute, ASTSlotStorage::kBool, SlotNameIndex{112}},
+};
 
-void ASTSlot::visit(OperatorFunctionTemplateIdAST* ast) {
-  switch (slot_) {
-    case 0:  // operatorFunctionId
-      value_ = reinterpret_cast<std::intptr_t>(ast->operatorFunctionId);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{147};
-      break;
-    case 1:  // lessLoc
-      value_ = ast->lessLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{122};
-      break;
-    case 2:  // templateArgumentList
-      value_ = reinterpret_cast<std::intptr_t>(ast->templateArgumentList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{190};
-      break;
-    case 3:  // greaterLoc
-      value_ = ast->greaterLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{89};
-      break;
-  }  // switch
-
-  slotCount_ = 4;
-}
+constexpr ASTSlotDescriptor kDefaultFunctionBodySlots[] = {
+    {offsetof(DefaultFunctionBodyAST, equalLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{69}},
+    {offsetof(DefaultFunctionBodyAST, defaultLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{58}},
+    {offsetof(DefaultFunctionBodyAST, semicolonLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{175}},
+};
 
-void ASTSlot::visit(GlobalNestedNameSpecifierAST* ast) {
-  switch (slot_) {
-    case 0:  // scopeLoc
-      value_ = ast->scopeLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{174};
-      break;
-  }  // switch
+constexpr ASTSlotDescriptor kCompoundStatementFunctionBodySlots[] = {
+    {offsetof(CompoundStatementFunctionBodyAST, colonLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{35}},
+    {offsetof(CompoundStatementFunctionBodyAST, memInitializerList),
+     ASTSlotKind::kNodeList, ASTSlotStorage::kPointer, SlotNameIndex{128},
+     ASTKind::ParenMemInitializer, ASTKind::BracedMemInitializer},
+    {offsetof(CompoundStatementFunctionBodyAST, statement), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{181}, ASTKind::CompoundStatement,
+     ASTKind::CompoundStatement},
+};
 
-  slotCount_ = 1;
-}
+constexpr ASTSlotDescriptor kTryStatementFunctionBodySlots[] = {
+    {offsetof(TryStatementFunctionBodyAST, tryLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{201}},
+    {offsetof(TryStatementFunctionBodyAST, colonLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{35}},
+    {offsetof(TryStatementFunctionBodyAST, memInitializerList),
+     ASTSlotKind::kNodeList, ASTSlotStorage::kPointer, SlotNameIndex{128},
+     ASTKind::ParenMemInitializer, ASTKind::BracedMemInitializer},
+    {offsetof(TryStatementFunctionBodyAST, statement), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{181}, ASTKind::CompoundStatement,
+     ASTKind::CompoundStatement},
+    {offsetof(TryStatementFunctionBodyAST, handlerList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{90}, ASTKind::Handler,
+     ASTKind::Handler},
+};
 
-void ASTSlot::visit(SimpleNestedNameSpecifierAST* ast) {
-  switch (slot_) {
-    case 0:  // nestedNameSpecifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->nestedNameSpecifier);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{138};
-      break;
-    case 1:  // identifierLoc
-      value_ = ast->identifierLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{95};
-      break;
-    case 2:  // identifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->identifier);
-      slotKind_ = ASTSlotKind::kIdentifierAttribute;
-      slotNameIndex_ = SlotNameIndex{94};
-      break;
-    case 3:  // scopeLoc
-      value_ = ast->scopeLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{174};
-      break;
-  }  // switch
-
-  slotCount_ = 4;
-}
+constexpr ASTSlotDescriptor kDeleteFunctionBodySlots[] = {
+    {offsetof(DeleteFunctionBodyAST, equalLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{69}},
+    {offsetof(DeleteFunctionBodyAST, deleteLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{59}},
+    {offsetof(DeleteFunctionBodyAST, semicolonLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{175}},
+};
 
-void ASTSlot::visit(DecltypeNestedNameSpecifierAST* ast) {
-  switch (slot_) {
-    case 0:  // nestedNameSpecifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->nestedNameSpecifier);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{138};
-      break;
-    case 1:  // decltypeSpecifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->decltypeSpecifier);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{57};
-      break;
-    case 2:  // scopeLoc
-      value_ = ast->scopeLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{174};
-      break;
-  }  // switch
-
-  slotCount_ = 3;
-}
+constexpr ASTSlotDescriptor kTypeTemplateArgumentSlots[] = {
+    {offsetof(TypeTemplateArgumentAST, typeId), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{203}, ASTKind::TypeId,
+     ASTKind::TypeId},
+};
 
-void ASTSlot::visit(TemplateNestedNameSpecifierAST* ast) {
-  switch (slot_) {
-    case 0:  // nestedNameSpecifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->nestedNameSpecifier);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{138};
-      break;
-    case 1:  // templateLoc
-      value_ = ast->templateLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{192};
-      break;
-    case 2:  // templateId
-      value_ = reinterpret_cast<std::intptr_t>(ast->templateId);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{191};
-      break;
-    case 3:  // scopeLoc
-      value_ = ast->scopeLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{174};
-      break;
-    case 4:  // isTemplateIntroduced
-      value_ = std::intptr_t(ast->isTemplateIntroduced != 0);
-      slotKind_ = ASTSlotKind::kBoolAttribute;
-      slotNameIndex_ = SlotNameIndex{112};
-      break;
-  }  // switch
-
-  slotCount_ = 5;
-}
+constexpr ASTSlotDescriptor kExpressionTemplateArgumentSlots[] = {
+    {offsetof(ExpressionTemplateArgumentAST, expression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{76},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+};
 
-void ASTSlot::visit(DefaultFunctionBodyAST* ast) {
-  switch (slot_) {
-    case 0:  // equalLoc
-      value_ = ast->equalLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{69};
-      break;
-    case 1:  // defaultLoc
-      value_ = ast->defaultLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{58};
-      break;
-    case 2:  // semicolonLoc
-      value_ = ast->semicolonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{175};
-      break;
-  }  // switch
-
-  slotCount_ = 3;
-}
+constexpr ASTSlotDescriptor kThrowExceptionSpecifierSlots[] = {
+    {offsetof(ThrowExceptionSpecifierAST, throwLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{198}},
+    {offsetof(ThrowExceptionSpecifierAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(ThrowExceptionSpecifierAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+};
 
-void ASTSlot::visit(CompoundStatementFunctionBodyAST* ast) {
-  switch (slot_) {
-    case 0:  // colonLoc
-      value_ = ast->colonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{35};
-      break;
-    case 1:  // memInitializerList
-      value_ = reinterpret_cast<std::intptr_t>(ast->memInitializerList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{128};
-      break;
-    case 2:  // statement
-      value_ = reinterpret_cast<std::intptr_t>(ast->statement);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{181};
-      break;
-  }  // switch
-
-  slotCount_ = 3;
-}
+constexpr ASTSlotDescriptor kNoexceptSpecifierSlots[] = {
+    {offsetof(NoexceptSpecifierAST, noexceptLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{143}},
+    {offsetof(NoexceptSpecifierAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(NoexceptSpecifierAST, expression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{76},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(NoexceptSpecifierAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+};
 
-void ASTSlot::visit(TryStatementFunctionBodyAST* ast) {
-  switch (slot_) {
-    case 0:  // tryLoc
-      value_ = ast->tryLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{201};
-      break;
-    case 1:  // colonLoc
-      value_ = ast->colonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{35};
-      break;
-    case 2:  // memInitializerList
-      value_ = reinterpret_cast<std::intptr_t>(ast->memInitializerList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{128};
-      break;
-    case 3:  // statement
-      value_ = reinterpret_cast<std::intptr_t>(ast->statement);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{181};
-      break;
-    case 4:  // handlerList
-      value_ = reinterpret_cast<std::intptr_t>(ast->handlerList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{90};
-      break;
-  }  // switch
-
-  slotCount_ = 5;
-}
+constexpr ASTSlotDescriptor kSimpleRequirementSlots[] = {
+    {offsetof(SimpleRequirementAST, expression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{76},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(SimpleRequirementAST, semicolonLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{175}},
+};
 
-void ASTSlot::visit(DeleteFunctionBodyAST* ast) {
-  switch (slot_) {
-    case 0:  // equalLoc
-      value_ = ast->equalLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{69};
-      break;
-    case 1:  // deleteLoc
-      value_ = ast->deleteLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{59};
-      break;
-    case 2:  // semicolonLoc
-      value_ = ast->semicolonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{175};
-      break;
-  }  // switch
-
-  slotCount_ = 3;
-}
+constexpr ASTSlotDescriptor kCompoundRequirementSlots[] = {
+    {offsetof(CompoundRequirementAST, lbraceLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{118}},
+    {offsetof(CompoundRequirementAST, expression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{76},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(CompoundRequirementAST, rbraceLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{160}},
+    {offsetof(CompoundRequirementAST, noexceptLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{143}},
+    {offsetof(CompoundRequirementAST, minusGreaterLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{130}},
+    {offsetof(CompoundRequirementAST, typeConstraint), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{202}, ASTKind::TypeConstraint,
+     ASTKind::TypeConstraint},
+    {offsetof(CompoundRequirementAST, semicolonLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{175}},
+};
 
-void ASTSlot::visit(TypeTemplateArgumentAST* ast) {
-  switch (slot_) {
-    case 0:  // typeId
-      value_ = reinterpret_cast<std::intptr_t>(ast->typeId);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{203};
-      break;
-  }  // switch
+constexpr ASTSlotDescriptor kTypeRequirementSlots[] = {
+    {offsetof(TypeRequirementAST, typenameLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{210}},
+    {offsetof(TypeRequirementAST, nestedNameSpecifier), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{138},
+     ASTKind::GlobalNestedNameSpecifier, ASTKind::TemplateNestedNameSpecifier},
+    {offsetof(TypeRequirementAST, unqualifiedId), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{212}, ASTKind::NameId,
+     ASTKind::OperatorFunctionTemplateId},
+    {offsetof(TypeRequirementAST, semicolonLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{175}},
+};
 
-  slotCount_ = 1;
-}
+constexpr ASTSlotDescriptor kNestedRequirementSlots[] = {
+    {offsetof(NestedRequirementAST, requiresLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{168}},
+    {offsetof(NestedRequirementAST, expression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{76},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(NestedRequirementAST, semicolonLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{175}},
+};
 
-void ASTSlot::visit(ExpressionTemplateArgumentAST* ast) {
-  switch (slot_) {
-    case 0:  // expression
-      value_ = reinterpret_cast<std::intptr_t>(ast->expression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{76};
-      break;
-  }  // switch
+constexpr ASTSlotDescriptor kNewParenInitializerSlots[] = {
+    {offsetof(NewParenInitializerAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(NewParenInitializerAST, expressionList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{77},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(NewParenInitializerAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+};
 
-  slotCount_ = 1;
-}
+constexpr ASTSlotDescriptor kNewBracedInitializerSlots[] = {
+    {offsetof(NewBracedInitializerAST, bracedInitList), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{22}, ASTKind::BracedInitList,
+     ASTKind::BracedInitList},
+};
 
-void ASTSlot::visit(ThrowExceptionSpecifierAST* ast) {
-  switch (slot_) {
-    case 0:  // throwLoc
-      value_ = ast->throwLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{198};
-      break;
-    case 1:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 2:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-  }  // switch
-
-  slotCount_ = 3;
-}
+constexpr ASTSlotDescriptor kParenMemInitializerSlots[] = {
+    {offsetof(ParenMemInitializerAST, nestedNameSpecifier), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{138},
+     ASTKind::GlobalNestedNameSpecifier, ASTKind::TemplateNestedNameSpecifier},
+    {offsetof(ParenMemInitializerAST, unqualifiedId), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{212}, ASTKind::NameId,
+     ASTKind::OperatorFunctionTemplateId},
+    {offsetof(ParenMemInitializerAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(ParenMemInitializerAST, expressionList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{77},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(ParenMemInitializerAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+    {offsetof(ParenMemInitializerAST, ellipsisLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{62}},
+};
 
-void ASTSlot::visit(NoexceptSpecifierAST* ast) {
-  switch (slot_) {
-    case 0:  // noexceptLoc
-      value_ = ast->noexceptLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{143};
-      break;
-    case 1:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 2:  // expression
-      value_ = reinterpret_cast<std::intptr_t>(ast->expression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{76};
-      break;
-    case 3:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-  }  // switch
-
-  slotCount_ = 4;
-}
+constexpr ASTSlotDescriptor kBracedMemInitializerSlots[] = {
+    {offsetof(BracedMemInitializerAST, nestedNameSpecifier), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{138},
+     ASTKind::GlobalNestedNameSpecifier, ASTKind::TemplateNestedNameSpecifier},
+    {offsetof(BracedMemInitializerAST, unqualifiedId), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{212}, ASTKind::NameId,
+     ASTKind::OperatorFunctionTemplateId},
+    {offsetof(BracedMemInitializerAST, bracedInitList), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{22}, ASTKind::BracedInitList,
+     ASTKind::BracedInitList},
+    {offsetof(BracedMemInitializerAST, ellipsisLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{62}},
+};
 
-void ASTSlot::visit(SimpleRequirementAST* ast) {
-  switch (slot_) {
-    case 0:  // expression
-      value_ = reinterpret_cast<std::intptr_t>(ast->expression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{76};
-      break;
-    case 1:  // semicolonLoc
-      value_ = ast->semicolonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{175};
-      break;
-  }  // switch
-
-  slotCount_ = 2;
-}
+constexpr ASTSlotDescriptor kThisLambdaCaptureSlots[] = {
+    {offsetof(ThisLambdaCaptureAST, thisLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{195}},
+};
 
-void ASTSlot::visit(CompoundRequirementAST* ast) {
-  switch (slot_) {
-    case 0:  // lbraceLoc
-      value_ = ast->lbraceLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{118};
-      break;
-    case 1:  // expression
-      value_ = reinterpret_cast<std::intptr_t>(ast->expression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{76};
-      break;
-    case 2:  // rbraceLoc
-      value_ = ast->rbraceLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{160};
-      break;
-    case 3:  // noexceptLoc
-      value_ = ast->noexceptLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{143};
-      break;
-    case 4:  // minusGreaterLoc
-      value_ = ast->minusGreaterLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{130};
-      break;
-    case 5:  // typeConstraint
-      value_ = reinterpret_cast<std::intptr_t>(ast->typeConstraint);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{202};
-      break;
-    case 6:  // semicolonLoc
-      value_ = ast->semicolonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{175};
-      break;
-  }  // switch
-
-  slotCount_ = 7;
-}
+constexpr ASTSlotDescriptor kDerefThisLambdaCaptureSlots[] = {
+    {offsetof(DerefThisLambdaCaptureAST, starLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{180}},
+    {offsetof(DerefThisLambdaCaptureAST, thisLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{195}},
+};
 
-void ASTSlot::visit(TypeRequirementAST* ast) {
-  switch (slot_) {
-    case 0:  // typenameLoc
-      value_ = ast->typenameLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{210};
-      break;
-    case 1:  // nestedNameSpecifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->nestedNameSpecifier);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{138};
-      break;
-    case 2:  // unqualifiedId
-      value_ = reinterpret_cast<std::intptr_t>(ast->unqualifiedId);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{212};
-      break;
-    case 3:  // semicolonLoc
-      value_ = ast->semicolonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{175};
-      break;
-  }  // switch
-
-  slotCount_ = 4;
-}
+constexpr ASTSlotDescriptor kSimpleLambdaCaptureSlots[] = {
+    {offsetof(SimpleLambdaCaptureAST, identifierLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{95}},
+    {offsetof(SimpleLambdaCaptureAST, ellipsisLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{62}},
+    {offsetof(SimpleLambdaCaptureAST, identifier),
+     ASTSlotKind::kIdentifierAttribute, ASTSlotStorage::kPointer,
+     SlotNameIndex{94}},
+};
 
-void ASTSlot::visit(NestedRequirementAST* ast) {
-  switch (slot_) {
-    case 0:  // requiresLoc
-      value_ = ast->requiresLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{168};
-      break;
-    case 1:  // expression
-      value_ = reinterpret_cast<std::intptr_t>(ast->expression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{76};
-      break;
-    case 2:  // semicolonLoc
-      value_ = ast->semicolonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{175};
-      break;
-  }  // switch
-
-  slotCount_ = 3;
-}
+constexpr ASTSlotDescriptor kRefLambdaCaptureSlots[] = {
+    {offsetof(RefLambdaCaptureAST, ampLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{5}},
+    {offsetof(RefLambdaCaptureAST, identifierLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{95}},
+    {offsetof(RefLambdaCaptureAST, ellipsisLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{62}},
+    {offsetof(RefLambdaCaptureAST, identifier),
+     ASTSlotKind::kIdentifierAttribute, ASTSlotStorage::kPointer,
+     SlotNameIndex{94}},
+};
 
-void ASTSlot::visit(NewParenInitializerAST* ast) {
-  switch (slot_) {
-    case 0:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 1:  // expressionList
-      value_ = reinterpret_cast<std::intptr_t>(ast->expressionList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{77};
-      break;
-    case 2:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-  }  // switch
-
-  slotCount_ = 3;
-}
+constexpr ASTSlotDescriptor kRefInitLambdaCaptureSlots[] = {
+    {offsetof(RefInitLambdaCaptureAST, ampLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{5}},
+    {offsetof(RefInitLambdaCaptureAST, ellipsisLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{62}},
+    {offsetof(RefInitLambdaCaptureAST, identifierLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{95}},
+    {offsetof(RefInitLambdaCaptureAST, initializer), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{103},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(RefInitLambdaCaptureAST, identifier),
+     ASTSlotKind::kIdentifierAttribute, ASTSlotStorage::kPointer,
+     SlotNameIndex{94}},
+};
 
-void ASTSlot::visit(NewBracedInitializerAST* ast) {
-  switch (slot_) {
-    case 0:  // bracedInitList
-      value_ = reinterpret_cast<std::intptr_t>(ast->bracedInitList);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{22};
-      break;
-  }  // switch
+constexpr ASTSlotDescriptor kInitLambdaCaptureSlots[] = {
+    {offsetof(InitLambdaCaptureAST, ellipsisLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{62}},
+    {offsetof(InitLambdaCaptureAST, identifierLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{95}},
+    {offsetof(InitLambdaCaptureAST, initializer), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{103},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(InitLambdaCaptureAST, identifier),
+     ASTSlotKind::kIdentifierAttribute, ASTSlotStorage::kPointer,
+     SlotNameIndex{94}},
+};
 
-  slotCount_ = 1;
-}
+constexpr ASTSlotDescriptor kEllipsisExceptionDeclarationSlots[] = {
+    {offsetof(EllipsisExceptionDeclarationAST, ellipsisLoc),
+     ASTSlotKind::kToken, ASTSlotStorage::kSourceLocation, SlotNameIndex{62}},
+};
 
-void ASTSlot::visit(ParenMemInitializerAST* ast) {
-  switch (slot_) {
-    case 0:  // nestedNameSpecifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->nestedNameSpecifier);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{138};
-      break;
-    case 1:  // unqualifiedId
-      value_ = reinterpret_cast<std::intptr_t>(ast->unqualifiedId);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{212};
-      break;
-    case 2:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 3:  // expressionList
-      value_ = reinterpret_cast<std::intptr_t>(ast->expressionList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{77};
-      break;
-    case 4:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-    case 5:  // ellipsisLoc
-      value_ = ast->ellipsisLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{62};
-      break;
-  }  // switch
-
-  slotCount_ = 6;
-}
+constexpr ASTSlotDescriptor kTypeExceptionDeclarationSlots[] = {
+    {offsetof(TypeExceptionDeclarationAST, attributeList),
+     ASTSlotKind::kNodeList, ASTSlotStorage::kPointer, SlotNameIndex{11},
+     ASTKind::CxxAttribute, ASTKind::AsmAttribute},
+    {offsetof(TypeExceptionDeclarationAST, typeSpecifierList),
+     ASTSlotKind::kNodeList, ASTSlotStorage::kPointer, SlotNameIndex{206},
+     ASTKind::TypedefSpecifier, ASTKind::TypenameSpecifier},
+    {offsetof(TypeExceptionDeclarationAST, declarator), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{54}, ASTKind::Declarator,
+     ASTKind::Declarator},
+};
 
-void ASTSlot::visit(BracedMemInitializerAST* ast) {
-  switch (slot_) {
-    case 0:  // nestedNameSpecifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->nestedNameSpecifier);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{138};
-      break;
-    case 1:  // unqualifiedId
-      value_ = reinterpret_cast<std::intptr_t>(ast->unqualifiedId);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{212};
-      break;
-    case 2:  // bracedInitList
-      value_ = reinterpret_cast<std::intptr_t>(ast->bracedInitList);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{22};
-      break;
-    case 3:  // ellipsisLoc
-      value_ = ast->ellipsisLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{62};
-      break;
-  }  // switch
-
-  slotCount_ = 4;
-}
+constexpr ASTSlotDescriptor kCxxAttributeSlots[] = {
+    {offsetof(CxxAttributeAST, lbracketLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{120}},
+    {offsetof(CxxAttributeAST, lbracket2Loc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{119}},
+    {offsetof(CxxAttributeAST, attributeUsingPrefix), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{16}, ASTKind::AttributeUsingPrefix,
+     ASTKind::AttributeUsingPrefix},
+    {offsetof(CxxAttributeAST, attributeList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{11}, ASTKind::Attribute,
+     ASTKind::Attribute},
+    {offsetof(CxxAttributeAST, rbracketLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{162}},
+    {offsetof(CxxAttributeAST, rbracket2Loc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{161}},
+};
 
-void ASTSlot::visit(ThisLambdaCaptureAST* ast) {
-  switch (slot_) {
-    case 0:  // thisLoc
-      value_ = ast->thisLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{195};
-      break;
-  }  // switch
+constexpr ASTSlotDescriptor kGccAttributeSlots[] = {
+    {offsetof(GccAttributeAST, attributeLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{12}},
+    {offsetof(GccAttributeAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(GccAttributeAST, lparen2Loc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{126}},
+    {offsetof(GccAttributeAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+    {offsetof(GccAttributeAST, rparen2Loc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{172}},
+};
 
-  slotCount_ = 1;
-}
+constexpr ASTSlotDescriptor kAlignasAttributeSlots[] = {
+    {offsetof(AlignasAttributeAST, alignasLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{3}},
+    {offsetof(AlignasAttributeAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(AlignasAttributeAST, expression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{76},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(AlignasAttributeAST, ellipsisLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{62}},
+    {offsetof(AlignasAttributeAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+    {offsetof(AlignasAttributeAST, isPack), ASTSlotKind::kBoolAttribute,
+     ASTSlotStorage::kBool, SlotNameIndex{110}},
+};
 
-void ASTSlot::visit(DerefThisLambdaCaptureAST* ast) {
-  switch (slot_) {
-    case 0:  // starLoc
-      value_ = ast->starLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{180};
-      break;
-    case 1:  // thisLoc
-      value_ = ast->thisLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{195};
-      break;
-  }  // switch
-
-  slotCount_ = 2;
-}
+constexpr ASTSlotDescriptor kAlignasTypeAttributeSlots[] = {
+    {offsetof(AlignasTypeAttributeAST, alignasLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{3}},
+    {offsetof(AlignasTypeAttributeAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(AlignasTypeAttributeAST, typeId), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{203}, ASTKind::TypeId,
+     ASTKind::TypeId},
+    {offsetof(AlignasTypeAttributeAST, ellipsisLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{62}},
+    {offsetof(AlignasTypeAttributeAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+    {offsetof(AlignasTypeAttributeAST, isPack), ASTSlotKind::kBoolAttribute,
+     ASTSlotStorage::kBool, SlotNameIndex{110}},
+};
 
-void ASTSlot::visit(SimpleLambdaCaptureAST* ast) {
-  switch (slot_) {
-    case 0:  // identifierLoc
-      value_ = ast->identifierLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{95};
-      break;
-    case 1:  // ellipsisLoc
-      value_ = ast->ellipsisLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{62};
-      break;
-    case 2:  // identifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->identifier);
-      slotKind_ = ASTSlotKind::kIdentifierAttribute;
-      slotNameIndex_ = SlotNameIndex{94};
-      break;
-  }  // switch
-
-  slotCount_ = 3;
-}
+constexpr ASTSlotDescriptor kAsmAttributeSlots[] = {
+    {offsetof(AsmAttributeAST, asmLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{7}},
+    {offsetof(AsmAttributeAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(AsmAttributeAST, literalLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{124}},
+    {offsetof(AsmAttributeAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+    {offsetof(AsmAttributeAST, literal), ASTSlotKind::kLiteralAttribute,
+     ASTSlotStorage::kPointer, SlotNameIndex{123}},
+};
 
-void ASTSlot::visit(RefLambdaCaptureAST* ast) {
-  switch (slot_) {
-    case 0:  // ampLoc
-      value_ = ast->ampLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{5};
-      break;
-    case 1:  // identifierLoc
-      value_ = ast->identifierLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{95};
-      break;
-    case 2:  // ellipsisLoc
-      value_ = ast->ellipsisLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{62};
-      break;
-    case 3:  // identifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->identifier);
-      slotKind_ = ASTSlotKind::kIdentifierAttribute;
-      slotNameIndex_ = SlotNameIndex{94};
-      break;
-  }  // switch
-
-  slotCount_ = 4;
-}
+constexpr ASTSlotDescriptor kScopedAttributeTokenSlots[] = {
+    {offsetof(ScopedAttributeTokenAST, attributeNamespaceLoc),
+     ASTSlotKind::kToken, ASTSlotStorage::kSourceLocation, SlotNameIndex{14}},
+    {offsetof(ScopedAttributeTokenAST, scopeLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{174}},
+    {offsetof(ScopedAttributeTokenAST, identifierLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{95}},
+    {offsetof(ScopedAttributeTokenAST, attributeNamespace),
+     ASTSlotKind::kIdentifierAttribute, ASTSlotStorage::kPointer,
+     SlotNameIndex{13}},
+    {offsetof(ScopedAttributeTokenAST, identifier),
+     ASTSlotKind::kIdentifierAttribute, ASTSlotStorage::kPointer,
+     SlotNameIndex{94}},
+};
 
-void ASTSlot::visit(RefInitLambdaCaptureAST* ast) {
-  switch (slot_) {
-    case 0:  // ampLoc
-      value_ = ast->ampLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{5};
-      break;
-    case 1:  // ellipsisLoc
-      value_ = ast->ellipsisLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{62};
-      break;
-    case 2:  // identifierLoc
-      value_ = ast->identifierLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{95};
-      break;
-    case 3:  // initializer
-      value_ = reinterpret_cast<std::intptr_t>(ast->initializer);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{103};
-      break;
-    case 4:  // identifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->identifier);
-      slotKind_ = ASTSlotKind::kIdentifierAttribute;
-      slotNameIndex_ = SlotNameIndex{94};
-      break;
-  }  // switch
-
-  slotCount_ = 5;
-}
+constexpr ASTSlotDescriptor kSimpleAttributeTokenSlots[] = {
+    {offsetof(SimpleAttributeTokenAST, identifierLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{95}},
+    {offsetof(SimpleAttributeTokenAST, identifier),
+     ASTSlotKind::kIdentifierAttribute, ASTSlotStorage::kPointer,
+     SlotNameIndex{94}},
+};
 
-void ASTSlot::visit(InitLambdaCaptureAST* ast) {
-  switch (slot_) {
-    case 0:  // ellipsisLoc
-      value_ = ast->ellipsisLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{62};
-      break;
-    case 1:  // identifierLoc
-      value_ = ast->identifierLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{95};
-      break;
-    case 2:  // initializer
-      value_ = reinterpret_cast<std::intptr_t>(ast->initializer);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{103};
-      break;
-    case 3:  // identifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->identifier);
-      slotKind_ = ASTSlotKind::kIdentifierAttribute;
-      slotNameIndex_ = SlotNameIndex{94};
-      break;
-  }  // switch
-
-  slotCount_ = 4;
-}
+constexpr ASTSlotDescriptor kGlobalModuleFragmentSlots[] = {
+    {offsetof(GlobalModuleFragmentAST, moduleLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{132}},
+    {offsetof(GlobalModuleFragmentAST, semicolonLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{175}},
+    {offsetof(GlobalModuleFragmentAST, declarationList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{53}, ASTKind::SimpleDeclaration,
+     ASTKind::AsmGotoLabel},
+};
 
-void ASTSlot::visit(EllipsisExceptionDeclarationAST* ast) {
-  switch (slot_) {
-    case 0:  // ellipsisLoc
-      value_ = ast->ellipsisLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{62};
-      break;
-  }  // switch
+constexpr ASTSlotDescriptor kPrivateModuleFragmentSlots[] = {
+    {offsetof(PrivateModuleFragmentAST, moduleLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{132}},
+    {offsetof(PrivateModuleFragmentAST, colonLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{35}},
+    {offsetof(PrivateModuleFragmentAST, privateLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{152}},
+    {offsetof(PrivateModuleFragmentAST, semicolonLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{175}},
+    {offsetof(PrivateModuleFragmentAST, declarationList),
+     ASTSlotKind::kNodeList, ASTSlotStorage::kPointer, SlotNameIndex{53},
+     ASTKind::SimpleDeclaration, ASTKind::AsmGotoLabel},
+};
 
-  slotCount_ = 1;
-}
+constexpr ASTSlotDescriptor kModuleDeclarationSlots[] = {
+    {offsetof(ModuleDeclarationAST, exportLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{75}},
+    {offsetof(ModuleDeclarationAST, moduleLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{132}},
+    {offsetof(ModuleDeclarationAST, moduleName), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{133}, ASTKind::ModuleName,
+     ASTKind::ModuleName},
+    {offsetof(ModuleDeclarationAST, modulePartition), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{134}, ASTKind::ModulePartition,
+     ASTKind::ModulePartition},
+    {offsetof(ModuleDeclarationAST, attributeList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{11}, ASTKind::CxxAttribute,
+     ASTKind::AsmAttribute},
+    {offsetof(ModuleDeclarationAST, semicolonLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{175}},
+};
 
-void ASTSlot::visit(TypeExceptionDeclarationAST* ast) {
-  switch (slot_) {
-    case 0:  // attributeList
-      value_ = reinterpret_cast<std::intptr_t>(ast->attributeList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{11};
-      break;
-    case 1:  // typeSpecifierList
-      value_ = reinterpret_cast<std::intptr_t>(ast->typeSpecifierList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{206};
-      break;
-    case 2:  // declarator
-      value_ = reinterpret_cast<std::intptr_t>(ast->declarator);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{54};
-      break;
-  }  // switch
-
-  slotCount_ = 3;
-}
+constexpr ASTSlotDescriptor kModuleNameSlots[] = {
+    {offsetof(ModuleNameAST, moduleQualifier), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{135}, ASTKind::ModuleQualifier,
+     ASTKind::ModuleQualifier},
+    {offsetof(ModuleNameAST, identifierLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{95}},
+    {offsetof(ModuleNameAST, identifier), ASTSlotKind::kIdentifierAttribute,
+     ASTSlotStorage::kPointer, SlotNameIndex{94}},
+};
 
-void ASTSlot::visit(CxxAttributeAST* ast) {
-  switch (slot_) {
-    case 0:  // lbracketLoc
-      value_ = ast->lbracketLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{120};
-      break;
-    case 1:  // lbracket2Loc
-      value_ = ast->lbracket2Loc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{119};
-      break;
-    case 2:  // attributeUsingPrefix
-      value_ = reinterpret_cast<std::intptr_t>(ast->attributeUsingPrefix);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{16};
-      break;
-    case 3:  // attributeList
-      value_ = reinterpret_cast<std::intptr_t>(ast->attributeList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{11};
-      break;
-    case 4:  // rbracketLoc
-      value_ = ast->rbracketLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{162};
-      break;
-    case 5:  // rbracket2Loc
-      value_ = ast->rbracket2Loc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{161};
-      break;
-  }  // switch
-
-  slotCount_ = 6;
-}
+constexpr ASTSlotDescriptor kModuleQualifierSlots[] = {
+    {offsetof(ModuleQualifierAST, moduleQualifier), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{135}, ASTKind::ModuleQualifier,
+     ASTKind::ModuleQualifier},
+    {offsetof(ModuleQualifierAST, identifierLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{95}},
+    {offsetof(ModuleQualifierAST, dotLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{61}},
+    {offsetof(ModuleQualifierAST, identifier),
+     ASTSlotKind::kIdentifierAttribute, ASTSlotStorage::kPointer,
+     SlotNameIndex{94}},
+};
 
-void ASTSlot::visit(GccAttributeAST* ast) {
-  switch (slot_) {
-    case 0:  // attributeLoc
-      value_ = ast->attributeLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{12};
-      break;
-    case 1:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 2:  // lparen2Loc
-      value_ = ast->lparen2Loc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{126};
-      break;
-    case 3:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-    case 4:  // rparen2Loc
-      value_ = ast->rparen2Loc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{172};
-      break;
-  }  // switch
-
-  slotCount_ = 5;
-}
+constexpr ASTSlotDescriptor kModulePartitionSlots[] = {
+    {offsetof(ModulePartitionAST, colonLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{35}},
+    {offsetof(ModulePartitionAST, moduleName), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{133}, ASTKind::ModuleName,
+     ASTKind::ModuleName},
+};
 
-void ASTSlot::visit(AlignasAttributeAST* ast) {
-  switch (slot_) {
-    case 0:  // alignasLoc
-      value_ = ast->alignasLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{3};
-      break;
-    case 1:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 2:  // expression
-      value_ = reinterpret_cast<std::intptr_t>(ast->expression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{76};
-      break;
-    case 3:  // ellipsisLoc
-      value_ = ast->ellipsisLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{62};
-      break;
-    case 4:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-    case 5:  // isPack
-      value_ = std::intptr_t(ast->isPack != 0);
-      slotKind_ = ASTSlotKind::kBoolAttribute;
-      slotNameIndex_ = SlotNameIndex{110};
-      break;
-  }  // switch
-
-  slotCount_ = 6;
-}
+constexpr ASTSlotDescriptor kImportNameSlots[] = {
+    {offsetof(ImportNameAST, headerLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{91}},
+    {offsetof(ImportNameAST, modulePartition), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{134}, ASTKind::ModulePartition,
+     ASTKind::ModulePartition},
+    {offsetof(ImportNameAST, moduleName), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{133}, ASTKind::ModuleName,
+     ASTKind::ModuleName},
+};
 
-void ASTSlot::visit(AlignasTypeAttributeAST* ast) {
-  switch (slot_) {
-    case 0:  // alignasLoc
-      value_ = ast->alignasLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{3};
-      break;
-    case 1:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 2:  // typeId
-      value_ = reinterpret_cast<std::intptr_t>(ast->typeId);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{203};
-      break;
-    case 3:  // ellipsisLoc
-      value_ = ast->ellipsisLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{62};
-      break;
-    case 4:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-    case 5:  // isPack
-      value_ = std::intptr_t(ast->isPack != 0);
-      slotKind_ = ASTSlotKind::kBoolAttribute;
-      slotNameIndex_ = SlotNameIndex{110};
-      break;
-  }  // switch
-
-  slotCount_ = 6;
-}
+constexpr ASTSlotDescriptor kInitDeclaratorSlots[] = {
+    {offsetof(InitDeclaratorAST, declarator), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{54}, ASTKind::Declarator,
+     ASTKind::Declarator},
+    {offsetof(InitDeclaratorAST, requiresClause), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{167}, ASTKind::RequiresClause,
+     ASTKind::RequiresClause},
+    {offsetof(InitDeclaratorAST, initializer), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{103},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+};
 
-void ASTSlot::visit(AsmAttributeAST* ast) {
-  switch (slot_) {
-    case 0:  // asmLoc
-      value_ = ast->asmLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{7};
-      break;
-    case 1:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 2:  // literalLoc
-      value_ = ast->literalLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{124};
-      break;
-    case 3:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-    case 4:  // literal
-      value_ = reinterpret_cast<std::intptr_t>(ast->literal);
-      slotKind_ = ASTSlotKind::kLiteralAttribute;
-      slotNameIndex_ = SlotNameIndex{123};
-      break;
-  }  // switch
-
-  slotCount_ = 5;
-}
+constexpr ASTSlotDescriptor kDeclaratorSlots[] = {
+    {offsetof(DeclaratorAST, ptrOpList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{154}, ASTKind::PointerOperator,
+     ASTKind::PtrToMemberOperator},
+    {offsetof(DeclaratorAST, coreDeclarator), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{48}, ASTKind::BitfieldDeclarator,
+     ASTKind::NestedDeclarator},
+    {offsetof(DeclaratorAST, declaratorChunkList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{55},
+     ASTKind::FunctionDeclaratorChunk, ASTKind::ArrayDeclaratorChunk},
+};
 
-void ASTSlot::visit(ScopedAttributeTokenAST* ast) {
-  switch (slot_) {
-    case 0:  // attributeNamespaceLoc
-      value_ = ast->attributeNamespaceLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{14};
-      break;
-    case 1:  // scopeLoc
-      value_ = ast->scopeLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{174};
-      break;
-    case 2:  // identifierLoc
-      value_ = ast->identifierLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{95};
-      break;
-    case 3:  // attributeNamespace
-      value_ = reinterpret_cast<std::intptr_t>(ast->attributeNamespace);
-      slotKind_ = ASTSlotKind::kIdentifierAttribute;
-      slotNameIndex_ = SlotNameIndex{13};
-      break;
-    case 4:  // identifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->identifier);
-      slotKind_ = ASTSlotKind::kIdentifierAttribute;
-      slotNameIndex_ = SlotNameIndex{94};
-      break;
-  }  // switch
-
-  slotCount_ = 5;
-}
+constexpr ASTSlotDescriptor kUsingDeclaratorSlots[] = {
+    {offsetof(UsingDeclaratorAST, typenameLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{210}},
+    {offsetof(UsingDeclaratorAST, nestedNameSpecifier), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{138},
+     ASTKind::GlobalNestedNameSpecifier, ASTKind::TemplateNestedNameSpecifier},
+    {offsetof(UsingDeclaratorAST, unqualifiedId), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{212}, ASTKind::NameId,
+     ASTKind::OperatorFunctionTemplateId},
+    {offsetof(UsingDeclaratorAST, ellipsisLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{62}},
+    {offsetof(UsingDeclaratorAST, isPack), ASTSlotKind::kBoolAttribute,
+     ASTSlotStorage::kBool, SlotNameIndex{110}},
+};
 
-void ASTSlot::visit(SimpleAttributeTokenAST* ast) {
-  switch (slot_) {
-    case 0:  // identifierLoc
-      value_ = ast->identifierLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{95};
-      break;
-    case 1:  // identifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->identifier);
-      slotKind_ = ASTSlotKind::kIdentifierAttribute;
-      slotNameIndex_ = SlotNameIndex{94};
-      break;
-  }  // switch
-
-  slotCount_ = 2;
-}
+constexpr ASTSlotDescriptor kEnumeratorSlots[] = {
+    {offsetof(EnumeratorAST, identifierLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{95}},
+    {offsetof(EnumeratorAST, attributeList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{11}, ASTKind::CxxAttribute,
+     ASTKind::AsmAttribute},
+    {offsetof(EnumeratorAST, equalLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{69}},
+    {offsetof(EnumeratorAST, expression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{76},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(EnumeratorAST, identifier), ASTSlotKind::kIdentifierAttribute,
+     ASTSlotStorage::kPointer, SlotNameIndex{94}},
+};
 
-void ASTSlot::visit(GlobalModuleFragmentAST* ast) {
-  switch (slot_) {
-    case 0:  // moduleLoc
-      value_ = ast->moduleLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{132};
-      break;
-    case 1:  // semicolonLoc
-      value_ = ast->semicolonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{175};
-      break;
-    case 2:  // declarationList
-      value_ = reinterpret_cast<std::intptr_t>(ast->declarationList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{53};
-      break;
-  }  // switch
-
-  slotCount_ = 3;
-}
+constexpr ASTSlotDescriptor kTypeIdSlots[] = {
+    {offsetof(TypeIdAST, typeSpecifierList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{206}, ASTKind::TypedefSpecifier,
+     ASTKind::TypenameSpecifier},
+    {offsetof(TypeIdAST, declarator), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{54}, ASTKind::Declarator,
+     ASTKind::Declarator},
+};
 
-void ASTSlot::visit(PrivateModuleFragmentAST* ast) {
-  switch (slot_) {
-    case 0:  // moduleLoc
-      value_ = ast->moduleLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{132};
-      break;
-    case 1:  // colonLoc
-      value_ = ast->colonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{35};
-      break;
-    case 2:  // privateLoc
-      value_ = ast->privateLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{152};
-      break;
-    case 3:  // semicolonLoc
-      value_ = ast->semicolonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{175};
-      break;
-    case 4:  // declarationList
-      value_ = reinterpret_cast<std::intptr_t>(ast->declarationList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{53};
-      break;
-  }  // switch
-
-  slotCount_ = 5;
-}
+constexpr ASTSlotDescriptor kHandlerSlots[] = {
+    {offsetof(HandlerAST, catchLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{29}},
+    {offsetof(HandlerAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(HandlerAST, exceptionDeclaration), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{70},
+     ASTKind::EllipsisExceptionDeclaration, ASTKind::TypeExceptionDeclaration},
+    {offsetof(HandlerAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+    {offsetof(HandlerAST, statement), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{181}, ASTKind::CompoundStatement,
+     ASTKind::CompoundStatement},
+};
 
-void ASTSlot::visit(ModuleDeclarationAST* ast) {
-  switch (slot_) {
-    case 0:  // exportLoc
-      value_ = ast->exportLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{75};
-      break;
-    case 1:  // moduleLoc
-      value_ = ast->moduleLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{132};
-      break;
-    case 2:  // moduleName
-      value_ = reinterpret_cast<std::intptr_t>(ast->moduleName);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{133};
-      break;
-    case 3:  // modulePartition
-      value_ = reinterpret_cast<std::intptr_t>(ast->modulePartition);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{134};
-      break;
-    case 4:  // attributeList
-      value_ = reinterpret_cast<std::intptr_t>(ast->attributeList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{11};
-      break;
-    case 5:  // semicolonLoc
-      value_ = ast->semicolonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{175};
-      break;
-  }  // switch
-
-  slotCount_ = 6;
-}
+constexpr ASTSlotDescriptor kBaseSpecifierSlots[] = {
+    {offsetof(BaseSpecifierAST, attributeList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{11}, ASTKind::CxxAttribute,
+     ASTKind::AsmAttribute},
+    {offsetof(BaseSpecifierAST, nestedNameSpecifier), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{138},
+     ASTKind::GlobalNestedNameSpecifier, ASTKind::TemplateNestedNameSpecifier},
+    {offsetof(BaseSpecifierAST, templateLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{192}},
+    {offsetof(BaseSpecifierAST, unqualifiedId), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{212}, ASTKind::NameId,
+     ASTKind::OperatorFunctionTemplateId},
+    {offsetof(BaseSpecifierAST, isTemplateIntroduced),
+     ASTSlotKind::kBoolAttribute, ASTSlotStorage::kBool, SlotNameIndex{112}},
+    {offsetof(BaseSpecifierAST, isVirtual), ASTSlotKind::kBoolAttribute,
+     ASTSlotStorage::kBool, SlotNameIndex{116}},
+    {offsetof(BaseSpecifierAST, accessSpecifier), ASTSlotKind::kIntAttribute,
+     ASTSlotStorage::kTokenKind, SlotNameIndex{2}},
+};
 
-void ASTSlot::visit(ModuleNameAST* ast) {
-  switch (slot_) {
-    case 0:  // moduleQualifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->moduleQualifier);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{135};
-      break;
-    case 1:  // identifierLoc
-      value_ = ast->identifierLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{95};
-      break;
-    case 2:  // identifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->identifier);
-      slotKind_ = ASTSlotKind::kIdentifierAttribute;
-      slotNameIndex_ = SlotNameIndex{94};
-      break;
-  }  // switch
-
-  slotCount_ = 3;
-}
+constexpr ASTSlotDescriptor kRequiresClauseSlots[] = {
+    {offsetof(RequiresClauseAST, requiresLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{168}},
+    {offsetof(RequiresClauseAST, expression), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{76},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+};
 
-void ASTSlot::visit(ModuleQualifierAST* ast) {
-  switch (slot_) {
-    case 0:  // moduleQualifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->moduleQualifier);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{135};
-      break;
-    case 1:  // identifierLoc
-      value_ = ast->identifierLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{95};
-      break;
-    case 2:  // dotLoc
-      value_ = ast->dotLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{61};
-      break;
-    case 3:  // identifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->identifier);
-      slotKind_ = ASTSlotKind::kIdentifierAttribute;
-      slotNameIndex_ = SlotNameIndex{94};
-      break;
-  }  // switch
-
-  slotCount_ = 4;
-}
+constexpr ASTSlotDescriptor kParameterDeclarationClauseSlots[] = {
+    {offsetof(ParameterDeclarationClauseAST, parameterDeclarationList),
+     ASTSlotKind::kNodeList, ASTSlotStorage::kPointer, SlotNameIndex{151},
+     ASTKind::ParameterDeclaration, ASTKind::ParameterDeclaration},
+    {offsetof(ParameterDeclarationClauseAST, commaLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{36}},
+    {offsetof(ParameterDeclarationClauseAST, ellipsisLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{62}},
+    {offsetof(ParameterDeclarationClauseAST, isVariadic),
+     ASTSlotKind::kBoolAttribute, ASTSlotStorage::kBool, SlotNameIndex{115}},
+};
 
-void ASTSlot::visit(ModulePartitionAST* ast) {
-  switch (slot_) {
-    case 0:  // colonLoc
-      value_ = ast->colonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{35};
-      break;
-    case 1:  // moduleName
-      value_ = reinterpret_cast<std::intptr_t>(ast->moduleName);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{133};
-      break;
-  }  // switch
-
-  slotCount_ = 2;
-}
+constexpr ASTSlotDescriptor kTrailingReturnTypeSlots[] = {
+    {offsetof(TrailingReturnTypeAST, minusGreaterLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{130}},
+    {offsetof(TrailingReturnTypeAST, typeId), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{203}, ASTKind::TypeId,
+     ASTKind::TypeId},
+};
 
-void ASTSlot::visit(ImportNameAST* ast) {
-  switch (slot_) {
-    case 0:  // headerLoc
-      value_ = ast->headerLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{91};
-      break;
-    case 1:  // modulePartition
-      value_ = reinterpret_cast<std::intptr_t>(ast->modulePartition);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{134};
-      break;
-    case 2:  // moduleName
-      value_ = reinterpret_cast<std::intptr_t>(ast->moduleName);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{133};
-      break;
-  }  // switch
-
-  slotCount_ = 3;
-}
+constexpr ASTSlotDescriptor kLambdaSpecifierSlots[] = {
+    {offsetof(LambdaSpecifierAST, specifierLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{179}},
+    {offsetof(LambdaSpecifierAST, specifier), ASTSlotKind::kIntAttribute,
+     ASTSlotStorage::kTokenKind, SlotNameIndex{178}},
+};
 
-void ASTSlot::visit(InitDeclaratorAST* ast) {
-  switch (slot_) {
-    case 0:  // declarator
-      value_ = reinterpret_cast<std::intptr_t>(ast->declarator);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{54};
-      break;
-    case 1:  // requiresClause
-      value_ = reinterpret_cast<std::intptr_t>(ast->requiresClause);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{167};
-      break;
-    case 2:  // initializer
-      value_ = reinterpret_cast<std::intptr_t>(ast->initializer);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{103};
-      break;
-  }  // switch
-
-  slotCount_ = 3;
-}
+constexpr ASTSlotDescriptor kTypeConstraintSlots[] = {
+    {offsetof(TypeConstraintAST, nestedNameSpecifier), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{138},
+     ASTKind::GlobalNestedNameSpecifier, ASTKind::TemplateNestedNameSpecifier},
+    {offsetof(TypeConstraintAST, identifierLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{95}},
+    {offsetof(TypeConstraintAST, lessLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{122}},
+    {offsetof(TypeConstraintAST, templateArgumentList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{190},
+     ASTKind::TypeTemplateArgument, ASTKind::ExpressionTemplateArgument},
+    {offsetof(TypeConstraintAST, greaterLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{89}},
+    {offsetof(TypeConstraintAST, identifier), ASTSlotKind::kIdentifierAttribute,
+     ASTSlotStorage::kPointer, SlotNameIndex{94}},
+};
 
-void ASTSlot::visit(DeclaratorAST* ast) {
-  switch (slot_) {
-    case 0:  // ptrOpList
-      value_ = reinterpret_cast<std::intptr_t>(ast->ptrOpList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{154};
-      break;
-    case 1:  // coreDeclarator
-      value_ = reinterpret_cast<std::intptr_t>(ast->coreDeclarator);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{48};
-      break;
-    case 2:  // declaratorChunkList
-      value_ = reinterpret_cast<std::intptr_t>(ast->declaratorChunkList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{55};
-      break;
-  }  // switch
-
-  slotCount_ = 3;
-}
+constexpr ASTSlotDescriptor kAttributeArgumentClauseSlots[] = {
+    {offsetof(AttributeArgumentClauseAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(AttributeArgumentClauseAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+};
 
-void ASTSlot::visit(UsingDeclaratorAST* ast) {
-  switch (slot_) {
-    case 0:  // typenameLoc
-      value_ = ast->typenameLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{210};
-      break;
-    case 1:  // nestedNameSpecifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->nestedNameSpecifier);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{138};
-      break;
-    case 2:  // unqualifiedId
-      value_ = reinterpret_cast<std::intptr_t>(ast->unqualifiedId);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{212};
-      break;
-    case 3:  // ellipsisLoc
-      value_ = ast->ellipsisLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{62};
-      break;
-    case 4:  // isPack
-      value_ = std::intptr_t(ast->isPack != 0);
-      slotKind_ = ASTSlotKind::kBoolAttribute;
-      slotNameIndex_ = SlotNameIndex{110};
-      break;
-  }  // switch
-
-  slotCount_ = 5;
-}
+constexpr ASTSlotDescriptor kAttributeSlots[] = {
+    {offsetof(AttributeAST, attributeToken), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{15}, ASTKind::ScopedAttributeToken,
+     ASTKind::SimpleAttributeToken},
+    {offsetof(AttributeAST, attributeArgumentClause), ASTSlotKind::kNode,
+     ASTSlotStorage::kPointer, SlotNameIndex{10},
+     ASTKind::AttributeArgumentClause, ASTKind::AttributeArgumentClause},
+    {offsetof(AttributeAST, ellipsisLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{62}},
+};
 
-void ASTSlot::visit(EnumeratorAST* ast) {
-  switch (slot_) {
-    case 0:  // identifierLoc
-      value_ = ast->identifierLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{95};
-      break;
-    case 1:  // attributeList
-      value_ = reinterpret_cast<std::intptr_t>(ast->attributeList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{11};
-      break;
-    case 2:  // equalLoc
-      value_ = ast->equalLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{69};
-      break;
-    case 3:  // expression
-      value_ = reinterpret_cast<std::intptr_t>(ast->expression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{76};
-      break;
-    case 4:  // identifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->identifier);
-      slotKind_ = ASTSlotKind::kIdentifierAttribute;
-      slotNameIndex_ = SlotNameIndex{94};
-      break;
-  }  // switch
-
-  slotCount_ = 5;
-}
+constexpr ASTSlotDescriptor kAttributeUsingPrefixSlots[] = {
+    {offsetof(AttributeUsingPrefixAST, usingLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{214}},
+    {offsetof(AttributeUsingPrefixAST, attributeNamespaceLoc),
+     ASTSlotKind::kToken, ASTSlotStorage::kSourceLocation, SlotNameIndex{14}},
+    {offsetof(AttributeUsingPrefixAST, colonLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{35}},
+};
 
-void ASTSlot::visit(TypeIdAST* ast) {
-  switch (slot_) {
-    case 0:  // typeSpecifierList
-      value_ = reinterpret_cast<std::intptr_t>(ast->typeSpecifierList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{206};
-      break;
-    case 1:  // declarator
-      value_ = reinterpret_cast<std::intptr_t>(ast->declarator);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{54};
-      break;
-  }  // switch
-
-  slotCount_ = 2;
-}
+constexpr ASTSlotDescriptor kNewPlacementSlots[] = {
+    {offsetof(NewPlacementAST, lparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{127}},
+    {offsetof(NewPlacementAST, expressionList), ASTSlotKind::kNodeList,
+     ASTSlotStorage::kPointer, SlotNameIndex{77},
+     ASTKind::CharLiteralExpression, ASTKind::ParenInitializer},
+    {offsetof(NewPlacementAST, rparenLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{173}},
+};
 
-void ASTSlot::visit(HandlerAST* ast) {
-  switch (slot_) {
-    case 0:  // catchLoc
-      value_ = ast->catchLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{29};
-      break;
-    case 1:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 2:  // exceptionDeclaration
-      value_ = reinterpret_cast<std::intptr_t>(ast->exceptionDeclaration);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{70};
-      break;
-    case 3:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-    case 4:  // statement
-      value_ = reinterpret_cast<std::intptr_t>(ast->statement);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{181};
-      break;
-  }  // switch
-
-  slotCount_ = 5;
-}
+constexpr ASTSlotDescriptor kNestedNamespaceSpecifierSlots[] = {
+    {offsetof(NestedNamespaceSpecifierAST, inlineLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{104}},
+    {offsetof(NestedNamespaceSpecifierAST, identifierLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{95}},
+    {offsetof(NestedNamespaceSpecifierAST, scopeLoc), ASTSlotKind::kToken,
+     ASTSlotStorage::kSourceLocation, SlotNameIndex{174}},
+    {offsetof(NestedNamespaceSpecifierAST, identifier),
+     ASTSlotKind::kIdentifierAttribute, ASTSlotStorage::kPointer,
+     SlotNameIndex{94}},
+    {offsetof(NestedNamespaceSpecifierAST, isInline),
+     ASTSlotKind::kBoolAttribute, ASTSlotStorage::kBool, SlotNameIndex{107}},
+};
 
-void ASTSlot::visit(BaseSpecifierAST* ast) {
-  switch (slot_) {
-    case 0:  // attributeList
-      value_ = reinterpret_cast<std::intptr_t>(ast->attributeList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{11};
-      break;
-    case 1:  // nestedNameSpecifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->nestedNameSpecifier);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{138};
-      break;
-    case 2:  // templateLoc
-      value_ = ast->templateLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{192};
-      break;
-    case 3:  // unqualifiedId
-      value_ = reinterpret_cast<std::intptr_t>(ast->unqualifiedId);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{212};
-      break;
-    case 4:  // isTemplateIntroduced
-      value_ = std::intptr_t(ast->isTemplateIntroduced != 0);
-      slotKind_ = ASTSlotKind::kBoolAttribute;
-      slotNameIndex_ = SlotNameIndex{112};
-      break;
-    case 5:  // isVirtual
-      value_ = std::intptr_t(ast->isVirtual != 0);
-      slotKind_ = ASTSlotKind::kBoolAttribute;
-      slotNameIndex_ = SlotNameIndex{116};
-      break;
-    case 6:  // accessSpecifier
-      value_ = std::intptr_t(ast->accessSpecifier);
-      slotKind_ = ASTSlotKind::kIntAttribute;
-      slotNameIndex_ = SlotNameIndex{2};
-      break;
-  }  // switch
-
-  slotCount_ = 7;
-}
+constexpr std::span<const ASTSlotDescriptor> kSlots[] = {
+    kTranslationUnitSlots,
+    kModuleUnitSlots,
+    kSimpleDeclarationSlots,
+    kAsmDeclarationSlots,
+    kNamespaceAliasDefinitionSlots,
+    kUsingDeclarationSlots,
+    kUsingEnumDeclarationSlots,
+    kUsingDirectiveSlots,
+    kStaticAssertDeclarationSlots,
+    kAliasDeclarationSlots,
+    kOpaqueEnumDeclarationSlots,
+    kFunctionDefinitionSlots,
+    kTemplateDeclarationSlots,
+    kConceptDefinitionSlots,
+    kDeductionGuideSlots,
+    kExplicitInstantiationSlots,
+    kExportDeclarationSlots,
+    kExportCompoundDeclarationSlots,
+    kLinkageSpecificationSlots,
+    kNamespaceDefinitionSlots,
+    kEmptyDeclarationSlots,
+    kAttributeDeclarationSlots,
+    kModuleImportDeclarationSlots,
+    kParameterDeclarationSlots,
+    kAccessDeclarationSlots,
+    {},  // ForRangeDeclarationAST
+    kStructuredBindingDeclarationSlots,
+    kAsmOperandSlots,
+    kAsmQualifierSlots,
+    kAsmClobberSlots,
+    kAsmGotoLabelSlots,
+    kLabeledStatementSlots,
+    kCaseStatementSlots,
+    kDefaultStatementSlots,
+    kExpressionStatementSlots,
+    kCompoundStatementSlots,
+    kIfStatementSlots,
+    kConstevalIfStatementSlots,
+    kSwitchStatementSlots,
+    kWhileStatementSlots,
+    kDoStatementSlots,
+    kForRangeStatementSlots,
+    kForStatementSlots,
+    kBreakStatementSlots,
+    kContinueStatementSlots,
+    kReturnStatementSlots,
+    kCoroutineReturnStatementSlots,
+    kGotoStatementSlots,
+    kDeclarationStatementSlots,
+    kTryBlockStatementSlots,
+    kCharLiteralExpressionSlots,
+    kBoolLiteralExpressionSlots,
+    kIntLiteralExpressionSlots,
+    kFloatLiteralExpressionSlots,
+    kNullptrLiteralExpressionSlots,
+    kStringLiteralExpressionSlots,
+    kUserDefinedStringLiteralExpressionSlots,
+    kThisExpressionSlots,
+    kNestedExpressionSlots,
+    kIdExpressionSlots,
+    kLambdaExpressionSlots,
+    kFoldExpressionSlots,
+    kRightFoldExpressionSlots,
+    kLeftFoldExpressionSlots,
+    kRequiresExpressionSlots,
+    kSubscriptExpressionSlots,
+    kCallExpressionSlots,
+    kTypeConstructionSlots,
+    kBracedTypeConstructionSlots,
+    kMemberExpressionSlots,
+    kPostIncrExpressionSlots,
+    kCppCastExpressionSlots,
+    kBuiltinBitCastExpressionSlots,
+    kTypeidExpressionSlots,
+    kTypeidOfTypeExpressionSlots,
+    kUnaryExpressionSlots,
+    kAwaitExpressionSlots,
+    kSizeofExpressionSlots,
+    kSizeofTypeExpressionSlots,
+    kSizeofPackExpressionSlots,
+    kAlignofTypeExpressionSlots,
+    kAlignofExpressionSlots,
+    kNoexceptExpressionSlots,
+    kNewExpressionSlots,
+    kDeleteExpressionSlots,
+    kCastExpressionSlots,
+    kImplicitCastExpressionSlots,
+    kBinaryExpressionSlots,
+    kConditionalExpressionSlots,
+    kYieldExpressionSlots,
+    kThrowExpressionSlots,
+    kAssignmentExpressionSlots,
+    kPackExpansionExpressionSlots,
+    kDesignatedInitializerClauseSlots,
+    kTypeTraitsExpressionSlots,
+    kConditionExpressionSlots,
+    kEqualInitializerSlots,
+    kBracedInitListSlots,
+    kParenInitializerSlots,
+    kTemplateTypeParameterSlots,
+    kNonTypeTemplateParameterSlots,
+    kTypenameTypeParameterSlots,
+    kConstraintTypeParameterSlots,
+    kTypedefSpecifierSlots,
+    kFriendSpecifierSlots,
+    kConstevalSpecifierSlots,
+    kConstinitSpecifierSlots,
+    kConstexprSpecifierSlots,
+    kInlineSpecifierSlots,
+    kStaticSpecifierSlots,
+    kExternSpecifierSlots,
+    kThreadLocalSpecifierSlots,
+    kThreadSpecifierSlots,
+    kMutableSpecifierSlots,
+    kVirtualSpecifierSlots,
+    kExplicitSpecifierSlots,
+    kAutoTypeSpecifierSlots,
+    kVoidTypeSpecifierSlots,
+    kSizeTypeSpecifierSlots,
+    kSignTypeSpecifierSlots,
+    kVaListTypeSpecifierSlots,
+    kIntegralTypeSpecifierSlots,
+    kFloatingPointTypeSpecifierSlots,
+    kComplexTypeSpecifierSlots,
+    kNamedTypeSpecifierSlots,
+    kAtomicTypeSpecifierSlots,
+    kUnderlyingTypeSpecifierSlots,
+    kElaboratedTypeSpecifierSlots,
+    kDecltypeAutoSpecifierSlots,
+    kDecltypeSpecifierSlots,
+    kPlaceholderTypeSpecifierSlots,
+    kConstQualifierSlots,
+    kVolatileQualifierSlots,
+    kRestrictQualifierSlots,
+    kEnumSpecifierSlots,
+    kClassSpecifierSlots,
+    kTypenameSpecifierSlots,
+    kPointerOperatorSlots,
+    kReferenceOperatorSlots,
+    kPtrToMemberOperatorSlots,
+    kBitfieldDeclaratorSlots,
+    kParameterPackSlots,
+    kIdDeclaratorSlots,
+    kNestedDeclaratorSlots,
+    kFunctionDeclaratorChunkSlots,
+    kArrayDeclaratorChunkSlots,
+    kNameIdSlots,
+    kDestructorIdSlots,
+    kDecltypeIdSlots,
+    kOperatorFunctionIdSlots,
+    kLiteralOperatorIdSlots,
+    kConversionFunctionIdSlots,
+    kSimpleTemplateIdSlots,
+    kLiteralOperatorTemplateIdSlots,
+    kOperatorFunctionTemplateIdSlots,
+    kGlobalNestedNameSpecifierSlots,
+    kSimpleNestedNameSpecifierSlots,
+    kDecltypeNestedNameSpecifierSlots,
+    kTemplateNestedNameSpecifierSlots,
+    kDefaultFunctionBodySlots,
+    kCompoundStatementFunctionBodySlots,
+    kTryStatementFunctionBodySlots,
+    kDeleteFunctionBodySlots,
+    kTypeTemplateArgumentSlots,
+    kExpressionTemplateArgumentSlots,
+    kThrowExceptionSpecifierSlots,
+    kNoexceptSpecifierSlots,
+    kSimpleRequirementSlots,
+    kCompoundRequirementSlots,
+    kTypeRequirementSlots,
+    kNestedRequirementSlots,
+    kNewParenInitializerSlots,
+    kNewBracedInitializerSlots,
+    kParenMemInitializerSlots,
+    kBracedMemInitializerSlots,
+    kThisLambdaCaptureSlots,
+    kDerefThisLambdaCaptureSlots,
+    kSimpleLambdaCaptureSlots,
+    kRefLambdaCaptureSlots,
+    kRefInitLambdaCaptureSlots,
+    kInitLambdaCaptureSlots,
+    kEllipsisExceptionDeclarationSlots,
+    kTypeExceptionDeclarationSlots,
+    kCxxAttributeSlots,
+    kGccAttributeSlots,
+    kAlignasAttributeSlots,
+    kAlignasTypeAttributeSlots,
+    kAsmAttributeSlots,
+    kScopedAttributeTokenSlots,
+    kSimpleAttributeTokenSlots,
+    kGlobalModuleFragmentSlots,
+    kPrivateModuleFragmentSlots,
+    kModuleDeclarationSlots,
+    kModuleNameSlots,
+    kModuleQualifierSlots,
+    kModulePartitionSlots,
+    kImportNameSlots,
+    kInitDeclaratorSlots,
+    kDeclaratorSlots,
+    kUsingDeclaratorSlots,
+    kEnumeratorSlots,
+    kTypeIdSlots,
+    kHandlerSlots,
+    kBaseSpecifierSlots,
+    kRequiresClauseSlots,
+    kParameterDeclarationClauseSlots,
+    kTrailingReturnTypeSlots,
+    kLambdaSpecifierSlots,
+    kTypeConstraintSlots,
+    kAttributeArgumentClauseSlots,
+    kAttributeSlots,
+    kAttributeUsingPrefixSlots,
+    kNewPlacementSlots,
+    kNestedNamespaceSpecifierSlots,
+};
 
-void ASTSlot::visit(RequiresClauseAST* ast) {
-  switch (slot_) {
-    case 0:  // requiresLoc
-      value_ = ast->requiresLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{168};
-      break;
-    case 1:  // expression
-      value_ = reinterpret_cast<std::intptr_t>(ast->expression);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{76};
-      break;
-  }  // switch
-
-  slotCount_ = 2;
-}
+template <typename T>
+auto constructAST(void* address) -> AST* {
+  return ::new (address) T();
+}
+
+constexpr ASTLayout kLayouts[] = {
+    {sizeof(TranslationUnitAST), &constructAST<TranslationUnitAST>},
+    {sizeof(ModuleUnitAST), &constructAST<ModuleUnitAST>},
+    {sizeof(SimpleDeclarationAST), &constructAST<SimpleDeclarationAST>},
+    {sizeof(AsmDeclarationAST), &constructAST<AsmDeclarationAST>},
+    {sizeof(NamespaceAliasDefinitionAST),
+     &constructAST<NamespaceAliasDefinitionAST>},
+    {sizeof(UsingDeclarationAST), &constructAST<UsingDeclarationAST>},
+    {sizeof(UsingEnumDeclarationAST), &constructAST<UsingEnumDeclarationAST>},
+    {sizeof(UsingDirectiveAST), &constructAST<UsingDirectiveAST>},
+    {sizeof(StaticAssertDeclarationAST),
+     &constructAST<StaticAssertDeclarationAST>},
+    {sizeof(AliasDeclarationAST), &constructAST<AliasDeclarationAST>},
+    {sizeof(OpaqueEnumDeclarationAST), &constructAST<OpaqueEnumDeclarationAST>},
+    {sizeof(FunctionDefinitionAST), &constructAST<FunctionDefinitionAST>},
+    {sizeof(TemplateDeclarationAST), &constructAST<TemplateDeclarationAST>},
+    {sizeof(ConceptDefinitionAST), &constructAST<ConceptDefinitionAST>},
+    {sizeof(DeductionGuideAST), &constructAST<DeductionGuideAST>},
+    {sizeof(ExplicitInstantiationAST), &constructAST<ExplicitInstantiationAST>},
+    {sizeof(ExportDeclarationAST), &constructAST<ExportDeclarationAST>},
+    {sizeof(ExportCompoundDeclarationAST),
+     &constructAST<ExportCompoundDeclarationAST>},
+    {sizeof(LinkageSpecificationAST), &constructAST<LinkageSpecificationAST>},
+    {sizeof(NamespaceDefinitionAST), &constructAST<NamespaceDefinitionAST>},
+    {sizeof(EmptyDeclarationAST), &constructAST<EmptyDeclarationAST>},
+    {sizeof(AttributeDeclarationAST), &constructAST<AttributeDeclarationAST>},
+    {sizeof(ModuleImportDeclarationAST),
+     &constructAST<ModuleImportDeclarationAST>},
+    {sizeof(ParameterDeclarationAST), &constructAST<ParameterDeclarationAST>},
+    {sizeof(AccessDeclarationAST), &constructAST<AccessDeclarationAST>},
+    {sizeof(ForRangeDeclarationAST), &constructAST<ForRangeDeclarationAST>},
+    {sizeof(StructuredBindingDeclarationAST),
+     &constructAST<StructuredBindingDeclarationAST>},
+    {sizeof(AsmOperandAST), &constructAST<AsmOperandAST>},
+    {sizeof(AsmQualifierAST), &constructAST<AsmQualifierAST>},
+    {sizeof(AsmClobberAST), &constructAST<AsmClobberAST>},
+    {sizeof(AsmGotoLabelAST), &constructAST<AsmGotoLabelAST>},
+    {sizeof(LabeledStatementAST), &constructAST<LabeledStatementAST>},
+    {sizeof(CaseStatementAST), &constructAST<CaseStatementAST>},
+    {sizeof(DefaultStatementAST), &constructAST<DefaultStatementAST>},
+    {sizeof(ExpressionStatementAST), &constructAST<ExpressionStatementAST>},
+    {sizeof(CompoundStatementAST), &constructAST<CompoundStatementAST>},
+    {sizeof(IfStatementAST), &constructAST<IfStatementAST>},
+    {sizeof(ConstevalIfStatementAST), &constructAST<ConstevalIfStatementAST>},
+    {sizeof(SwitchStatementAST), &constructAST<SwitchStatementAST>},
+    {sizeof(WhileStatementAST), &constructAST<WhileStatementAST>},
+    {sizeof(DoStatementAST), &constructAST<DoStatementAST>},
+    {sizeof(ForRangeStatementAST), &constructAST<ForRangeStatementAST>},
+    {sizeof(ForStatementAST), &constructAST<ForStatementAST>},
+    {sizeof(BreakStatementAST), &constructAST<BreakStatementAST>},
+    {sizeof(ContinueStatementAST), &constructAST<ContinueStatementAST>},
+    {sizeof(ReturnStatementAST), &constructAST<ReturnStatementAST>},
+    {sizeof(CoroutineReturnStatementAST),
+     &constructAST<CoroutineReturnStatementAST>},
+    {sizeof(GotoStatementAST), &constructAST<GotoStatementAST>},
+    {sizeof(DeclarationStatementAST), &constructAST<DeclarationStatementAST>},
+    {sizeof(TryBlockStatementAST), &constructAST<TryBlockStatementAST>},
+    {sizeof(CharLiteralExpressionAST), &constructAST<CharLiteralExpressionAST>},
+    {sizeof(BoolLiteralExpressionAST), &constructAST<BoolLiteralExpressionAST>},
+    {sizeof(IntLiteralExpressionAST), &constructAST<IntLiteralExpressionAST>},
+    {sizeof(FloatLiteralExpressionAST),
+     &constructAST<FloatLiteralExpressionAST>},
+    {sizeof(NullptrLiteralExpressionAST),
+     &constructAST<NullptrLiteralExpressionAST>},
+    {sizeof(StringLiteralExpressionAST),
+     &constructAST<StringLiteralExpressionAST>},
+    {sizeof(UserDefinedStringLiteralExpressionAST),
+     &constructAST<UserDefinedStringLiteralExpressionAST>},
+    {sizeof(ThisExpressionAST), &constructAST<ThisExpressionAST>},
+    {sizeof(NestedExpressionAST), &constructAST<NestedExpressionAST>},
+    {sizeof(IdExpressionAST), &constructAST<IdExpressionAST>},
+    {sizeof(LambdaExpressionAST), &constructAST<LambdaExpressionAST>},
+    {sizeof(FoldExpressionAST), &constructAST<FoldExpressionAST>},
+    {sizeof(RightFoldExpressionAST), &constructAST<RightFoldExpressionAST>},
+    {sizeof(LeftFoldExpressionAST), &constructAST<LeftFoldExpressionAST>},
+    {sizeof(RequiresExpressionAST), &constructAST<RequiresExpressionAST>},
+    {sizeof(SubscriptExpressionAST), &constructAST<SubscriptExpressionAST>},
+    {sizeof(CallExpressionAST), &constructAST<CallExpressionAST>},
+    {sizeof(TypeConstructionAST), &constructAST<TypeConstructionAST>},
+    {sizeof(BracedTypeConstructionAST),
+     &constructAST<BracedTypeConstructionAST>},
+    {sizeof(MemberExpressionAST), &constructAST<MemberExpressionAST>},
+    {sizeof(PostIncrExpressionAST), &constructAST<PostIncrExpressionAST>},
+    {sizeof(CppCastExpressionAST), &constructAST<CppCastExpressionAST>},
+    {sizeof(BuiltinBitCastExpressionAST),
+     &constructAST<BuiltinBitCastExpressionAST>},
+    {sizeof(TypeidExpressionAST), &constructAST<TypeidExpressionAST>},
+    {sizeof(TypeidOfTypeExpressionAST),
+     &constructAST<TypeidOfTypeExpressionAST>},
+    {sizeof(UnaryExpressionAST), &constructAST<UnaryExpressionAST>},
+    {sizeof(AwaitExpressionAST), &constructAST<AwaitExpressionAST>},
+    {sizeof(SizeofExpressionAST), &constructAST<SizeofExpressionAST>},
+    {sizeof(SizeofTypeExpressionAST), &constructAST<SizeofTypeExpressionAST>},
+    {sizeof(SizeofPackExpressionAST), &constructAST<SizeofPackExpressionAST>},
+    {sizeof(AlignofTypeExpressionAST), &constructAST<AlignofTypeExpressionAST>},
+    {sizeof(AlignofExpressionAST), &constructAST<AlignofExpressionAST>},
+    {sizeof(NoexceptExpressionAST), &constructAST<NoexceptExpressionAST>},
+    {sizeof(NewExpressionAST), &constructAST<NewExpressionAST>},
+    {sizeof(DeleteExpressionAST), &constructAST<DeleteExpressionAST>},
+    {sizeof(CastExpressionAST), &constructAST<CastExpressionAST>},
+    {sizeof(ImplicitCastExpressionAST),
+     &constructAST<ImplicitCastExpressionAST>},
+    {sizeof(BinaryExpressionAST), &constructAST<BinaryExpressionAST>},
+    {sizeof(ConditionalExpressionAST), &constructAST<ConditionalExpressionAST>},
+    {sizeof(YieldExpressionAST), &constructAST<YieldExpressionAST>},
+    {sizeof(ThrowExpressionAST), &constructAST<ThrowExpressionAST>},
+    {sizeof(AssignmentExpressionAST), &constructAST<AssignmentExpressionAST>},
+    {sizeof(PackExpansionExpressionAST),
+     &constructAST<PackExpansionExpressionAST>},
+    {sizeof(DesignatedInitializerClauseAST),
+     &constructAST<DesignatedInitializerClauseAST>},
+    {sizeof(TypeTraitsExpressionAST), &constructAST<TypeTraitsExpressionAST>},
+    {sizeof(ConditionExpressionAST), &constructAST<ConditionExpressionAST>},
+    {sizeof(EqualInitializerAST), &constructAST<EqualInitializerAST>},
+    {sizeof(BracedInitListAST), &constructAST<BracedInitListAST>},
+    {sizeof(ParenInitializerAST), &constructAST<ParenInitializerAST>},
+    {sizeof(TemplateTypeParameterAST), &constructAST<TemplateTypeParameterAST>},
+    {sizeof(NonTypeTemplateParameterAST),
+     &constructAST<NonTypeTemplateParameterAST>},
+    {sizeof(TypenameTypeParameterAST), &constructAST<TypenameTypeParameterAST>},
+    {sizeof(ConstraintTypeParameterAST),
+     &constructAST<ConstraintTypeParameterAST>},
+    {sizeof(TypedefSpecifierAST), &constructAST<TypedefSpecifierAST>},
+    {sizeof(FriendSpecifierAST), &constructAST<FriendSpecifierAST>},
+    {sizeof(ConstevalSpecifierAST), &constructAST<ConstevalSpecifierAST>},
+    {sizeof(ConstinitSpecifierAST), &constructAST<ConstinitSpecifierAST>},
+    {sizeof(ConstexprSpecifierAST), &constructAST<ConstexprSpecifierAST>},
+    {sizeof(InlineSpecifierAST), &constructAST<InlineSpecifierAST>},
+    {sizeof(StaticSpecifierAST), &constructAST<StaticSpecifierAST>},
+    {sizeof(ExternSpecifierAST), &constructAST<ExternSpecifierAST>},
+    {sizeof(ThreadLocalSpecifierAST), &constructAST<ThreadLocalSpecifierAST>},
+    {sizeof(ThreadSpecifierAST), &constructAST<ThreadSpecifierAST>},
+    {sizeof(MutableSpecifierAST), &constructAST<MutableSpecifierAST>},
+    {sizeof(VirtualSpecifierAST), &constructAST<VirtualSpecifierAST>},
+    {sizeof(ExplicitSpecifierAST), &constructAST<ExplicitSpecifierAST>},
+    {sizeof(AutoTypeSpecifierAST), &constructAST<AutoTypeSpecifierAST>},
+    {sizeof(VoidTypeSpecifierAST), &constructAST<VoidTypeSpecifierAST>},
+    {sizeof(SizeTypeSpecifierAST), &constructAST<SizeTypeSpecifierAST>},
+    {sizeof(SignTypeSpecifierAST), &constructAST<SignTypeSpecifierAST>},
+    {sizeof(VaListTypeSpecifierAST), &constructAST<VaListTypeSpecifierAST>},
+    {sizeof(IntegralTypeSpecifierAST), &constructAST<IntegralTypeSpecifierAST>},
+    {sizeof(FloatingPointTypeSpecifierAST),
+     &constructAST<FloatingPointTypeSpecifierAST>},
+    {sizeof(ComplexTypeSpecifierAST), &constructAST<ComplexTypeSpecifierAST>},
+    {sizeof(NamedTypeSpecifierAST), &constructAST<NamedTypeSpecifierAST>},
+    {sizeof(AtomicTypeSpecifierAST), &constructAST<AtomicTypeSpecifierAST>},
+    {sizeof(UnderlyingTypeSpecifierAST),
+     &constructAST<UnderlyingTypeSpecifierAST>},
+    {sizeof(ElaboratedTypeSpecifierAST),
+     &constructAST<ElaboratedTypeSpecifierAST>},
+    {sizeof(DecltypeAutoSpecifierAST), &constructAST<DecltypeAutoSpecifierAST>},
+    {sizeof(DecltypeSpecifierAST), &constructAST<DecltypeSpecifierAST>},
+    {sizeof(PlaceholderTypeSpecifierAST),
+     &constructAST<PlaceholderTypeSpecifierAST>},
+    {sizeof(ConstQualifierAST), &constructAST<ConstQualifierAST>},
+    {sizeof(VolatileQualifierAST), &constructAST<VolatileQualifierAST>},
+    {sizeof(RestrictQualifierAST), &constructAST<RestrictQualifierAST>},
+    {sizeof(EnumSpecifierAST), &constructAST<EnumSpecifierAST>},
+    {sizeof(ClassSpecifierAST), &constructAST<ClassSpecifierAST>},
+    {sizeof(TypenameSpecifierAST), &constructAST<TypenameSpecifierAST>},
+    {sizeof(PointerOperatorAST), &constructAST<PointerOperatorAST>},
+    {sizeof(ReferenceOperatorAST), &constructAST<ReferenceOperatorAST>},
+    {sizeof(PtrToMemberOperatorAST), &constructAST<PtrToMemberOperatorAST>},
+    {sizeof(BitfieldDeclaratorAST), &constructAST<BitfieldDeclaratorAST>},
+    {sizeof(ParameterPackAST), &constructAST<ParameterPackAST>},
+    {sizeof(IdDeclaratorAST), &constructAST<IdDeclaratorAST>},
+    {sizeof(NestedDeclaratorAST), &constructAST<NestedDeclaratorAST>},
+    {sizeof(FunctionDeclaratorChunkAST),
+     &constructAST<FunctionDeclaratorChunkAST>},
+    {sizeof(ArrayDeclaratorChunkAST), &constructAST<ArrayDeclaratorChunkAST>},
+    {sizeof(NameIdAST), &constructAST<NameIdAST>},
+    {sizeof(DestructorIdAST), &constructAST<DestructorIdAST>},
+    {sizeof(DecltypeIdAST), &constructAST<DecltypeIdAST>},
+    {sizeof(OperatorFunctionIdAST), &constructAST<OperatorFunctionIdAST>},
+    {sizeof(LiteralOperatorIdAST), &constructAST<LiteralOperatorIdAST>},
+    {sizeof(ConversionFunctionIdAST), &constructAST<ConversionFunctionIdAST>},
+    {sizeof(SimpleTemplateIdAST), &constructAST<SimpleTemplateIdAST>},
+    {sizeof(LiteralOperatorTemplateIdAST),
+     &constructAST<LiteralOperatorTemplateIdAST>},
+    {sizeof(OperatorFunctionTemplateIdAST),
+     &constructAST<OperatorFunctionTemplateIdAST>},
+    {sizeof(GlobalNestedNameSpecifierAST),
+     &constructAST<GlobalNestedNameSpecifierAST>},
+    {sizeof(SimpleNestedNameSpecifierAST),
+     &constructAST<SimpleNestedNameSpecifierAST>},
+    {sizeof(DecltypeNestedNameSpecifierAST),
+     &constructAST<DecltypeNestedNameSpecifierAST>},
+    {sizeof(TemplateNestedNameSpecifierAST),
+     &constructAST<TemplateNestedNameSpecifierAST>},
+    {sizeof(DefaultFunctionBodyAST), &constructAST<DefaultFunctionBodyAST>},
+    {sizeof(CompoundStatementFunctionBodyAST),
+     &constructAST<CompoundStatementFunctionBodyAST>},
+    {sizeof(TryStatementFunctionBodyAST),
+     &constructAST<TryStatementFunctionBodyAST>},
+    {sizeof(DeleteFunctionBodyAST), &constructAST<DeleteFunctionBodyAST>},
+    {sizeof(TypeTemplateArgumentAST), &constructAST<TypeTemplateArgumentAST>},
+    {sizeof(ExpressionTemplateArgumentAST),
+     &constructAST<ExpressionTemplateArgumentAST>},
+    {sizeof(ThrowExceptionSpecifierAST),
+     &constructAST<ThrowExceptionSpecifierAST>},
+    {sizeof(NoexceptSpecifierAST), &constructAST<NoexceptSpecifierAST>},
+    {sizeof(SimpleRequirementAST), &constructAST<SimpleRequirementAST>},
+    {sizeof(CompoundRequirementAST), &constructAST<CompoundRequirementAST>},
+    {sizeof(TypeRequirementAST), &constructAST<TypeRequirementAST>},
+    {sizeof(NestedRequirementAST), &constructAST<NestedRequirementAST>},
+    {sizeof(NewParenInitializerAST), &constructAST<NewParenInitializerAST>},
+    {sizeof(NewBracedInitializerAST), &constructAST<NewBracedInitializerAST>},
+    {sizeof(ParenMemInitializerAST), &constructAST<ParenMemInitializerAST>},
+    {sizeof(BracedMemInitializerAST), &constructAST<BracedMemInitializerAST>},
+    {sizeof(ThisLambdaCaptureAST), &constructAST<ThisLambdaCaptureAST>},
+    {sizeof(DerefThisLambdaCaptureAST),
+     &constructAST<DerefThisLambdaCaptureAST>},
+    {sizeof(SimpleLambdaCaptureAST), &constructAST<SimpleLambdaCaptureAST>},
+    {sizeof(RefLambdaCaptureAST), &constructAST<RefLambdaCaptureAST>},
+    {sizeof(RefInitLambdaCaptureAST), &constructAST<RefInitLambdaCaptureAST>},
+    {sizeof(InitLambdaCaptureAST), &constructAST<InitLambdaCaptureAST>},
+    {sizeof(EllipsisExceptionDeclarationAST),
+     &constructAST<EllipsisExceptionDeclarationAST>},
+    {sizeof(TypeExceptionDeclarationAST),
+     &constructAST<TypeExceptionDeclarationAST>},
+    {sizeof(CxxAttributeAST), &constructAST<CxxAttributeAST>},
+    {sizeof(GccAttributeAST), &constructAST<GccAttributeAST>},
+    {sizeof(AlignasAttributeAST), &constructAST<AlignasAttributeAST>},
+    {sizeof(AlignasTypeAttributeAST), &constructAST<AlignasTypeAttributeAST>},
+    {sizeof(AsmAttributeAST), &constructAST<AsmAttributeAST>},
+    {sizeof(ScopedAttributeTokenAST), &constructAST<ScopedAttributeTokenAST>},
+    {sizeof(SimpleAttributeTokenAST), &constructAST<SimpleAttributeTokenAST>},
+    {sizeof(GlobalModuleFragmentAST), &constructAST<GlobalModuleFragmentAST>},
+    {sizeof(PrivateModuleFragmentAST), &constructAST<PrivateModuleFragmentAST>},
+    {sizeof(ModuleDeclarationAST), &constructAST<ModuleDeclarationAST>},
+    {sizeof(ModuleNameAST), &constructAST<ModuleNameAST>},
+    {sizeof(ModuleQualifierAST), &constructAST<ModuleQualifierAST>},
+    {sizeof(ModulePartitionAST), &constructAST<ModulePartitionAST>},
+    {sizeof(ImportNameAST), &constructAST<ImportNameAST>},
+    {sizeof(InitDeclaratorAST), &constructAST<InitDeclaratorAST>},
+    {sizeof(DeclaratorAST), &constructAST<DeclaratorAST>},
+    {sizeof(UsingDeclaratorAST), &constructAST<UsingDeclaratorAST>},
+    {sizeof(EnumeratorAST), &constructAST<EnumeratorAST>},
+    {sizeof(TypeIdAST), &constructAST<TypeIdAST>},
+    {sizeof(HandlerAST), &constructAST<HandlerAST>},
+    {sizeof(BaseSpecifierAST), &constructAST<BaseSpecifierAST>},
+    {sizeof(RequiresClauseAST), &constructAST<RequiresClauseAST>},
+    {sizeof(ParameterDeclarationClauseAST),
+     &constructAST<ParameterDeclarationClauseAST>},
+    {sizeof(TrailingReturnTypeAST), &constructAST<TrailingReturnTypeAST>},
+    {sizeof(LambdaSpecifierAST), &constructAST<LambdaSpecifierAST>},
+    {sizeof(TypeConstraintAST), &constructAST<TypeConstraintAST>},
+    {sizeof(AttributeArgumentClauseAST),
+     &constructAST<AttributeArgumentClauseAST>},
+    {sizeof(AttributeAST), &constructAST<AttributeAST>},
+    {sizeof(AttributeUsingPrefixAST), &constructAST<AttributeUsingPrefixAST>},
+    {sizeof(NewPlacementAST), &constructAST<NewPlacementAST>},
+    {sizeof(NestedNamespaceSpecifierAST),
+     &constructAST<NestedNamespaceSpecifierAST>},
+};
 
-void ASTSlot::visit(ParameterDeclarationClauseAST* ast) {
-  switch (slot_) {
-    case 0:  // parameterDeclarationList
-      value_ = reinterpret_cast<std::intptr_t>(ast->parameterDeclarationList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{151};
-      break;
-    case 1:  // commaLoc
-      value_ = ast->commaLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{36};
-      break;
-    case 2:  // ellipsisLoc
-      value_ = ast->ellipsisLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{62};
-      break;
-    case 3:  // isVariadic
-      value_ = std::intptr_t(ast->isVariadic != 0);
-      slotKind_ = ASTSlotKind::kBoolAttribute;
-      slotNameIndex_ = SlotNameIndex{115};
-      break;
-  }  // switch
-
-  slotCount_ = 4;
-}
+}  // namespace
 
-void ASTSlot::visit(TrailingReturnTypeAST* ast) {
-  switch (slot_) {
-    case 0:  // minusGreaterLoc
-      value_ = ast->minusGreaterLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{130};
-      break;
-    case 1:  // typeId
-      value_ = reinterpret_cast<std::intptr_t>(ast->typeId);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{203};
-      break;
-  }  // switch
-
-  slotCount_ = 2;
+std::string_view to_string(SlotNameIndex index) {
+  return kMemberSlotNames[int(index)];
 }
 
-void ASTSlot::visit(LambdaSpecifierAST* ast) {
-  switch (slot_) {
-    case 0:  // specifierLoc
-      value_ = ast->specifierLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{179};
-      break;
-    case 1:  // specifier
-      value_ = std::intptr_t(ast->specifier);
-      slotKind_ = ASTSlotKind::kIntAttribute;
-      slotNameIndex_ = SlotNameIndex{178};
-      break;
-  }  // switch
-
-  slotCount_ = 2;
+auto getASTSlots(ASTKind kind) -> std::span<const ASTSlotDescriptor> {
+  return kSlots[static_cast<int>(kind)];
 }
 
-void ASTSlot::visit(TypeConstraintAST* ast) {
-  switch (slot_) {
-    case 0:  // nestedNameSpecifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->nestedNameSpecifier);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{138};
-      break;
-    case 1:  // identifierLoc
-      value_ = ast->identifierLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{95};
-      break;
-    case 2:  // lessLoc
-      value_ = ast->lessLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{122};
-      break;
-    case 3:  // templateArgumentList
-      value_ = reinterpret_cast<std::intptr_t>(ast->templateArgumentList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{190};
-      break;
-    case 4:  // greaterLoc
-      value_ = ast->greaterLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{89};
-      break;
-    case 5:  // identifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->identifier);
-      slotKind_ = ASTSlotKind::kIdentifierAttribute;
-      slotNameIndex_ = SlotNameIndex{94};
-      break;
-  }  // switch
-
-  slotCount_ = 6;
+auto getASTLayout(ASTKind kind) -> const ASTLayout* {
+  const auto index = static_cast<std::size_t>(kind);
+  if (index >= std::size(kLayouts)) return nullptr;
+  return &kLayouts[index];
 }
 
-void ASTSlot::visit(AttributeArgumentClauseAST* ast) {
-  switch (slot_) {
-    case 0:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 1:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-  }  // switch
-
-  slotCount_ = 2;
-}
+auto ASTSlot::operator()(AST* ast, int slot) -> SlotInfo {
+  if (!ast) return {0, ASTSlotKind::kInvalid, SlotNameIndex{}, 0};
 
-void ASTSlot::visit(AttributeAST* ast) {
-  switch (slot_) {
-    case 0:  // attributeToken
-      value_ = reinterpret_cast<std::intptr_t>(ast->attributeToken);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{15};
-      break;
-    case 1:  // attributeArgumentClause
-      value_ = reinterpret_cast<std::intptr_t>(ast->attributeArgumentClause);
-      slotKind_ = ASTSlotKind::kNode;
-      slotNameIndex_ = SlotNameIndex{10};
-      break;
-    case 2:  // ellipsisLoc
-      value_ = ast->ellipsisLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{62};
-      break;
-  }  // switch
-
-  slotCount_ = 3;
-}
+  const auto slots = getASTSlots(ast->kind());
+  const auto slotCount = static_cast<int>(slots.size());
 
-void ASTSlot::visit(AttributeUsingPrefixAST* ast) {
-  switch (slot_) {
-    case 0:  // usingLoc
-      value_ = ast->usingLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{214};
-      break;
-    case 1:  // attributeNamespaceLoc
-      value_ = ast->attributeNamespaceLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{14};
-      break;
-    case 2:  // colonLoc
-      value_ = ast->colonLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{35};
-      break;
-  }  // switch
-
-  slotCount_ = 3;
-}
+  if (slot < 0 || slot >= slotCount) {
+    return {0, ASTSlotKind::kInvalid, SlotNameIndex{}, slotCount};
+  }
 
-void ASTSlot::visit(NewPlacementAST* ast) {
-  switch (slot_) {
-    case 0:  // lparenLoc
-      value_ = ast->lparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{127};
-      break;
-    case 1:  // expressionList
-      value_ = reinterpret_cast<std::intptr_t>(ast->expressionList);
-      slotKind_ = ASTSlotKind::kNodeList;
-      slotNameIndex_ = SlotNameIndex{77};
-      break;
-    case 2:  // rparenLoc
-      value_ = ast->rparenLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{173};
-      break;
-  }  // switch
-
-  slotCount_ = 3;
-}
+  const auto& descriptor = slots[slot];
 
-void ASTSlot::visit(NestedNamespaceSpecifierAST* ast) {
-  switch (slot_) {
-    case 0:  // inlineLoc
-      value_ = ast->inlineLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{104};
-      break;
-    case 1:  // identifierLoc
-      value_ = ast->identifierLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{95};
-      break;
-    case 2:  // scopeLoc
-      value_ = ast->scopeLoc.index();
-      slotKind_ = ASTSlotKind::kToken;
-      slotNameIndex_ = SlotNameIndex{174};
-      break;
-    case 3:  // identifier
-      value_ = reinterpret_cast<std::intptr_t>(ast->identifier);
-      slotKind_ = ASTSlotKind::kIdentifierAttribute;
-      slotNameIndex_ = SlotNameIndex{94};
-      break;
-    case 4:  // isInline
-      value_ = std::intptr_t(ast->isInline != 0);
-      slotKind_ = ASTSlotKind::kBoolAttribute;
-      slotNameIndex_ = SlotNameIndex{107};
-      break;
-  }  // switch
-
-  slotCount_ = 5;
+  return {getASTSlotValue(ast, descriptor), descriptor.kind,
+          descriptor.nameIndex, slotCount};
 }
 
 }  // namespace cxx
@@ -19,6 +19,9 @@
 // SOFTWARE.
 
 #include <cxx/control.h>
+
+// cxx
+#include <cxx/arena.h>
 #include <cxx/literals.h>
 #include <cxx/memory_layout.h>
 #include <cxx/names.h>
@@ -26,61 +29,285 @@
 #include <cxx/type_traits.h>
 #include <cxx/types.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cassert>
 #include <cstdlib>
-#include <forward_list>
-#include <set>
+#include <functional>
+#include <tuple>
+#include <unordered_map>
 #include <unordered_set>
+#include <utility>
+
+#ifndef CXX_NO_THREADS
+#include <mutex>
+#include <thread>
+#endif
 
 namespace cxx {
 
 namespace {
 
-template <typename Literal>
-struct LiteralHash {
-  auto operator()(const Literal& literal) const -> std::size_t {
-    return std::hash<std::string_view>{}(literal.value());
+void hashCombine(std::size_t& seed, std::size_t hash) {
+  seed ^= hash + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+template <typename T>
+auto hashValue(const T& value) -> std::size_t {
+  return std::hash<T>{}(value);
+}
+
+auto hashValue(std::string_view value) -> std::size_t {
+  return std::hash<std::string_view>{}(value);
+}
+
+template <typename T>
+auto hashValue(const std::vector<T>& values) -> std::size_t {
+  std::size_t seed = values.size();
+  for (const auto& value : values) hashCombine(seed, hashValue(value));
+  return seed;
+}
+
+template <typename... Args>
+auto hashValue(const std::tuple<Args...>& values) -> std::size_t {
+  std::size_t seed = 0;
+  std::apply(
+      [&](const auto&... value) {
+        (hashCombine(seed, hashValue(value)), ...);
+      },
+      values);
+  return seed;
+}
+
+// names and types are tuples of their components, literals are keyed by
+// their spelling.
+template <typename T>
+auto internKey(const T& value) -> const typename T::tuple& {
+  return value;
+}
+
+auto internKey(const Literal& literal) -> std::tuple<std::string_view> {
+  return std::tuple<std::string_view>(literal.value());
+}
+
+// The interned objects are allocated in one of kStripeCount arenas,
+// selected by the hash of their key. When Control is concurrent, each
+// arena and the matching part of every InternTable is guarded by the
+// mutex of its stripe.
+struct InternStorage {
+  static constexpr std::size_t kStripeCount = 16;
+
+  struct Stripe {
+#ifndef CXX_NO_THREADS
+    std::mutex mutex;
+#endif
+    Arena arena;
+  };
+
+  std::array<Stripe, kStripeCount> stripes;
+  bool concurrent = false;
+
+  [[nodiscard]] static auto stripeIndex(std::size_t hash) -> std::size_t {
+    // the low bits of the hash of a pointer are mostly zeros.
+    return (hash * 0x9e3779b97f4a7c15ull) >> 60;
   }
 };
 
-template <typename Literal>
-struct LiteralEqualTo {
-  auto operator()(const Literal& lhs, const Literal& rhs) const -> bool {
-    return lhs.value() == rhs.value();
+// Hash-consing of names, types and literals. The interned objects are
+// allocated together with the hash of their key, so the hash is computed
+// once per lookup and never when the table grows.
+template <typename T>
+class InternTable {
+  struct Entry {
+    std::size_t hash;
+    T value;
+
+    Entry(std::size_t hash, auto make) : hash(hash), value(make()) {}
+  };
+
+  template <typename Key>
+  struct Lookup {
+    const Key& key;
+    std::size_t hash;
+  };
+
+  struct Hash {
+    using is_transparent = void;
+
+    auto operator()(const Entry* entry) const -> std::size_t {
+      return entry->hash;
+    }
+
+    template <typename Key>
+    auto operator()(const Lookup<Key>& lookup) const -> std::size_t {
+      return lookup.hash;
+    }
+  };
+
+  struct Equal {
+    using is_transparent = void;
+
+    auto operator()(const Entry* entry, const Entry* other) const -> bool {
+      return entry == other;
+    }
+
+    template <typename Key>
+    auto operator()(const Lookup<Key>& lookup, const Entry* entry) const
+        -> bool {
+      return lookup.hash == entry->hash &&
+             internKey(entry->value) == lookup.key;
+    }
+
+    template <typename Key>
+    auto operator()(const Entry* entry, const Lookup<Key>& lookup) const
+        -> bool {
+      return (*this)(lookup, entry);
+    }
+  };
+
+  using EntrySet = std::unordered_set<Entry*, Hash, Equal>;
+
+ public:
+  InternTable(const InternTable&) = delete;
+  auto operator=(const InternTable&) -> InternTable& = delete;
+
+  explicit InternTable(InternStorage* storage) : storage_(storage) {}
+
+  ~InternTable() {
+    for (auto& entries : entries_) {
+      for (auto entry : entries) entry->~Entry();
+    }
+  }
+
+  // returns the interned object equal to key, make() creates it if needed.
+  template <typename Key>
+  auto intern(const Key& key, auto make) -> std::pair<const T*, bool> {
+    const Lookup<Key> lookup{key, hashValue(key)};
+    const auto index = InternStorage::stripeIndex(lookup.hash);
+    auto& stripe = storage_->stripes[index];
+    auto& entries = entries_[index];
+
+#ifndef CXX_NO_THREADS
+    std::unique_lock lock(stripe.mutex, std::defer_lock);
+    if (storage_->concurrent) lock.lock();
+#endif
+
+    if (auto it = entries.find(lookup); it != entries.end()) {
+      return {&(*it)->value, false};
+    }
+
+    auto entry =
+        new (stripe.arena.allocate(sizeof(Entry))) Entry(lookup.hash, make);
+
+    // literals are fully initialized before other threads can see them.
+    if constexpr (requires { entry->value.initialize(); }) {
+      entry->value.initialize();
+    }
+
+    entries.insert(entry);
+    return {&entry->value, true};
+  }
+
+  [[nodiscard]] auto size() const -> std::size_t {
+    std::size_t count = 0;
+    for (std::size_t index = 0; index < entries_.size(); ++index) {
+#ifndef CXX_NO_THREADS
+      std::unique_lock lock(storage_->stripes[index].mutex, std::defer_lock);
+      if (storage_->concurrent) lock.lock();
+#endif
+      count += entries_[index].size();
+    }
+    return count;
   }
+
+  template <typename... Args>
+  auto emplace(Args... args) -> std::pair<const T*, bool> {
+    return intern(std::tie(std::as_const(args)...),
+                  [&] { return T(std::move(args)...); });
+  }
+
+ private:
+  InternStorage* storage_;
+  std::array<EntrySet, InternStorage::kStripeCount> entries_;
 };
 
-template <typename Literal>
-using LiteralSet =
-    std::unordered_set<Literal, LiteralHash<Literal>, LiteralEqualTo<Literal>>;
+template <typename T>
+auto emplace(InternTable<T>& table, std::string_view spelling)
+    -> std::pair<const T*, bool> {
+  return table.intern(std::tuple<std::string_view>(spelling),
+                      [&] { return T(std::string(spelling)); });
+}
 
-template <typename Name>
-using NameSet = std::set<Name>;
+// the symbols created by one thread.
+struct SymbolPool {
+  Arena arena;
+  std::vector<Symbol*> symbols;
+
+  SymbolPool() = default;
+  SymbolPool(const SymbolPool&) = delete;
+  auto operator=(const SymbolPool&) -> SymbolPool& = delete;
+
+  ~SymbolPool() {
+    for (auto symbol : symbols) symbol->~Symbol();
+  }
+
+  template <typename S>
+  auto newSymbol(Scope* enclosingScope) -> S* {
+    auto symbol = new (arena.allocate(sizeof(S))) S(enclosingScope);
+    symbols.push_back(symbol);
+    return symbol;
+  }
+};
 
 }  // namespace
 
 struct Control::Private {
   explicit Private(Control* control) : traits(control) {}
 
+  template <typename S>
+  auto newSymbol(Scope* enclosingScope) -> S* {
+    return symbolPool()->newSymbol<S>(enclosingScope);
+  }
+
+  auto symbolPool() -> SymbolPool* {
+#ifndef CXX_NO_THREADS
+    if (storage.concurrent) {
+      // the pool of the current thread for the last Control it used.
+      thread_local std::pair<std::uint64_t, SymbolPool*> cachedPool;
+      if (cachedPool.first == id) return cachedPool.second;
+
+      std::scoped_lock lock(symbolPoolsMutex);
+      auto& pool = symbolPools[std::this_thread::get_id()];
+      if (!pool) pool = std::make_unique<SymbolPool>();
+      cachedPool = {id, pool.get()};
+      return pool.get();
+    }
+#endif
+    return &mainSymbolPool;
+  }
+
   TypeTraits traits;
 
+  InternStorage storage;
+
   MemoryLayout* memoryLayout = nullptr;
-  LiteralSet<IntegerLiteral> integerLiterals;
-  LiteralSet<FloatLiteral> floatLiterals;
-  LiteralSet<StringLiteral> stringLiterals;
-  LiteralSet<CharLiteral> charLiterals;
-  LiteralSet<WideStringLiteral> wideStringLiterals;
-  LiteralSet<Utf8StringLiteral> utf8StringLiterals;
-  LiteralSet<Utf16StringLiteral> utf16StringLiterals;
-  LiteralSet<Utf32StringLiteral> utf32StringLiterals;
-  LiteralSet<CommentLiteral> commentLiterals;
-
-  std::set<Identifier, std::less<>> identifiers;
-  std::set<OperatorId> operatorIds;
-  std::set<DestructorId> destructorIds;
-  std::set<LiteralOperatorId> literalOperatorIds;
-  std::set<ConversionFunctionId> conversionFunctionIds;
-  std::set<TemplateId> templateIds;
+  InternTable<IntegerLiteral> integerLiterals{&storage};
+  InternTable<FloatLiteral> floatLiterals{&storage};
+  InternTable<StringLiteral> stringLiterals{&storage};
+  InternTable<CharLiteral> charLiterals{&storage};
+  InternTable<WideStringLiteral> wideStringLiterals{&storage};
+  InternTable<Utf8StringLiteral> utf8StringLiterals{&storage};
+  InternTable<Utf16StringLiteral> utf16StringLiterals{&storage};
+  InternTable<Utf32StringLiteral> utf32StringLiterals{&storage};
+  InternTable<CommentLiteral> commentLiterals{&storage};
+
+  InternTable<Identifier> identifiers{&storage};
+  InternTable<OperatorId> operatorIds{&storage};
+  InternTable<DestructorId> destructorIds{&storage};
+  InternTable<LiteralOperatorId> literalOperatorIds{&storage};
+  InternTable<ConversionFunctionId> conversionFunctionIds{&storage};
+  InternTable<TemplateId> templateIds{&storage};
 
   VoidType voidType;
   NullptrType nullptrType;
@@ -107,49 +334,48 @@ struct Control::Private {
   LongDoubleType longDoubleType;
   ClassDescriptionType classDescriptionType;
 
-  std::set<QualType> qualTypes;
-  std::set<BoundedArrayType> boundedArrayTypes;
-  std::set<UnboundedArrayType> unboundedArrayTypes;
-  std::set<PointerType> pointerTypes;
-  std::set<LvalueReferenceType> lvalueReferenceTypes;
-  std::set<RvalueReferenceType> rvalueReferenceTypes;
-  std::set<OverloadSetType> overloadSetTypes;
-  std::set<FunctionType> functionTypes;
-  std::set<MemberObjectPointerType> memberObjectPointerTypes;
-  std::set<MemberFunctionPointerType> memberFunctionPointerTypes;
-  std::set<UnresolvedNameType> unresolvedNameTypes;
-  std::set<UnresolvedBoundedArrayType> unresolvedBoundedArrayTypes;
-  std::set<UnresolvedUnderlyingType> unresolvedUnderlyingTypes;
-  std::set<ClassType> classTypes;
-  std::set<UnionType> unionTypes;
-  std::set<NamespaceType> namespaceTypes;
-  std::set<EnumType> enumTypes;
-  std::set<ScopedEnumType> scopedEnumTypes;
-
-  std::forward_list<NamespaceSymbol> namespaceSymbols;
-  std::forward_list<ConceptSymbol> conceptSymbols;
-  std::forward_list<ClassSymbol> classSymbols;
-  std::forward_list<UnionSymbol> unionSymbols;
-  std::forward_list<EnumSymbol> enumSymbols;
-  std::forward_list<ScopedEnumSymbol> scopedEnumSymbols;
-  std::forward_list<OverloadSetSymbol> overloadSetSymbols;
-  std::forward_list<FunctionSymbol> functionSymbols;
-  std::forward_list<LambdaSymbol> lambdaSymbols;
-  std::forward_list<FunctionParametersSymbol> functionParametersSymbol;
-  std::forward_list<TemplateParametersSymbol> templateParametersSymbol;
-  std::forward_list<BlockSymbol> blockSymbols;
-  std::forward_list<TypeAliasSymbol> typeAliasSymbols;
-  std::forward_list<VariableSymbol> variableSymbols;
-  std::forward_list<FieldSymbol> fieldSymbols;
-  std::forward_list<ParameterSymbol> parameterSymbols;
-  std::forward_list<TypeParameterSymbol> typeParameterSymbols;
-  std::forward_list<NonTypeParameterSymbol> nonTypeParameterSymbols;
-  std::forward_list<TemplateTypeParameterSymbol> templateTypeParameterSymbols;
-  std::forward_list<ConstraintTypeParameterSymbol>
-      constraintTypeParameterSymbols;
-  std::forward_list<EnumeratorSymbol> enumeratorSymbols;
-
-  int anonymousIdCount = 0;
+  InternTable<QualType> qualTypes{&storage};
+  InternTable<BoundedArrayType> boundedArrayTypes{&storage};
+  InternTable<UnboundedArrayType> unboundedArrayTypes{&storage};
+  InternTable<PointerType> pointerTypes{&storage};
+  InternTable<LvalueReferenceType> lvalueReferenceTypes{&storage};
+  InternTable<RvalueReferenceType> rvalueReferenceTypes{&storage};
+  InternTable<OverloadSetType> overloadSetTypes{&storage};
+  InternTable<FunctionType> functionTypes{&storage};
+  InternTable<MemberObjectPointerType> memberObjectPointerTypes{&storage};
+  InternTable<MemberFunctionPointerType> memberFunctionPointerTypes{&storage};
+  InternTable<UnresolvedNameType> unresolvedNameTypes{&storage};
+  InternTable<UnresolvedBoundedArrayType> unresolvedBoundedArrayTypes{&storage};
+  InternTable<UnresolvedUnderlyingType> unresolvedUnderlyingTypes{&storage};
+  InternTable<ClassType> classTypes{&storage};
+  InternTable<UnionType> unionTypes{&storage};
+  InternTable<NamespaceType> namespaceTypes{&storage};
+  InternTable<EnumType> enumTypes{&storage};
+  InternTable<ScopedEnumType> scopedEnumTypes{&storage};
+
+  // the symbol pools are declared after the interning tables, so the
+  // symbols are destroyed before the names and types they refer to.
+  SymbolPool mainSymbolPool;
+#ifndef CXX_NO_THREADS
+  std::mutex symbolPoolsMutex;
+  std::unordered_map<std::thread::id, std::unique_ptr<SymbolPool>> symbolPools;
+#endif
+
+  // identifies this Control in the thread local symbol pool caches.
+  std::uint64_t id = nextId++;
+  inline static std::atomic<std::uint64_t> nextId = 1;
+
+  std::atomic<int> anonymousIdCount = 0;
+  std::atomic<std::size_t> astReferenceCount = 0;
+
+  // counts the interned objects created with a reference to an AST node.
+  template <typename T>
+  auto referenceAST(std::pair<const T*, bool> result) -> const T* {
+    if (result.second) {
+      astReferenceCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    return result.first;
+  }
 };
 
 Control::Control() : d(std::make_unique<Private>(this)) {}
@@ -158,52 +384,44 @@ Control::~Control() = default;
 
 auto Control::integerLiteral(std::string_view spelling)
     -> const IntegerLiteral* {
-  auto [it, inserted] = d->integerLiterals.emplace(std::string(spelling));
-  if (inserted) it->initialize();
-  return &*it;
+  return emplace(d->integerLiterals, spelling).first;
 }
 
 auto Control::floatLiteral(std::string_view spelling) -> const FloatLiteral* {
-  auto [it, inserted] = d->floatLiterals.emplace(std::string(spelling));
-  if (inserted) it->initialize();
-  return &*it;
+  return emplace(d->floatLiterals, spelling).first;
 }
 
 auto Control::stringLiteral(std::string_view spelling) -> const StringLiteral* {
-  auto [it, inserted] = d->stringLiterals.emplace(std::string(spelling));
-  if (inserted) it->initialize();
-  return &*it;
+  return emplace(d->stringLiterals, spelling).first;
 }
 
 auto Control::charLiteral(std::string_view spelling) -> const CharLiteral* {
-  auto [it, inserted] = d->charLiterals.emplace(std::string(spelling));
-  if (inserted) it->initialize();
-  return &*it;
+  return emplace(d->charLiterals, spelling).first;
 }
 
 auto Control::wideStringLiteral(std::string_view spelling)
     -> const WideStringLiteral* {
-  return &*d->wideStringLiterals.emplace(std::string(spelling)).first;
+  return emplace(d->wideStringLiterals, spelling).first;
 }
 
 auto Control::utf8StringLiteral(std::string_view spelling)
     -> const Utf8StringLiteral* {
-  return &*d->utf8StringLiterals.emplace(std::string(spelling)).first;
+  return emplace(d->utf8StringLiterals, spelling).first;
 }
 
 auto Control::utf16StringLiteral(std::string_view spelling)
     -> const Utf16StringLiteral* {
-  return &*d->utf16StringLiterals.emplace(std::string(spelling)).first;
+  return emplace(d->utf16StringLiterals, spelling).first;
 }
 
 auto Control::utf32StringLiteral(std::string_view spelling)
     -> const Utf32StringLiteral* {
-  return &*d->utf32StringLiterals.emplace(std::string(spelling)).first;
+  return emplace(d->utf32StringLiterals, spelling).first;
 }
 
 auto Control::commentLiteral(std::string_view spelling)
     -> const CommentLiteral* {
-  return &*d->commentLiterals.emplace(std::string(spelling)).first;
+  return emplace(d->commentLiterals, spelling).first;
 }
 
 auto Control::memoryLayout() const -> MemoryLayout* { return d->memoryLayout; }
@@ -212,6 +430,67 @@ void Control::setMemoryLayout(MemoryLayout* memoryLayout) {
   d->memoryLayout = memoryLayout;
 }
 
+auto Control::concurrent() const -> bool { return d->storage.concurrent; }
+
+void Control::setConcurrent(bool concurrent) {
+#ifndef CXX_NO_THREADS
+  d->storage.concurrent = concurrent;
+#endif
+}
+
+auto Control::astReferenceCount() const -> std::size_t {
+  return d->astReferenceCount.load(std::memory_order_relaxed);
+}
+
+auto Control::stats() const -> ControlStats {
+  ControlStats stats;
+
+  auto count = [](const auto&... tables) {
+    return (tables.size() + ...);
+  };
+
+  stats.names = count(d->identifiers, d->operatorIds, d->destructorIds,
+                      d->literalOperatorIds, d->conversionFunctionIds,
+                      d->templateIds);
+
+  stats.types =
+      count(d->qualTypes, d->boundedArrayTypes, d->unboundedArrayTypes,
+            d->pointerTypes, d->lvalueReferenceTypes, d->rvalueReferenceTypes,
+            d->overloadSetTypes, d->functionTypes, d->memberObjectPointerTypes,
+            d->memberFunctionPointerTypes, d->unresolvedNameTypes,
+            d->unresolvedBoundedArrayTypes, d->unresolvedUnderlyingTypes,
+            d->classTypes, d->unionTypes, d->namespaceTypes, d->enumTypes,
+            d->scopedEnumTypes);
+
+  stats.literals =
+      count(d->integerLiterals, d->floatLiterals, d->stringLiterals,
+            d->charLiterals, d->wideStringLiterals, d->utf8StringLiterals,
+            d->utf16StringLiterals, d->utf32StringLiterals,
+            d->commentLiterals);
+
+  for (auto& stripe : d->storage.stripes) {
+#ifndef CXX_NO_THREADS
+    std::unique_lock lock(stripe.mutex, std::defer_lock);
+    if (d->storage.concurrent) lock.lock();
+#endif
+    stats.bytes += stripe.arena.bytesAllocated();
+  }
+
+  auto addPool = [&](const SymbolPool& pool) {
+    stats.symbols += pool.symbols.size();
+    stats.bytes += pool.arena.bytesAllocated();
+  };
+
+  addPool(d->mainSymbolPool);
+
+#ifndef CXX_NO_THREADS
+  std::scoped_lock lock(d->symbolPoolsMutex);
+  for (const auto& [thread, pool] : d->symbolPools) addPool(*pool);
+#endif
+
+  return stats;
+}
+
 auto Control::newAnonymousId(std::string_view base) -> const Identifier* {
   auto id = std::string("$") + std::string(base) +
             std::to_string(++d->anonymousIdCount);
@@ -219,33 +498,38 @@ auto Control::newAnonymousId(std::string_view base) -> const Identifier* {
 }
 
 auto Control::getIdentifier(std::string_view name) -> const Identifier* {
-  if (auto it = d->identifiers.find(name); it != d->identifiers.end())
-    return &*it;
-  return &*d->identifiers.emplace(std::string(name)).first;
+  return emplace(d->identifiers, name).first;
 }
 
 auto Control::getOperatorId(TokenKind op) -> const OperatorId* {
-  return &*d->operatorIds.emplace(op).first;
+  return d->operatorIds.emplace(op).first;
 }
 
 auto Control::getDestructorId(const Name* name) -> const DestructorId* {
-  return &*d->destructorIds.emplace(name).first;
+  return d->destructorIds.emplace(name).first;
 }
 
 auto Control::getLiteralOperatorId(std::string_view name)
     -> const LiteralOperatorId* {
-  return &*d->literalOperatorIds.emplace(std::string(name)).first;
+  return emplace(d->literalOperatorIds, name).first;
 }
 
 auto Control::getConversionFunctionId(const Type* type)
     -> const ConversionFunctionId* {
-  return &*d->conversionFunctionIds.emplace(type).first;
+  return d->conversionFunctionIds.emplace(type).first;
 }
 
 auto Control::getTemplateId(const Name* name,
                             std::vector<TemplateArgument> arguments)
     -> const TemplateId* {
-  return &*d->templateIds.emplace(name, std::move(arguments)).first;
+  const auto refersToAST =
+      std::ranges::any_of(arguments, [](const TemplateArgument& argument) {
+        return std::holds_alternative<ExpressionAST*>(argument);
+      });
+
+  auto result = d->templateIds.emplace(name, std::move(arguments));
+  if (refersToAST) return d->referenceAST(result);
+  return result.first;
 }
 
 auto Control::getSizeType() -> const Type* {
@@ -327,7 +611,7 @@ auto Control::getClassDescriptionType() -> const ClassDescriptionType* {
 
 auto Control::getQualType(const Type* elementType, CvQualifiers cvQualifiers)
     -> const QualType* {
-  return &*d->qualTypes.emplace(elementType, cvQualifiers).first;
+  return d->qualTypes.emplace(elementType, cvQualifiers).first;
 }
 
 auto Control::getConstType(const Type* elementType) -> const QualType* {
@@ -344,31 +628,31 @@ auto Control::getConstVolatileType(const Type* elementType) -> const QualType* {
 
 auto Control::getBoundedArrayType(const Type* elementType, std::size_t size)
     -> const BoundedArrayType* {
-  return &*d->boundedArrayTypes.emplace(elementType, size).first;
+  return d->boundedArrayTypes.emplace(elementType, size).first;
 }
 
 auto Control::getUnboundedArrayType(const Type* elementType)
     -> const UnboundedArrayType* {
-  return &*d->unboundedArrayTypes.emplace(elementType).first;
+  return d->unboundedArrayTypes.emplace(elementType).first;
 }
 
 auto Control::getPointerType(const Type* elementType) -> const PointerType* {
-  return &*d->pointerTypes.emplace(elementType).first;
+  return d->pointerTypes.emplace(elementType).first;
 }
 
 auto Control::getLvalueReferenceType(const Type* elementType)
     -> const LvalueReferenceType* {
-  return &*d->lvalueReferenceTypes.emplace(elementType).first;
+  return d->lvalueReferenceTypes.emplace(elementType).first;
 }
 
 auto Control::getRvalueReferenceType(const Type* elementType)
     -> const RvalueReferenceType* {
-  return &*d->rvalueReferenceTypes.emplace(elementType).first;
+  return d->rvalueReferenceTypes.emplace(elementType).first;
 }
 
 auto Control::getOverloadSetType(OverloadSetSymbol* symbol)
     -> const OverloadSetType* {
-  return &*d->overloadSetTypes.emplace(symbol).first;
+  return d->overloadSetTypes.emplace(symbol).first;
 }
 
 auto Control::getFunctionType(const Type* returnType,
@@ -376,7 +660,7 @@ auto Control::getFunctionType(const Type* returnType,
                               bool isVariadic, CvQualifiers cvQualifiers,
                               RefQualifier refQualifier, bool isNoexcept)
     -> const FunctionType* {
-  return &*d->functionTypes
+  return d->functionTypes
                .emplace(returnType, std::move(parameterTypes), isVariadic,
                         cvQualifiers, refQualifier, isNoexcept)
                .first;
@@ -385,177 +669,174 @@ auto Control::getFunctionType(const Type* returnType,
 auto Control::getMemberObjectPointerType(const ClassType* classType,
                                          const Type* elementType)
     -> const MemberObjectPointerType* {
-  return &*d->memberObjectPointerTypes.emplace(classType, elementType).first;
+  return d->memberObjectPointerTypes.emplace(classType, elementType).first;
 }
 
 auto Control::getMemberFunctionPointerType(const ClassType* classType,
                                            const FunctionType* functionType)
     -> const MemberFunctionPointerType* {
-  return &*d->memberFunctionPointerTypes.emplace(classType, functionType).first;
+  return d->memberFunctionPointerTypes.emplace(classType, functionType).first;
 }
 
 auto Control::getUnresolvedNameType(TranslationUnit* unit,
                                     NestedNameSpecifierAST* nestedNameSpecifier,
                                     UnqualifiedIdAST* unqualifiedId)
     -> const UnresolvedNameType* {
-  return &*d->unresolvedNameTypes
-               .emplace(unit, nestedNameSpecifier, unqualifiedId)
-               .first;
+  return d->referenceAST(
+      d->unresolvedNameTypes.emplace(unit, nestedNameSpecifier, unqualifiedId));
 }
 
 auto Control::getUnresolvedBoundedArrayType(TranslationUnit* unit,
                                             const Type* elementType,
                                             ExpressionAST* sizeExpression)
     -> const UnresolvedBoundedArrayType* {
-  return &*d->unresolvedBoundedArrayTypes
-               .emplace(unit, elementType, sizeExpression)
-               .first;
+  return d->referenceAST(d->unresolvedBoundedArrayTypes.emplace(
+      unit, elementType, sizeExpression));
 }
 
 auto Control::getUnresolvedUnderlyingType(TranslationUnit* unit,
                                           TypeIdAST* typeId)
     -> const UnresolvedUnderlyingType* {
-  return &*d->unresolvedUnderlyingTypes.emplace(unit, typeId).first;
+  return d->referenceAST(d->unresolvedUnderlyingTypes.emplace(unit, typeId));
 }
 
 auto Control::getClassType(ClassSymbol* symbol) -> const ClassType* {
-  return &*d->classTypes.emplace(symbol).first;
+  return d->classTypes.emplace(symbol).first;
 }
 
 auto Control::getUnionType(UnionSymbol* symbol) -> const UnionType* {
-  return &*d->unionTypes.emplace(symbol).first;
+  return d->unionTypes.emplace(symbol).first;
 }
 
 auto Control::getNamespaceType(NamespaceSymbol* symbol)
     -> const NamespaceType* {
-  return &*d->namespaceTypes.emplace(symbol).first;
+  return d->namespaceTypes.emplace(symbol).first;
 }
 
 auto Control::getEnumType(EnumSymbol* symbol) -> const EnumType* {
-  return &*d->enumTypes.emplace(symbol).first;
+  return d->enumTypes.emplace(symbol).first;
 }
 
 auto Control::getScopedEnumType(ScopedEnumSymbol* symbol)
     -> const ScopedEnumType* {
-  return &*d->scopedEnumTypes.emplace(symbol).first;
+  return d->scopedEnumTypes.emplace(symbol).first;
 }
 
 auto Control::newNamespaceSymbol(Scope* enclosingScope) -> NamespaceSymbol* {
-  auto symbol = &d->namespaceSymbols.emplace_front(enclosingScope);
+  auto symbol = d->newSymbol<NamespaceSymbol>(enclosingScope);
   symbol->setType(getNamespaceType(symbol));
   return symbol;
 }
 
 auto Control::newConceptSymbol(Scope* enclosingScope) -> ConceptSymbol* {
-  auto symbol = &d->conceptSymbols.emplace_front(enclosingScope);
+  auto symbol = d->newSymbol<ConceptSymbol>(enclosingScope);
   return symbol;
 }
 
 auto Control::newClassSymbol(Scope* enclosingScope) -> ClassSymbol* {
-  auto symbol = &d->classSymbols.emplace_front(enclosingScope);
+  auto symbol = d->newSymbol<ClassSymbol>(enclosingScope);
   symbol->setType(getClassType(symbol));
   return symbol;
 }
 
 auto Control::newUnionSymbol(Scope* enclosingScope) -> UnionSymbol* {
-  auto symbol = &d->unionSymbols.emplace_front(enclosingScope);
+  auto symbol = d->newSymbol<UnionSymbol>(enclosingScope);
   symbol->setType(getUnionType(symbol));
   return symbol;
 }
 
 auto Control::newEnumSymbol(Scope* enclosingScope) -> EnumSymbol* {
-  auto symbol = &d->enumSymbols.emplace_front(enclosingScope);
+  auto symbol = d->newSymbol<EnumSymbol>(enclosingScope);
   symbol->setType(getEnumType(symbol));
   return symbol;
 }
 
 auto Control::newScopedEnumSymbol(Scope* enclosingScope) -> ScopedEnumSymbol* {
-  auto symbol = &d->scopedEnumSymbols.emplace_front(enclosingScope);
+  auto symbol = d->newSymbol<ScopedEnumSymbol>(enclosingScope);
   symbol->setType(getScopedEnumType(symbol));
   return symbol;
 }
 
 auto Control::newOverloadSetSymbol(Scope* enclosingScope)
     -> OverloadSetSymbol* {
-  auto symbol = &d->overloadSetSymbols.emplace_front(enclosingScope);
+  auto symbol = d->newSymbol<OverloadSetSymbol>(enclosingScope);
   symbol->setType(getOverloadSetType(symbol));
   return symbol;
 }
 
 auto Control::newFunctionSymbol(Scope* enclosingScope) -> FunctionSymbol* {
-  auto symbol = &d->functionSymbols.emplace_front(enclosingScope);
+  auto symbol = d->newSymbol<FunctionSymbol>(enclosingScope);
   return symbol;
 }
 
 auto Control::newLambdaSymbol(Scope* enclosingScope) -> LambdaSymbol* {
-  auto symbol = &d->lambdaSymbols.emplace_front(enclosingScope);
+  auto symbol = d->newSymbol<LambdaSymbol>(enclosingScope);
   return symbol;
 }
 
 auto Control::newFunctionParametersSymbol(Scope* enclosingScope)
     -> FunctionParametersSymbol* {
-  auto symbol = &d->functionParametersSymbol.emplace_front(enclosingScope);
+  auto symbol = d->newSymbol<FunctionParametersSymbol>(enclosingScope);
   return symbol;
 }
 
 auto Control::newTemplateParametersSymbol(Scope* enclosingScope)
     -> TemplateParametersSymbol* {
-  auto symbol = &d->templateParametersSymbol.emplace_front(enclosingScope);
+  auto symbol = d->newSymbol<TemplateParametersSymbol>(enclosingScope);
   return symbol;
 }
 
 auto Control::newBlockSymbol(Scope* enclosingScope) -> BlockSymbol* {
-  auto symbol = &d->blockSymbols.emplace_front(enclosingScope);
+  auto symbol = d->newSymbol<BlockSymbol>(enclosingScope);
   return symbol;
 }
 
 auto Control::newTypeAliasSymbol(Scope* enclosingScope) -> TypeAliasSymbol* {
-  auto symbol = &d->typeAliasSymbols.emplace_front(enclosingScope);
+  auto symbol = d->newSymbol<TypeAliasSymbol>(enclosingScope);
   return symbol;
 }
 
 auto Control::newVariableSymbol(Scope* enclosingScope) -> VariableSymbol* {
-  auto symbol = &d->variableSymbols.emplace_front(enclosingScope);
+  auto symbol = d->newSymbol<VariableSymbol>(enclosingScope);
   return symbol;
 }
 
 auto Control::newFieldSymbol(Scope* enclosingScope) -> FieldSymbol* {
-  auto symbol = &d->fieldSymbols.emplace_front(enclosingScope);
+  auto symbol = d->newSymbol<FieldSymbol>(enclosingScope);
   return symbol;
 }
 
 auto Control::newParameterSymbol(Scope* enclosingScope) -> ParameterSymbol* {
-  auto symbol = &d->parameterSymbols.emplace_front(enclosingScope);
+  auto symbol = d->newSymbol<ParameterSymbol>(enclosingScope);
   return symbol;
 }
 
 auto Control::newTypeParameterSymbol(Scope* enclosingScope)
     -> TypeParameterSymbol* {
-  auto symbol = &d->typeParameterSymbols.emplace_front(enclosingScope);
+  auto symbol = d->newSymbol<TypeParameterSymbol>(enclosingScope);
   return symbol;
 }
 
 auto Control::newNonTypeParameterSymbol(Scope* enclosingScope)
     -> NonTypeParameterSymbol* {
-  auto symbol = &d->nonTypeParameterSymbols.emplace_front(enclosingScope);
+  auto symbol = d->newSymbol<NonTypeParameterSymbol>(enclosingScope);
   return symbol;
 }
 
 auto Control::newTemplateTypeParameterSymbol(Scope* enclosingScope)
     -> TemplateTypeParameterSymbol* {
-  auto symbol = &d->templateTypeParameterSymbols.emplace_front(enclosingScope);
+  auto symbol = d->newSymbol<TemplateTypeParameterSymbol>(enclosingScope);
   return symbol;
 }
 
 auto Control::newConstraintTypeParameterSymbol(Scope* enclosingScope)
     -> ConstraintTypeParameterSymbol* {
-  auto symbol =
-      &d->constraintTypeParameterSymbols.emplace_front(enclosingScope);
+  auto symbol = d->newSymbol<ConstraintTypeParameterSymbol>(enclosingScope);
   return symbol;
 }
 
 auto Control::newEnumeratorSymbol(Scope* enclosingScope) -> EnumeratorSymbol* {
-  auto symbol = &d->enumeratorSymbols.emplace_front(enclosingScope);
+  auto symbol = d->newSymbol<EnumeratorSymbol>(enclosingScope);
   return symbol;
 }
 
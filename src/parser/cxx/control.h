@@ -26,6 +26,7 @@
 #include <cxx/token_fwd.h>
 #include <cxx/types_fwd.h>
 
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -35,6 +36,16 @@ namespace cxx {
 
 class MemoryLayout;
 
+// the objects owned by a Control, see Control::stats().
+struct ControlStats {
+  std::size_t names = 0;
+  std::size_t types = 0;
+  std::size_t literals = 0;
+  std::size_t symbols = 0;
+  // the bytes allocated for the interned objects and the symbols.
+  std::size_t bytes = 0;
+};
+
 class Control {
  public:
   Control();
@@ -43,6 +54,18 @@ class Control {
   [[nodiscard]] auto memoryLayout() const -> MemoryLayout*;
   void setMemoryLayout(MemoryLayout* memoryLayout);
 
+  // when concurrent, names, types, literals and symbols can be created
+  // from multiple threads. It must be set before sharing the Control.
+  [[nodiscard]] auto concurrent() const -> bool;
+  void setConcurrent(bool concurrent);
+
+  [[nodiscard]] auto stats() const -> ControlStats;
+
+  // the number of interned names and types created with a reference to an
+  // AST node, e.g. the unresolved types. The parser must not release the
+  // nodes allocated since it last read the count if the count changed.
+  [[nodiscard]] auto astReferenceCount() const -> std::size_t;
+
   auto integerLiteral(std::string_view spelling) -> const IntegerLiteral*;
   auto floatLiteral(std::string_view spelling) -> const FloatLiteral*;
   auto stringLiteral(std::string_view spelling) -> const StringLiteral*;
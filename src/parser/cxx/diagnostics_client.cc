@@ -30,6 +30,8 @@
 
 namespace cxx {
 
+DiagnosticsClient::DiagnosticsClient() : output_(&std::cerr) {}
+
 DiagnosticsClient::~DiagnosticsClient() = default;
 
 void DiagnosticsClient::report(const Diagnostic& diag) {
@@ -57,7 +59,7 @@ void DiagnosticsClient::report(const Diagnostic& diag) {
   preprocessor_->getTokenStartPosition(diag.token(), &line, &column, &fileName);
 
   if (!fileName.empty()) {
-    fmt::print(std::cerr, "{}:{}:{}: {}\n", fileName, line, column,
+    fmt::print(*output_, "{}:{}:{}: {}\n", fileName, line, column,
                diag.message());
 
     const auto textLine = preprocessor_->getTextLine(diag.token());
@@ -70,9 +72,9 @@ void DiagnosticsClient::report(const Diagnostic& diag) {
       if (!std::isspace(ch)) ch = ' ';
     }
 
-    fmt::print(std::cerr, "{0}\n{1}^\n", textLine, indent);
+    fmt::print(*output_, "{0}\n{1}^\n", textLine, indent);
   } else {
-    fmt::print(std::cerr, "{}\n", diag.message());
+    fmt::print(*output_, "{}\n", diag.message());
   }
 
   if (diag.severity() == Severity::Fatal ||
@@ -22,6 +22,8 @@
 
 #include <cxx/diagnostic.h>
 
+#include <iosfwd>
+
 namespace cxx {
 
 class Preprocessor;
@@ -31,7 +33,7 @@ class DiagnosticsClient {
   DiagnosticsClient(const DiagnosticsClient&) = delete;
   auto operator=(const DiagnosticsClient&) -> DiagnosticsClient& = delete;
 
-  DiagnosticsClient() = default;
+  DiagnosticsClient();
 
   virtual ~DiagnosticsClient();
 
@@ -45,6 +47,9 @@ class DiagnosticsClient {
     preprocessor_ = preprocessor;
   }
 
+  [[nodiscard]] auto output() const -> std::ostream& { return *output_; }
+  void setOutput(std::ostream& output) { output_ = &output; }
+
   [[nodiscard]] auto fatalErrors() const -> bool { return fatalErrors_; }
   void setFatalErrors(bool fatalErrors) { fatalErrors_ = fatalErrors; }
 
@@ -63,6 +68,7 @@ class DiagnosticsClient {
 
  private:
   Preprocessor* preprocessor_ = nullptr;
+  std::ostream* output_;
   bool blockErrors_ = false;
   bool fatalErrors_ = false;
 };
@@ -0,0 +1,181 @@
+// Copyright (c) 2023 Roberto Raggi <roberto.raggi@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cxx/flat_ast.h>
+
+// cxx
+#include <cxx/ast.h>
+#include <cxx/literals.h>
+#include <cxx/names.h>
+#include <cxx/translation_unit.h>
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace cxx {
+
+auto FlatASTWriter::operator()(AST* root) -> std::vector<std::uint32_t> {
+  data_.assign(FlatAST::kHeaderSize, 0);
+  recordCount_ = 0;
+  firstToken_ = FlatAST::kNone;
+  lastToken_ = 0;
+  stringIds_.clear();
+  strings_.clear();
+
+  if (root) writeNode(root, FlatAST::kNone, FlatAST::kNone);
+
+  data_[FlatAST::kVersionWord] = FlatAST::kVersion;
+  data_[FlatAST::kRecordCount] = recordCount_;
+  data_[FlatAST::kStringCount] = static_cast<std::uint32_t>(strings_.size());
+  data_[FlatAST::kStringTable] = static_cast<std::uint32_t>(data_.size());
+
+  writeStringTable();
+
+  return std::move(data_);
+}
+
+void FlatASTWriter::writeNode(AST* ast, std::uint32_t parent,
+                              std::uint32_t slotName) {
+  const auto index = writeRecord(ASTSlotKind::kNode,
+                                 static_cast<std::uint32_t>(ast->kind()),
+                                 parent, slotName, 0);
+
+  if constexpr (sizeof(ast) == sizeof(std::uint32_t)) {
+    data_[FlatAST::kHeaderSize + index * FlatAST::kRecordSize +
+          FlatAST::kHandle] = static_cast<std::uint32_t>(
+        reinterpret_cast<std::uintptr_t>(ast));
+  }
+
+  const auto enclosingTokens = std::pair(firstToken_, lastToken_);
+  firstToken_ = FlatAST::kNone;
+  lastToken_ = 0;
+
+  for (const auto& slot : getASTSlots(ast->kind())) {
+    const auto value = getASTSlotValue(ast, slot);
+    const auto name = static_cast<std::uint32_t>(slot.nameIndex);
+
+    switch (slot.kind) {
+      case ASTSlotKind::kToken:
+        writeToken(static_cast<std::uint32_t>(value), index, name);
+        break;
+
+      case ASTSlotKind::kNode:
+        if (auto child = reinterpret_cast<AST*>(value)) {
+          writeNode(child, index, name);
+        }
+        break;
+
+      case ASTSlotKind::kNodeList:
+        for (auto it = reinterpret_cast<List<AST*>*>(value); it;
+             it = it->next) {
+          if (it->value) writeNode(it->value, index, name);
+        }
+        break;
+
+      case ASTSlotKind::kIdentifierAttribute:
+        if (auto id = reinterpret_cast<const Identifier*>(value)) {
+          writeRecord(slot.kind, 0, index, name, stringId(id, id->name()));
+        }
+        break;
+
+      case ASTSlotKind::kLiteralAttribute:
+        if (auto literal = reinterpret_cast<const Literal*>(value)) {
+          writeRecord(slot.kind, 0, index, name,
+                      stringId(literal, literal->value()));
+        }
+        break;
+
+      case ASTSlotKind::kBoolAttribute:
+      case ASTSlotKind::kIntAttribute:
+        writeRecord(slot.kind, 0, index, name,
+                    static_cast<std::uint32_t>(value));
+        break;
+
+      default:
+        break;
+    }  // switch
+  }
+
+  auto record = &data_[FlatAST::kHeaderSize + index * FlatAST::kRecordSize];
+  record[FlatAST::kValue] = recordCount_;
+
+  if (firstToken_ != FlatAST::kNone) {
+    record[FlatAST::kFirstToken] = firstToken_;
+    record[FlatAST::kLastToken] = lastToken_;
+  }
+
+  firstToken_ = std::min(firstToken_, enclosingTokens.first);
+  lastToken_ = std::max(lastToken_, enclosingTokens.second);
+}
+
+auto FlatASTWriter::writeRecord(ASTSlotKind slotKind, std::uint32_t kind,
+                                std::uint32_t parent, std::uint32_t slotName,
+                                std::uint32_t value) -> std::uint32_t {
+  const auto record = data_.size();
+  data_.resize(record + FlatAST::kRecordSize);
+  data_[record + FlatAST::kSlotKind] = slotKind;
+  data_[record + FlatAST::kKind] = kind;
+  data_[record + FlatAST::kParent] = parent;
+  data_[record + FlatAST::kSlotName] = slotName;
+  data_[record + FlatAST::kValue] = value;
+  return recordCount_++;
+}
+
+void FlatASTWriter::writeToken(std::uint32_t index, std::uint32_t parent,
+                               std::uint32_t slotName) {
+  const SourceLocation loc(index);
+  if (!loc) return;
+
+  writeRecord(ASTSlotKind::kToken,
+              static_cast<std::uint32_t>(unit_->tokenKind(loc)), parent,
+              slotName, index);
+
+  firstToken_ = std::min(firstToken_, index);
+  lastToken_ = std::max(lastToken_, index + 1);
+}
+
+auto FlatASTWriter::stringId(const void* key, std::string_view text)
+    -> std::uint32_t {
+  auto [it, inserted] = stringIds_.emplace(
+      key, static_cast<std::uint32_t>(strings_.size()));
+  if (inserted) strings_.push_back(text);
+  return it->second;
+}
+
+void FlatASTWriter::writeStringTable() {
+  std::uint32_t offset = 0;
+  data_.push_back(offset);
+  for (auto text : strings_) {
+    offset += static_cast<std::uint32_t>(text.size());
+    data_.push_back(offset);
+  }
+
+  const auto start = data_.size();
+  data_.resize(start + (offset + 3) / 4);
+
+  auto bytes = reinterpret_cast<char*>(data_.data() + start);
+  for (auto text : strings_) {
+    std::memcpy(bytes, text.data(), text.size());
+    bytes += text.size();
+  }
+}
+
+}  // namespace cxx
@@ -0,0 +1,110 @@
+// Copyright (c) 2023 Roberto Raggi <roberto.raggi@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cxx/ast_fwd.h>
+#include <cxx/ast_slot.h>
+
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace cxx {
+
+class TranslationUnit;
+
+// An AST, or a subtree of it, flattened in a buffer of 32-bit words, so it
+// can be copied to another runtime, e.g. to JavaScript, in one go.
+//
+// The buffer starts with a header of kHeaderSize words, followed by the
+// records of the nodes, of their tokens and of their attributes, in
+// pre-order. Each record has kRecordSize words. The children of a node are
+// the records that follow it, up to the end of its subtree.
+//
+// The string table follows the records. It has the byte offsets of the
+// stringCount + 1 strings, relative to the end of the offsets, followed by
+// the UTF-8 text of the identifiers and of the literals.
+struct FlatAST {
+  static constexpr std::uint32_t kVersion = 1;
+  static constexpr std::uint32_t kNone = 0xffffffff;
+
+  // the fields of the header.
+  static constexpr std::uint32_t kVersionWord = 0;
+  static constexpr std::uint32_t kRecordCount = 1;
+  static constexpr std::uint32_t kStringCount = 2;
+  // the offset of the string table, in words.
+  static constexpr std::uint32_t kStringTable = 3;
+  static constexpr std::uint32_t kHeaderSize = 4;
+
+  // the fields of the records.
+
+  // the ASTSlotKind of the record, kNode, kToken or an attribute.
+  static constexpr std::uint32_t kSlotKind = 0;
+  // the ASTKind of a node or the TokenKind of a token.
+  static constexpr std::uint32_t kKind = 1;
+  // the index of the record of the parent node, kNone for the root.
+  static constexpr std::uint32_t kParent = 2;
+  // the SlotNameIndex of the record in its parent, kNone for the root.
+  static constexpr std::uint32_t kSlotName = 3;
+  // the end of the subtree of a node, the index of a token, the string id
+  // of an identifier or a literal, or the value of an attribute.
+  static constexpr std::uint32_t kValue = 4;
+  // the smallest token index of a node and one past the largest one.
+  static constexpr std::uint32_t kFirstToken = 5;
+  static constexpr std::uint32_t kLastToken = 6;
+  // the address of a node in 32-bit builds, e.g. wasm32, otherwise 0.
+  static constexpr std::uint32_t kHandle = 7;
+  static constexpr std::uint32_t kRecordSize = 8;
+};
+
+class FlatASTWriter {
+ public:
+  explicit FlatASTWriter(const TranslationUnit* unit) : unit_(unit) {}
+
+  auto operator()(AST* root) -> std::vector<std::uint32_t>;
+
+ private:
+  void writeNode(AST* ast, std::uint32_t parent, std::uint32_t slotName);
+
+  auto writeRecord(ASTSlotKind slotKind, std::uint32_t kind,
+                   std::uint32_t parent, std::uint32_t slotName,
+                   std::uint32_t value) -> std::uint32_t;
+
+  void writeToken(std::uint32_t index, std::uint32_t parent,
+                  std::uint32_t slotName);
+
+  auto stringId(const void* key, std::string_view text) -> std::uint32_t;
+
+  void writeStringTable();
+
+ private:
+  const TranslationUnit* unit_;
+  std::vector<std::uint32_t> data_;
+  std::uint32_t recordCount_ = 0;
+  // the token range of the node being written.
+  std::uint32_t firstToken_ = FlatAST::kNone;
+  std::uint32_t lastToken_ = 0;
+  std::unordered_map<const void*, std::uint32_t> stringIds_;
+  std::vector<std::string_view> strings_;
+};
+
+}  // namespace cxx
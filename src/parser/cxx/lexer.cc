@@ -22,10 +22,20 @@
 #include <cxx/private/format.h>
 #include <utf8/unchecked.h>
 
+#include <bit>
 #include <cassert>
 #include <cctype>
+#include <memory>
 #include <unordered_map>
 
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define CXX_LEXER_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define CXX_LEXER_NEON 1
+#endif
+
 #include "builtins-priv.h"
 #include "keywords-priv.h"
 
@@ -60,6 +70,138 @@ inline auto is_idcont(int ch) -> bool {
   return ch == '_' || std::isalnum(static_cast<unsigned char>(ch));
 }
 
+// Character classes for the ASCII fast paths of the lexer. Each class
+// answers whether the scan stops at a byte, for a single byte and for a
+// vector of 16 bytes. Backslashes always stop the scan, so line splices
+// are handled by the regular code path.
+
+#if CXX_LEXER_SSE2
+inline auto inRange(__m128i c, char lo, char hi) -> __m128i {
+  return _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8(char(lo - 1))),
+                       _mm_cmplt_epi8(c, _mm_set1_epi8(char(hi + 1))));
+}
+
+inline auto equal(__m128i c, char ch) -> __m128i {
+  return _mm_cmpeq_epi8(c, _mm_set1_epi8(ch));
+}
+
+inline auto complement(__m128i c) -> __m128i {
+  return _mm_xor_si128(c, _mm_set1_epi8(char(0xff)));
+}
+#elif CXX_LEXER_NEON
+inline auto inRange(uint8x16_t c, char lo, char hi) -> uint8x16_t {
+  return vandq_u8(vcgeq_u8(c, vdupq_n_u8(lo)), vcleq_u8(c, vdupq_n_u8(hi)));
+}
+
+inline auto equal(uint8x16_t c, char ch) -> uint8x16_t {
+  return vceqq_u8(c, vdupq_n_u8(ch));
+}
+
+inline auto complement(uint8x16_t c) -> uint8x16_t { return vmvnq_u8(c); }
+#endif
+
+struct IdentifierChar {
+  static auto stop(unsigned char ch) -> bool {
+    return ch >= 0x80 || !is_idcont(ch);
+  }
+
+  // bytes >= 0x80 are negative when compared as signed chars, and they
+  // are outside of all the ranges below.
+#if CXX_LEXER_SSE2 || CXX_LEXER_NEON
+  static auto stop(auto c) {
+#if CXX_LEXER_SSE2
+    const auto lower = _mm_or_si128(c, _mm_set1_epi8(0x20));
+    const auto ok = _mm_or_si128(
+        _mm_or_si128(inRange(lower, 'a', 'z'), inRange(c, '0', '9')),
+        equal(c, '_'));
+#else
+    const auto lower = vorrq_u8(c, vdupq_n_u8(0x20));
+    const auto ok =
+        vorrq_u8(vorrq_u8(inRange(lower, 'a', 'z'), inRange(c, '0', '9')),
+                 equal(c, '_'));
+#endif
+    return complement(ok);
+  }
+#endif
+};
+
+struct HorizontalSpace {
+  static auto stop(unsigned char ch) -> bool {
+    return ch != ' ' && ch != '\t' && ch != '\v' && ch != '\f' && ch != '\r';
+  }
+
+#if CXX_LEXER_SSE2 || CXX_LEXER_NEON
+  static auto stop(auto c) {
+#if CXX_LEXER_SSE2
+    const auto ok = _mm_or_si128(
+        equal(c, ' '), _mm_andnot_si128(equal(c, '\n'), inRange(c, '\t', '\r')));
+#else
+    const auto ok =
+        vorrq_u8(equal(c, ' '), vbicq_u8(inRange(c, '\t', '\r'), equal(c, '\n')));
+#endif
+    return complement(ok);
+  }
+#endif
+};
+
+struct LineCommentChar {
+  static auto stop(unsigned char ch) -> bool {
+    return ch == '\n' || ch == '\\';
+  }
+
+#if CXX_LEXER_SSE2 || CXX_LEXER_NEON
+  static auto stop(auto c) {
+#if CXX_LEXER_SSE2
+    return _mm_or_si128(equal(c, '\n'), equal(c, '\\'));
+#else
+    return vorrq_u8(equal(c, '\n'), equal(c, '\\'));
+#endif
+  }
+#endif
+};
+
+struct BlockCommentChar {
+  static auto stop(unsigned char ch) -> bool {
+    return ch == '*' || ch == '\\';
+  }
+
+#if CXX_LEXER_SSE2 || CXX_LEXER_NEON
+  static auto stop(auto c) {
+#if CXX_LEXER_SSE2
+    return _mm_or_si128(equal(c, '*'), equal(c, '\\'));
+#else
+    return vorrq_u8(equal(c, '*'), equal(c, '\\'));
+#endif
+  }
+#endif
+};
+
+// Returns the first byte in [it, end) where the scan of the given character
+// class stops, 16 bytes at a time when SIMD is available.
+template <typename CharClass>
+inline auto scan(const char* it, const char* end) -> const char* {
+#if CXX_LEXER_SSE2
+  for (; end - it >= 16; it += 16) {
+    const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(it));
+    const auto mask = _mm_movemask_epi8(CharClass::stop(chunk));
+    if (mask) return it + std::countr_zero(static_cast<unsigned>(mask));
+  }
+#elif CXX_LEXER_NEON
+  for (; end - it >= 16; it += 16) {
+    const auto chunk = vld1q_u8(reinterpret_cast<const std::uint8_t*>(it));
+    if (vmaxvq_u8(CharClass::stop(chunk))) break;
+  }
+#endif
+  while (it < end && !CharClass::stop(static_cast<unsigned char>(*it))) ++it;
+  return it;
+}
+
+template <typename CharClass, typename It>
+inline auto scan(It it, It end) -> It {
+  const char* first = std::to_address(it);
+  return it + (scan<CharClass>(first, std::to_address(end)) - first);
+}
+
 template <typename It>
 inline auto skipSlash(It it, It end) -> It {
   while (it < end && *it == '\\') {
@@ -110,6 +252,12 @@ Lexer::Lexer(std::string buffer)
   currentChar_ = pos_ < end_ ? peekNext(pos_, end_) : 0;
 }
 
+void Lexer::advanceTo(std::string_view::const_iterator pos) {
+  if (pos == pos_) return;
+  pos_ = pos;
+  currentChar_ = pos_ < end_ ? peekNext(pos_, end_) : 0;
+}
+
 void Lexer::consume() {
   readNext(pos_, end_);
   currentChar_ = pos_ < end_ ? peekNext(pos_, end_) : 0;
@@ -166,10 +314,14 @@ auto Lexer::readToken() -> TokenKind {
   bool isRawStringLiteral = false;
 
   if (std::isalpha(ch) || ch == '_') {
-    do {
+    const auto start = pos_;
+    advanceTo(scan<IdentifierChar>(pos_, end_));
+    text_.append(start, pos_);
+
+    while (pos_ != end_ && is_idcont(LA())) {
       text_ += static_cast<char>(LA());
       consume();
-    } while (pos_ != end_ && is_idcont(LA()));
+    }
 
     bool isStringOrCharacterLiteral = false;
 
@@ -492,6 +644,7 @@ auto Lexer::readToken() -> TokenKind {
       if (keepComments_ && LA() == '/') {
         consume();
         for (; pos_ != end_; consume()) {
+          advanceTo(scan<LineCommentChar>(pos_, end_));
           if (pos_ != end_ && LA() == '\n') {
             break;
           }
@@ -501,6 +654,7 @@ auto Lexer::readToken() -> TokenKind {
       if (keepComments_ && LA() == '*') {
         consume();
         while (pos_ != end_) {
+          advanceTo(scan<BlockCommentChar>(pos_, end_));
           if (pos_ + 1 < end_ && LA() == '*' && LA(1) == '/') {
             consume(2);
             break;
@@ -534,11 +688,17 @@ auto Lexer::skipSpaces() -> bool {
         tokenLeadingSpace_ = false;
       } else {
         tokenLeadingSpace_ = true;
+
+        if (const auto it = scan<HorizontalSpace>(pos_, end_); it != pos_) {
+          advanceTo(it);
+          continue;
+        }
       }
       consume();
     } else if (!keepComments_ && pos_ + 1 < end_ && ch == '/' && LA(1) == '/') {
       consume(2);
       for (; pos_ != end_; consume()) {
+        advanceTo(scan<LineCommentChar>(pos_, end_));
         if (pos_ != end_ && LA() == '\n') {
           break;
         }
@@ -546,6 +706,7 @@ auto Lexer::skipSpaces() -> bool {
     } else if (!keepComments_ && pos_ + 1 < end_ && ch == '/' && LA(1) == '*') {
       consume(2);
       while (pos_ != end_) {
+        advanceTo(scan<BlockCommentChar>(pos_, end_));
         if (pos_ + 1 < end_ && LA() == '*' && LA(1) == '/') {
           consume(2);
           break;
@@ -101,6 +101,7 @@ class Lexer {
  private:
   void consume();
   void consume(int n);
+  void advanceTo(std::string_view::const_iterator pos);
 
   [[nodiscard]] inline auto LA() const -> std::uint32_t { return currentChar_; }
   [[nodiscard]] auto LA(int n) const -> std::uint32_t;
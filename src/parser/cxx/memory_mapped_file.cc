@@ -0,0 +1,122 @@
+// Copyright (c) 2023 Roberto Raggi <roberto.raggi@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <cxx/private/memory_mapped_file.h>
+
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(__wasi__) && \
+    !defined(__EMSCRIPTEN__)
+#define CXX_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace cxx {
+
+MemoryMappedFile::MemoryMappedFile(MemoryMappedFile&& other) noexcept {
+  *this = std::move(other);
+}
+
+auto MemoryMappedFile::operator=(MemoryMappedFile&& other) noexcept
+    -> MemoryMappedFile& {
+  if (this == &other) return *this;
+
+  close();
+
+  // the data of a file that was read points to the moved buffer.
+  const auto data = std::exchange(other.data_, nullptr);
+
+  mapped_ = std::exchange(other.mapped_, false);
+  size_ = std::exchange(other.size_, 0);
+  buffer_ = std::move(other.buffer_);
+  other.buffer_.clear();
+
+  if (mapped_) {
+    data_ = data;
+  } else if (data) {
+    data_ = buffer_.data();
+  }
+
+  return *this;
+}
+
+MemoryMappedFile::~MemoryMappedFile() { close(); }
+
+auto MemoryMappedFile::open(const std::string& fileName) -> bool {
+  close();
+
+#ifdef CXX_HAS_MMAP
+  const int fd = ::open(fileName.c_str(), O_RDONLY);
+  if (fd == -1) return false;
+
+  struct stat st;
+  const auto hasStat = fstat(fd, &st) == 0;
+
+  // the directories can be opened, but not read.
+  if (hasStat && S_ISDIR(st.st_mode)) {
+    ::close(fd);
+    return false;
+  }
+
+  if (hasStat && S_ISREG(st.st_mode) && st.st_size > 0) {
+    void* addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    if (addr != MAP_FAILED) {
+      ::close(fd);
+      data_ = static_cast<const char*>(addr);
+      size_ = st.st_size;
+      mapped_ = true;
+      return true;
+    }
+  }
+
+  ::close(fd);
+#endif
+
+  std::ifstream in(fileName, std::ios::binary);
+  if (!in) return false;
+
+  std::ostringstream out;
+  out << in.rdbuf();
+  buffer_ = std::move(out).str();
+  data_ = buffer_.data();
+  size_ = buffer_.size();
+
+  return true;
+}
+
+void MemoryMappedFile::close() {
+#ifdef CXX_HAS_MMAP
+  if (mapped_) munmap(const_cast<char*>(data_), size_);
+#endif
+
+  data_ = nullptr;
+  size_ = 0;
+  mapped_ = false;
+  buffer_.clear();
+}
+
+}  // namespace cxx
@@ -21,6 +21,7 @@
 #include <cxx/parser.h>
 
 // cxx
+#include <cxx/arena.h>
 #include <cxx/ast.h>
 #include <cxx/const_expression_evaluator.h>
 #include <cxx/control.h>
@@ -35,8 +36,11 @@
 #include <cxx/types.h>
 
 #include <algorithm>
+#include <bit>
 #include <cstring>
 #include <forward_list>
+#include <limits>
+#include <utility>
 
 namespace cxx {
 
@@ -220,45 +224,11 @@ struct Parser::GetDeclaratorType {
   void operator()(DeclaratorAST* ast) {
     for (auto it = ast->ptrOpList; it; it = it->next) visit(*this, it->value);
 
-    auto nestedNameSpecifier = getNestedNameSpecifier(ast->coreDeclarator);
-
     std::invoke(*this, ast->declaratorChunkList);
 
     if (ast->coreDeclarator) visit(*this, ast->coreDeclarator);
   }
 
-  auto getNestedNameSpecifier(CoreDeclaratorAST* ast) const
-      -> NestedNameSpecifierAST* {
-    struct {
-      auto operator()(DeclaratorAST* ast) const -> NestedNameSpecifierAST* {
-        if (ast->coreDeclarator) return visit(*this, ast->coreDeclarator);
-        return nullptr;
-      }
-
-      auto operator()(BitfieldDeclaratorAST* ast) const
-          -> NestedNameSpecifierAST* {
-        return nullptr;
-      }
-
-      auto operator()(ParameterPackAST* ast) const -> NestedNameSpecifierAST* {
-        return nullptr;
-      }
-
-      auto operator()(IdDeclaratorAST* ast) const -> NestedNameSpecifierAST* {
-        return ast->nestedNameSpecifier;
-      }
-
-      auto operator()(NestedDeclaratorAST* ast) const
-          -> NestedNameSpecifierAST* {
-        if (!ast->declarator) return nullptr;
-        return std::invoke(*this, ast->declarator);
-      }
-    } v;
-
-    if (!ast) return nullptr;
-    return visit(v, ast);
-  }
-
   void operator()(List<DeclaratorChunkAST*>* chunks) {
     if (!chunks) return;
     std::invoke(*this, chunks->next);
@@ -379,6 +349,9 @@ struct Parser::GetDeclaratorType {
 struct Parser::LookaheadParser {
   Parser* p;
   SourceLocation loc;
+  std::optional<Arena::Mark> mark;
+  std::uint32_t astPinCount = 0;
+  std::size_t astReferenceCount = 0;
   RecordingDiagnosticsClient client;
   DiagnosticsClient* previousClient = nullptr;
   bool committed = false;
@@ -386,21 +359,44 @@ struct Parser::LookaheadParser {
   LookaheadParser(const LookaheadParser&) = delete;
   auto operator=(const LookaheadParser&) -> LookaheadParser& = delete;
 
-  explicit LookaheadParser(Parser* p) : p(p), loc(p->currentLocation()) {
+  // when reclaim is true, the nodes allocated by a failed attempt are
+  // released, unless the caches or the Control kept a reference to one of
+  // them. The lookahead must not store its nodes anywhere else, e.g. in an
+  // out parameter or in a Decl of the caller.
+  explicit LookaheadParser(Parser* p, bool reclaim = false)
+      : p(p), loc(p->currentLocation()) {
+    if (reclaim) {
+      mark = p->pool_->mark();
+      astPinCount = p->astPinCount_;
+      astReferenceCount = p->control_->astReferenceCount();
+    }
     previousClient = p->unit->changeDiagnosticsClient(&client);
+    ++p->stats_.lookaheads;
   }
 
   ~LookaheadParser() {
     p->unit->changeDiagnosticsClient(previousClient);
 
     if (!committed) {
+      ++p->stats_.rewinds;
       p->rewind(loc);
+      reclaimNodes();
     } else {
       client.reportTo(p->unit->diagnosticsClient());
     }
   }
 
   void commit() { committed = true; }
+
+  void reclaimNodes() {
+    if (!mark) return;
+    if (p->astPinCount_ != astPinCount) return;
+    if (p->control_->astReferenceCount() != astReferenceCount) return;
+
+    const auto bytes = p->pool_->bytesAllocated() - mark->bytesAllocated;
+    p->stats_.reclaimedBytes += bytes;
+    p->pool_->rollback(*mark);
+  }
 };
 
 struct Parser::LoopParser {
@@ -683,7 +679,21 @@ struct Parser::DeclareSymbol {
 
   auto control() const -> Control* { return p->control_; }
 
+  // records the symbols declared in namespace scopes, see
+  // Parser::removeDeclaration().
+  void record(Scope* scope, Symbol* symbol) {
+    if (!p->config_.incremental) return;
+    if (symbol->isTemplateParameters()) return;
+    auto owner = scope->owner();
+    if (!owner || !owner->isNamespace()) return;
+    p->declaredSymbols_.emplace_back(scope, symbol);
+  }
+
   void operator()(Symbol* symbol) {
+    p->invalidateLookupCache();
+
+    if (!p->removedSymbols_.empty()) symbol = p->reuseRemovedSymbol(symbol);
+
     if (auto f = symbol_cast<FunctionSymbol>(symbol)) {
       for (Symbol* candidate : scope_->get(symbol->name())) {
         if (auto currentFunction = symbol_cast<FunctionSymbol>(candidate)) {
@@ -712,6 +722,7 @@ struct Parser::DeclareSymbol {
 #endif
 
           ovl->addFunction(f);
+          record(scope_, f);
           return;
         }
 
@@ -722,11 +733,14 @@ struct Parser::DeclareSymbol {
                                  to_string(ovl->name())));
 #endif
           ovl->addFunction(f);
+          record(scope_, f);
           return;
         }
       }
     }
     scope_->addSymbol(symbol);
+    // the symbols of the templates are added to the enclosing scope.
+    record(symbol->enclosingScope(), symbol);
   }
 };
 
@@ -747,25 +761,63 @@ struct Parser::UnqualifiedLookup {
   auto operator()(const Name* name) -> Result {
     if (!name) return nullptr;
 
-    auto is_compatible = [](Symbol* symbol, Symbol* other) -> bool {
-      return true;
-    };
+    auto& entry = p->lookupCacheEntry(scope_, name);
+
+    if (entry.generation != p->lookupGeneration_ || entry.scope != scope_ ||
+        entry.name != name) {
+      entry = {scope_, name, lookup(name), p->lookupGeneration_};
+    }
 
+    if (!entry.symbol) return NotFound{};
+    return entry.symbol;
+  }
+
+ private:
+  auto lookup(const Name* name) const -> Symbol* {
     for (auto current = scope_; current; current = current->parent()) {
-      Symbol* symbol = nullptr;
+      if (auto symbol = lookupIn(current, name)) return symbol;
 
-      for (auto candidate : current->get(name)) {
-        if (!is_compatible(candidate, symbol)) {
-          return Ambiguous{};
-        }
+      auto ns = symbol_cast<NamespaceSymbol>(current->owner());
+      if (!ns || ns->usingNamespaces().empty()) continue;
+
+      std::vector<NamespaceSymbol*> visited{ns};
+      if (auto symbol = lookupInUsingNamespaces(ns, name, visited)) {
+        return symbol;
+      }
+    }
+
+    return nullptr;
+  }
+
+  // the names of the nominated namespaces, the inline namespaces, are
+  // visible in the nominating namespace.
+  auto lookupInUsingNamespaces(NamespaceSymbol* ns, const Name* name,
+                               std::vector<NamespaceSymbol*>& visited) const
+      -> Symbol* {
+    for (auto usingNamespace : ns->usingNamespaces()) {
+      if (std::ranges::find(visited, usingNamespace) != visited.end()) {
+        continue;
+      }
 
-        symbol = candidate;
+      visited.push_back(usingNamespace);
+
+      if (auto symbol = lookupIn(usingNamespace->scope(), name)) {
+        return symbol;
       }
 
-      if (symbol) return symbol;
+      if (auto symbol =
+              lookupInUsingNamespaces(usingNamespace, name, visited)) {
+        return symbol;
+      }
     }
 
-    return NotFound{};
+    return nullptr;
+  }
+
+  auto lookupIn(Scope* scope, const Name* name) const -> Symbol* {
+    Symbol* symbol = nullptr;
+    for (auto candidate : scope->get(name)) symbol = candidate;
+    return symbol;
   }
 };
 
@@ -843,10 +895,6 @@ auto Parser::prec(TokenKind tk) -> Parser::Prec {
   }  // switch
 }
 
-auto Parser::LA(int n) const -> const Token& {
-  return unit->tokenAt(SourceLocation(cursor_ + n));
-}
-
 auto Parser::match(TokenKind tk, SourceLocation& location) -> bool {
   if (lookat(tk)) {
     location = consumeToken();
@@ -863,9 +911,63 @@ auto Parser::expect(TokenKind tk, SourceLocation& location) -> bool {
   return false;
 }
 
+void Parser::setConfig(const ParserConfiguration& config) {
+  config_ = config;
+  skipFunctionBody_ = config_.skipFunctionBodies;
+
+  // in packrat mode the tables are unbounded, so each memoized production
+  // is parsed at most once per start token.
+  const auto capacity = config_.packrat
+                            ? std::numeric_limits<std::size_t>::max()
+                            : config_.astCacheCapacity;
+
+  class_specifiers_.setCapacity(capacity);
+  elaborated_type_specifiers_.setCapacity(capacity);
+  cast_expressions_.setCapacity(capacity);
+  nested_name_specifiers_.setCapacity(capacity);
+  parameter_declaration_clauses_.setCapacity(capacity);
+  template_arguments_.setCapacity(capacity);
+  simple_template_ids_.setCapacity(config_.packrat ? capacity : 0);
+}
+
+auto Parser::astCacheStats() const -> ASTCacheStats {
+  ASTCacheStats stats;
+
+  auto add = [&](const auto& cache) {
+    stats.hits += cache.stats().hits;
+    stats.misses += cache.stats().misses;
+    stats.evictions += cache.stats().evictions;
+  };
+
+  add(class_specifiers_);
+  add(elaborated_type_specifiers_);
+  add(cast_expressions_);
+  add(nested_name_specifiers_);
+  add(parameter_declaration_clauses_);
+  add(template_arguments_);
+  add(simple_template_ids_);
+
+  return stats;
+}
+
 void Parser::operator()(UnitAST*& ast) { parse(ast); }
 
-void Parser::parse(UnitAST*& ast) { parse_translation_unit(ast); }
+void Parser::parse(UnitAST*& ast) {
+  parse_translation_unit(ast);
+  clearASTCaches();
+}
+
+// the memoized nodes are reachable from the AST, the entries are only
+// useful while the same tokens are parsed.
+void Parser::clearASTCaches() {
+  class_specifiers_.clear();
+  elaborated_type_specifiers_.clear();
+  cast_expressions_.clear();
+  nested_name_specifiers_.clear();
+  parameter_declaration_clauses_.clear();
+  template_arguments_.clear();
+  simple_template_ids_.clear();
+}
 
 void Parser::parse_warn(std::string message) {
   unit->warning(SourceLocation(cursor_), std::move(message));
@@ -912,7 +1014,7 @@ auto Parser::parse_id(const Identifier* id, SourceLocation& loc) -> bool {
 }
 
 auto Parser::parse_nospace() -> bool {
-  const auto& tk = unit->tokenAt(currentLocation());
+  const auto tk = unit->tokenAt(currentLocation());
   return !tk.leadingSpace() && !tk.startOfLine();
 }
 
@@ -1006,7 +1108,7 @@ auto Parser::parse_name_id(NameIdAST*& yyast) -> bool {
 }
 
 auto Parser::parse_literal(ExpressionAST*& yyast) -> bool {
-  switch (TokenKind(LA())) {
+  switch (LK()) {
     case TokenKind::T_CHARACTER_LITERAL: {
       auto ast = new (pool_) CharLiteralExpressionAST();
       yyast = ast;
@@ -1200,24 +1302,33 @@ void Parser::parse_top_level_declaration_seq(UnitAST*& yyast) {
 
   moduleUnit_ = false;
 
-  auto it = &ast->declarationList;
+  parse_top_level_declaration_seq(ast->declarationList);
+}
+
+void Parser::parse_top_level_declaration_seq(List<DeclarationAST*>*& yyast) {
+  auto it = &yyast;
 
   LoopParser loop(this);
 
-  while (LA()) {
+  while (LK() != TokenKind::T_EOF_SYMBOL) {
     loop.start();
 
     DeclarationAST* declaration = nullptr;
 
+    const auto start = currentLocation();
+    const auto firstSymbol = declaredSymbols_.size();
+
     if (!parse_declaration(declaration, BindingContext::kNamespace)) {
       parse_error("expected a declaration");
       continue;
     }
 
-    if (declaration) {
-      *it = new (pool_) List(declaration);
-      it = &(*it)->next;
-    }
+    if (!declaration) continue;
+
+    recordDeclaration(declaration, start, firstSymbol);
+
+    *it = new (pool_) List(declaration);
+    it = &(*it)->next;
   }
 }
 
@@ -1226,7 +1337,7 @@ void Parser::parse_declaration_seq(List<DeclarationAST*>*& yyast) {
 
   LoopParser loop(this);
 
-  while (LA()) {
+  while (LK() != TokenKind::T_EOF_SYMBOL) {
     if (lookat(TokenKind::T_RBRACE)) break;
 
     if (parse_maybe_module()) break;
@@ -1235,8 +1346,12 @@ void Parser::parse_declaration_seq(List<DeclarationAST*>*& yyast) {
 
     DeclarationAST* declaration = nullptr;
 
+    const auto start = currentLocation();
+    const auto firstSymbol = declaredSymbols_.size();
+
     if (parse_declaration(declaration, BindingContext::kNamespace)) {
       if (declaration) {
+        recordDeclaration(declaration, start, firstSymbol);
         *it = new (pool_) List(declaration);
         it = &(*it)->next;
       }
@@ -1349,7 +1464,7 @@ auto Parser::parse_maybe_template_id(UnqualifiedIdAST*& yyast,
     return true;
   }
 
-  switch (TokenKind(LA())) {
+  switch (LK()) {
     case TokenKind::T_COLON:
     case TokenKind::T_COMMA:
     case TokenKind::T_LPAREN:
@@ -1501,7 +1616,7 @@ auto Parser::parse_nested_name_specifier(NestedNameSpecifierAST*& yyast)
   };
 
   auto lookat_template_nested_name_specifier = [&] {
-    LookaheadParser lookahead{this};
+    LookaheadParser lookahead{this, /*reclaim=*/true};
 
     SourceLocation templateLoc;
     const auto isTemplateIntroduced = match(TokenKind::T_TEMPLATE, templateLoc);
@@ -1675,8 +1790,8 @@ auto Parser::parse_lambda_capture(SourceLocation& captureDefaultLoc,
 }
 
 auto Parser::parse_capture_default(SourceLocation& opLoc) -> bool {
-  if (!LA().isOneOf(TokenKind::T_AMP, TokenKind::T_EQUAL)) return false;
-  if (!LA(1).isOneOf(TokenKind::T_COMMA, TokenKind::T_RBRACKET)) return false;
+  if (!lookatAny(TokenKind::T_AMP, TokenKind::T_EQUAL)) return false;
+  if (!lookatAnyAt(1, TokenKind::T_COMMA, TokenKind::T_RBRACKET)) return false;
 
   opLoc = consumeToken();
 
@@ -1744,7 +1859,7 @@ auto Parser::parse_simple_capture(LambdaCaptureAST*& yyast) -> bool {
     SourceLocation ellipsisLoc;
     match(TokenKind::T_DOT_DOT_DOT, ellipsisLoc);
 
-    if (!LA().isOneOf(TokenKind::T_COMMA, TokenKind::T_RBRACKET)) return false;
+    if (!lookatAny(TokenKind::T_COMMA, TokenKind::T_RBRACKET)) return false;
 
     auto ast = new (pool_) SimpleLambdaCaptureAST();
     yyast = ast;
@@ -1771,7 +1886,7 @@ auto Parser::parse_simple_capture(LambdaCaptureAST*& yyast) -> bool {
   SourceLocation ellipsisLoc;
   match(TokenKind::T_DOT_DOT_DOT, ellipsisLoc);
 
-  if (!LA().isOneOf(TokenKind::T_COMMA, TokenKind::T_RBRACKET)) return false;
+  if (!lookatAny(TokenKind::T_COMMA, TokenKind::T_RBRACKET)) return false;
 
   lookahead.commit();
 
@@ -1793,7 +1908,7 @@ auto Parser::parse_init_capture(LambdaCaptureAST*& yyast) -> bool {
     SourceLocation ampLoc;
     match(TokenKind::T_AMP, ampLoc);
 
-    if (LA().isOneOf(TokenKind::T_DOT_DOT_DOT, TokenKind::T_IDENTIFIER))
+    if (lookatAny(TokenKind::T_DOT_DOT_DOT, TokenKind::T_IDENTIFIER))
       return true;
 
     return false;
@@ -1972,7 +2087,7 @@ auto Parser::parse_fold_expression(ExpressionAST*& yyast,
 auto Parser::parse_fold_operator(SourceLocation& loc, TokenKind& op) -> bool {
   loc = currentLocation();
 
-  switch (TokenKind(LA())) {
+  switch (LK()) {
     case TokenKind::T_GREATER: {
       if (parse_greater_greater()) {
         op = TokenKind::T_GREATER_GREATER;
@@ -2017,7 +2132,7 @@ auto Parser::parse_fold_operator(SourceLocation& loc, TokenKind& op) -> bool {
     case TokenKind::T_COMMA:
     case TokenKind::T_DOT_STAR:
     case TokenKind::T_MINUS_GREATER_STAR: {
-      op = LA().kind();
+      op = LK();
       consumeToken();
       return true;
     }
@@ -2082,7 +2197,7 @@ void Parser::parse_requirement_seq(List<RequirementAST*>*& yyast) {
 
   LoopParser loop(this);
 
-  while (LA()) {
+  while (LK() != TokenKind::T_EOF_SYMBOL) {
     if (lookat(TokenKind::T_RBRACE)) break;
 
     loop.start();
@@ -2128,7 +2243,13 @@ auto Parser::parse_type_requirement(RequirementAST*& yyast) -> bool {
 
   parse_optional_nested_name_specifier(ast->nestedNameSpecifier);
 
-  if (!parse_type_name(ast->unqualifiedId)) parse_error("expected a type name");
+  SourceLocation templateLoc;
+  const auto isTemplateIntroduced = match(TokenKind::T_TEMPLATE, templateLoc);
+
+  if (!parse_simple_template_or_name_id(ast->unqualifiedId,
+                                        isTemplateIntroduced)) {
+    parse_error("expected a type name");
+  }
 
   expect(TokenKind::T_SEMICOLON, ast->semicolonLoc);
 
@@ -2347,8 +2468,8 @@ auto Parser::parse_postincr_expression(ExpressionAST*& yyast,
 }
 
 auto Parser::parse_cpp_cast_head(SourceLocation& castLoc) -> bool {
-  if (LA().isOneOf(TokenKind::T_CONST_CAST, TokenKind::T_DYNAMIC_CAST,
-                   TokenKind::T_REINTERPRET_CAST, TokenKind::T_STATIC_CAST)) {
+  if (lookatAny(TokenKind::T_CONST_CAST, TokenKind::T_DYNAMIC_CAST,
+                TokenKind::T_REINTERPRET_CAST, TokenKind::T_STATIC_CAST)) {
     castLoc = consumeToken();
     return true;
   }
@@ -2401,7 +2522,7 @@ auto Parser::parse_builtin_bit_cast_expression(ExpressionAST*& yyast,
 auto Parser::parse_cpp_type_cast_expression(ExpressionAST*& yyast,
                                             const ExprContext& ctx) -> bool {
   auto lookat_function_call = [&] {
-    LookaheadParser lookahead{this};
+    LookaheadParser lookahead{this, /*reclaim=*/true};
 
     SpecifierAST* typeSpecifier = nullptr;
     DeclSpecs specs{this};
@@ -2417,7 +2538,7 @@ auto Parser::parse_cpp_type_cast_expression(ExpressionAST*& yyast,
   };
 
   auto lookat_braced_type_construction = [&] {
-    LookaheadParser lookahead{this};
+    LookaheadParser lookahead{this, /*reclaim=*/true};
 
     SpecifierAST* typeSpecifier = nullptr;
     DeclSpecs specs{this};
@@ -2442,7 +2563,7 @@ auto Parser::parse_cpp_type_cast_expression(ExpressionAST*& yyast,
   if (lookat_function_call()) return false;
   if (lookat_braced_type_construction()) return true;
 
-  LookaheadParser lookahead{this};
+  LookaheadParser lookahead{this, /*reclaim=*/true};
 
   SpecifierAST* typeSpecifier = nullptr;
   DeclSpecs specs{this};
@@ -2808,7 +2929,7 @@ auto Parser::parse_alignof_expression(ExpressionAST*& yyast,
 }
 
 auto Parser::parse_unary_operator(SourceLocation& opLoc) -> bool {
-  switch (TokenKind(LA())) {
+  switch (LK()) {
     case TokenKind::T_STAR:
     case TokenKind::T_AMP:
     case TokenKind::T_PLUS:
@@ -3067,7 +3188,7 @@ auto Parser::parse_binary_operator(SourceLocation& loc, TokenKind& tk,
   loc = start;
   tk = TokenKind::T_EOF_SYMBOL;
 
-  switch (TokenKind(LA())) {
+  switch (LK()) {
     case TokenKind::T_GREATER: {
       if (parse_greater_greater()) {
         if (exprContext.templArg) {
@@ -3108,7 +3229,7 @@ auto Parser::parse_binary_operator(SourceLocation& loc, TokenKind& tk,
     case TokenKind::T_PLUS:
     case TokenKind::T_SLASH:
     case TokenKind::T_STAR:
-      tk = LA().kind();
+      tk = LK();
       consumeToken();
       return true;
 
@@ -3405,7 +3526,7 @@ auto Parser::parse_maybe_assignment_expression(ExpressionAST*& yyast,
 
 auto Parser::parse_assignment_operator(SourceLocation& loc, TokenKind& op)
     -> bool {
-  switch (TokenKind(LA())) {
+  switch (LK()) {
     case TokenKind::T_EQUAL:
     case TokenKind::T_STAR_EQUAL:
     case TokenKind::T_SLASH_EQUAL:
@@ -3417,7 +3538,7 @@ auto Parser::parse_assignment_operator(SourceLocation& loc, TokenKind& op)
     case TokenKind::T_CARET_EQUAL:
     case TokenKind::T_BAR_EQUAL:
     case TokenKind::T_GREATER_GREATER_EQUAL: {
-      op = LA().kind();
+      op = LK();
       loc = consumeToken();
       return true;
     }
@@ -3569,7 +3690,7 @@ void Parser::parse_init_statement(StatementAST*& yyast) {
 
 void Parser::parse_condition(ExpressionAST*& yyast, const ExprContext& ctx) {
   auto lookat_condition = [&] {
-    LookaheadParser lookahead{this};
+    LookaheadParser lookahead{this, /*reclaim=*/true};
 
     List<AttributeSpecifierAST*>* attributes = nullptr;
 
@@ -3714,10 +3835,10 @@ auto Parser::parse_compound_statement(CompoundStatementAST*& yyast, bool skip)
   if (skip) {
     int depth = 1;
 
-    while (const auto& tok = LA()) {
-      if (tok.is(TokenKind::T_LBRACE)) {
+    for (auto kind = LK(); kind != TokenKind::T_EOF_SYMBOL; kind = LK()) {
+      if (kind == TokenKind::T_LBRACE) {
         ++depth;
-      } else if (tok.is(TokenKind::T_RBRACE)) {
+      } else if (kind == TokenKind::T_RBRACE) {
         if (!--depth) {
           break;
         }
@@ -3749,7 +3870,7 @@ void Parser::finish_compound_statement(CompoundStatementAST* ast) {
 
   LoopParser loop{this};
 
-  while (LA()) {
+  while (LK() != TokenKind::T_EOF_SYMBOL) {
     if (lookat(TokenKind::T_RBRACE)) break;
 
     loop.start();
@@ -3767,10 +3888,10 @@ void Parser::finish_compound_statement(CompoundStatementAST* ast) {
 }
 
 void Parser::parse_skip_statement(bool& skipping) {
-  if (!LA()) return;
+  if (LK() == TokenKind::T_EOF_SYMBOL) return;
   if (lookat(TokenKind::T_RBRACE)) return;
   if (!skipping) parse_error("expected a statement");
-  for (; LA(); consumeToken()) {
+  for (; LK() != TokenKind::T_EOF_SYMBOL; consumeToken()) {
     if (lookat(TokenKind::T_SEMICOLON)) break;
     if (lookat(TokenKind::T_LBRACE)) break;
     if (lookat(TokenKind::T_RBRACE)) break;
@@ -3785,7 +3906,7 @@ auto Parser::parse_if_statement(StatementAST*& yyast) -> bool {
 
   ScopeGuard scopeGuard{this};
 
-  if (LA().isOneOf(TokenKind::T_EXCLAIM, TokenKind::T_CONSTEVAL)) {
+  if (lookatAny(TokenKind::T_EXCLAIM, TokenKind::T_CONSTEVAL)) {
     auto ast = new (pool_) ConstevalIfStatementAST();
     yyast = ast;
     ast->ifLoc = ifLoc;
@@ -4296,6 +4417,7 @@ auto Parser::enterOrCreateNamespace(const Name* name, bool isInline)
 
     if (isInline) {
       parentNamespace->addUsingNamespace(namespaceSymbol);
+      invalidateLookupCache();
     }
   }
 
@@ -4632,7 +4754,7 @@ auto Parser::parse_simple_declaration(
     ast->functionBody = functionBody;
     ast->symbol = functionSymbol;
 
-    if (classDepth_) pendingFunctionDefinitions_.push_back(ast);
+    addPendingFunctionDefinition(ast);
 
     return true;
   };
@@ -4765,7 +4887,7 @@ auto Parser::parse_notypespec_function_definition(
   ast->functionBody = functionBody;
   ast->symbol = functionSymbol;
 
-  if (classDepth_) pendingFunctionDefinitions_.push_back(ast);
+  addPendingFunctionDefinition(ast);
 
   return true;
 }
@@ -4827,7 +4949,7 @@ auto Parser::parse_static_assert_declaration(DeclarationAST*& yyast) -> bool {
 }
 
 auto Parser::match_string_literal(SourceLocation& loc) -> bool {
-  switch (TokenKind(LA())) {
+  switch (LK()) {
     case TokenKind::T_WIDE_STRING_LITERAL:
     case TokenKind::T_UTF8_STRING_LITERAL:
     case TokenKind::T_UTF16_STRING_LITERAL:
@@ -4880,7 +5002,7 @@ auto Parser::parse_attribute_declaration(DeclarationAST*& yyast) -> bool {
 
 auto Parser::parse_decl_specifier(SpecifierAST*& yyast, DeclSpecs& specs)
     -> bool {
-  switch (TokenKind(LA())) {
+  switch (LK()) {
     case TokenKind::T_TYPEDEF: {
       auto ast = new (pool_) TypedefSpecifierAST();
       yyast = ast;
@@ -5125,7 +5247,7 @@ auto Parser::parse_type_specifier_seq(List<SpecifierAST*>*& yyast,
 
   LoopParser loop{this};
 
-  while (LA()) {
+  while (LK() != TokenKind::T_EOF_SYMBOL) {
     loop.start();
 
     const auto before_type_specifier = currentLocation();
@@ -5191,7 +5313,7 @@ auto Parser::parse_defining_type_specifier_seq(List<SpecifierAST*>*& yyast,
 
   LoopParser loop{this};
 
-  while (LA()) {
+  while (LK() != TokenKind::T_EOF_SYMBOL) {
     loop.start();
 
     const auto before_type_specifier = currentLocation();
@@ -5303,7 +5425,7 @@ auto Parser::parse_sign_type_specifier(SpecifierAST*& yyast, DeclSpecs& specs)
 
 auto Parser::parse_complex_type_specifier(SpecifierAST*& yyast,
                                           DeclSpecs& specs) -> bool {
-  if (!LA().isOneOf(TokenKind::T__COMPLEX, TokenKind::T___COMPLEX__))
+  if (!lookatAny(TokenKind::T__COMPLEX, TokenKind::T___COMPLEX__))
     return false;
   auto ast = new (pool_) ComplexTypeSpecifierAST();
   yyast = ast;
@@ -5434,7 +5556,7 @@ auto Parser::parse_primitive_type_specifier(SpecifierAST*& yyast,
     ast->specifier = unit->tokenKind(ast->specifierLoc);
   };
 
-  switch (auto tk = LA(); tk.kind()) {
+  switch (LK()) {
     case TokenKind::T___BUILTIN_VA_LIST: {
       auto ast = new (pool_) VaListTypeSpecifierAST();
       yyast = ast;
@@ -5526,6 +5648,22 @@ auto Parser::maybe_template_name(const Identifier* id) -> bool {
   return false;
 }
 
+auto Parser::lookupCacheEntry(Scope* scope, const Name* name)
+    -> LookupCacheEntry& {
+  if (lookupCache_.empty()) lookupCache_.resize(kLookupCacheSize);
+
+  const auto key = static_cast<std::uint64_t>(
+      reinterpret_cast<std::uintptr_t>(scope) ^
+      (reinterpret_cast<std::uintptr_t>(name) << 1));
+
+  const auto index = (key * 0x9e3779b97f4a7c15ull) >>
+                     (64 - std::countr_zero(kLookupCacheSize));
+
+  return lookupCache_[index];
+}
+
+void Parser::invalidateLookupCache() { ++lookupGeneration_; }
+
 void Parser::mark_maybe_template_name(const Identifier* id) {
   if (!config_.fuzzyTemplateResolution) return;
   if (id) template_names_.insert(id);
@@ -6187,8 +6325,8 @@ auto Parser::parse_elaborated_type_specifier(SpecifierAST*& yyast,
                                              DeclSpecs& specs) -> bool {
   if (specs.typeSpecifier) return false;
 
-  if (!LA().isOneOf(TokenKind::T_ENUM, TokenKind::T_CLASS, TokenKind::T_STRUCT,
-                    TokenKind::T_UNION))
+  if (!lookatAny(TokenKind::T_ENUM, TokenKind::T_CLASS, TokenKind::T_STRUCT,
+                 TokenKind::T_UNION))
     return false;
 
   const auto start = currentLocation();
@@ -6317,7 +6455,7 @@ auto Parser::parse_placeholder_type_specifier(SpecifierAST*& yyast,
   TypeConstraintAST* typeConstraint = nullptr;
 
   auto lookat_placeholder_type_specifier = [&] {
-    LookaheadParser lookahead{this};
+    LookaheadParser lookahead{this, /*reclaim=*/true};
 
     (void)parse_type_constraint(typeConstraint, /*parsing placeholder=*/true);
 
@@ -6462,7 +6600,7 @@ auto Parser::parse_declarator(DeclaratorAST*& yyast, Decl& decl,
   List<DeclaratorChunkAST*>* declaratorChunkList = nullptr;
   auto it = &declaratorChunkList;
 
-  while (LA().isOneOf(TokenKind::T_LPAREN, TokenKind::T_LBRACKET)) {
+  while (lookatAny(TokenKind::T_LPAREN, TokenKind::T_LBRACKET)) {
     if (ArrayDeclaratorChunkAST* arrayDeclaratorChunk = nullptr;
         parse_array_declarator(arrayDeclaratorChunk)) {
       *it = new (pool_) List<DeclaratorChunkAST*>(arrayDeclaratorChunk);
@@ -7224,7 +7362,7 @@ void Parser::parse_virt_specifier_seq(
 }
 
 auto Parser::lookat_function_body() -> bool {
-  switch (TokenKind(LA())) {
+  switch (LK()) {
     case TokenKind::T_TRY:
       // function-try-block
       return true;
@@ -7236,7 +7374,7 @@ auto Parser::lookat_function_body() -> bool {
       return true;
     case TokenKind::T_EQUAL:
       // default/delete functions
-      return LA(1).isNot(TokenKind::T_INTEGER_LITERAL);
+      return LK(1) != TokenKind::T_INTEGER_LITERAL;
     default:
       return false;
   }  // swtich
@@ -7652,17 +7790,19 @@ void Parser::parse_namespace_body(NamespaceDefinitionAST* yyast) {
 
   LoopParser loop{this};
 
-  while (LA()) {
+  while (LK() != TokenKind::T_EOF_SYMBOL) {
     if (lookat(TokenKind::T_RBRACE)) break;
 
     loop.start();
 
     const auto beforeDeclaration = currentLocation();
+    const auto firstSymbol = declaredSymbols_.size();
 
     DeclarationAST* declaration = nullptr;
 
     if (parse_declaration(declaration, BindingContext::kNamespace)) {
       if (declaration) {
+        recordDeclaration(declaration, beforeDeclaration, firstSymbol);
         *it = new (pool_) List(declaration);
         it = &(*it)->next;
       }
@@ -7825,7 +7965,7 @@ auto Parser::parse_using_declarator(UsingDeclaratorAST*& yyast) -> bool {
 }
 
 auto Parser::parse_asm_operand(AsmOperandAST*& yyast) -> bool {
-  if (!LA().isOneOf(TokenKind::T_LBRACKET, TokenKind::T_STRING_LITERAL))
+  if (!lookatAny(TokenKind::T_LBRACKET, TokenKind::T_STRING_LITERAL))
     return false;
 
   auto ast = new (pool_) AsmOperandAST();
@@ -7874,8 +8014,8 @@ auto Parser::parse_asm_declaration(DeclarationAST*& yyast) -> bool {
   ast->asmLoc = asmLoc;
 
   auto it = &ast->asmQualifierList;
-  while (LA().isOneOf(TokenKind::T_INLINE, TokenKind::T_VOLATILE,
-                      TokenKind::T_GOTO)) {
+  while (lookatAny(TokenKind::T_INLINE, TokenKind::T_VOLATILE,
+                   TokenKind::T_GOTO)) {
     auto qualifier = new (pool_) AsmQualifierAST();
     qualifier->qualifierLoc = consumeToken();
     *it = new (pool_) List(qualifier);
@@ -8076,7 +8216,7 @@ auto Parser::parse_attribute_specifier(AttributeSpecifierAST*& yyast,
 
 auto Parser::lookat_cxx_attribute_specifier() -> bool {
   if (!lookat(TokenKind::T_LBRACKET)) return false;
-  if (LA(1).isNot(TokenKind::T_LBRACKET)) return false;
+  if (LK(1) != TokenKind::T_LBRACKET) return false;
   if (LA(1).leadingSpace() || LA(1).startOfLine()) return false;
   return true;
 }
@@ -8599,8 +8739,7 @@ auto Parser::parse_class_specifier(ClassSpecifierAST*& yyast, DeclSpecs& specs)
 auto Parser::parse_class_specifier(
     ClassSpecifierAST*& yyast, DeclSpecs& specs,
     const std::vector<TemplateDeclarationAST*>& templateDeclarations) -> bool {
-  if (!LA().isOneOf(TokenKind::T_CLASS, TokenKind::T_STRUCT,
-                    TokenKind::T_UNION))
+  if (!lookatAny(TokenKind::T_CLASS, TokenKind::T_STRUCT, TokenKind::T_UNION))
     return false;
 
   const auto start = currentLocation();
@@ -8673,7 +8812,7 @@ void Parser::parse_class_body(List<DeclarationAST*>*& yyast) {
 
   LoopParser loop{this};
 
-  while (LA()) {
+  while (LK() != TokenKind::T_EOF_SYMBOL) {
     if (lookat(TokenKind::T_RBRACE)) break;
 
     loop.start();
@@ -8706,7 +8845,7 @@ auto Parser::parse_class_head(ClassHead& classHead) -> bool {
     }
   }
 
-  if (LA().isOneOf(TokenKind::T_COLON, TokenKind::T_LBRACE)) {
+  if (lookatAny(TokenKind::T_COLON, TokenKind::T_LBRACE)) {
     is_class_declaration = true;
   }
 
@@ -8758,8 +8897,7 @@ auto Parser::parse_class_virt_specifier(SourceLocation& finalLoc) -> bool {
 }
 
 auto Parser::parse_class_key(SourceLocation& classLoc) -> bool {
-  if (LA().isOneOf(TokenKind::T_CLASS, TokenKind::T_STRUCT,
-                   TokenKind::T_UNION)) {
+  if (lookatAny(TokenKind::T_CLASS, TokenKind::T_STRUCT, TokenKind::T_UNION)) {
     classLoc = consumeToken();
     return true;
   }
@@ -8856,7 +8994,7 @@ auto Parser::parse_member_declaration_helper(DeclarationAST*& yyast) -> bool {
   }
 
   auto lookat_function_definition = [&] {
-    LookaheadParser lookahead{this};
+    LookaheadParser lookahead{this, /*reclaim=*/true};
 
     DeclaratorAST* declarator = nullptr;
     Decl decl{specs};
@@ -8910,7 +9048,7 @@ auto Parser::parse_member_declaration_helper(DeclarationAST*& yyast) -> bool {
     ast->functionBody = functionBody;
     ast->symbol = functionSymbol;
 
-    if (classDepth_) pendingFunctionDefinitions_.push_back(ast);
+    addPendingFunctionDefinition(ast);
 
     return true;
   };
@@ -9265,8 +9403,8 @@ auto Parser::parse_class_or_decltype(
 }
 
 auto Parser::parse_access_specifier(SourceLocation& loc) -> bool {
-  if (LA().isOneOf(TokenKind::T_PRIVATE, TokenKind::T_PROTECTED,
-                   TokenKind::T_PUBLIC)) {
+  if (lookatAny(TokenKind::T_PRIVATE, TokenKind::T_PROTECTED,
+                TokenKind::T_PUBLIC)) {
     loc = consumeToken();
     return true;
   }
@@ -9403,7 +9541,7 @@ auto Parser::parse_operator_function_id(OperatorFunctionIdAST*& yyast) -> bool {
 auto Parser::parse_operator(TokenKind& op, SourceLocation& opLoc,
                             SourceLocation& openLoc, SourceLocation& closeLoc)
     -> bool {
-  op = TokenKind(LA());
+  op = LK();
   switch (op) {
     case TokenKind::T_LPAREN:
       openLoc = consumeToken();
@@ -9682,7 +9820,7 @@ void Parser::parse_template_parameter(TemplateParameterAST*& yyast) {
 
     if (!parse_constraint_type_parameter(yyast)) return false;
 
-    if (!LA().isOneOf(TokenKind::T_GREATER, TokenKind::T_COMMA)) return false;
+    if (!lookatAny(TokenKind::T_GREATER, TokenKind::T_COMMA)) return false;
 
     lookahead.commit();
 
@@ -9741,7 +9879,7 @@ auto Parser::parse_typename_type_parameter(TemplateParameterAST*& yyast)
   auto maybe_elaborated_type_spec = [this]() {
     if (!lookat(TokenKind::T_TYPENAME, TokenKind::T_IDENTIFIER)) return false;
 
-    if (!LA(2).isOneOf(TokenKind::T_COLON_COLON, TokenKind::T_LESS))
+    if (!lookatAnyAt(2, TokenKind::T_COLON_COLON, TokenKind::T_LESS))
       return false;
 
     return true;
@@ -9957,10 +10095,37 @@ auto Parser::parse_simple_template_or_name_id(UnqualifiedIdAST*& yyast,
 
 auto Parser::parse_simple_template_id(SimpleTemplateIdAST*& yyast,
                                       bool isTemplateIntroduced) -> bool {
-  LookaheadParser lookahead{this};
-
   if (!lookat(TokenKind::T_IDENTIFIER, TokenKind::T_LESS)) return false;
 
+  // the template ids introduced by the template keyword are not memoized,
+  // their parse does not depend on the known template names.
+  const auto memoize = config_.packrat && !isTemplateIntroduced;
+  const auto start = currentLocation();
+
+  if (memoize) {
+    if (auto it = simple_template_ids_.get(start)) {
+      auto [endLoc, ast, parsed, hit] = *it;
+      rewind(endLoc);
+      yyast = ast;
+      return parsed;
+    }
+  }
+
+  const auto parsed = parse_simple_template_id_helper(yyast,
+                                                      isTemplateIntroduced);
+
+  if (memoize) {
+    simple_template_ids_.set(start, currentLocation(), yyast, parsed);
+  }
+
+  return parsed;
+}
+
+auto Parser::parse_simple_template_id_helper(SimpleTemplateIdAST*& yyast,
+                                             bool isTemplateIntroduced)
+    -> bool {
+  LookaheadParser lookahead{this};
+
   SourceLocation identifierLoc = consumeToken();
   SourceLocation lessLoc = consumeToken();
 
@@ -10112,8 +10277,8 @@ auto Parser::parse_template_argument(TemplateArgumentAST*& yyast) -> bool {
   }
 
   auto check = [&]() -> bool {
-    return LA().isOneOf(TokenKind::T_COMMA, TokenKind::T_GREATER,
-                        TokenKind::T_DOT_DOT_DOT);
+    return lookatAny(TokenKind::T_COMMA, TokenKind::T_GREATER,
+                     TokenKind::T_DOT_DOT_DOT);
   };
 
   auto lookat_type_id = [&] {
@@ -10513,6 +10678,249 @@ auto Parser::parse_identifier_list(List<NameIdAST*>*& yyast) -> bool {
   return true;
 }
 
+auto Parser::parseFunctionBody(FunctionDefinitionAST* ast) -> bool {
+  auto it = skippedFunctionDefinitions_.find(ast);
+  if (it == skippedFunctionDefinitions_.end()) return false;
+
+  const auto templateParameterDepth =
+      std::exchange(templateParameterDepth_, it->second);
+
+  skippedFunctionDefinitions_.erase(it);
+
+  // the nested function definitions, e.g. the members of the local classes,
+  // are parsed with the body.
+  const auto skipFunctionBody = std::exchange(skipFunctionBody_, false);
+
+  completeFunctionDefinition(ast);
+  clearASTCaches();
+
+  skipFunctionBody_ = skipFunctionBody;
+  templateParameterDepth_ = templateParameterDepth;
+
+  return true;
+}
+
+auto Parser::reparseDeclarations(std::span<DeclarationAST* const> damaged,
+                                 SourceLocation loc,
+                                 std::vector<const Name*>& changedNames)
+    -> List<DeclarationAST*>* {
+  auto visibleSymbols = [](Scope* scope, const Name* name) {
+    std::vector<Symbol*> symbols;
+    for (auto symbol : scope->get(name)) symbols.push_back(symbol);
+    return symbols;
+  };
+
+  // the names declared by the damaged declarations, and the symbols they
+  // denoted before the edit.
+  struct DeclaredName {
+    Scope* scope = nullptr;
+    const Name* name = nullptr;
+    std::vector<Symbol*> symbols;
+  };
+
+  std::vector<DeclaredName> declaredNames;
+
+  auto findDeclaredName = [&](Scope* scope, const Name* name) {
+    return std::ranges::find_if(declaredNames, [&](const auto& declared) {
+      return declared.scope == scope && declared.name == name;
+    });
+  };
+
+  auto scope = globalScope_;
+
+  for (auto ast : damaged) {
+    auto it = namespaceDeclarations_.find(ast);
+    if (it == namespaceDeclarations_.end()) continue;
+
+    scope = it->second.scope;
+
+    for (auto i = it->second.firstSymbol; i < it->second.lastSymbol; ++i) {
+      const auto& [symbolScope, symbol] = declaredSymbols_[i];
+      if (findDeclaredName(symbolScope, symbol->name()) !=
+          declaredNames.end()) {
+        continue;
+      }
+      declaredNames.push_back({symbolScope, symbol->name(),
+                               visibleSymbols(symbolScope, symbol->name())});
+    }
+  }
+
+  for (auto ast : damaged | std::views::reverse) removeDeclaration(ast);
+
+  // the removed symbols are reused in declaration order.
+  std::ranges::reverse(removedSymbols_);
+
+  rewind(loc);
+  scope_ = scope;
+
+  const auto firstSymbol = declaredSymbols_.size();
+
+  // the diagnostics go to the current client of the unit.
+  auto diagnosticClient =
+      std::exchange(diagnosticClient_, unit->diagnosticsClient());
+
+  List<DeclarationAST*>* declarations = nullptr;
+  parse_top_level_declaration_seq(declarations);
+  clearASTCaches();
+
+  diagnosticClient_ = diagnosticClient;
+
+  removedSymbols_.clear();
+
+  for (const auto& declared : declaredNames) {
+    if (visibleSymbols(declared.scope, declared.name) == declared.symbols) {
+      continue;
+    }
+    changedNames.push_back(declared.name);
+  }
+
+  for (auto i = firstSymbol; i < declaredSymbols_.size(); ++i) {
+    const auto& [symbolScope, symbol] = declaredSymbols_[i];
+    if (findDeclaredName(symbolScope, symbol->name()) != declaredNames.end()) {
+      continue;
+    }
+    changedNames.push_back(symbol->name());
+  }
+
+  return declarations;
+}
+
+auto Parser::declarationRange(DeclarationAST* ast) const
+    -> SourceLocationRange {
+  auto it = namespaceDeclarations_.find(ast);
+  if (it == namespaceDeclarations_.end()) return {};
+  return it->second.tokens;
+}
+
+void Parser::recordDeclaration(DeclarationAST* ast, SourceLocation start,
+                               std::size_t firstSymbol) {
+  if (!config_.incremental) return;
+
+  namespaceDeclarations_[ast] = {
+      .tokens = {start, currentLocation()},
+      .scope = scope_,
+      .firstSymbol = firstSymbol,
+      .lastSymbol = declaredSymbols_.size(),
+  };
+}
+
+void Parser::removeDeclaration(DeclarationAST* ast) {
+  auto it = namespaceDeclarations_.find(ast);
+  if (it == namespaceDeclarations_.end()) return;
+
+  const auto first = it->second.firstSymbol;
+  const auto last = it->second.lastSymbol;
+  namespaceDeclarations_.erase(it);
+
+  for (auto i = last; i > first; --i) {
+    const auto& [scope, symbol] = declaredSymbols_[i - 1];
+    removeSymbol(scope, symbol);
+    removedSymbols_.push_back(symbol);
+  }
+}
+
+// the variables and the functions declared again with the same name and
+// type keep their symbol, with the new specifiers.
+auto Parser::reuseRemovedSymbol(Symbol* symbol) -> Symbol* {
+  for (auto it = removedSymbols_.begin(); it != removedSymbols_.end(); ++it) {
+    auto removed = *it;
+
+    if (removed->kind() != symbol->kind()) continue;
+    if (removed->name() != symbol->name()) continue;
+    if (removed->type() != symbol->type()) continue;
+    if (removed->enclosingScope() != symbol->enclosingScope()) continue;
+
+    if (auto function = symbol_cast<FunctionSymbol>(symbol)) {
+      auto kept = symbol_cast<FunctionSymbol>(removed);
+      if (function->templateParameters() || kept->templateParameters()) {
+        continue;
+      }
+      kept->setStatic(function->isStatic());
+      kept->setExtern(function->isExtern());
+      kept->setFriend(function->isFriend());
+      kept->setConstexpr(function->isConstexpr());
+      kept->setConsteval(function->isConsteval());
+      kept->setInline(function->isInline());
+      kept->setVirtual(function->isVirtual());
+      kept->setExplicit(function->isExplicit());
+      kept->setDeleted(function->isDeleted());
+      kept->setDefaulted(function->isDefaulted());
+    } else if (auto variable = symbol_cast<VariableSymbol>(symbol)) {
+      auto kept = symbol_cast<VariableSymbol>(removed);
+      if (variable->templateParameters() || kept->templateParameters()) {
+        continue;
+      }
+      kept->setStatic(variable->isStatic());
+      kept->setThreadLocal(variable->isThreadLocal());
+      kept->setExtern(variable->isExtern());
+      kept->setConstexpr(variable->isConstexpr());
+      kept->setConstinit(variable->isConstinit());
+      kept->setInline(variable->isInline());
+    } else {
+      continue;
+    }
+
+    removedSymbols_.erase(it);
+    return removed;
+  }
+
+  return symbol;
+}
+
+void Parser::removeSymbol(Scope* scope, Symbol* symbol) {
+  invalidateLookupCache();
+
+  for (Symbol* candidate : scope->get(symbol->name())) {
+    if (candidate == symbol) {
+      if (auto namespaceSymbol = symbol_cast<NamespaceSymbol>(symbol)) {
+        // the namespace is reopened by other declarations.
+        if (!namespaceSymbol->scope()->symbols().empty()) return;
+
+        auto parent = symbol_cast<NamespaceSymbol>(scope->owner());
+        if (parent->unnamedNamespace() == namespaceSymbol) {
+          parent->setUnnamedNamespace(nullptr);
+        }
+
+        if (namespaceSymbol->isInline()) {
+          parent->removeUsingNamespace(namespaceSymbol);
+        }
+      }
+
+      scope->removeSymbol(symbol);
+      return;
+    }
+
+    if (auto ovl = symbol_cast<OverloadSetSymbol>(candidate)) {
+      auto functions = ovl->functions();
+      if (std::erase(functions, symbol) == 0) continue;
+
+      if (functions.empty()) {
+        scope->removeSymbol(ovl);
+      } else {
+        ovl->setFunctions(std::move(functions));
+      }
+
+      return;
+    }
+  }
+}
+
+// the bodies of the member functions are parsed at the end of the outermost
+// class. When skipping the function bodies, they are parsed on demand.
+void Parser::addPendingFunctionDefinition(FunctionDefinitionAST* ast) {
+  if (!classDepth_ && !skipFunctionBody_) return;
+
+  if (!ast_cast<CompoundStatementFunctionBodyAST>(ast->functionBody)) return;
+
+  ++astPinCount_;
+
+  if (classDepth_) {
+    pendingFunctionDefinitions_.push_back(ast);
+  } else {
+    skippedFunctionDefinitions_.emplace(ast, templateParameterDepth_);
+  }
+}
+
 void Parser::completePendingFunctionDefinitions() {
   if (pendingFunctionDefinitions_.empty()) return;
 
@@ -10521,7 +10929,11 @@ void Parser::completePendingFunctionDefinitions() {
   std::swap(pendingFunctionDefinitions_, functions);
 
   for (const auto& function : functions) {
-    completeFunctionDefinition(function);
+    if (skipFunctionBody_) {
+      skippedFunctionDefinitions_.emplace(function, templateParameterDepth_);
+    } else {
+      completeFunctionDefinition(function);
+    }
   }
 }
 
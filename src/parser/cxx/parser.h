@@ -27,10 +27,11 @@
 #include <cxx/symbols_fwd.h>
 #include <cxx/translation_unit.h>
 
-#include <deque>
 #include <optional>
+#include <span>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 namespace cxx {
 
@@ -57,7 +58,17 @@ class Parser final {
     return config_;
   }
 
-  void setConfig(const ParserConfiguration& config) { config_ = config; }
+  void setConfig(const ParserConfiguration& config);
+
+  /**
+   * Returns the hits, misses and evictions of the memoization tables.
+   */
+  [[nodiscard]] auto astCacheStats() const -> ASTCacheStats;
+
+  /**
+   * Returns the number of lookaheads and rewinds of the parser.
+   */
+  [[nodiscard]] auto stats() const -> const ParserStats& { return stats_; }
 
   /**
    * Whether to enable fuzzy template resolution.
@@ -83,6 +94,43 @@ class Parser final {
    */
   void operator()(UnitAST*& ast);
 
+  /**
+   * Parse the body of a function definition skipped by a declarations-only
+   * parse, see ParserConfiguration::skipFunctionBodies.
+   *
+   * @param ast the function definition
+   * @return false if the body of the function was not skipped
+   */
+  auto parseFunctionBody(FunctionDefinitionAST* ast) -> bool;
+
+  /**
+   * Returns the location of the first token of a declaration of a namespace
+   * scope, and the location following its last token. The declarations are
+   * recorded when ParserConfiguration::incremental is set.
+   *
+   * @param ast the declaration
+   */
+  [[nodiscard]] auto declarationRange(DeclarationAST* ast) const
+      -> SourceLocationRange;
+
+  /**
+   * Replace the declarations of a namespace scope damaged by an edit, see
+   * TranslationUnit::applyEdit(). The symbols of the damaged declarations
+   * are removed, and the declarations starting at the given location are
+   * parsed, up to the next end of file token. A variable or a function
+   * declared again with the same name and type keeps its symbol, so the
+   * other declarations keep referring to it.
+   *
+   * @param damaged the consecutive declarations to replace
+   * @param loc the location of the first token of the new declarations
+   * @param changedNames receives the names that denote other symbols
+   * @return the list of the parsed declarations
+   */
+  auto reparseDeclarations(std::span<DeclarationAST* const> damaged,
+                           SourceLocation loc,
+                           std::vector<const Name*>& changedNames)
+      -> List<DeclarationAST*>*;
+
  private:
   struct DeclSpecs;
   struct Decl;
@@ -167,6 +215,7 @@ class Parser final {
   [[nodiscard]] auto parse_module_head() -> bool;
   [[nodiscard]] auto parse_module_unit(UnitAST*& yyast) -> bool;
   void parse_top_level_declaration_seq(UnitAST*& yyast);
+  void parse_top_level_declaration_seq(List<DeclarationAST*>*& yyast);
   void parse_declaration_seq(List<DeclarationAST*>*& yyast);
   void parse_skip_declaration(bool& skipping);
   [[nodiscard]] auto parse_primary_expression(ExpressionAST*& yyast,
@@ -686,6 +735,8 @@ class Parser final {
   [[nodiscard]] auto parse_simple_template_id(SimpleTemplateIdAST*& yyast,
                                               bool isTemplateIntroduced = false)
       -> bool;
+  [[nodiscard]] auto parse_simple_template_id_helper(
+      SimpleTemplateIdAST*& yyast, bool isTemplateIntroduced) -> bool;
   [[nodiscard]] auto parse_literal_operator_template_id(
       LiteralOperatorTemplateIdAST*& yyast) -> bool;
   [[nodiscard]] auto parse_function_operator_template_id(
@@ -721,17 +772,34 @@ class Parser final {
   [[nodiscard]] auto lookatHelper(int) const { return true; }
 
   [[nodiscard]] auto lookatHelper(int n, TokenKind tk, auto... rest) const {
-    return LA(n).is(tk) && lookatHelper(n + 1, rest...);
+    return unit->tokenKind(SourceLocation(cursor_ + n)) == tk &&
+           lookatHelper(n + 1, rest...);
   }
 
   [[nodiscard]] auto lookatHelper(int n, BuiltinKind bt, auto... rest) const {
-    const auto& tk = LA(n);
+    const auto tk = LA(n);
     return tk.is(TokenKind::T_BUILTIN) &&
            static_cast<BuiltinKind>(tk.value().intValue) == bt &&
            lookatHelper(n + 1, rest...);
   }
 
-  [[nodiscard]] auto LA(int n = 0) const -> const Token&;
+  [[nodiscard]] auto LA(int n = 0) const -> Token {
+    return unit->tokenAt(SourceLocation(cursor_ + n));
+  }
+
+  // the kind of the lookahead token, without building the whole token.
+  [[nodiscard]] auto LK(int n = 0) const -> TokenKind {
+    return unit->tokenKind(SourceLocation(cursor_ + n));
+  }
+
+  [[nodiscard]] auto lookatAny(auto... tokens) const -> bool {
+    return lookatAnyAt(0, tokens...);
+  }
+
+  [[nodiscard]] auto lookatAnyAt(int n, auto... tokens) const -> bool {
+    const auto kind = LK(n);
+    return (... || (kind == tokens));
+  }
 
   auto match(TokenKind tk, SourceLocation& location) -> bool;
   auto expect(TokenKind tk, SourceLocation& location) -> bool;
@@ -744,9 +812,26 @@ class Parser final {
 
   void rewind(SourceLocation location) { cursor_ = location.index(); }
 
+  void addPendingFunctionDefinition(FunctionDefinitionAST* ast);
+  void clearASTCaches();
+
   void completePendingFunctionDefinitions();
   void completeFunctionDefinition(FunctionDefinitionAST* ast);
 
+  void recordDeclaration(DeclarationAST* ast, SourceLocation start,
+                         std::size_t firstSymbol);
+  void removeDeclaration(DeclarationAST* ast);
+  void removeSymbol(Scope* scope, Symbol* symbol);
+  [[nodiscard]] auto reuseRemovedSymbol(Symbol* symbol) -> Symbol*;
+
+  struct LookupCacheEntry;
+
+  [[nodiscard]] auto lookupCacheEntry(Scope* scope, const Name* name)
+      -> LookupCacheEntry&;
+
+  // discards the cached lookups, when a symbol is declared or removed.
+  void invalidateLookupCache();
+
   [[nodiscard]] auto enterOrCreateNamespace(const Name* name, bool isInline)
       -> NamespaceSymbol*;
 
@@ -832,9 +917,44 @@ class Parser final {
   std::uint32_t cursor_ = 0;
   int templateParameterDepth_ = -1;
   int templateParameterCount_ = 0;
+  ParserStats stats_;
+  // counts the AST nodes stored outside of the AST, e.g. in the caches. A
+  // failed lookahead keeps its nodes when the count changed.
+  std::uint32_t astPinCount_ = 0;
 
   std::vector<FunctionDefinitionAST*> pendingFunctionDefinitions_;
-
+  // the function definitions with a skipped body, and the template
+  // parameter depth to use when the body is parsed.
+  std::unordered_map<FunctionDefinitionAST*, int> skippedFunctionDefinitions_;
+  // the symbols declared in namespace scopes.
+  std::vector<std::pair<Scope*, Symbol*>> declaredSymbols_;
+  // a direct-mapped cache of the results of the unqualified lookups, the
+  // entries of the previous generations are stale.
+  struct LookupCacheEntry {
+    Scope* scope = nullptr;
+    const Name* name = nullptr;
+    Symbol* symbol = nullptr;
+    std::uint32_t generation = 0;
+  };
+  static constexpr std::size_t kLookupCacheSize = 512;
+  std::vector<LookupCacheEntry> lookupCache_;
+  std::uint32_t lookupGeneration_ = 1;
+  // the tokens of a declaration of a namespace scope, its scope, and the
+  // range of the symbols it declared in namespace scopes.
+  struct NamespaceDeclaration {
+    SourceLocationRange tokens;
+    Scope* scope = nullptr;
+    std::size_t firstSymbol = 0;
+    std::size_t lastSymbol = 0;
+  };
+  std::unordered_map<DeclarationAST*, NamespaceDeclaration>
+      namespaceDeclarations_;
+  // the symbols removed by reparseDeclarations() that can be declared again.
+  std::vector<Symbol*> removedSymbols_;
+
+  // memoizes the result of a parse function by start location. When the
+  // cache is full, the least recently used entry is evicted. The entries
+  // form an intrusive doubly linked list, most recently used first.
   template <typename T>
   class CachedAST {
    public:
@@ -845,67 +965,119 @@ class Parser final {
       int hit = 0;
     };
 
-    using Map = std::unordered_map<SourceLocation, Entry>;
-    using const_iterator = typename Map::const_iterator;
-
     CachedAST(const CachedAST&) = delete;
     auto operator=(const CachedAST&) -> CachedAST& = delete;
 
-    CachedAST() = default;
+    explicit CachedAST(std::uint32_t* pinCount) : pinCount_(pinCount) {}
+
+    auto empty() const -> bool { return map_.empty(); }
+    auto size() const -> std::size_t { return map_.size(); }
+
+    auto capacity() const -> std::size_t { return capacity_; }
+    void setCapacity(std::size_t capacity) {
+      capacity_ = capacity;
+      while (map_.size() > capacity_) evict();
+    }
+
+    auto stats() const -> const ASTCacheStats& { return stats_; }
 
-    auto empty() const -> bool { return this->map_.empty(); }
-    auto size() const -> std::size_t { return this->map_.size(); }
-    auto begin() const -> const_iterator { return this->map_.begin(); }
-    auto end() const -> const_iterator { return this->map_.end(); }
+    void clear() {
+      map_.clear();
+      head_ = tail_ = nullptr;
+    }
 
     auto get(SourceLocation loc) -> std::optional<Entry> {
-      if (auto it = this->map_.find(loc); it != this->map_.end()) {
-        queue_.erase(std::find(queue_.begin(), queue_.end(), it));
-        queue_.push_front(it);
-        ++it->second.hit;
-        return it->second;
+      auto it = map_.find(loc);
+
+      if (it == map_.end()) {
+        ++stats_.misses;
+        return std::nullopt;
       }
-      return std::nullopt;
+
+      ++stats_.hits;
+      auto node = &it->second;
+      moveToFront(node);
+      ++node->entry.hit;
+      return node->entry;
     }
 
     void set(SourceLocation startLoc, SourceLocation endLoc, T* ast,
              bool parsed) {
-      const std::size_t kMaxSize = 100;
+      if (!capacity_) return;
 
-      if (this->map_.size() == kMaxSize) {
-        auto it = queue_.back();
-        queue_.pop_back();
-        this->map_.erase(it);
-      }
+      // the cached nodes must survive the failed lookaheads.
+      if (ast) ++*pinCount_;
 
-      auto it = this->map_.find(startLoc);
+      auto it = map_.find(startLoc);
 
-      if (it != this->map_.end()) {
-        // ### todo: speed up
-        queue_.erase(std::find(queue_.begin(), queue_.end(), it));
+      if (it != map_.end()) {
+        unlink(&it->second);
       } else {
-        it = this->map_.insert({startLoc, {}}).first;
+        if (map_.size() == capacity_) evict();
+        it = map_.emplace(startLoc, Node{startLoc}).first;
       }
 
-      queue_.push_front(it);
+      auto node = &it->second;
+      linkFront(node);
 
-      it->second.endLoc = endLoc;
-      it->second.ast = ast;
-      it->second.parsed = parsed;
-      ++it->second.hit;
+      node->entry.endLoc = endLoc;
+      node->entry.ast = ast;
+      node->entry.parsed = parsed;
+      ++node->entry.hit;
     }
 
    private:
-    Map map_;
-    std::deque<const_iterator> queue_;
+    struct Node {
+      SourceLocation startLoc;
+      Entry entry;
+      Node* prev = nullptr;
+      Node* next = nullptr;
+    };
+
+    void unlink(Node* node) {
+      (node->prev ? node->prev->next : head_) = node->next;
+      (node->next ? node->next->prev : tail_) = node->prev;
+      node->prev = node->next = nullptr;
+    }
+
+    void linkFront(Node* node) {
+      node->next = head_;
+      if (head_) head_->prev = node;
+      head_ = node;
+      if (!tail_) tail_ = node;
+    }
+
+    void moveToFront(Node* node) {
+      if (node == head_) return;
+      unlink(node);
+      linkFront(node);
+    }
+
+    void evict() {
+      auto node = tail_;
+      unlink(node);
+      map_.erase(node->startLoc);
+      ++stats_.evictions;
+    }
+
+    // the nodes are stable, rehashing does not move the elements.
+    std::unordered_map<SourceLocation, Node> map_;
+    std::uint32_t* pinCount_;
+    Node* head_ = nullptr;
+    Node* tail_ = nullptr;
+    std::size_t capacity_ = ParserConfiguration{}.astCacheCapacity;
+    ASTCacheStats stats_;
   };
 
-  CachedAST<ClassSpecifierAST> class_specifiers_;
-  CachedAST<ElaboratedTypeSpecifierAST> elaborated_type_specifiers_;
-  CachedAST<ExpressionAST> cast_expressions_;
-  CachedAST<NestedNameSpecifierAST> nested_name_specifiers_;
-  CachedAST<ParameterDeclarationClauseAST> parameter_declaration_clauses_;
-  CachedAST<TemplateArgumentAST> template_arguments_;
+  CachedAST<ClassSpecifierAST> class_specifiers_{&astPinCount_};
+  CachedAST<ElaboratedTypeSpecifierAST> elaborated_type_specifiers_{
+      &astPinCount_};
+  CachedAST<ExpressionAST> cast_expressions_{&astPinCount_};
+  CachedAST<NestedNameSpecifierAST> nested_name_specifiers_{&astPinCount_};
+  CachedAST<ParameterDeclarationClauseAST> parameter_declaration_clauses_{
+      &astPinCount_};
+  CachedAST<TemplateArgumentAST> template_arguments_{&astPinCount_};
+  CachedAST<SimpleTemplateIdAST> simple_template_ids_{&astPinCount_};
 
   // TODO: remove
   std::unordered_set<const Identifier*> concept_names_;
@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include <cstddef>
+
 namespace cxx {
 
 class Parser;
@@ -29,6 +31,35 @@ struct ParserConfiguration {
   bool checkTypes = false;
   bool fuzzyTemplateResolution = false;
   bool staticAssert = false;
+  // the maximum number of entries of each memoization table of the parser.
+  std::size_t astCacheCapacity = 100;
+  // make the memoization tables unbounded, and memoize the simple template
+  // ids too. Only the productions with a table are parsed at most once per
+  // start token. The other backtracking productions, e.g. the declaration
+  // and the expression statements or the operand of sizeof, are parsed again
+  // after a failed lookahead, so the parse is not guaranteed to be linear.
+  // On ordinary code this mode is slower and uses more memory.
+  bool packrat = false;
+  // parse only the declarations. The function bodies are skipped and can be
+  // parsed on demand with TranslationUnit::parseFunctionBody().
+  bool skipFunctionBodies = false;
+  // record the top level declarations and the symbols they declare, so the
+  // source can be edited with TranslationUnit::applyEdit().
+  bool incremental = false;
+};
+
+struct ASTCacheStats {
+  std::size_t hits = 0;
+  std::size_t misses = 0;
+  std::size_t evictions = 0;
+};
+
+struct ParserStats {
+  // the speculative parses, and the ones that failed and were rewound.
+  std::size_t lookaheads = 0;
+  std::size_t rewinds = 0;
+  // the arena bytes released by the failed lookaheads.
+  std::size_t reclaimedBytes = 0;
 };
 
 }  // namespace cxx
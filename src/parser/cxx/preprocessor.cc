@@ -26,7 +26,9 @@
 #include <cxx/diagnostics_client.h>
 #include <cxx/lexer.h>
 #include <cxx/literals.h>
+#include <cxx/private/memory_mapped_file.h>
 #include <cxx/private/path.h>
+#include <cxx/private/stopwatch.h>
 
 // fmt
 #include <cxx/private/format.h>
@@ -37,18 +39,28 @@
 // stl
 #include <cxx/preprocessor.h>
 
+#include <algorithm>
 #include <cassert>
+#include <cstdio>
+#include <cstring>
 #include <forward_list>
 #include <fstream>
 #include <functional>
 #include <iostream>
 #include <optional>
-#include <set>
+#include <random>
+#include <ranges>
+#include <span>
 #include <sstream>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <variant>
 
+#ifndef CXX_NO_THREADS
+#include <mutex>
+#endif
+
 namespace {
 
 std::unordered_set<std::string_view> builtinMacros{
@@ -158,35 +170,6 @@ std::unordered_set<std::string_view> enabledFeatures{
     "cxx_variadic_templates",
 };
 
-class Hideset {
- public:
-  Hideset(const Hideset &other) = default;
-  auto operator=(const Hideset &other) -> Hideset & = default;
-
-  Hideset(Hideset &&other) = default;
-  auto operator=(Hideset &&other) -> Hideset & = default;
-
-  Hideset() = default;
-
-  explicit Hideset(std::set<std::string_view> names)
-      : names_(std::move(names)) {}
-
-  [[nodiscard]] auto contains(const std::string_view &name) const -> bool {
-    return names_.contains(name);
-  }
-
-  [[nodiscard]] auto names() const -> const std::set<std::string_view> & {
-    return names_;
-  };
-
-  auto operator==(const Hideset &other) const -> bool {
-    return names_ == other.names_;
-  }
-
- private:
-  std::set<std::string_view> names_;
-};
-
 struct SystemInclude {
   std::string fileName;
 
@@ -208,98 +191,87 @@ using Include = std::variant<std::monostate, SystemInclude, QuoteInclude>;
 
 }  // namespace
 
-template <>
-struct std::less<Hideset> {
-  using is_transparent = void;
+namespace cxx {
 
-  auto operator()(const Hideset &hideset, const Hideset &other) const -> bool {
-    return hideset.names() < other.names();
-  }
+namespace {
 
-  auto operator()(const Hideset &hideset,
-                  const std::set<std::string_view> &names) const -> bool {
-    return hideset.names() < names;
-  }
+struct SourceFile;
 
-  auto operator()(const std::set<std::string_view> &names,
-                  const Hideset &hideset) const -> bool {
-    return names < hideset.names();
-  }
+// A hideset is a sorted array of macro ids. Hidesets are hash-consed by the
+// preprocessor, so two hidesets are equal iff they have the same address.
+class Hideset final : public Managed {
+ public:
+  Hideset(const std::uint32_t *ids, std::uint32_t size, std::size_t hash)
+      : ids_(ids), size_(size), hash_(hash) {}
 
-  auto operator()(const Hideset &hideset, const std::string_view &name) const
-      -> bool {
-    return std::lexicographical_compare(begin(hideset.names()),
-                                        end(hideset.names()), &name, &name + 1);
+  [[nodiscard]] auto ids() const -> std::span<const std::uint32_t> {
+    return {ids_, size_};
   }
 
-  auto operator()(const std::string_view &name, const Hideset &hideset) const
-      -> bool {
-    return std::lexicographical_compare(
-        &name, &name + 1, begin(hideset.names()), end(hideset.names()));
-  }
-};
-
-template <>
-struct std::hash<Hideset> {
-  using is_transparent = void;
+  [[nodiscard]] auto hash() const -> std::size_t { return hash_; }
 
-  template <typename T>
-  void hash_combine(std::size_t &seed, const T &val) const {
-    seed ^= std::hash<T>()(val) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  [[nodiscard]] auto contains(std::uint32_t id) const -> bool {
+    return std::binary_search(ids_, ids_ + size_, id);
   }
 
-  auto operator()(const Hideset &hideset) const -> std::size_t {
-    return operator()(hideset.names());
-  }
-
-  auto operator()(const std::set<std::string_view> &names) const
-      -> std::size_t {
-    std::size_t seed = 0;
-    for (const auto &name : names) hash_combine(seed, name);
+  static auto hash(std::span<const std::uint32_t> ids) -> std::size_t {
+    std::size_t seed = ids.size();
+    for (auto id : ids) {
+      seed ^= std::hash<std::uint32_t>()(id) + 0x9e3779b9 + (seed << 6) +
+              (seed >> 2);
+    }
     return seed;
   }
 
-  auto operator()(const std::string_view &name) const -> std::size_t {
-    std::size_t seed = 0;
-    hash_combine(seed, name);
-    return seed;
-  }
+ private:
+  const std::uint32_t *ids_;
+  std::uint32_t size_;
+  std::size_t hash_;
+};
+
+struct HidesetKey {
+  std::span<const std::uint32_t> ids;
+  std::size_t hash;
 };
 
-template <>
-struct std::equal_to<Hideset> {
+struct HidesetHash {
   using is_transparent = void;
 
-  auto operator()(const Hideset &hideset, const Hideset &other) const -> bool {
-    return hideset.names() == other.names();
+  auto operator()(const Hideset *hideset) const -> std::size_t {
+    return hideset->hash();
   }
 
-  auto operator()(const Hideset &hideset,
-                  const std::set<std::string_view> &names) const -> bool {
-    return hideset.names() == names;
+  auto operator()(const HidesetKey &key) const -> std::size_t {
+    return key.hash;
   }
+};
+
+struct HidesetEqual {
+  using is_transparent = void;
 
-  auto operator()(const std::set<std::string_view> &names,
-                  const Hideset &hideset) const -> bool {
-    return hideset.names() == names;
+  auto operator()(const Hideset *hideset, const Hideset *other) const -> bool {
+    return hideset == other;
   }
 
-  auto operator()(const Hideset &hideset, const std::string_view &name) const
+  auto operator()(const HidesetKey &key, const Hideset *hideset) const
       -> bool {
-    return hideset.names().size() == 1 && *hideset.names().begin() == name;
+    return key.hash == hideset->hash() &&
+           std::ranges::equal(key.ids, hideset->ids());
   }
 
-  auto operator()(const std::string_view &name, const Hideset &hideset) const
+  auto operator()(const Hideset *hideset, const HidesetKey &key) const
       -> bool {
-    return hideset.names().size() == 1 && *hideset.names().begin() == name;
+    return operator()(key, hideset);
   }
 };
 
-namespace cxx {
-
-namespace {
-
-struct SourceFile;
+template <typename T, typename U>
+struct PairHash {
+  auto operator()(const std::pair<T, U> &p) const -> std::size_t {
+    const auto h = std::hash<T>()(p.first);
+    return h ^ (std::hash<U>()(p.second) + 0x9e3779b9 + (h << 6) + (h >> 2));
+  }
+};
 
 struct Tok final : Managed {
   std::string_view text;
@@ -340,6 +312,21 @@ struct Tok final : Managed {
     return tk;
   }
 
+  static auto FromCachedToken(Arena *pool, TokenKind kind,
+                              const std::string_view &text,
+                              std::uint32_t offset, std::uint32_t length,
+                              int sourceFile, bool bol, bool space) -> Tok * {
+    auto tk = new (pool) Tok();
+    tk->sourceFile = sourceFile;
+    tk->kind = kind;
+    tk->text = text;
+    tk->offset = offset;
+    tk->length = length;
+    tk->bol = bol;
+    tk->space = space;
+    return tk;
+  }
+
   static auto Gen(Arena *pool, TokenKind kind, const std::string_view &text,
                   const Hideset *hideset = nullptr) -> Tok * {
     auto tk = new (pool) Tok();
@@ -411,21 +398,28 @@ struct Macro {
 
 struct SourceFile {
   std::string fileName;
-  std::string source;
+  std::string_view source;
   std::vector<int> lines;
   const TokList *tokens = nullptr;
+  // the include guard and #pragma once of the file, detected once when the
+  // file is tokenized.
+  const TokList *headerProtection = nullptr;
+  bool pragmaOnce = false;
   int id;
 
-  SourceFile() noexcept = default;
-  SourceFile(const SourceFile &) noexcept = default;
-  auto operator=(const SourceFile &) noexcept -> SourceFile & = default;
-  SourceFile(SourceFile &&) noexcept = default;
-  auto operator=(SourceFile &&) noexcept -> SourceFile & = default;
+  SourceFile(const SourceFile &) = delete;
+  auto operator=(const SourceFile &) -> SourceFile & = delete;
 
-  SourceFile(std::string fileName, std::string source,
+  SourceFile(std::string fileName, std::string text, std::uint32_t id) noexcept
+      : fileName(std::move(fileName)), id(id), buffer_(std::move(text)) {
+    source = buffer_;
+  }
+
+  // the source references the contents of the mapped file, no copy is made.
+  SourceFile(std::string fileName, MemoryMappedFile file,
              std::uint32_t id) noexcept
-      : fileName(std::move(fileName)), source(std::move(source)), id(id) {
-    initLineMap();
+      : fileName(std::move(fileName)), id(id), mappedFile_(std::move(file)) {
+    source = mappedFile_.text();
   }
 
   void getTokenStartPosition(unsigned offset, unsigned *line, unsigned *column,
@@ -448,7 +442,16 @@ struct SourceFile {
     if (fileName) *fileName = this->fileName;
   }
 
- private:
+  // replaces the text of the file. The previous texts are kept alive, the
+  // tokens of the macros defined in the file refer to them.
+  void setText(std::string text) {
+    auto &buffer = edits_.emplace_back(
+        std::make_unique<std::string>(std::move(text)));
+    source = *buffer;
+    lines.clear();
+    initLineMap();
+  }
+
   void initLineMap() {
     std::size_t offset = 0;
 
@@ -464,6 +467,136 @@ struct SourceFile {
       lines.push_back(static_cast<int>(offset));
     }
   }
+
+ private:
+  std::string buffer_;
+  MemoryMappedFile mappedFile_;
+  std::vector<std::unique_ptr<std::string>> edits_;
+};
+
+#define TOKEN_COUNT(tk, _) +1
+constexpr std::uint32_t kTokenKindCount = 0 FOR_EACH_TOKEN(TOKEN_COUNT);
+#undef TOKEN_COUNT
+
+constexpr char kTokenCacheMagic[8] = {'c', 'x', 'x', 't', 'o', 'k', 's', 0};
+constexpr std::uint32_t kTokenCacheVersion = 1;
+
+// The layout of a token cache file is the header, followed by the file name
+// (padded to 4 bytes), the line table, the tokens and the text of the tokens
+// that are not a plain slice of the source (e.g. spliced lines).
+struct TokenCacheHeader {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t tokenKindCount;
+  std::uint64_t mtime;
+  std::uint64_t sourceSize;
+  std::uint64_t sourceHash;
+  std::uint32_t fileNameSize;
+  std::uint32_t lineCount;
+  std::uint32_t tokenCount;
+  std::uint32_t textSize;
+};
+
+struct CachedTok {
+  enum Flags : std::uint8_t {
+    kStartOfLine = 1 << 0,
+    kLeadingSpace = 1 << 1,
+    kClean = 1 << 2,
+  };
+
+  std::uint32_t offset = 0;
+  std::uint32_t length = 0;
+  std::uint32_t textOffset = 0;
+  std::uint32_t textLength = 0;
+  TokenKind kind = TokenKind::T_EOF_SYMBOL;
+  std::uint8_t flags = 0;
+  std::uint16_t reserved = 0;
+};
+
+struct TokenCacheData {
+  std::vector<CachedTok> tokens;
+  std::string text;
+};
+
+auto hashBytes(std::string_view bytes) -> std::uint64_t {
+  std::uint64_t hash = 0xcbf29ce484222325ull;
+  for (auto ch : bytes) {
+    hash ^= static_cast<std::uint8_t>(ch);
+    hash *= 0x100000001b3ull;
+  }
+  return hash;
+}
+
+auto alignTo4(std::size_t size) -> std::size_t { return (size + 3) & ~3; }
+
+constexpr char kPrecompiledHeaderMagic[8] = {'c', 'x', 'x', 'p', 'c', 'h', 0, 0};
+constexpr std::uint32_t kPrecompiledHeaderVersion = 3;
+
+class BinaryWriter {
+ public:
+  [[nodiscard]] auto data() const -> const std::string & { return data_; }
+
+  void bytes(std::string_view bytes) { data_.append(bytes); }
+
+  void u32(std::uint32_t value) {
+    data_.append(reinterpret_cast<const char *>(&value), sizeof(value));
+  }
+
+  void u64(std::uint64_t value) {
+    data_.append(reinterpret_cast<const char *>(&value), sizeof(value));
+  }
+
+  void str(std::string_view s) {
+    u32(static_cast<std::uint32_t>(s.size()));
+    data_.append(s);
+  }
+
+ private:
+  std::string data_;
+};
+
+class BinaryReader {
+ public:
+  explicit BinaryReader(std::string_view data) : data_(data) {}
+
+  [[nodiscard]] auto ok() const -> bool { return ok_; }
+
+  auto bytes(std::size_t size) -> std::string_view {
+    if (!ok_ || data_.size() - pos_ < size) {
+      ok_ = false;
+      return {};
+    }
+    auto result = data_.substr(pos_, size);
+    pos_ += size;
+    return result;
+  }
+
+  auto u32() -> std::uint32_t {
+    std::uint32_t value = 0;
+    auto b = bytes(sizeof(value));
+    if (ok_) std::memcpy(&value, b.data(), sizeof(value));
+    return value;
+  }
+
+  auto u64() -> std::uint64_t {
+    std::uint64_t value = 0;
+    auto b = bytes(sizeof(value));
+    if (ok_) std::memcpy(&value, b.data(), sizeof(value));
+    return value;
+  }
+
+  auto str() -> std::string_view { return bytes(u32()); }
+
+ private:
+  std::string_view data_;
+  std::size_t pos_ = 0;
+  bool ok_ = true;
+};
+
+struct ResolvedInclude {
+  std::optional<fs::path> path;
+  // the included file, once it has been opened.
+  SourceFile *sourceFile = nullptr;
 };
 
 }  // namespace
@@ -478,11 +611,25 @@ struct Preprocessor::Private {
   std::vector<std::string> systemIncludePaths_;
   std::vector<std::string> quoteIncludePaths_;
   std::unordered_map<std::string_view, Macro> macros_;
-  std::set<Hideset> hidesets;
+  std::unordered_map<std::string_view, std::uint32_t> macroIds_;
+  std::unordered_set<const Hideset *, HidesetHash, HidesetEqual> hidesets_;
+  std::unordered_map<std::pair<const Hideset *, std::uint32_t>,
+                     const Hideset *,
+                     PairHash<const Hideset *, std::uint32_t>>
+      unions_;
+  std::unordered_map<std::pair<const Hideset *, const Hideset *>,
+                     const Hideset *,
+                     PairHash<const Hideset *, const Hideset *>>
+      intersections_;
   std::forward_list<std::string> scratchBuffer_;
   std::unordered_set<std::string> pragmaOnceProtected_;
   std::unordered_map<std::string, std::string> ifndefProtectedFiles_;
   std::vector<std::unique_ptr<SourceFile>> sourceFiles_;
+  std::string tokenCacheDirectory_;
+  std::vector<const Tok *> precompiledTokens_;
+  // the configuration of the precompiled header, a header precompiled after
+  // it was included inherits it.
+  std::optional<std::uint64_t> precompiledConfiguration_;
   fs::path currentPath_;
   std::string currentFileName_;
   std::vector<bool> evaluating_;
@@ -491,6 +638,13 @@ struct Preprocessor::Private {
   std::string_view time_;
   std::function<bool(std::string)> fileExists_;
   std::function<std::string(std::string)> readFile_;
+  std::shared_ptr<FileSystemCache> fileSystemCache_ =
+      std::make_shared<FileSystemCache>();
+  // the resolved includes, keyed by the kind of the include, the current
+  // path of quote includes and the spelling of the file name.
+  std::unordered_map<std::string, ResolvedInclude> resolvedIncludes_;
+  mutable IncludeCacheStats includeCacheStats_;
+  PreprocessorStats stats_;
   std::function<void(const std::string &, int)> willIncludeHeader_;
   int counter_ = 0;
   int includeDepth_ = 0;
@@ -551,23 +705,80 @@ struct Preprocessor::Private {
     return nullptr;
   }
 
-  auto createSourceFile(std::string fileName, std::string source)
-      -> SourceFile * {
-    if (sourceFiles_.size() >= 4096) {
-      cxx_runtime_error("too many source files");
-    }
+  [[nodiscard]] auto nextSourceFileId() const -> int {
+    return static_cast<int>(sourceFiles_.size() + 1);
+  }
 
-    const int sourceFileId = static_cast<int>(sourceFiles_.size() + 1);
+  auto createSourceFile(std::string fileName, std::string source,
+                        TokenCacheData *cache = nullptr) -> SourceFile * {
+    return addSourceFile(
+        std::make_unique<SourceFile>(std::move(fileName), std::move(source),
+                                     nextSourceFileId()),
+        cache);
+  }
 
+  auto addSourceFile(std::unique_ptr<SourceFile> newSourceFile,
+                     TokenCacheData *cache = nullptr) -> SourceFile * {
     SourceFile *sourceFile =
-        &*sourceFiles_.emplace_back(std::make_unique<SourceFile>(
-            std::move(fileName), std::move(source), sourceFileId));
+        &*sourceFiles_.emplace_back(std::move(newSourceFile));
 
-    sourceFile->tokens = tokenize(sourceFile->source, sourceFileId, true);
+    sourceFile->initLineMap();
+
+    tokenizeSourceFile(sourceFile, cache);
 
     return sourceFile;
   }
 
+  // the files restored from a precompiled header are tokenized the first
+  // time they are included again.
+  void tokenizeSourceFile(SourceFile *sourceFile,
+                          TokenCacheData *cache = nullptr) {
+    sourceFile->tokens =
+        tokenize(sourceFile->source, sourceFile->id, true, cache);
+
+    checkHeaderProtection(sourceFile);
+  }
+
+  [[nodiscard]] auto readSourceFile(const fs::path &path) const
+      -> std::unique_ptr<SourceFile>;
+
+  auto openSourceFile(const fs::path &path) -> SourceFile *;
+
+  [[nodiscard]] auto lastWriteTime(const fs::path &path) const
+      -> std::uint64_t;
+
+  [[nodiscard]] auto absolutePath(const std::string &fileName) const
+      -> std::string;
+
+  [[nodiscard]] auto fileSize(const fs::path &path) const
+      -> std::optional<std::uint64_t>;
+
+  [[nodiscard]] auto tokenCacheFileName(const std::string &fileName) const
+      -> std::string;
+
+  auto loadCachedSourceFile(std::unique_ptr<SourceFile> &newSourceFile,
+                            std::uint64_t mtime) -> SourceFile *;
+
+  void storeCachedSourceFile(const SourceFile *sourceFile, std::uint64_t mtime,
+                             const TokenCacheData &cache) const;
+
+  void reportComment(int sourceFile, std::uint32_t offset,
+                     std::uint32_t length, bool bol, bool space);
+
+  void writeTok(BinaryWriter &out, const Tok *tk) const;
+  auto readTok(BinaryReader &in) -> const Tok *;
+
+  // the hash of the include paths and of the macros defined before the
+  // prefix header is preprocessed, i.e. the ones of the toolchain and of the
+  // command line.
+  [[nodiscard]] auto configurationHash() const -> std::uint64_t;
+
+  void writePrecompiledHeader(const std::vector<const Tok *> &tokens,
+                              std::uint64_t configuration,
+                              std::ostream &out) const;
+
+  auto readPrecompiledHeader(std::string_view data) -> bool;
+
   auto bol(const TokList *ts) const -> bool { return ts && ts->head->bol; }
 
   [[nodiscard]] auto lookat(const TokList *ts, auto... tokens) const -> bool {
@@ -633,13 +844,41 @@ struct Preprocessor::Private {
     return {};
   }
 
+  auto macroId(const std::string_view &name) -> std::uint32_t {
+    auto [it, inserted] = macroIds_.try_emplace(
+        name, static_cast<std::uint32_t>(macroIds_.size()));
+    return it->second;
+  }
+
+  [[nodiscard]] auto isHidden(const Tok *tk) const -> bool {
+    if (!tk->hideset) return false;
+    auto it = macroIds_.find(tk->text);
+    if (it == macroIds_.end()) return false;
+    return tk->hideset->contains(it->second);
+  }
+
   auto makeUnion(const Hideset *hs, const std::string_view &name)
       -> const Hideset * {
-    if (!hs) return get(name);
-    if (hs->names().contains(name)) return hs;
-    auto names = hs->names();
-    names.insert(name);
-    return get(std::move(names));
+    const auto id = macroId(name);
+
+    if (hs && hs->contains(id)) return hs;
+
+    auto &result = unions_[std::pair(hs, id)];
+
+    if (!result) {
+      std::vector<std::uint32_t> ids;
+
+      if (hs) {
+        ids.reserve(hs->ids().size() + 1);
+        ids.assign(hs->ids().begin(), hs->ids().end());
+      }
+
+      ids.insert(std::upper_bound(ids.begin(), ids.end(), id), id);
+
+      result = get(ids);
+    }
+
+    return result;
   }
 
   auto makeIntersection(const Hideset *hs, const Hideset *other)
@@ -647,24 +886,42 @@ struct Preprocessor::Private {
     if (!other || !hs) return nullptr;
     if (other == hs) return hs;
 
-    std::set<std::string_view> names;
+    if (other < hs) std::swap(hs, other);
 
-    std::set_intersection(begin(hs->names()), end(hs->names()),
-                          begin(other->names()), end(other->names()),
-                          std::inserter(names, names.begin()));
+    auto [it, inserted] = intersections_.try_emplace(std::pair(hs, other));
 
-    return get(std::move(names));
-  }
+    if (inserted) {
+      std::vector<std::uint32_t> ids;
+
+      std::set_intersection(hs->ids().begin(), hs->ids().end(),
+                            other->ids().begin(), other->ids().end(),
+                            std::back_inserter(ids));
 
-  auto get(std::set<std::string_view> names) -> const Hideset * {
-    if (names.empty()) return nullptr;
-    if (auto it = hidesets.find(names); it != hidesets.end()) return &*it;
-    return &*hidesets.emplace(std::move(names)).first;
+      it->second = get(ids);
+    }
+
+    return it->second;
   }
 
-  auto get(const std::string_view &name) -> const Hideset * {
-    if (auto it = hidesets.find(name); it != hidesets.end()) return &*it;
-    return &*hidesets.emplace(std::set{name}).first;
+  auto get(std::span<const std::uint32_t> ids) -> const Hideset * {
+    if (ids.empty()) return nullptr;
+
+    const HidesetKey key{ids, Hideset::hash(ids)};
+
+    if (auto it = hidesets_.find(key); it != hidesets_.end()) return *it;
+
+    auto data = static_cast<std::uint32_t *>(
+        pool_.allocate(ids.size() * sizeof(std::uint32_t)));
+
+    std::copy(ids.begin(), ids.end(), data);
+
+    auto hideset = new (&pool_)
+        Hideset(data, static_cast<std::uint32_t>(ids.size()), key.hash);
+
+    hidesets_.insert(hideset);
+    ++stats_.hidesets;
+
+    return hideset;
   }
 
   auto isStringLiteral(TokenKind kind) {
@@ -726,8 +983,18 @@ struct Preprocessor::Private {
   }
 
   [[nodiscard]] auto fileExists(const fs::path &file) const -> bool {
-    if (fileExists_) return fileExists_(file.string());
-    return fs::exists(file);
+    auto fileName = file.string();
+
+    if (auto exists = fileSystemCache_->fileExists(fileName)) return *exists;
+
+    ++includeCacheStats_.fileExistsCalls;
+
+    const auto exists =
+        fileExists_ ? fileExists_(fileName) : fs::exists(fileName);
+
+    fileSystemCache_->setFileExists(fileName, exists);
+
+    return exists;
   }
 
   [[nodiscard]] auto readFile(const fs::path &file) const -> std::string {
@@ -738,13 +1005,58 @@ struct Preprocessor::Private {
     return out.str();
   }
 
+  void checkHeaderProtection(SourceFile *sourceFile) const;
+
   auto checkHeaderProtection(const TokList *ts) const -> const TokList *;
 
   auto checkPragmaOnceProtected(const TokList *ts) const -> bool;
 
-  [[nodiscard]] auto resolve(const Include &include, bool next) const
+  [[nodiscard]] auto resolve(const Include &include, bool next)
+      -> std::optional<fs::path> {
+    auto resolved = resolveInclude(include, next);
+    if (!resolved) return std::nullopt;
+    return resolved->path;
+  }
+
+  [[nodiscard]] auto resolveInclude(const Include &include, bool next)
+      -> ResolvedInclude * {
+    if (!canResolveFiles_) return nullptr;
+
+    std::string key(next ? "n" : "i");
+
+    if (auto quoteInclude = std::get_if<QuoteInclude>(&include)) {
+      key += '"';
+      key += currentPath_.string();
+      key += '\0';
+      key += quoteInclude->fileName;
+    } else if (auto systemInclude = std::get_if<SystemInclude>(&include)) {
+      key += '<';
+      key += systemInclude->fileName;
+    } else {
+      return nullptr;
+    }
+
+    if (auto it = resolvedIncludes_.find(key); it != resolvedIncludes_.end()) {
+      ++includeCacheStats_.hits;
+      return &it->second;
+    }
+
+    ++includeCacheStats_.misses;
+
+    std::optional<fs::path> path;
+
+    {
+      ScopedStopwatch stopwatch(stats_.includeTime);
+      path = resolveUncached(include, next);
+    }
+
+    auto [it, inserted] =
+        resolvedIncludes_.emplace(std::move(key), ResolvedInclude{path});
+    return &it->second;
+  }
+
+  [[nodiscard]] auto resolveUncached(const Include &include, bool next) const
       -> std::optional<fs::path> {
-    if (!canResolveFiles_) return std::nullopt;
 
     struct Resolve {
       const Private *d;
@@ -806,6 +1118,23 @@ struct Preprocessor::Private {
     return std::visit(Resolve(this, next), include);
   }
 
+  [[nodiscard]] auto isProtected(const std::string &fileName) const -> bool {
+    if (pragmaOnceProtected_.contains(fileName)) return true;
+    auto it = ifndefProtectedFiles_.find(fileName);
+    return it != ifndefProtectedFiles_.end() && macros_.contains(it->second);
+  }
+
+  // the guards detected when the file was tokenized avoid the lookups of the
+  // files without #pragma once or include guards. The files restored from a
+  // precompiled header are not tokenized until they are included again.
+  [[nodiscard]] auto isProtected(const SourceFile *sourceFile) const -> bool {
+    if (sourceFile->tokens && !sourceFile->pragmaOnce &&
+        !sourceFile->headerProtection) {
+      return false;
+    }
+    return isProtected(sourceFile->fileName);
+  }
+
   auto isDefined(const std::string_view &id) const -> bool {
     if (macros_.contains(id)) return true;
     return builtinMacros.contains(id);
@@ -816,160 +1145,717 @@ struct Preprocessor::Private {
     return isDefined(tok->text);
   }
 
-  void defineMacro(const TokList *ts);
+  void defineMacro(const TokList *ts);
+
+  auto tokenize(const std::string_view &source, int sourceFile, bool bol,
+                TokenCacheData *cache = nullptr) -> const TokList *;
+
+  auto skipLine(const TokList *ts) -> const TokList *;
+
+  void expandFile(const SourceFile *sourceFile,
+                  const std::function<void(const Tok *)> &emitToken);
+
+  // converts tk to a Token. The previous token is held in pending, and is
+  // only passed to emitToken once it is known that tk is not a string
+  // literal concatenated to it.
+  void addToken(Token &pending, const Tok *tk,
+                const std::function<void(const Token &)> &emitToken);
+
+  auto expand(const TokList *ts) -> const TokList *;
+
+  void expand(const TokList *ts, TokList **&out);
+
+  void expand(const TokList *ts,
+              const std::function<void(const Tok *)> &emitToken);
+
+  auto expandOne(const TokList *ts,
+                 const std::function<void(const Tok *)> &emitToken)
+      -> const TokList *;
+
+  auto expandObjectLikeMacro(const TokList *&ts, const Macro *macro)
+      -> const TokList *;
+
+  auto expandFunctionLikeMacro(const TokList *&ts, const Macro *macro)
+      -> const TokList *;
+
+  auto substitude(const TokList *ts, const Macro *macro,
+                  const std::vector<const TokList *> &actuals,
+                  const Hideset *hideset, const TokList *os) -> const TokList *;
+
+  auto merge(const Tok *left, const Tok *right) -> const Tok *;
+
+  auto stringize(const TokList *ts) -> const Tok *;
+
+  auto instantiate(const TokList *ts, const Hideset *hideset)
+      -> const TokList *;
+
+  auto lookupMacro(const Tok *tk, const Macro *&macro) const -> bool;
+
+  auto lookupMacroArgument(const TokList *&ts, const Macro *macro,
+                           const std::vector<const TokList *> &actuals,
+                           const TokList *&actual) -> bool;
+
+  auto copyLine(const TokList *ts) -> const TokList *;
+
+  auto constantExpression(const TokList *ts) -> long;
+  auto conditionalExpression(const TokList *&ts) -> long;
+  auto binaryExpression(const TokList *&ts) -> long;
+  auto binaryExpressionHelper(const TokList *&ts, long lhs, int minPrec)
+      -> long;
+  auto unaryExpression(const TokList *&ts) -> long;
+  auto primaryExpression(const TokList *&ts) -> long;
+
+  auto readArguments(const TokList *ts, int formalCount,
+                     bool ignoreComma = false)
+      -> std::tuple<std::vector<const TokList *>, const TokList *,
+                    const Hideset *>;
+
+  auto string(std::string s) -> std::string_view;
+
+  void print(const TokList *ts, std::ostream &out) const;
+
+  void printLine(const TokList *ts, std::ostream &out, bool nl = true) const;
+};
+
+static auto clone(Arena *pool, const TokList *ts) -> const TokList * {
+  if (!ts) return nullptr;
+  return new (pool) TokList(ts->head, clone(pool, ts->tail));
+}
+
+static auto depth(const TokList *ts) -> int {
+  if (!ts) return 0;
+  return depth(ts->tail) + 1;
+}
+
+auto Preprocessor::Private::tokenize(const std::string_view &source,
+                                     int sourceFile, bool bol,
+                                     TokenCacheData *cache)
+    -> const TokList * {
+  ScopedStopwatch stopwatch(stats_.lexTime);
+  cxx::Lexer lex(source);
+  lex.setKeepComments(true);
+  lex.setPreprocessing(true);
+  const TokList *ts = nullptr;
+  auto it = &ts;
+  do {
+    lex();
+
+    if (cache) {
+      CachedTok cachedTok;
+      cachedTok.offset = lex.tokenPos();
+      cachedTok.length = lex.tokenLength();
+      cachedTok.kind = lex.tokenKind();
+
+      if (lex.tokenStartOfLine()) cachedTok.flags |= CachedTok::kStartOfLine;
+      if (lex.tokenLeadingSpace()) cachedTok.flags |= CachedTok::kLeadingSpace;
+
+      if (lex.tokenIsClean()) {
+        cachedTok.flags |= CachedTok::kClean;
+      } else {
+        cachedTok.textOffset = static_cast<std::uint32_t>(cache->text.size());
+        cachedTok.textLength = static_cast<std::uint32_t>(lex.text().size());
+        cache->text += lex.text();
+      }
+
+      cache->tokens.push_back(cachedTok);
+    }
+
+    if (lex.tokenKind() == TokenKind::T_COMMENT) {
+      reportComment(sourceFile, lex.tokenPos(), lex.tokenLength(),
+                    lex.tokenStartOfLine(), lex.tokenLeadingSpace());
+      continue;
+    }
+    auto tk = Tok::FromCurrentToken(&pool_, lex, sourceFile);
+    if (!lex.tokenIsClean()) tk->text = string(std::move(lex.text()));
+    *it = new (&pool_) TokList(tk);
+    it = const_cast<const TokList **>(&(*it)->tail);
+  } while (lex.tokenKind() != cxx::TokenKind::T_EOF_SYMBOL);
+  return ts;
+}
+
+void Preprocessor::Private::reportComment(int sourceFile, std::uint32_t offset,
+                                          std::uint32_t length, bool bol,
+                                          bool space) {
+  if (!commentHandler_) return;
+
+  TokenValue tokenValue{};
+
+  if (sourceFile) {
+    const SourceFile *file = sourceFiles_[sourceFile - 1].get();
+
+    auto tokenText = file->source.substr(offset, length);
+
+    tokenValue.literalValue = control_->commentLiteral(tokenText);
+  }
+
+  Token token(TokenKind::T_COMMENT, offset, length, tokenValue);
+  token.setFileId(sourceFile);
+  token.setLeadingSpace(space);
+  token.setStartOfLine(bol);
+  commentHandler_->handleComment(preprocessor_, token);
+}
+
+auto Preprocessor::Private::readSourceFile(const fs::path &path) const
+    -> std::unique_ptr<SourceFile> {
+  if (!readFile_) {
+    MemoryMappedFile file;
+
+    if (file.open(path.string())) {
+      return std::make_unique<SourceFile>(path.string(), std::move(file),
+                                          nextSourceFileId());
+    }
+  }
+
+  return std::make_unique<SourceFile>(path.string(), readFile(path),
+                                      nextSourceFileId());
+}
+
+auto Preprocessor::Private::openSourceFile(const fs::path &path)
+    -> SourceFile * {
+  std::unique_ptr<SourceFile> newSourceFile;
+
+  {
+    ScopedStopwatch stopwatch(stats_.includeTime);
+    newSourceFile = readSourceFile(path);
+  }
+
+  if (tokenCacheDirectory_.empty()) {
+    return addSourceFile(std::move(newSourceFile));
+  }
+
+  const auto mtime = lastWriteTime(path);
+
+  if (auto sourceFile = loadCachedSourceFile(newSourceFile, mtime)) {
+    ++stats_.tokenCacheHits;
+    return sourceFile;
+  }
+
+  ++stats_.tokenCacheMisses;
+
+  TokenCacheData cache;
+
+  auto sourceFile = addSourceFile(std::move(newSourceFile), &cache);
+
+  storeCachedSourceFile(sourceFile, mtime, cache);
+
+  return sourceFile;
+}
+
+auto Preprocessor::Private::lastWriteTime(const fs::path &path) const
+    -> std::uint64_t {
+#ifndef CXX_NO_FILESYSTEM
+  if (!readFile_) {
+    std::error_code ec;
+    const auto time = std::filesystem::last_write_time(path, ec);
+    if (!ec) return time.time_since_epoch().count();
+  }
+#endif
+  return 0;
+}
+
+auto Preprocessor::Private::absolutePath(const std::string &fileName) const
+    -> std::string {
+#ifndef CXX_NO_FILESYSTEM
+  // the files read with a custom reader have no working directory.
+  if (!readFile_) {
+    std::error_code ec;
+    const auto path = std::filesystem::absolute(fileName, ec);
+    if (!ec) return path.lexically_normal().string();
+  }
+#endif
+  return fileName;
+}
+
+auto Preprocessor::Private::fileSize(const fs::path &path) const
+    -> std::optional<std::uint64_t> {
+#ifndef CXX_NO_FILESYSTEM
+  if (!readFile_) {
+    std::error_code ec;
+    const auto size = std::filesystem::file_size(path, ec);
+    if (ec) return std::nullopt;
+    return size;
+  }
+#endif
+  if (!fileExists(path)) return std::nullopt;
+  return readFile(path).size();
+}
+
+auto Preprocessor::Private::tokenCacheFileName(
+    const std::string &fileName) const -> std::string {
+  return (fs::path(tokenCacheDirectory_) /
+          fmt::format("{:016x}.tokens", hashBytes(fileName)))
+      .string();
+}
+
+auto Preprocessor::Private::loadCachedSourceFile(
+    std::unique_ptr<SourceFile> &newSourceFile, std::uint64_t mtime)
+    -> SourceFile * {
+  const std::string &fileName = newSourceFile->fileName;
+  const std::string_view source = newSourceFile->source;
+
+  MemoryMappedFile file;
+
+  if (!file.open(tokenCacheFileName(fileName))) return nullptr;
+
+  TokenCacheHeader header;
+
+  if (file.size() < sizeof(header)) return nullptr;
+
+  std::memcpy(&header, file.data(), sizeof(header));
+
+  if (std::memcmp(header.magic, kTokenCacheMagic, sizeof(header.magic)) != 0)
+    return nullptr;
+
+  if (header.version != kTokenCacheVersion) return nullptr;
+  if (header.tokenKindCount != kTokenKindCount) return nullptr;
+  if (header.mtime != mtime) return nullptr;
+  if (header.sourceSize != source.size()) return nullptr;
+  if (header.sourceHash != hashBytes(source)) return nullptr;
+  if (header.tokenCount == 0) return nullptr;
+
+  const auto fileNameOffset = sizeof(header);
+  const auto linesOffset = fileNameOffset + alignTo4(header.fileNameSize);
+  const auto tokensOffset =
+      linesOffset + std::size_t(header.lineCount) * sizeof(std::int32_t);
+  const auto textOffset =
+      tokensOffset + std::size_t(header.tokenCount) * sizeof(CachedTok);
+
+  if (textOffset + header.textSize > file.size()) return nullptr;
+
+  if (file.text().substr(fileNameOffset, header.fileNameSize) != fileName)
+    return nullptr;
+
+  const auto tokens = reinterpret_cast<const CachedTok *>(
+      file.data() + tokensOffset);
+
+  const auto text = file.text().substr(textOffset, header.textSize);
+
+  for (std::uint32_t i = 0; i < header.tokenCount; ++i) {
+    const auto &tk = tokens[i];
+    if (static_cast<std::uint32_t>(tk.kind) >= kTokenKindCount) return nullptr;
+    if (std::uint64_t(tk.offset) + tk.length > source.size()) return nullptr;
+    if (std::uint64_t(tk.textOffset) + tk.textLength > text.size())
+      return nullptr;
+  }
+
+  if (tokens[header.tokenCount - 1].kind != TokenKind::T_EOF_SYMBOL)
+    return nullptr;
+
+  SourceFile *sourceFile =
+      &*sourceFiles_.emplace_back(std::move(newSourceFile));
+  const int sourceFileId = sourceFile->id;
+
+  sourceFile->lines.resize(header.lineCount);
+  std::memcpy(sourceFile->lines.data(), file.data() + linesOffset,
+              sourceFile->lines.size() * sizeof(std::int32_t));
+
+  const std::string_view sourceText = sourceFile->source;
+
+  const TokList *ts = nullptr;
+  auto it = &ts;
+
+  for (std::uint32_t i = 0; i < header.tokenCount; ++i) {
+    const auto &cachedTok = tokens[i];
+
+    const bool bol = cachedTok.flags & CachedTok::kStartOfLine;
+    const bool space = cachedTok.flags & CachedTok::kLeadingSpace;
+
+    if (cachedTok.kind == TokenKind::T_COMMENT) {
+      reportComment(sourceFileId, cachedTok.offset, cachedTok.length, bol,
+                    space);
+      continue;
+    }
+
+    const auto tokenText =
+        cachedTok.flags & CachedTok::kClean
+            ? sourceText.substr(cachedTok.offset, cachedTok.length)
+            : string(std::string(
+                  text.substr(cachedTok.textOffset, cachedTok.textLength)));
+
+    auto tk = Tok::FromCachedToken(&pool_, cachedTok.kind, tokenText,
+                                   cachedTok.offset, cachedTok.length,
+                                   sourceFileId, bol, space);
+
+    *it = new (&pool_) TokList(tk);
+    it = const_cast<const TokList **>(&(*it)->tail);
+  }
+
+  sourceFile->tokens = ts;
+
+  checkHeaderProtection(sourceFile);
+
+  return sourceFile;
+}
+
+void Preprocessor::Private::storeCachedSourceFile(
+    const SourceFile *sourceFile, std::uint64_t mtime,
+    const TokenCacheData &cache) const {
+  TokenCacheHeader header{};
+  std::memcpy(header.magic, kTokenCacheMagic, sizeof(header.magic));
+  header.version = kTokenCacheVersion;
+  header.tokenKindCount = kTokenKindCount;
+  header.mtime = mtime;
+  header.sourceSize = sourceFile->source.size();
+  header.sourceHash = hashBytes(sourceFile->source);
+  header.fileNameSize = static_cast<std::uint32_t>(sourceFile->fileName.size());
+  header.lineCount = static_cast<std::uint32_t>(sourceFile->lines.size());
+  header.tokenCount = static_cast<std::uint32_t>(cache.tokens.size());
+  header.textSize = static_cast<std::uint32_t>(cache.text.size());
+
+  std::string data;
+  data.append(reinterpret_cast<const char *>(&header), sizeof(header));
+  data.append(sourceFile->fileName);
+  data.resize(alignTo4(data.size()));
+  data.append(reinterpret_cast<const char *>(sourceFile->lines.data()),
+              sourceFile->lines.size() * sizeof(std::int32_t));
+  data.append(reinterpret_cast<const char *>(cache.tokens.data()),
+              cache.tokens.size() * sizeof(CachedTok));
+  data.append(cache.text);
+
+#ifndef CXX_NO_FILESYSTEM
+  std::error_code ec;
+  std::filesystem::create_directories(tokenCacheDirectory_, ec);
+#endif
+
+  // write to a temporary file and rename it, so concurrent readers never see
+  // a partially written cache entry.
+  const auto cacheFileName = tokenCacheFileName(sourceFile->fileName);
+  const auto tempFileName =
+      fmt::format("{}.{:08x}.tmp", cacheFileName, std::random_device()());
+
+  {
+    std::ofstream out(tempFileName, std::ios::binary);
+    if (!out) return;
+    out.write(data.data(), static_cast<std::streamsize>(data.size()));
+    if (!out) {
+      out.close();
+      std::remove(tempFileName.c_str());
+      return;
+    }
+  }
+
+  if (std::rename(tempFileName.c_str(), cacheFileName.c_str()) != 0) {
+    std::remove(tempFileName.c_str());
+  }
+}
+
+void Preprocessor::Private::writeTok(BinaryWriter &out, const Tok *tk) const {
+  enum Flags : std::uint32_t {
+    kStartOfLine = 1 << 8,
+    kLeadingSpace = 1 << 9,
+    kGenerated = 1 << 10,
+    kSourceText = 1 << 11,
+  };
+
+  std::uint32_t flags = static_cast<std::uint32_t>(tk->kind);
+  if (tk->bol) flags |= kStartOfLine;
+  if (tk->space) flags |= kLeadingSpace;
+  if (tk->generated) flags |= kGenerated;
+
+  // the text of most of the tokens is the slice of their source file
+  bool isSourceText = false;
+
+  if (tk->sourceFile > 0 && tk->sourceFile <= sourceFiles_.size()) {
+    std::string_view source = sourceFiles_[tk->sourceFile - 1]->source;
+    isSourceText = tk->offset + std::size_t(tk->length) <= source.size() &&
+                   source.substr(tk->offset, tk->length) == tk->text;
+  }
+
+  if (isSourceText) flags |= kSourceText;
+
+  out.u32(flags);
+  out.u32(tk->sourceFile);
+  out.u32(tk->offset);
+  out.u32(tk->length);
+
+  if (!isSourceText) out.str(tk->text);
+}
+
+auto Preprocessor::Private::readTok(BinaryReader &in) -> const Tok * {
+  const auto flags = in.u32();
+  const auto sourceFile = in.u32();
+  const auto offset = in.u32();
+  const auto length = in.u32();
+
+  const auto kind = static_cast<TokenKind>(flags & 0xff);
+
+  if (!in.ok() || (flags & 0xff) >= kTokenKindCount) return nullptr;
+  if (sourceFile > sourceFiles_.size()) return nullptr;
+
+  std::string_view text;
+
+  if (flags & (1 << 11)) {
+    if (!sourceFile) return nullptr;
+    std::string_view source = sourceFiles_[sourceFile - 1]->source;
+    if (offset + std::size_t(length) > source.size()) return nullptr;
+    text = source.substr(offset, length);
+  } else {
+    text = string(std::string(in.str()));
+    if (!in.ok()) return nullptr;
+  }
+
+  auto tk = Tok::FromCachedToken(&pool_, kind, text, offset, length,
+                                 sourceFile, flags & (1 << 8), flags & (1 << 9));
+  tk->generated = (flags & (1 << 10)) != 0;
+
+  return tk;
+}
+
+auto Preprocessor::Private::configurationHash() const -> std::uint64_t {
+  std::string config;
+
+  auto append = [&](std::string_view text, char sep = '\0') {
+    config += text;
+    config += sep;
+  };
+
+  for (const auto &path : systemIncludePaths_) append(path);
+  append("", '\1');
+
+  for (const auto &path : quoteIncludePaths_) append(path);
+  append("", '\1');
+
+  // the order of the macro table is not deterministic.
+  std::vector<std::string_view> names;
+  names.reserve(macros_.size());
+  for (const auto &[name, macro] : macros_) names.push_back(name);
+  std::ranges::sort(names);
+
+  for (auto name : names) {
+    const auto &macro = macros_.at(name);
+    append(name);
+    append(macro.objLike ? "" : macro.variadic ? "(...)" : "()");
+    for (auto formal : macro.formals) append(formal);
+    for (auto it = macro.body; it; it = it->tail) append(it->head->text);
+    append("", '\1');
+  }
+
+  return hashBytes(config);
+}
+
+void Preprocessor::Private::writePrecompiledHeader(
+    const std::vector<const Tok *> &tokens, std::uint64_t configuration,
+    std::ostream &out) const {
+  BinaryWriter w;
+
+  w.bytes(std::string_view(kPrecompiledHeaderMagic, 8));
+  w.u32(kPrecompiledHeaderVersion);
+  w.u32(kTokenKindCount);
+  w.u64(configuration);
+  w.u32(counter_);
+
+  // the files are read again from their absolute path when the header is
+  // included, it is rejected if any of them changed.
+  w.u32(static_cast<std::uint32_t>(sourceFiles_.size()));
+  for (const auto &sourceFile : sourceFiles_) {
+    w.str(sourceFile->fileName);
+    w.str(absolutePath(sourceFile->fileName));
+    w.u64(sourceFile->source.size());
+    w.u64(hashBytes(sourceFile->source));
+  }
+
+  w.u32(static_cast<std::uint32_t>(macros_.size()));
+  for (const auto &[name, macro] : macros_) {
+    w.str(name);
+    w.u32((macro.objLike ? 1 : 0) | (macro.variadic ? 2 : 0));
+    w.u32(static_cast<std::uint32_t>(macro.formals.size()));
+    for (const auto &formal : macro.formals) w.str(formal);
+    w.u32(static_cast<std::uint32_t>(depth(macro.body)));
+    for (auto it = macro.body; it; it = it->tail) writeTok(w, it->head);
+  }
+
+  w.u32(static_cast<std::uint32_t>(pragmaOnceProtected_.size()));
+  for (const auto &fileName : pragmaOnceProtected_) w.str(fileName);
+
+  w.u32(static_cast<std::uint32_t>(ifndefProtectedFiles_.size()));
+  for (const auto &[fileName, guard] : ifndefProtectedFiles_) {
+    w.str(fileName);
+    w.str(guard);
+  }
+
+  w.u32(static_cast<std::uint32_t>(tokens.size()));
+  for (auto tk : tokens) writeTok(w, tk);
+
+  out.write(w.data().data(), static_cast<std::streamsize>(w.data().size()));
+}
+
+auto Preprocessor::Private::readPrecompiledHeader(std::string_view data)
+    -> bool {
+  // the source files of the header must get the same ids they had when the
+  // header was precompiled.
+  if (!sourceFiles_.empty()) return false;
+
+  BinaryReader r(data);
+
+  if (r.bytes(8) != std::string_view(kPrecompiledHeaderMagic, 8)) return false;
+  if (r.u32() != kPrecompiledHeaderVersion) return false;
+  if (r.u32() != kTokenKindCount) return false;
+
+  // the header must have been precompiled with the same include paths and
+  // predefined macros.
+  const auto configuration = r.u64();
+  if (configuration != configurationHash()) return false;
 
-  auto tokenize(const std::string_view &source, int sourceFile, bool bol)
-      -> const TokList *;
+  const auto counter = r.u32();
 
-  auto skipLine(const TokList *ts) -> const TokList *;
+  auto failed = [this] {
+    sourceFiles_.clear();
+    return false;
+  };
 
-  auto expand(const TokList *ts, bool evaluateDirectives) -> const TokList *;
+  // the relative names that denote other files in the current directory
+  // are replaced by the absolute paths of the restored files.
+  std::unordered_map<std::string, std::string> renamed;
 
-  void expand(const TokList *ts, bool evaluateDirectives, TokList **&out);
+  auto restoredName = [&](std::string fileName) {
+    auto it = renamed.find(fileName);
+    return it != renamed.end() ? it->second : fileName;
+  };
 
-  void expand(const TokList *ts, bool evaluateDirectives,
-              const std::function<void(const Tok *)> &emitToken);
+  const auto sourceFileCount = r.u32();
+  for (std::uint32_t i = 0; r.ok() && i < sourceFileCount; ++i) {
+    auto fileName = std::string(r.str());
+    auto path = std::string(r.str());
+    const auto size = r.u64();
+    const auto hash = r.u64();
+    if (!r.ok()) break;
 
-  auto expandOne(const TokList *ts,
-                 const std::function<void(const Tok *)> &emitToken)
-      -> const TokList *;
+    // the header is stale if a restored file changed.
+    if (fileSize(path) != size) return failed();
 
-  auto expandObjectLikeMacro(const TokList *&ts, const Macro *macro)
-      -> const TokList *;
+    auto source = readFile(path);
+    if (source.size() != size || hashBytes(source) != hash) return failed();
 
-  auto expandFunctionLikeMacro(const TokList *&ts, const Macro *macro)
-      -> const TokList *;
+    if (absolutePath(fileName) != path) {
+      renamed.insert_or_assign(fileName, path);
+      fileName = std::move(path);
+    }
 
-  auto substitude(const TokList *ts, const Macro *macro,
-                  const std::vector<const TokList *> &actuals,
-                  const Hideset *hideset, const TokList *os) -> const TokList *;
+    const int sourceFileId = nextSourceFileId();
+    auto &sourceFile = sourceFiles_.emplace_back(std::make_unique<SourceFile>(
+        std::move(fileName), std::move(source), sourceFileId));
+    sourceFile->initLineMap();
+  }
 
-  auto merge(const Tok *left, const Tok *right) -> const Tok *;
+  if (!r.ok()) return failed();
 
-  auto stringize(const TokList *ts) -> const Tok *;
+  std::unordered_map<std::string_view, Macro> macros;
 
-  auto instantiate(const TokList *ts, const Hideset *hideset)
-      -> const TokList *;
+  const auto macroCount = r.u32();
+  for (std::uint32_t i = 0; r.ok() && i < macroCount; ++i) {
+    const auto name = string(std::string(r.str()));
+    const auto flags = r.u32();
 
-  auto lookupMacro(const Tok *tk, const Macro *&macro) const -> bool;
+    Macro macro;
+    macro.objLike = flags & 1;
+    macro.variadic = flags & 2;
 
-  auto lookupMacroArgument(const TokList *&ts, const Macro *macro,
-                           const std::vector<const TokList *> &actuals,
-                           const TokList *&actual) -> bool;
+    const auto formalCount = r.u32();
+    for (std::uint32_t j = 0; r.ok() && j < formalCount; ++j) {
+      macro.formals.push_back(string(std::string(r.str())));
+    }
 
-  auto copyLine(const TokList *ts) -> const TokList *;
+    const auto bodyLength = r.u32();
+    TokList *body = nullptr;
+    auto it = &body;
+    for (std::uint32_t j = 0; r.ok() && j < bodyLength; ++j) {
+      auto tk = readTok(r);
+      if (!tk) return failed();
+      *it = new (&pool_) TokList(tk);
+      it = const_cast<TokList **>(&(*it)->tail);
+    }
+    macro.body = body;
 
-  auto constantExpression(const TokList *ts) -> long;
-  auto conditionalExpression(const TokList *&ts) -> long;
-  auto binaryExpression(const TokList *&ts) -> long;
-  auto binaryExpressionHelper(const TokList *&ts, long lhs, int minPrec)
-      -> long;
-  auto unaryExpression(const TokList *&ts) -> long;
-  auto primaryExpression(const TokList *&ts) -> long;
+    macros.insert_or_assign(name, std::move(macro));
+  }
 
-  auto readArguments(const TokList *ts, int formalCount,
-                     bool ignoreComma = false)
-      -> std::tuple<std::vector<const TokList *>, const TokList *,
-                    const Hideset *>;
+  std::unordered_set<std::string> pragmaOnceProtected;
 
-  auto string(std::string s) -> std::string_view;
+  const auto pragmaOnceCount = r.u32();
+  for (std::uint32_t i = 0; r.ok() && i < pragmaOnceCount; ++i) {
+    pragmaOnceProtected.insert(restoredName(std::string(r.str())));
+  }
 
-  void print(const TokList *ts, std::ostream &out) const;
+  std::unordered_map<std::string, std::string> ifndefProtectedFiles;
 
-  void printLine(const TokList *ts, std::ostream &out, bool nl = true) const;
-};
+  const auto ifndefCount = r.u32();
+  for (std::uint32_t i = 0; r.ok() && i < ifndefCount; ++i) {
+    auto fileName = restoredName(std::string(r.str()));
+    auto guard = std::string(r.str());
+    ifndefProtectedFiles.insert_or_assign(std::move(fileName),
+                                          std::move(guard));
+  }
 
-static auto clone(Arena *pool, const TokList *ts) -> const TokList * {
-  if (!ts) return nullptr;
-  return new (pool) TokList(ts->head, clone(pool, ts->tail));
-}
+  std::vector<const Tok *> tokens;
 
-static auto depth(const TokList *ts) -> int {
-  if (!ts) return 0;
-  return depth(ts->tail) + 1;
-}
+  const auto tokenCount = r.u32();
+  for (std::uint32_t i = 0; r.ok() && i < tokenCount; ++i) {
+    auto tk = readTok(r);
+    if (!tk) return failed();
+    tokens.push_back(tk);
+  }
 
-auto Preprocessor::Private::tokenize(const std::string_view &source,
-                                     int sourceFile, bool bol)
-    -> const TokList * {
-  cxx::Lexer lex(source);
-  lex.setKeepComments(true);
-  lex.setPreprocessing(true);
-  const TokList *ts = nullptr;
-  auto it = &ts;
-  do {
-    lex();
+  if (!r.ok()) return failed();
 
-    if (lex.tokenKind() == TokenKind::T_COMMENT) {
-      if (commentHandler_) {
-        TokenValue tokenValue{};
+  // the macros defined before are the same, the configurations match, so the
+  // macros undefined by the prefix header are not restored.
+  macros_ = std::move(macros);
 
-        if (sourceFile) {
-          const SourceFile *file = sourceFiles_[sourceFile - 1].get();
+  pragmaOnceProtected_.merge(pragmaOnceProtected);
 
-          auto tokenText =
-              file->source.substr(lex.tokenPos(), lex.tokenLength());
+  for (auto &[fileName, guard] : ifndefProtectedFiles) {
+    ifndefProtectedFiles_.insert_or_assign(fileName, std::move(guard));
+  }
 
-          tokenValue.literalValue = control_->commentLiteral(tokenText);
-        }
+  precompiledTokens_ = std::move(tokens);
+  precompiledConfiguration_ = configuration;
+  counter_ = static_cast<int>(counter);
 
-        Token token(lex.tokenKind(), lex.tokenPos(), lex.tokenLength(),
-                    tokenValue);
-        token.setFileId(sourceFile);
-        token.setLeadingSpace(lex.tokenLeadingSpace());
-        token.setStartOfLine(lex.tokenStartOfLine());
-        commentHandler_->handleComment(preprocessor_, token);
-      }
-      continue;
-    }
-    auto tk = Tok::FromCurrentToken(&pool_, lex, sourceFile);
-    if (!lex.tokenIsClean()) tk->text = string(std::move(lex.text()));
-    *it = new (&pool_) TokList(tk);
-    it = const_cast<const TokList **>(&(*it)->tail);
-  } while (lex.tokenKind() != cxx::TokenKind::T_EOF_SYMBOL);
-  return ts;
+  return true;
 }
 
-auto Preprocessor::Private::expand(const TokList *ts, bool evaluateDirectives)
-    -> const TokList * {
+auto Preprocessor::Private::expand(const TokList *ts) -> const TokList * {
   TokList *tokens = nullptr;
   auto out = &tokens;
-  expand(ts, evaluateDirectives, out);
+  expand(ts, out);
   return tokens;
 }
 
-void Preprocessor::Private::expand(const TokList *ts, bool evaluateDirectives,
-                                   TokList **&out) {
-  expand(ts, evaluateDirectives, [&](auto tok) {
+void Preprocessor::Private::expand(const TokList *ts, TokList **&out) {
+  expand(ts, [&](auto tok) {
     *out = new (&pool_) TokList(tok);
     out = const_cast<TokList **>(&(*out)->tail);
   });
 }
 
-void Preprocessor::Private::expand(
-    const TokList *ts, bool evaluateDirectives,
+void Preprocessor::Private::expandFile(
+    const SourceFile *sourceFile,
     const std::function<void(const Tok *)> &emitToken) {
-  const TokList *headerProtection = nullptr;
+  const auto headerProtection = sourceFile->headerProtection;
   const auto headerProtectionLevel = evaluating_.size();
 
-  const auto start = ts;
+  fs::path path(sourceFile->fileName);
+  path.remove_filename();
 
-  if (evaluateDirectives) {
-    headerProtection = checkHeaderProtection(ts);
+  std::string fileName = sourceFile->fileName;
 
-    if (headerProtection) {
-      ifndefProtectedFiles_.insert_or_assign(currentFileName_,
-                                             headerProtection->head->text);
-    }
+  std::swap(currentPath_, path);
+  std::swap(currentFileName_, fileName);
+
+  if (headerProtection) {
+    ifndefProtectedFiles_.insert_or_assign(currentFileName_,
+                                           headerProtection->head->text);
   }
 
+  const TokList *ts = sourceFile->tokens;
+
   while (ts && !lookat(ts, TokenKind::T_EOF_SYMBOL)) {
     const auto tk = ts->head;
     const auto start = ts;
 
     const auto [skipping, evaluating] = state();
 
-    if (evaluateDirectives && tk->bol && match(ts, TokenKind::T_HASH)) {
+    if (tk->bol && match(ts, TokenKind::T_HASH)) {
       auto directive = ts;
 
 #if 0
@@ -991,28 +1877,30 @@ void Preprocessor::Private::expand(
       } else if (!skipping &&
                  (matchId(ts, "include") || matchId(ts, "include_next"))) {
         if (lookat(ts, TokenKind::T_IDENTIFIER)) {
-          ts = expand(copyLine(ts), /*directives=*/false);
+          ts = expand(copyLine(ts));
         }
 
         auto loc = ts;
         if (lookat(ts, TokenKind::T_EOF_SYMBOL)) loc = directive;
 
         const bool next = directive->head->text == "include_next";
-        std::optional<fs::path> path;
+        Include include;
         std::string file;
         if (lookat(ts, TokenKind::T_STRING_LITERAL)) {
           file = ts->head->text.substr(1, ts->head->text.length() - 2);
-          path = resolve(QuoteInclude(file), next);
+          include = QuoteInclude(file);
         } else if (match(ts, TokenKind::T_LESS)) {
           while (ts && !lookat(ts, TokenKind::T_EOF_SYMBOL) && !ts->head->bol) {
             if (match(ts, TokenKind::T_GREATER)) break;
             file += ts->head->text;
             ts = ts->tail;
           }
-          path = resolve(SystemInclude(file), next);
+          include = SystemInclude(file);
         }
 
-        if (!path) {
+        auto resolved = resolveInclude(include, next);
+
+        if (!resolved || !resolved->path) {
           auto errorLoc = loc ? loc : directive;
           error(errorLoc->head->token(),
                 fmt::format("file '{}' not found", file));
@@ -1020,45 +1908,41 @@ void Preprocessor::Private::expand(
           continue;
         }
 
-        std::string currentFileName = path->string();
+        // the files included before are known without a lookup of their path.
+        auto includedFile = resolved->sourceFile;
 
-        if (pragmaOnceProtected_.contains(currentFileName)) {
+        if (includedFile ? isProtected(includedFile)
+                         : isProtected(resolved->path->string())) {
+          ++includeCacheStats_.skippedIncludes;
           ts = skipLine(directive);
           continue;
         }
 
-        if (auto it = ifndefProtectedFiles_.find(currentFileName);
-            it != ifndefProtectedFiles_.end() && macros_.contains(it->second)) {
-          ts = skipLine(directive);
-          continue;
-        }
+        if (!includedFile) {
+          std::string currentFileName = resolved->path->string();
 
-        auto sourceFile = findSourceFile(currentFileName);
+          includedFile = findSourceFile(currentFileName);
 
-        if (!sourceFile) {
-          sourceFile = createSourceFile(path->string(), readFile(*path));
+          if (!includedFile) {
+            includedFile = openSourceFile(*resolved->path);
 
-          if (checkPragmaOnceProtected(sourceFile->tokens)) {
-            pragmaOnceProtected_.insert(currentFileName);
+            if (includedFile->pragmaOnce) {
+              pragmaOnceProtected_.insert(currentFileName);
+            }
           }
+
+          resolved->sourceFile = includedFile;
         }
 
+        if (!includedFile->tokens) tokenizeSourceFile(includedFile);
+
         ++includeDepth_;
 
         if (willIncludeHeader_) {
-          willIncludeHeader_(currentFileName, includeDepth_);
+          willIncludeHeader_(includedFile->fileName, includeDepth_);
         }
 
-        auto dirpath = *path;
-        dirpath.remove_filename();
-
-        std::swap(currentPath_, dirpath);
-        std::swap(currentFileName_, currentFileName);
-
-        expand(sourceFile->tokens, /*directives=*/true, emitToken);
-
-        std::swap(currentPath_, dirpath);
-        std::swap(currentFileName_, currentFileName);
+        expandFile(includedFile, emitToken);
 
         --includeDepth_;
 
@@ -1158,9 +2042,21 @@ void Preprocessor::Private::expand(
         warning(directive->head->token(), fmt::format("{}", out.str()));
       }
       ts = skipLine(ts);
-    } else if (evaluateDirectives && skipping) {
+    } else if (skipping) {
       ts = skipLine(ts->tail);
-    } else if (!evaluateDirectives && matchId(ts, "defined")) {
+    } else {
+      ts = expandOne(ts, emitToken);
+    }
+  }
+
+  std::swap(currentFileName_, fileName);
+  std::swap(currentPath_, path);
+}
+
+void Preprocessor::Private::expand(
+    const TokList *ts, const std::function<void(const Tok *)> &emitToken) {
+  while (ts && !lookat(ts, TokenKind::T_EOF_SYMBOL)) {
+    if (matchId(ts, "defined")) {
       auto value = false;
       if (match(ts, TokenKind::T_LPAREN)) {
         value = isDefined(ts->head);
@@ -1173,7 +2069,7 @@ void Preprocessor::Private::expand(
       auto t =
           Tok::Gen(&pool_, TokenKind::T_INTEGER_LITERAL, value ? "1" : "0");
       emitToken(t);
-    } else if (!evaluateDirectives && matchId(ts, "__has_include")) {
+    } else if (matchId(ts, "__has_include")) {
       std::string fn;
       expect(ts, TokenKind::T_LPAREN);
       auto literal = ts;
@@ -1194,7 +2090,7 @@ void Preprocessor::Private::expand(
       auto t =
           Tok::Gen(&pool_, TokenKind::T_INTEGER_LITERAL, value ? "1" : "0");
       emitToken(t);
-    } else if (!evaluateDirectives && matchId(ts, "__has_include_next")) {
+    } else if (matchId(ts, "__has_include_next")) {
       std::string fn;
       expect(ts, TokenKind::T_LPAREN);
       auto literal = ts;
@@ -1215,7 +2111,7 @@ void Preprocessor::Private::expand(
       auto t =
           Tok::Gen(&pool_, TokenKind::T_INTEGER_LITERAL, value ? "1" : "0");
       emitToken(t);
-    } else if (!evaluateDirectives && matchId(ts, "__has_extension")) {
+    } else if (matchId(ts, "__has_extension")) {
       expect(ts, TokenKind::T_LPAREN);
       const auto id = expectId(ts);
       expect(ts, TokenKind::T_RPAREN);
@@ -1223,7 +2119,7 @@ void Preprocessor::Private::expand(
       auto t =
           Tok::Gen(&pool_, TokenKind::T_INTEGER_LITERAL, enabled ? "1" : "0");
       emitToken(t);
-    } else if (!evaluateDirectives && matchId(ts, "__has_feature")) {
+    } else if (matchId(ts, "__has_feature")) {
       expect(ts, TokenKind::T_LPAREN);
       auto id = expectId(ts);
       expect(ts, TokenKind::T_RPAREN);
@@ -1231,7 +2127,7 @@ void Preprocessor::Private::expand(
       auto t =
           Tok::Gen(&pool_, TokenKind::T_INTEGER_LITERAL, enabled ? "1" : "0");
       emitToken(t);
-    } else if (!evaluateDirectives && matchId(ts, "__has_builtin")) {
+    } else if (matchId(ts, "__has_builtin")) {
       expect(ts, TokenKind::T_LPAREN);
       auto id = expectId(ts);
       expect(ts, TokenKind::T_RPAREN);
@@ -1239,7 +2135,7 @@ void Preprocessor::Private::expand(
       auto t =
           Tok::Gen(&pool_, TokenKind::T_INTEGER_LITERAL, enabled ? "1" : "0");
       emitToken(t);
-    } else if (!evaluateDirectives && matchId(ts, "__has_attribute")) {
+    } else if (matchId(ts, "__has_attribute")) {
       expect(ts, TokenKind::T_LPAREN);
       auto id = expectId(ts);
       expect(ts, TokenKind::T_RPAREN);
@@ -1325,6 +2221,8 @@ auto Preprocessor::Private::expandObjectLikeMacro(const TokList *&ts,
 
   assert(macro->objLike);
 
+  ++stats_.macroExpansions;
+
   const auto hideset = makeUnion(tk->hideset, tk->text);
   auto expanded = substitude(macro->body, macro, {}, hideset, nullptr);
 
@@ -1352,6 +2250,8 @@ auto Preprocessor::Private::expandFunctionLikeMacro(const TokList *&ts,
 
   const Tok *tk = ts->head;
 
+  ++stats_.macroExpansions;
+
   auto [args, rest, hideset] = readArguments(ts, macro->formals.size());
 
   auto hs = makeUnion(makeIntersection(tk->hideset, hideset), tk->text);
@@ -1435,7 +2335,7 @@ auto Preprocessor::Private::substitude(
 
     const TokList *actual = nullptr;
     if (lookupMacroArgument(ts, macro, actuals, actual)) {
-      appendTokens(expand(actual, /*directives=*/false));
+      appendTokens(expand(actual));
       continue;
     }
 
@@ -1490,6 +2390,12 @@ auto Preprocessor::Private::lookupMacroArgument(
   return false;
 }
 
+void Preprocessor::Private::checkHeaderProtection(
+    SourceFile *sourceFile) const {
+  sourceFile->headerProtection = checkHeaderProtection(sourceFile->tokens);
+  sourceFile->pragmaOnce = checkPragmaOnceProtected(sourceFile->tokens);
+}
+
 auto Preprocessor::Private::checkPragmaOnceProtected(const TokList *ts) const
     -> bool {
   if (!ts) return false;
@@ -1538,7 +2444,7 @@ auto Preprocessor::Private::constantExpression(const TokList *ts) -> long {
   fmt::print("\n");
   fmt::print("\n**expanded to: ");
 #endif
-  auto e = expand(line, /*directives=*/false);
+  auto e = expand(line);
 #if 0
   print(e, std::cout);
   fmt::print("\n");
@@ -1902,7 +2808,7 @@ auto Preprocessor::Private::lookupMacro(const Tok *tk,
   if (!tk || tk->isNot(TokenKind::T_IDENTIFIER)) return false;
   auto it = macros_.find(tk->text);
   if (it != macros_.end()) {
-    const auto disabled = tk->hideset && tk->hideset->contains(tk->text);
+    const auto disabled = isHidden(tk);
     if (!disabled) {
       macro = &it->second;
       return true;
@@ -1965,6 +2871,41 @@ void Preprocessor::Private::printLine(const TokList *ts, std::ostream &out,
   if (nl) fmt::print(out, "\n");
 }
 
+struct FileSystemCache::Private {
+#ifndef CXX_NO_THREADS
+  mutable std::mutex mutex;
+#endif
+  std::unordered_map<std::string, bool> fileExists;
+};
+
+FileSystemCache::FileSystemCache() : d(std::make_unique<Private>()) {}
+
+FileSystemCache::~FileSystemCache() = default;
+
+auto FileSystemCache::fileExists(const std::string &fileName) const
+    -> std::optional<bool> {
+#ifndef CXX_NO_THREADS
+  std::lock_guard lock(d->mutex);
+#endif
+  auto it = d->fileExists.find(fileName);
+  if (it == d->fileExists.end()) return std::nullopt;
+  return it->second;
+}
+
+void FileSystemCache::setFileExists(const std::string &fileName, bool exists) {
+#ifndef CXX_NO_THREADS
+  std::lock_guard lock(d->mutex);
+#endif
+  d->fileExists.insert_or_assign(fileName, exists);
+}
+
+void FileSystemCache::clear() {
+#ifndef CXX_NO_THREADS
+  std::lock_guard lock(d->mutex);
+#endif
+  d->fileExists.clear();
+}
+
 Preprocessor::Preprocessor(Control *control,
                            DiagnosticsClient *diagnosticsClient)
     : d(std::make_unique<Private>()) {
@@ -2022,6 +2963,28 @@ void Preprocessor::setOmitLineMarkers(bool omitLineMarkers) {
 void Preprocessor::setFileExistsFunction(
     std::function<bool(std::string)> fileExists) {
   d->fileExists_ = std::move(fileExists);
+  d->fileSystemCache_ = std::make_shared<FileSystemCache>();
+  d->resolvedIncludes_.clear();
+}
+
+auto Preprocessor::fileSystemCache() const
+    -> const std::shared_ptr<FileSystemCache> & {
+  return d->fileSystemCache_;
+}
+
+void Preprocessor::setFileSystemCache(
+    std::shared_ptr<FileSystemCache> fileSystemCache) {
+  if (!fileSystemCache) fileSystemCache = std::make_shared<FileSystemCache>();
+  d->fileSystemCache_ = std::move(fileSystemCache);
+  d->resolvedIncludes_.clear();
+}
+
+auto Preprocessor::includeCacheStats() const -> const IncludeCacheStats & {
+  return d->includeCacheStats_;
+}
+
+auto Preprocessor::stats() const -> const PreprocessorStats & {
+  return d->stats_;
 }
 
 void Preprocessor::setReadFileFunction(
@@ -2029,31 +2992,146 @@ void Preprocessor::setReadFileFunction(
   d->readFile_ = std::move(readFile);
 }
 
+auto Preprocessor::tokenCacheDirectory() const -> const std::string & {
+  return d->tokenCacheDirectory_;
+}
+
+void Preprocessor::setTokenCacheDirectory(std::string tokenCacheDirectory) {
+  d->tokenCacheDirectory_ = std::move(tokenCacheDirectory);
+}
+
 void Preprocessor::setOnWillIncludeHeader(
     std::function<void(const std::string &, int)> willIncludeHeader) {
   d->willIncludeHeader_ = std::move(willIncludeHeader);
 }
 
-void Preprocessor::squeeze() { d->pool_.reset(); }
+void Preprocessor::Private::addToken(
+    Token &pending, const Tok *tk,
+    const std::function<void(const Token &)> &emitToken) {
+  ++stats_.tokens;
+
+  auto kind = tk->kind;
+  const auto fileId = tk->sourceFile;
+  TokenValue value{};
+
+  switch (tk->kind) {
+    case TokenKind::T_IDENTIFIER: {
+      kind = Lexer::classifyKeyword(tk->text);
+      if (kind == TokenKind::T_IDENTIFIER) {
+        if (auto builtin = Lexer::classifyBuiltin(tk->text);
+            builtin != BuiltinKind::T_IDENTIFIER) {
+          value.intValue = static_cast<int>(builtin);
+          kind = TokenKind::T_BUILTIN;
+        } else {
+          value.idValue = control_->getIdentifier(tk->text);
+        }
+      }
+      break;
+    }
+
+    case TokenKind::T_CHARACTER_LITERAL:
+      value.literalValue = control_->charLiteral(tk->text);
+      break;
+
+    case TokenKind::T_WIDE_STRING_LITERAL:
+      if (updateStringLiteralValue(pending, tk)) {
+        return;
+      }
+      value.literalValue = control_->wideStringLiteral(tk->text);
+      break;
+
+    case TokenKind::T_UTF8_STRING_LITERAL:
+      if (updateStringLiteralValue(pending, tk)) {
+        return;
+      }
+      value.literalValue = control_->utf8StringLiteral(tk->text);
+      break;
+
+    case TokenKind::T_UTF16_STRING_LITERAL:
+      if (updateStringLiteralValue(pending, tk)) {
+        return;
+      }
+      value.literalValue = control_->utf16StringLiteral(tk->text);
+      break;
+
+    case TokenKind::T_UTF32_STRING_LITERAL:
+      if (updateStringLiteralValue(pending, tk)) {
+        return;
+      }
+      value.literalValue = control_->utf32StringLiteral(tk->text);
+      break;
+
+    case TokenKind::T_STRING_LITERAL:
+      if (updateStringLiteralValue(pending, tk)) {
+        return;
+      }
+      value.literalValue = control_->stringLiteral(tk->text);
+      break;
+
+    case TokenKind::T_USER_DEFINED_STRING_LITERAL:
+      value.literalValue = control_->stringLiteral(tk->text);
+      break;
+
+    case TokenKind::T_INTEGER_LITERAL:
+      value.literalValue = control_->integerLiteral(tk->text);
+      break;
+
+    case TokenKind::T_FLOATING_POINT_LITERAL:
+      value.literalValue = control_->floatLiteral(tk->text);
+      break;
+
+    default:
+      break;
+  }  // switch
+
+  if (tk->kind == TokenKind::T_GREATER_GREATER) {
+    value.tokenKindValue = tk->kind;
+
+    Token token(TokenKind::T_GREATER, tk->offset, 1);
+    token.setFileId(fileId);
+    token.setLeadingSpace(tk->space);
+    token.setStartOfLine(tk->bol);
+    emitToken(pending);
+    emitToken(token);
+
+    pending = Token(TokenKind::T_GREATER, tk->offset + 1, 1);
+    pending.setFileId(fileId);
+  } else {
+    Token token(kind, tk->offset, tk->length, value);
+    token.setFileId(fileId);
+    token.setLeadingSpace(tk->space);
+    token.setStartOfLine(tk->bol);
+    emitToken(pending);
+    pending = token;
+  }
+}
+
+void Preprocessor::squeeze() {
+  d->hidesets_.clear();
+  d->unions_.clear();
+  d->intersections_.clear();
+  d->pool_.reset();
+}
 
 void Preprocessor::preprocess(std::string source, std::string fileName,
                               std::ostream &out) {
   assert(!d->findSourceFile(fileName));
   auto sourceFile = d->createSourceFile(std::move(fileName), std::move(source));
-  const auto sourceFileId = sourceFile->id;
 
-  std::string currentFileName = sourceFile->fileName;
+  TokList *expanded = nullptr;
+  auto it = &expanded;
 
-  fs::path path(sourceFile->fileName);
-  path.remove_filename();
+  auto emitToken = [&](const Tok *tk) {
+    *it = new (&d->pool_) TokList(tk);
+    it = const_cast<TokList **>(&(*it)->tail);
+    ++d->stats_.tokens;
+  };
 
-  std::swap(d->currentPath_, path);
-  std::swap(d->currentFileName_, currentFileName);
+  for (auto tk : d->precompiledTokens_) emitToken(tk);
 
-  const auto os = d->expand(sourceFile->tokens, /*directives*/ true);
+  d->expandFile(sourceFile, emitToken);
 
-  std::swap(d->currentFileName_, currentFileName);
-  std::swap(d->currentPath_, path);
+  const TokList *os = expanded;
 
   std::uint32_t outFile = 0;
   std::uint32_t outLine = -1;
@@ -2094,127 +3172,50 @@ void Preprocessor::preprocess(std::string source, std::string fileName,
 
 void Preprocessor::preprocess(std::string source, std::string fileName,
                               std::vector<Token> &tokens) {
+  preprocess(std::move(source), std::move(fileName),
+             [&](const Token &tk) { tokens.push_back(tk); });
+}
+
+void Preprocessor::preprocess(
+    std::string source, std::string fileName,
+    const std::function<void(const Token &)> &emitToken) {
   assert(!d->findSourceFile(fileName));
   auto sourceFile = d->createSourceFile(std::move(fileName), std::move(source));
-  const auto sourceFileId = sourceFile->id;
-
-  std::string currentFileName = sourceFile->fileName;
-
-  fs::path path(currentFileName);
-  path.remove_filename();
-
-  std::swap(d->currentPath_, path);
-  std::swap(d->currentFileName_, currentFileName);
-
-  const TokList *ts = sourceFile->tokens;
-
-  tokens.emplace_back(TokenKind::T_ERROR);
-
-  d->expand(ts, /*directives*/ true, [&](const Tok *tk) {
-    auto kind = tk->kind;
-    const auto fileId = tk->sourceFile;
-    TokenValue value{};
-
-    switch (tk->kind) {
-      case TokenKind::T_IDENTIFIER: {
-        kind = Lexer::classifyKeyword(tk->text);
-        if (kind == TokenKind::T_IDENTIFIER) {
-          if (auto builtin = Lexer::classifyBuiltin(tk->text);
-              builtin != BuiltinKind::T_IDENTIFIER) {
-            value.intValue = static_cast<int>(builtin);
-            kind = TokenKind::T_BUILTIN;
-          } else {
-            value.idValue = d->control_->getIdentifier(tk->text);
-          }
-        }
-        break;
-      }
-
-      case TokenKind::T_CHARACTER_LITERAL:
-        value.literalValue = d->control_->charLiteral(tk->text);
-        break;
-
-      case TokenKind::T_WIDE_STRING_LITERAL:
-        if (d->updateStringLiteralValue(tokens.back(), tk)) {
-          return;
-        }
-        value.literalValue = d->control_->wideStringLiteral(tk->text);
-        break;
-
-      case TokenKind::T_UTF8_STRING_LITERAL:
-        if (d->updateStringLiteralValue(tokens.back(), tk)) {
-          return;
-        }
-        value.literalValue = d->control_->utf8StringLiteral(tk->text);
-        break;
 
-      case TokenKind::T_UTF16_STRING_LITERAL:
-        if (d->updateStringLiteralValue(tokens.back(), tk)) {
-          return;
-        }
-        value.literalValue = d->control_->utf16StringLiteral(tk->text);
-        break;
+  Token pending(TokenKind::T_ERROR);
 
-      case TokenKind::T_UTF32_STRING_LITERAL:
-        if (d->updateStringLiteralValue(tokens.back(), tk)) {
-          return;
-        }
-        value.literalValue = d->control_->utf32StringLiteral(tk->text);
-        break;
+  auto addToken = [&](const Tok *tk) { d->addToken(pending, tk, emitToken); };
 
-      case TokenKind::T_STRING_LITERAL:
-        if (d->updateStringLiteralValue(tokens.back(), tk)) {
-          return;
-        }
-        value.literalValue = d->control_->stringLiteral(tk->text);
-        break;
+  for (auto tk : d->precompiledTokens_) addToken(tk);
 
-      case TokenKind::T_USER_DEFINED_STRING_LITERAL:
-        value.literalValue = d->control_->stringLiteral(tk->text);
-        break;
+  d->expandFile(sourceFile, addToken);
 
-      case TokenKind::T_INTEGER_LITERAL:
-        value.literalValue = d->control_->integerLiteral(tk->text);
-        break;
+  emitToken(pending);
 
-      case TokenKind::T_FLOATING_POINT_LITERAL:
-        value.literalValue = d->control_->floatLiteral(tk->text);
-        break;
+  Token eofToken(TokenKind::T_EOF_SYMBOL,
+                 static_cast<std::uint32_t>(sourceFile->source.size()));
+  eofToken.setFileId(sourceFile->id);
+  emitToken(eofToken);
+}
 
-      default:
-        break;
-    }  // switch
+void Preprocessor::precompileHeader(std::string source, std::string fileName,
+                                    std::ostream &out) {
+  assert(!d->findSourceFile(fileName));
 
-    if (tk->kind == TokenKind::T_GREATER_GREATER) {
-      value.tokenKindValue = tk->kind;
+  const auto configuration =
+      d->precompiledConfiguration_.value_or(d->configurationHash());
 
-      Token token(TokenKind::T_GREATER, tk->offset, 1);
-      token.setFileId(fileId);
-      token.setLeadingSpace(tk->space);
-      token.setStartOfLine(tk->bol);
-      tokens.push_back(token);
+  auto sourceFile = d->createSourceFile(std::move(fileName), std::move(source));
 
-      token = Token(TokenKind::T_GREATER, tk->offset + 1, 1);
-      token.setFileId(fileId);
-      token.setLeadingSpace(false);
-      token.setStartOfLine(false);
-      tokens.push_back(token);
-    } else {
-      Token token(kind, tk->offset, tk->length, value);
-      token.setFileId(fileId);
-      token.setLeadingSpace(tk->space);
-      token.setStartOfLine(tk->bol);
-      tokens.push_back(token);
-    }
-  });
+  std::vector<const Tok *> tokens = d->precompiledTokens_;
 
-  tokens.emplace_back(TokenKind::T_EOF_SYMBOL,
-                      static_cast<std::uint32_t>(sourceFile->source.size()));
+  d->expandFile(sourceFile, [&](const Tok *tk) { tokens.push_back(tk); });
 
-  tokens.back().setFileId(sourceFileId);
+  d->writePrecompiledHeader(tokens, configuration, out);
+}
 
-  std::swap(d->currentPath_, path);
-  std::swap(d->currentFileName_, currentFileName);
+auto Preprocessor::includePrecompiledHeader(std::string_view data) -> bool {
+  return d->readPrecompiledHeader(data);
 }
 
 auto Preprocessor::systemIncludePaths() const
@@ -2224,6 +3225,7 @@ auto Preprocessor::systemIncludePaths() const
 
 void Preprocessor::addSystemIncludePath(std::string path) {
   d->systemIncludePaths_.push_back(std::move(path));
+  d->resolvedIncludes_.clear();
 }
 
 void Preprocessor::defineMacro(const std::string &name,
@@ -2244,7 +3246,7 @@ void Preprocessor::printMacros(std::ostream &out) const {
     if (!macro.objLike) {
       fmt::print(out, "(");
       for (std::size_t i = 0; i < macro.formals.size(); ++i) {
-        if (i > 0) fmt::print(",");
+        if (i > 0) fmt::print(out, ",");
         fmt::print(out, "{}", macro.formals[i]);
       }
       if (macro.variadic) {
@@ -2306,6 +3308,70 @@ auto Preprocessor::getTextLine(const Token &token) const -> std::string_view {
   return textLine;
 }
 
+auto Preprocessor::sourceText(std::uint32_t fileId) const -> std::string_view {
+  if (fileId == 0) return {};
+  return d->sourceFiles_[fileId - 1]->source;
+}
+
+void Preprocessor::setSourceText(std::uint32_t fileId, std::string text) {
+  if (fileId == 0) return;
+  d->sourceFiles_[fileId - 1]->setText(std::move(text));
+}
+
+auto Preprocessor::tokenize(std::string_view text, std::uint32_t length,
+                            std::uint32_t fileId, std::uint32_t offset,
+                            std::vector<Token> &tokens, Token &next) -> bool {
+  // starts with a sentinel, the leading string literals of the text are not
+  // concatenated to the tokens before it.
+  std::vector<Token> result;
+  Token pending(TokenKind::T_ERROR);
+
+  auto emitToken = [&](const Token &tk) { result.push_back(tk); };
+
+  Lexer lex(text);
+  lex.setPreprocessing(true);
+
+  while (true) {
+    lex();
+
+    if (lex.tokenKind() == TokenKind::T_EOF_SYMBOL) break;
+    if (std::uint32_t(lex.tokenPos()) >= length) break;
+
+    // the last token must end before the text that follows it.
+    if (lex.tokenPos() + lex.tokenLength() > length) return false;
+
+    if (lex.tokenKind() == TokenKind::T_HASH ||
+        lex.tokenKind() == TokenKind::T_HASH_HASH) {
+      return false;
+    }
+
+    auto tk = Tok::FromCurrentToken(&d->pool_, lex, fileId);
+    tk->offset += offset;
+    if (!lex.tokenIsClean()) tk->text = d->string(std::move(lex.text()));
+
+    if (tk->is(TokenKind::T_IDENTIFIER) && d->isDefined(tk->text)) {
+      return false;
+    }
+
+    d->addToken(pending, tk, emitToken);
+  }
+
+  emitToken(pending);
+
+  // the adjacent string literals would be concatenated.
+  if (d->isStringLiteral(result.back().kind()) &&
+      d->isStringLiteral(lex.tokenKind())) {
+    return false;
+  }
+
+  next = Token(lex.tokenKind(), lex.tokenPos() + offset, lex.tokenLength());
+  next.setStartOfLine(lex.tokenStartOfLine());
+
+  tokens.insert(tokens.end(), result.begin() + 1, result.end());
+
+  return true;
+}
+
 auto Preprocessor::getTokenText(const Token &token) const -> std::string_view {
   if (token.fileId() == 0) return {};
   const SourceFile *file = d->sourceFiles_[token.fileId() - 1].get();
@@ -22,9 +22,13 @@
 
 #include <cxx/cxx_fwd.h>
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <iosfwd>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -50,6 +54,48 @@ class PreprocessorDelegate {
   virtual ~PreprocessorDelegate() = default;
 };
 
+struct IncludeCacheStats {
+  std::size_t hits = 0;
+  std::size_t misses = 0;
+  std::size_t fileExistsCalls = 0;
+  std::size_t skippedIncludes = 0;
+};
+
+// the work done by a preprocessor. The times are measured once per source
+// file and per include resolution.
+struct PreprocessorStats {
+  std::size_t tokens = 0;
+  std::size_t macroExpansions = 0;
+  std::size_t hidesets = 0;
+  // the included files restored from, or missing in, the token cache.
+  std::size_t tokenCacheHits = 0;
+  std::size_t tokenCacheMisses = 0;
+  // the time spent lexing the source files.
+  std::chrono::nanoseconds lexTime{};
+  // the time spent searching the include paths and reading the files.
+  std::chrono::nanoseconds includeTime{};
+};
+
+// caches the results of the file existence checks of the include resolution,
+// including the negative ones. A cache can be shared by the preprocessors of
+// translation units that use the same file system and file exists function.
+class FileSystemCache {
+ public:
+  FileSystemCache();
+  ~FileSystemCache();
+
+  [[nodiscard]] auto fileExists(const std::string &fileName) const
+      -> std::optional<bool>;
+
+  void setFileExists(const std::string &fileName, bool exists);
+
+  void clear();
+
+ private:
+  struct Private;
+  std::unique_ptr<Private> d;
+};
+
 class Preprocessor {
  public:
   Preprocessor(Preprocessor &&) noexcept = default;
@@ -78,6 +124,18 @@ class Preprocessor {
   void setFileExistsFunction(std::function<bool(std::string)> fileExists);
   void setReadFileFunction(std::function<std::string(std::string)> readFile);
 
+  [[nodiscard]] auto fileSystemCache() const
+      -> const std::shared_ptr<FileSystemCache> &;
+  void setFileSystemCache(std::shared_ptr<FileSystemCache> fileSystemCache);
+
+  [[nodiscard]] auto includeCacheStats() const -> const IncludeCacheStats &;
+
+  [[nodiscard]] auto stats() const -> const PreprocessorStats &;
+
+  // when set, the tokens of the included headers are cached in this directory
+  [[nodiscard]] auto tokenCacheDirectory() const -> const std::string &;
+  void setTokenCacheDirectory(std::string tokenCacheDirectory);
+
   void setOnWillIncludeHeader(
       std::function<void(const std::string &, int)> willIncludeHeader);
 
@@ -86,6 +144,26 @@ class Preprocessor {
   void preprocess(std::string source, std::string fileName,
                   std::vector<Token> &tokens);
 
+  // preprocesses the source and passes the tokens to emitToken as they are
+  // produced. Only the last token is held back, until the next one shows
+  // that no string literal is concatenated to it.
+  void preprocess(std::string source, std::string fileName,
+                  const std::function<void(const Token &)> &emitToken);
+
+  // preprocesses the given prefix header and writes the resulting macro
+  // definitions, include guards and tokens to out.
+  void precompileHeader(std::string source, std::string fileName,
+                        std::ostream &out);
+
+  // restores the state saved by precompileHeader(). The tokens of the prefix
+  // header are emitted before the tokens of the next preprocessed source.
+  // Must be called after the include paths and the macros are set up, and
+  // before any source file is preprocessed. The files of the header are read
+  // again from the absolute paths they had when it was precompiled. Returns
+  // false if the header was precompiled with other include paths or macros,
+  // or if the content of any of its files changed since.
+  [[nodiscard]] auto includePrecompiledHeader(std::string_view data) -> bool;
+
   [[nodiscard]] auto systemIncludePaths() const
       -> const std::vector<std::string> &;
 
@@ -108,6 +186,21 @@ class Preprocessor {
 
   [[nodiscard]] auto getTokenText(const Token &token) const -> std::string_view;
 
+  [[nodiscard]] auto sourceText(std::uint32_t fileId) const
+      -> std::string_view;
+
+  // replaces the text of a source file, e.g. to apply an edit to the main
+  // file. The file is not preprocessed again.
+  void setSourceText(std::uint32_t fileId, std::string text);
+
+  // tokenizes the first length bytes of text as if they started at the given
+  // offset of the source file, without preprocessing them, and returns the
+  // first token after them in next. Returns false if the tokens contain a
+  // directive or the name of a macro, or if a token crosses the end.
+  [[nodiscard]] auto tokenize(std::string_view text, std::uint32_t length,
+                              std::uint32_t fileId, std::uint32_t offset,
+                              std::vector<Token> &tokens, Token &next) -> bool;
+
   void squeeze();
 
  private:
@@ -0,0 +1,65 @@
+// Copyright (c) 2023 Roberto Raggi <roberto.raggi@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <cxx/cxx_fwd.h>
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace cxx {
+
+class MemoryMappedFile {
+ public:
+  MemoryMappedFile(const MemoryMappedFile&) = delete;
+  auto operator=(const MemoryMappedFile&) -> MemoryMappedFile& = delete;
+
+  MemoryMappedFile(MemoryMappedFile&& other) noexcept;
+  auto operator=(MemoryMappedFile&& other) noexcept -> MemoryMappedFile&;
+
+  MemoryMappedFile() = default;
+  ~MemoryMappedFile();
+
+  // maps the file in memory, or reads it when mmap is not available.
+  auto open(const std::string& fileName) -> bool;
+
+  void close();
+
+  [[nodiscard]] auto isOpen() const -> bool { return data_ != nullptr; }
+  [[nodiscard]] auto isMapped() const -> bool { return mapped_; }
+
+  [[nodiscard]] auto data() const -> const char* { return data_; }
+  [[nodiscard]] auto size() const -> std::size_t { return size_; }
+
+  [[nodiscard]] auto text() const -> std::string_view {
+    return std::string_view(data_, size_);
+  }
+
+ private:
+  const char* data_ = nullptr;
+  std::size_t size_ = 0;
+  std::string buffer_;
+  bool mapped_ = false;
+};
+
+}  // namespace cxx
@@ -22,10 +22,15 @@
 #include <cxx/scope.h>
 #include <cxx/symbols.h>
 
+#include <bit>
+
 namespace cxx {
 
 namespace {
 
+// scopes with up to kLinearScopeSize symbols are not hashed.
+constexpr std::size_t kLinearScopeSize = 8;
+
 struct AddTemplateSymbol {
   TemplateParametersSymbol* templateParameters;
 
@@ -97,17 +102,126 @@ void Scope::addSymbol(Symbol* symbol) {
 
   symbol->setEnclosingScope(this);
   symbol->setInsertionPoint(symbols_.size());
-  symbols_.emplace(symbol->name(), symbol);
+
+  if (auto last = find(symbol->name())) {
+    for (; last != symbol; last = last->link()) {
+      if (last->link()) continue;
+      symbol->setLink(nullptr);
+      last->setLink(symbol);
+      symbols_.push_back(symbol);
+      break;
+    }
+    return;
+  }
+
+  symbol->setLink(nullptr);
+  symbols_.push_back(symbol);
+
+  if (!table_.empty()) {
+    insert(symbol);
+  } else if (symbols_.size() > kLinearScopeSize) {
+    rehash(4 * kLinearScopeSize);
+  }
 }
 
 void Scope::removeSymbol(Symbol* symbol) {
-  auto [first, last] = symbols_.equal_range(symbol->name());
-  for (auto it = first; it != last; ++it) {
-    if (it->second == symbol) {
-      symbols_.erase(it);
-      break;
+  auto first = find(symbol->name());
+  if (!first) return;
+
+  if (first == symbol) {
+    if (!table_.empty()) {
+      const auto index = slot(symbol->name());
+      if (auto next = symbol->link()) {
+        table_[index].second = next;
+      } else {
+        erase(index);
+      }
+    }
+  } else {
+    auto previous = first;
+    while (previous->link() && previous->link() != symbol) {
+      previous = previous->link();
     }
+    if (!previous->link()) return;
+    previous->setLink(symbol->link());
   }
+
+  symbol->setLink(nullptr);
+  std::erase(symbols_, symbol);
+}
+
+auto Scope::find(const Name* name) const -> Symbol* {
+  if (table_.empty()) {
+    for (auto symbol : symbols_) {
+      if (symbol->name() == name) return symbol;
+    }
+    return nullptr;
+  }
+
+  return table_[slot(name)].second;
+}
+
+auto Scope::home(const Name* name) const -> std::size_t {
+  const auto key = static_cast<std::uint64_t>(
+      reinterpret_cast<std::uintptr_t>(name));
+  return static_cast<std::size_t>((key * 0x9e3779b97f4a7c15ull) >>
+                                  tableShift_);
+}
+
+auto Scope::slot(const Name* name) const -> std::size_t {
+  const auto mask = table_.size() - 1;
+  auto index = home(name);
+  while (table_[index].second && table_[index].first != name) {
+    index = (index + 1) & mask;
+  }
+  return index;
+}
+
+void Scope::insert(Symbol* symbol) {
+  // keep the load factor under 1/2, rehash() adds the new symbol.
+  if ((tableNames_ + 1) * 2 > table_.size()) {
+    rehash(table_.size() * 2);
+    return;
+  }
+
+  table_[slot(symbol->name())] = {symbol->name(), symbol};
+  ++tableNames_;
+}
+
+void Scope::erase(std::size_t index) {
+  // backward shift deletion, moves the following entries of the cluster
+  // into the hole when the hole is between their home slot and them.
+  const auto mask = table_.size() - 1;
+
+  table_[index] = {};
+  --tableNames_;
+
+  for (auto next = (index + 1) & mask; table_[next].second;
+       next = (next + 1) & mask) {
+    const auto distance = (next - home(table_[next].first)) & mask;
+    if (distance < ((next - index) & mask)) continue;
+    table_[index] = table_[next];
+    table_[next] = {};
+    index = next;
+  }
+}
+
+void Scope::rehash(std::size_t size) {
+  table_.assign(size, {});
+  tableShift_ = 64 - std::countr_zero(size);
+  tableNames_ = 0;
+
+  for (auto symbol : symbols_) {
+    auto& entry = table_[slot(symbol->name())];
+    if (entry.second) continue;
+    entry = {symbol->name(), symbol};
+    ++tableNames_;
+  }
+}
+
+auto ScopeSymbolIterator::operator++() -> ScopeSymbolIterator& {
+  symbol_ = symbol_->link();
+  return *this;
 }
 
 }  // namespace cxx
@@ -24,12 +24,44 @@
 #include <cxx/symbols_fwd.h>
 #include <cxx/types_fwd.h>
 
-#include <map>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <ranges>
+#include <utility>
 #include <vector>
 
 namespace cxx {
 
+// iterates over the symbols of a scope that have the same name, in the
+// order they were added to the scope.
+class ScopeSymbolIterator {
+ public:
+  using iterator_concept = std::forward_iterator_tag;
+  using value_type = Symbol*;
+  using difference_type = std::ptrdiff_t;
+
+  ScopeSymbolIterator() = default;
+  explicit ScopeSymbolIterator(Symbol* symbol) : symbol_(symbol) {}
+
+  auto operator*() const -> Symbol* { return symbol_; }
+
+  auto operator++() -> ScopeSymbolIterator&;
+
+  auto operator++(int) -> ScopeSymbolIterator {
+    auto it = *this;
+    ++*this;
+    return it;
+  }
+
+  auto operator==(const ScopeSymbolIterator&) const -> bool = default;
+
+  auto operator==(std::default_sentinel_t) const -> bool { return !symbol_; }
+
+ private:
+  Symbol* symbol_ = nullptr;
+};
+
 class Scope {
  public:
   explicit Scope(Scope* parent = nullptr);
@@ -46,20 +78,40 @@ class Scope {
   [[nodiscard]] auto owner() const -> Symbol* { return owner_; }
   void setOwner(Symbol* owner) { owner_ = owner; }
 
-  [[nodiscard]] auto symbols() const { return symbols_ | std::views::values; }
+  [[nodiscard]] auto symbols() const -> const std::vector<Symbol*>& {
+    return symbols_;
+  }
 
   [[nodiscard]] auto get(const Name* name) const {
-    auto [first, last] = symbols_.equal_range(name);
-    return std::ranges::subrange(first, last) | std::views::values;
+    return std::ranges::subrange(ScopeSymbolIterator{find(name)},
+                                 std::default_sentinel);
   }
 
   void addSymbol(Symbol* symbol);
   void removeSymbol(Symbol* symbol);
 
+ private:
+  // returns the first symbol with the given name.
+  [[nodiscard]] auto find(const Name* name) const -> Symbol*;
+
+  // returns the slot of the table that holds name, or the empty slot where
+  // it would be inserted.
+  [[nodiscard]] auto slot(const Name* name) const -> std::size_t;
+  [[nodiscard]] auto home(const Name* name) const -> std::size_t;
+
+  void insert(Symbol* symbol);
+  void erase(std::size_t index);
+  void rehash(std::size_t size);
+
  private:
   Scope* parent_ = nullptr;
   Symbol* owner_ = nullptr;
-  std::multimap<const Name*, Symbol*> symbols_;
+  std::vector<Symbol*> symbols_;
+  // open addressing hash table of the first symbol of each name. Small
+  // scopes are searched linearly and have no table.
+  std::vector<std::pair<const Name*, Symbol*>> table_;
+  std::size_t tableNames_ = 0;
+  int tableShift_ = 0;
 };
 
 }  // namespace cxx
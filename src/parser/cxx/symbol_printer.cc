@@ -129,16 +129,16 @@ struct DumpSymbols {
 
     fmt::print(out, "function");
 
-    if (symbol->isStatic()) fmt::print(" static");
-    if (symbol->isExtern()) fmt::print(" extern");
-    if (symbol->isFriend()) fmt::print(" friend");
-    if (symbol->isConstexpr()) fmt::print(" constexpr");
-    if (symbol->isConsteval()) fmt::print(" consteval");
-    if (symbol->isInline()) fmt::print(" inline");
-    if (symbol->isVirtual()) fmt::print(" virtual");
-    if (symbol->isExplicit()) fmt::print(" explicit");
-    if (symbol->isDeleted()) fmt::print(" deleted");
-    if (symbol->isDefaulted()) fmt::print(" defaulted");
+    if (symbol->isStatic()) fmt::print(out, " static");
+    if (symbol->isExtern()) fmt::print(out, " extern");
+    if (symbol->isFriend()) fmt::print(out, " friend");
+    if (symbol->isConstexpr()) fmt::print(out, " constexpr");
+    if (symbol->isConsteval()) fmt::print(out, " consteval");
+    if (symbol->isInline()) fmt::print(out, " inline");
+    if (symbol->isVirtual()) fmt::print(out, " virtual");
+    if (symbol->isExplicit()) fmt::print(out, " explicit");
+    if (symbol->isDeleted()) fmt::print(out, " deleted");
+    if (symbol->isDefaulted()) fmt::print(out, " defaulted");
 
     fmt::print(out, " {}\n", to_string(symbol->type(), symbol->name()));
 
@@ -154,10 +154,10 @@ struct DumpSymbols {
 
     fmt::print(out, "lambda");
 
-    if (symbol->isConstexpr()) fmt::print(" constexpr");
-    if (symbol->isConsteval()) fmt::print(" consteval");
-    if (symbol->isMutable()) fmt::print(" mutable");
-    if (symbol->isStatic()) fmt::print(" static");
+    if (symbol->isConstexpr()) fmt::print(out, " constexpr");
+    if (symbol->isConsteval()) fmt::print(out, " consteval");
+    if (symbol->isMutable()) fmt::print(out, " mutable");
+    if (symbol->isStatic()) fmt::print(out, " static");
 
     fmt::print(out, "{}\n", to_string(symbol->type(), symbol->name()));
 
@@ -201,14 +201,14 @@ struct DumpSymbols {
 
     fmt::print(out, "variable");
 
-    if (symbol->isStatic()) fmt::print(" static");
-    if (symbol->isThreadLocal()) fmt::print(" thread_local");
-    if (symbol->isExtern()) fmt::print(" extern");
-    if (symbol->isConstexpr()) fmt::print(" constexpr");
-    if (symbol->isConstinit()) fmt::print(" constinit");
-    if (symbol->isInline()) fmt::print(" inline");
+    if (symbol->isStatic()) fmt::print(out, " static");
+    if (symbol->isThreadLocal()) fmt::print(out, " thread_local");
+    if (symbol->isExtern()) fmt::print(out, " extern");
+    if (symbol->isConstexpr()) fmt::print(out, " constexpr");
+    if (symbol->isConstinit()) fmt::print(out, " constinit");
+    if (symbol->isInline()) fmt::print(out, " inline");
 
-    fmt::print(" {}\n", to_string(symbol->type(), symbol->name()));
+    fmt::print(out, " {}\n", to_string(symbol->type(), symbol->name()));
 
     if (symbol->templateParameters()) {
       dumpScope(symbol->templateParameters()->scope());
@@ -220,13 +220,13 @@ struct DumpSymbols {
 
     fmt::print(out, "field");
 
-    if (symbol->isStatic()) fmt::print(" static");
-    if (symbol->isThreadLocal()) fmt::print(" thread_local");
-    if (symbol->isConstexpr()) fmt::print(" constexpr");
-    if (symbol->isConstinit()) fmt::print(" constinit");
-    if (symbol->isInline()) fmt::print(" inline");
+    if (symbol->isStatic()) fmt::print(out, " static");
+    if (symbol->isThreadLocal()) fmt::print(out, " thread_local");
+    if (symbol->isConstexpr()) fmt::print(out, " constexpr");
+    if (symbol->isConstinit()) fmt::print(out, " constinit");
+    if (symbol->isInline()) fmt::print(out, " inline");
 
-    fmt::print(" {}\n", to_string(symbol->type(), symbol->name()));
+    fmt::print(out, " {}\n", to_string(symbol->type(), symbol->name()));
   }
 
   void operator()(ParameterSymbol* symbol) {
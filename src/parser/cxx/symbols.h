@@ -57,6 +57,10 @@ class Symbol {
   [[nodiscard]] auto insertionPoint() const -> int { return insertionPoint_; }
   void setInsertionPoint(int index) { insertionPoint_ = index; }
 
+  // the next symbol with the same name in the enclosing scope.
+  [[nodiscard]] auto link() const -> Symbol* { return link_; }
+  void setLink(Symbol* link) { link_ = link; }
+
 #define PROCESS_SYMBOL(S) \
   [[nodiscard]] auto is##S() const -> bool { return kind_ == SymbolKind::k##S; }
   CXX_FOR_EACH_SYMBOL(PROCESS_SYMBOL)
@@ -67,6 +71,7 @@ class Symbol {
   const Name* name_ = nullptr;
   const Type* type_ = nullptr;
   Scope* enclosingScope_ = nullptr;
+  Symbol* link_ = nullptr;
   int insertionPoint_ = 0;
 };
 
@@ -99,6 +104,10 @@ class NamespaceSymbol final : public Symbol {
     usingNamespaces_.push_back(usingNamespace);
   }
 
+  void removeUsingNamespace(NamespaceSymbol* usingNamespace) {
+    std::erase(usingNamespaces_, usingNamespace);
+  }
+
  private:
   std::unique_ptr<Scope> scope_;
   NamespaceSymbol* unnamedNamespace_ = nullptr;
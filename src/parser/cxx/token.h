@@ -92,23 +92,26 @@ class Token {
 
   auto isBuiltinTypeTrait() const -> bool;
 
+  // identifiers, builtins, literals and comments carry a value.
+  [[nodiscard]] static inline auto hasValue(TokenKind kind) -> bool;
+
  private:
-  std::uint64_t kind_ : 8;
-  std::uint64_t startOfLine_ : 1;
-  std::uint64_t leadingSpace_ : 1;
-  std::uint64_t fileId_ : 12;
-  std::uint64_t length_ : 17;
-  std::uint64_t offset_ : 25;
+  std::uint32_t kind_ : 8;
+  std::uint32_t startOfLine_ : 1;
+  std::uint32_t leadingSpace_ : 1;
+  std::uint32_t length_ : 22;
+  std::uint32_t fileId_;
+  std::uint32_t offset_;
   TokenValue value_;
 };
 
 inline Token::Token(TokenKind kind, unsigned offset, unsigned length,
                     TokenValue value)
-    : kind_(static_cast<std::uint64_t>(kind)),
+    : kind_(static_cast<std::uint32_t>(kind)),
       startOfLine_(0),
       leadingSpace_(0),
-      fileId_(0),
       length_(length),
+      fileId_(0),
       offset_(offset),
       value_(value) {}
 
@@ -117,7 +120,7 @@ inline auto Token::kind() const -> TokenKind {
 }
 
 inline void Token::setKind(TokenKind kind) {
-  kind_ = static_cast<std::uint64_t>(kind);
+  kind_ = static_cast<std::uint32_t>(kind);
 }
 
 inline auto Token::value() const -> TokenValue { return value_; }
@@ -154,4 +157,9 @@ inline auto Token::is(TokenKind k) const -> bool { return kind() == k; }
 
 inline auto Token::isNot(TokenKind k) const -> bool { return kind() != k; }
 
+inline auto Token::hasValue(TokenKind kind) -> bool {
+  return kind >= TokenKind::T_COMMENT &&
+         kind <= TokenKind::T_WIDE_STRING_LITERAL;
+}
+
 }  // namespace cxx
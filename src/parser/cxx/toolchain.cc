@@ -26,6 +26,16 @@
 
 namespace cxx {
 
+void ToolchainConfiguration::apply(Preprocessor* preprocessor) const {
+  for (const auto& path : systemIncludePaths) {
+    preprocessor->addSystemIncludePath(path);
+  }
+
+  for (const auto& [name, definition] : macros) {
+    preprocessor->defineMacro(name, definition);
+  }
+}
+
 Toolchain::Toolchain(Preprocessor* preprocessor) : preprocessor_(preprocessor) {
   setMemoryLayout(std::make_unique<MemoryLayout>(64));
 }
@@ -36,12 +46,38 @@ void Toolchain::setMemoryLayout(std::unique_ptr<MemoryLayout> memoryLayout) {
   memoryLayout_ = std::move(memoryLayout);
 }
 
+auto Toolchain::configuration(bool systemIncludePaths,
+                              bool systemCppIncludePaths)
+    -> ToolchainConfiguration {
+  ToolchainConfiguration configuration;
+
+  auto saved = std::exchange(configuration_, &configuration);
+
+  if (systemIncludePaths) addSystemIncludePaths();
+  if (systemCppIncludePaths) addSystemCppIncludePaths();
+  addPredefinedMacros();
+
+  configuration_ = saved;
+
+  return configuration;
+}
+
 void Toolchain::defineMacro(const std::string& name,
                             const std::string& definition) {
+  if (configuration_) {
+    configuration_->macros.emplace_back(name, definition);
+    return;
+  }
+
   preprocessor_->defineMacro(name, definition);
 }
 
 void Toolchain::addSystemIncludePath(std::string path) {
+  if (configuration_) {
+    configuration_->systemIncludePaths.push_back(std::move(path));
+    return;
+  }
+
   preprocessor_->addSystemIncludePath(std::move(path));
 }
 
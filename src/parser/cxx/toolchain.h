@@ -24,12 +24,23 @@
 
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace cxx {
 
 class Preprocessor;
 class MemoryLayout;
 
+// the include paths and the predefined macros of a toolchain, collected once
+// and added to the preprocessor of each translation unit.
+struct ToolchainConfiguration {
+  std::vector<std::string> systemIncludePaths;
+  std::vector<std::pair<std::string, std::string>> macros;
+
+  void apply(Preprocessor *preprocessor) const;
+};
+
 class Toolchain {
  public:
   Toolchain(const Toolchain &) = delete;
@@ -48,16 +59,27 @@ class Toolchain {
   virtual void addSystemCppIncludePaths() = 0;
   virtual void addPredefinedMacros() = 0;
 
+  // collects the include paths and the predefined macros, instead of adding
+  // them to the preprocessor.
+  [[nodiscard]] auto configuration(bool systemIncludePaths = true,
+                                   bool systemCppIncludePaths = true)
+      -> ToolchainConfiguration;
+
   [[nodiscard]] auto preprocessor() const -> Preprocessor * {
     return preprocessor_;
   }
 
+  void setPreprocessor(Preprocessor *preprocessor) {
+    preprocessor_ = preprocessor;
+  }
+
   void defineMacro(const std::string &name, const std::string &definition);
 
   void addSystemIncludePath(std::string path);
 
  private:
   Preprocessor *preprocessor_;
+  ToolchainConfiguration *configuration_ = nullptr;
   std::unique_ptr<MemoryLayout> memoryLayout_;
 };
 
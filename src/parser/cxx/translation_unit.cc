@@ -22,12 +22,16 @@
 
 // cxx
 #include <cxx/arena.h>
+#include <cxx/ast.h>
+#include <cxx/ast_image.h>
 #include <cxx/control.h>
+#include <cxx/flat_ast.h>
 #include <cxx/lexer.h>
 #include <cxx/literals.h>
 #include <cxx/names.h>
 #include <cxx/parser.h>
 #include <cxx/preprocessor.h>
+#include <cxx/private/stopwatch.h>
 #include <cxx/symbols.h>
 
 #ifndef CXX_NO_FLATBUFFERS
@@ -37,10 +41,44 @@
 
 #include <utf8/unchecked.h>
 
+#include <algorithm>
+#include <cassert>
+#include <cctype>
 #include <ostream>
+#include <ranges>
+#include <unordered_set>
 
 namespace cxx {
 
+namespace {
+
+// keeps the diagnostics of an edit until it is known to be applied.
+class DeferredDiagnosticsClient final : public DiagnosticsClient {
+ public:
+  void report(const Diagnostic& diagnostic) override {
+    diagnostics_.push_back(diagnostic);
+  }
+
+  [[nodiscard]] auto hasErrors() const -> bool {
+    return std::ranges::any_of(diagnostics_, [](const Diagnostic& diagnostic) {
+      return diagnostic.severity() == Severity::Error ||
+             diagnostic.severity() == Severity::Fatal;
+    });
+  }
+
+  void flush(DiagnosticsClient* diagnosticsClient) {
+    for (const auto& diagnostic : diagnostics_) {
+      diagnosticsClient->report(diagnostic);
+    }
+    diagnostics_.clear();
+  }
+
+ private:
+  std::vector<Diagnostic> diagnostics_;
+};
+
+}  // namespace
+
 TranslationUnit::TranslationUnit(Control* control,
                                  DiagnosticsClient* diagnosticsClient)
     : control_(control), diagnosticsClient_(diagnosticsClient) {
@@ -68,11 +106,66 @@ auto TranslationUnit::changeDiagnosticsClient(
 
 void TranslationUnit::setSource(std::string source, std::string fileName) {
   fileName_ = std::move(fileName);
-  preprocessor_->preprocess(std::move(source), fileName_, tokens_);
+
+  ScopedStopwatch stopwatch(stats_.preprocessTime);
+
+  // the tokens go to the token columns as they are preprocessed, they are
+  // not collected in a vector of Token first.
+  preprocessor_->preprocess(std::move(source), fileName_,
+                            [this](const Token& tk) { appendToken(tk); });
+}
+
+void TranslationUnit::appendToken(const Token& tk) {
+  const auto index = tokenKinds_.size();
+
+  if (index % 64 == 0) {
+    auto& block = tokenValueBlocks_.emplace_back();
+    block.firstValue = static_cast<std::uint32_t>(tokenValues_.size());
+  }
+
+  tokenKinds_.push_back(tk.kind());
+
+  auto& location = tokenLocations_.emplace_back();
+  location.offset = tk.offset();
+  location.length = tk.length();
+  location.startOfLine = tk.startOfLine();
+  location.leadingSpace = tk.leadingSpace();
+
+  if (Token::hasValue(tk.kind())) {
+    tokenValueBlocks_.back().mask |= std::uint64_t(1) << (index % 64);
+    tokenValues_.push_back(tk.value());
+  }
+
+  if (tokenFileIds_.empty() || tokenFileIds_.back().second != tk.fileId()) {
+    tokenFileIds_.emplace_back(static_cast<std::uint32_t>(index), tk.fileId());
+  }
+}
+
+void TranslationUnit::setTokenValue(SourceLocation loc, TokenValue value) {
+  const auto slot = tokenValueSlot(loc.index());
+  assert(slot);
+  *slot = value;
+}
+
+void TranslationUnit::replaceBuiltins(std::size_t start) {
+  for (const auto& [builtin, id] : replacedBuiltins_) {
+    TokenValue value;
+    value.idValue = id;
+
+    for (auto i = start; i < tokenKinds_.size(); ++i) {
+      if (tokenKinds_[i] != TokenKind::T_BUILTIN) continue;
+
+      const auto slot = tokenValueSlot(i);
+      if (slot->intValue != builtin) continue;
+
+      tokenKinds_[i] = TokenKind::T_IDENTIFIER;
+      *slot = value;
+    }
+  }
 }
 
 auto TranslationUnit::tokenLength(SourceLocation loc) const -> int {
-  const auto& tk = tokenAt(loc);
+  const auto tk = tokenAt(loc);
   if (tk.kind() == TokenKind::T_IDENTIFIER) {
     const std::string* id = tk.value().stringValue;
     return static_cast<int>(id->size());
@@ -82,18 +175,16 @@ auto TranslationUnit::tokenLength(SourceLocation loc) const -> int {
 
 auto TranslationUnit::identifier(SourceLocation loc) const
     -> const Identifier* {
-  const auto& tk = tokenAt(loc);
-  return tk.value().idValue;
+  return tokenValue(loc).idValue;
 }
 
 auto TranslationUnit::literal(SourceLocation loc) const -> const Literal* {
-  const auto& tk = tokenAt(loc);
-  return tk.value().literalValue;
+  return tokenValue(loc).literalValue;
 }
 
 auto TranslationUnit::tokenText(SourceLocation loc) const
     -> const std::string& {
-  const auto& tk = tokenAt(loc);
+  const auto tk = tokenAt(loc);
   switch (tk.kind()) {
     case TokenKind::T_IDENTIFIER:
       return tk.value().idValue->name();
@@ -111,28 +202,410 @@ auto TranslationUnit::tokenText(SourceLocation loc) const
 void TranslationUnit::getTokenStartPosition(SourceLocation loc, unsigned* line,
                                             unsigned* column,
                                             std::string_view* fileName) const {
+  if (!tokenPositions_.empty()) {
+    const auto& pos = tokenPositions_[loc.index()];
+    if (line) *line = pos.line;
+    if (column) *column = pos.column;
+    if (fileName) {
+      *fileName = pos.fileIndex ? tokenFileNames_[pos.fileIndex - 1]
+                                : std::string_view();
+    }
+    return;
+  }
+
   preprocessor_->getTokenStartPosition(tokenAt(loc), line, column, fileName);
 }
 
 void TranslationUnit::getTokenEndPosition(SourceLocation loc, unsigned* line,
                                           unsigned* column,
                                           std::string_view* fileName) const {
+  if (!tokenPositions_.empty()) {
+    const auto& pos = tokenPositions_[loc.index()];
+    if (line) *line = pos.endLine;
+    if (column) *column = pos.endColumn;
+    if (fileName) {
+      *fileName = pos.fileIndex ? tokenFileNames_[pos.fileIndex - 1]
+                                : std::string_view();
+    }
+    return;
+  }
+
   preprocessor_->getTokenEndPosition(tokenAt(loc), line, column, fileName);
 }
 
 auto TranslationUnit::parse(const ParserConfiguration& config) -> bool {
-  Parser parse(this);
-  parse.setConfig(config);
-  parse(ast_);
+  ScopedStopwatch stopwatch(stats_.parseTime);
+  imageReader_.reset();
+  parser_ = std::make_unique<Parser>(this);
+  parser_->setConfig(config);
+  parser_->parse(ast_);
+
+  stats_.parser = parser_->stats();
+  stats_.astCache = parser_->astCacheStats();
+
+  // the parser is kept to parse the skipped function bodies and the edits.
+  if (!config.skipFunctionBodies && !config.incremental) parser_.reset();
+
+  endOfFile_ = tokenCount() - 1;
+  garbageTokens_ = 0;
+
   return true;
 }
 
+auto TranslationUnit::parseFunctionBody(FunctionDefinitionAST* ast) -> bool {
+  if (imageReader_) return imageReader_->loadFunctionBody(ast);
+  if (!parser_) return false;
+  ScopedStopwatch stopwatch(stats_.parseTime);
+  return parser_->parseFunctionBody(ast);
+}
+
+auto TranslationUnit::applyEdit(std::uint32_t offset, std::uint32_t length,
+                                std::string_view text)
+    -> std::optional<std::pair<std::uint32_t, std::uint32_t>> {
+  auto unit = ast_cast<TranslationUnitAST>(ast_);
+  if (!unit || !parser_ || !parser_->config().incremental) return std::nullopt;
+
+  const auto fileId = tokenFileId(endOfFile_);
+  const auto source = preprocessor_->sourceText(fileId);
+
+  if (offset > source.size() || length > source.size() - offset) {
+    return std::nullopt;
+  }
+
+  // the range of the tokens of a declaration, and of its source text.
+  struct Range {
+    std::uint32_t firstToken = 0;
+    std::uint32_t lastToken = 0;
+    std::uint32_t start = 0;
+    std::uint32_t end = 0;
+  };
+
+  auto getRange = [&](DeclarationAST* ast) -> std::optional<Range> {
+    const auto [firstLoc, lastLoc] = parser_->declarationRange(ast);
+    if (!firstLoc || !(firstLoc < lastLoc)) return std::nullopt;
+
+    Range range;
+    range.firstToken = firstLoc.index();
+    range.lastToken = lastLoc.index();
+    if (tokenFileId(range.firstToken) != fileId) return std::nullopt;
+    if (tokenFileId(range.lastToken - 1) != fileId) return std::nullopt;
+
+    const auto& last = tokenLocations_[range.lastToken - 1];
+    range.start = tokenLocations_[range.firstToken].offset;
+    range.end = last.offset + last.length;
+    return range;
+  };
+
+  // the edits inside the braces of a namespace or of a linkage specification
+  // damage the declarations of its body, the declarations following them,
+  // in the enclosing bodies too, keep referring to the same symbols.
+  auto declarationList = &unit->declarationList;
+  std::vector<List<DeclarationAST*>*> following;
+
+  auto insideBraces = [&](SourceLocation lbraceLoc, SourceLocation rbraceLoc) {
+    if (!lbraceLoc || !rbraceLoc) return false;
+    if (tokenFileId(lbraceLoc.index()) != fileId) return false;
+    if (tokenFileId(rbraceLoc.index()) != fileId) return false;
+    const auto& lbrace = tokenLocations_[lbraceLoc.index()];
+    const auto& rbrace = tokenLocations_[rbraceLoc.index()];
+    return lbrace.offset + lbrace.length <= offset &&
+           offset + length <= rbrace.offset;
+  };
+
+  auto enclosingBody =
+      [&](DeclarationAST* ast) -> List<DeclarationAST*>** {
+    if (auto ns = ast_cast<NamespaceDefinitionAST>(ast)) {
+      if (!insideBraces(ns->lbraceLoc, ns->rbraceLoc)) return nullptr;
+      return &ns->declarationList;
+    }
+    if (auto linkage = ast_cast<LinkageSpecificationAST>(ast)) {
+      if (!insideBraces(linkage->lbraceLoc, linkage->rbraceLoc)) {
+        return nullptr;
+      }
+      return &linkage->declarationList;
+    }
+    return nullptr;
+  };
+
+  // the damaged declarations are the last declaration starting before the
+  // edit, up to the first declaration ending after it.
+  List<DeclarationAST*>** first = nullptr;
+
+  while (true) {
+    first = nullptr;
+
+    for (auto it = declarationList; *it; it = &(*it)->next) {
+      const auto range = getRange((*it)->value);
+      if (!range) continue;
+      if (range->start > offset) break;
+      first = it;
+    }
+
+    if (!first || !*first) break;
+
+    auto body = enclosingBody((*first)->value);
+    if (!body) break;
+
+    following.push_back((*first)->next);
+    declarationList = body;
+  }
+
+  if (!first) first = declarationList;
+  if (!*first) return std::nullopt;
+
+  std::vector<DeclarationAST*> damaged;
+  std::vector<Token> oldTokens;
+  std::uint32_t start = offset;
+  std::uint32_t end = offset + length;
+  List<DeclarationAST*>* last = nullptr;
+
+  auto addDamaged = [&](List<DeclarationAST*>* it) -> std::optional<Range> {
+    const auto range = getRange(it->value);
+    if (!range) return std::nullopt;
+
+    damaged.push_back(it->value);
+
+    for (auto i = range->firstToken; i < range->lastToken; ++i) {
+      oldTokens.push_back(makeToken(i));
+    }
+
+    start = std::min(start, range->start);
+    end = std::max(end, range->end);
+    last = it;
+
+    return range;
+  };
+
+  for (auto it = *first; it; it = it->next) {
+    const auto range = addDamaged(it);
+    if (!range) return std::nullopt;
+    if (range->end >= offset + length) break;
+  }
+
+  // the symbols of the damaged declarations are declared again, the edit
+  // needs a full parse when the damaged declarations, before or after it,
+  // declare a template, a concept or a namespace, or a using declaration or
+  // directive, that affect the lookup of names not declared by them. Only
+  // the tokens outside braces declare names of the namespace, except the
+  // braces of a linkage specification.
+  auto isReparsable = [](const std::vector<Token>& tokens) {
+    std::vector<bool> braces;
+    int nesting = 0;
+    auto previous = TokenKind::T_EOF_SYMBOL;
+
+    for (const auto& tk : tokens) {
+      const auto kind = tk.kind();
+      const auto topLevel = std::ranges::find(braces, true) == braces.end();
+
+      switch (kind) {
+        case TokenKind::T_LBRACE:
+          braces.push_back(previous != TokenKind::T_STRING_LITERAL);
+          break;
+        case TokenKind::T_RBRACE:
+          if (braces.empty()) return false;
+          braces.pop_back();
+          break;
+        case TokenKind::T_LPAREN:
+        case TokenKind::T_LBRACKET:
+          ++nesting;
+          break;
+        case TokenKind::T_RPAREN:
+        case TokenKind::T_RBRACKET:
+          if (!nesting) return false;
+          --nesting;
+          break;
+        case TokenKind::T_USING:
+        case TokenKind::T_TEMPLATE:
+        case TokenKind::T_CONCEPT:
+        case TokenKind::T_NAMESPACE:
+        case TokenKind::T_EXPORT:
+        case TokenKind::T_MODULE:
+        case TokenKind::T_IMPORT:
+          if (topLevel) return false;
+          break;
+        default:
+          break;
+      }
+
+      previous = kind;
+    }
+
+    return braces.empty() && !nesting;
+  };
+
+  std::string newSource;
+  newSource.reserve(source.size() - length + text.size());
+  newSource.append(source.substr(0, offset));
+  newSource.append(text);
+  newSource.append(source.substr(offset + length));
+
+  const auto delta = std::int64_t(text.size()) - std::int64_t(length);
+
+  std::vector<Token> tokens;
+  Token next;
+
+  while (true) {
+    if (!isReparsable(oldTokens)) return std::nullopt;
+
+    // the damaged region must be plain tokens, without directives or macro
+    // expansions, before and after the edit.
+    Token oldNext;
+    tokens.clear();
+
+    if (!preprocessor_->tokenize(source.substr(start), end - start, fileId,
+                                 start, tokens, oldNext)) {
+      return std::nullopt;
+    }
+
+    const auto sameTokens = std::ranges::equal(
+        tokens, oldTokens, [](const auto& a, const auto& b) {
+          return a.offset() == b.offset() && a.length() == b.length();
+        });
+
+    if (!sameTokens) return std::nullopt;
+
+    const auto newEnd = static_cast<std::uint32_t>(end + delta);
+
+    tokens.clear();
+
+    if (!preprocessor_->tokenize(std::string_view(newSource).substr(start),
+                                 newEnd - start, fileId, start, tokens,
+                                 next)) {
+      return std::nullopt;
+    }
+
+    if (!isReparsable(tokens)) return std::nullopt;
+
+    // the edit must not change how the text after it is lexed, e.g. by
+    // opening a comment or splicing lines, so the first token after it is
+    // unchanged.
+    if (next.kind() != oldNext.kind() || next.length() != oldNext.length() ||
+        next.startOfLine() != oldNext.startOfLine() ||
+        next.offset() != oldNext.offset() + delta) {
+      return std::nullopt;
+    }
+
+    // a declaration cut by the end of the region continues with the
+    // following tokens, e.g. when the edit leaves a `static` before
+    // `int c;`, so the region grows up to the end of the next declaration.
+    if (tokens.empty() ||
+        tokens.back().isOneOf(TokenKind::T_SEMICOLON, TokenKind::T_RBRACE)) {
+      break;
+    }
+
+    if (!last->next || !addDamaged(last->next)) return std::nullopt;
+  }
+
+  following.push_back(last->next);
+
+  const auto newEnd = static_cast<std::uint32_t>(end + delta);
+
+  // the edits are applied until the garbage exceeds the live tokens.
+  const auto garbageTokens = garbageTokens_ + oldTokens.size() + 1;
+  if (2 * garbageTokens > tokenCount()) return std::nullopt;
+
+  // the tokens of the main file after the damaged region are moved.
+
+  for (std::size_t run = 0; run < tokenFileIds_.size(); ++run) {
+    if (tokenFileIds_[run].second != fileId) continue;
+
+    const auto runEnd = run + 1 < tokenFileIds_.size()
+                            ? tokenFileIds_[run + 1].first
+                            : tokenLocations_.size();
+
+    for (auto i = tokenFileIds_[run].first; i < runEnd; ++i) {
+      auto& location = tokenLocations_[i];
+      if (location.offset < end) continue;
+      location.offset = static_cast<std::uint32_t>(location.offset + delta);
+    }
+  }
+
+  if (!tokens.empty()) {
+    auto& tk = tokens.front();
+    const auto before = std::string_view(newSource).substr(0, start);
+    const auto indent = before.find_last_not_of(" \t");
+    tk.setStartOfLine(indent == std::string_view::npos ||
+                      before[indent] == '\n');
+    tk.setLeadingSpace(!before.empty() && std::isspace(before.back()));
+  }
+
+  preprocessor_->setSourceText(fileId, std::move(newSource));
+
+  // the reparsed tokens are appended, followed by an end of file token, so
+  // the locations of the other tokens don't change.
+  const auto firstToken = tokenKinds_.size();
+
+  for (const auto& tk : tokens) appendToken(tk);
+
+  Token eofToken(TokenKind::T_EOF_SYMBOL, newEnd);
+  eofToken.setFileId(fileId);
+  appendToken(eofToken);
+
+  replaceBuiltins(firstToken);
+
+  garbageTokens_ = static_cast<std::uint32_t>(garbageTokens);
+
+  std::vector<const Name*> changedNames;
+
+  // the errors of the reparsed declarations, e.g. of a declaration that
+  // continues after the region, mean a full parse can give a different
+  // result, their diagnostics are reported only when the edit is applied.
+  DeferredDiagnosticsClient diagnostics;
+  auto diagnosticsClient = changeDiagnosticsClient(&diagnostics);
+
+  auto declarations = parser_->reparseDeclarations(
+      damaged, SourceLocation(firstToken), changedNames);
+
+  (void)changeDiagnosticsClient(diagnosticsClient);
+
+  auto tail = &declarations;
+  while (*tail) tail = &(*tail)->next;
+  *tail = last->next;
+  *first = declarations;
+
+  if (diagnostics.hasErrors()) return std::nullopt;
+
+  // the following declarations must not use the names that denote other
+  // symbols after the edit. The names of the members of a class are not
+  // looked up in the namespace.
+  std::unordered_set<const Identifier*> names;
+
+  for (auto name : changedNames) {
+    auto id = name_cast<Identifier>(name);
+    if (!id) return std::nullopt;
+    names.insert(id);
+  }
+
+  for (auto it : following) {
+    if (names.empty()) break;
+
+    for (; it; it = it->next) {
+      const auto [firstLoc, lastLoc] = parser_->declarationRange(it->value);
+      if (!firstLoc) return std::nullopt;
+
+      for (auto i = firstLoc.index(); i < lastLoc.index(); ++i) {
+        if (tokenKinds_[i] != TokenKind::T_IDENTIFIER) continue;
+        if (tokenKinds_[i - 1] == TokenKind::T_DOT) continue;
+        if (tokenKinds_[i - 1] == TokenKind::T_MINUS_GREATER) continue;
+        if (names.contains(tokenValue(i).idValue)) return std::nullopt;
+      }
+    }
+  }
+
+  diagnostics.flush(diagnosticsClient_);
+
+  return std::pair(start, end);
+}
+
 auto TranslationUnit::globalScope() const -> Scope* {
   if (!globalNamespace_) return nullptr;
   return globalNamespace_->scope();
 }
 
 auto TranslationUnit::load(std::span<const std::uint8_t> data) -> bool {
+  parser_.reset();
+  imageReader_.reset();
+
 #ifndef CXX_NO_FLATBUFFERS
   ASTDecoder decode{this};
   return decode(data);
@@ -141,6 +614,19 @@ auto TranslationUnit::load(std::span<const std::uint8_t> data) -> bool {
 #endif
 }
 
+auto TranslationUnit::loadImage(std::span<const std::uint8_t> data,
+                                bool lazy) -> bool {
+  parser_.reset();
+  imageReader_.reset();
+
+  auto read = std::make_unique<ASTImageReader>(this);
+  if (!(*read)(data, lazy)) return false;
+
+  if (lazy) imageReader_ = std::move(read);
+
+  return true;
+}
+
 auto TranslationUnit::serialize(std::ostream& out) -> bool {
   return serialize([&out](auto data) {
     out.write(reinterpret_cast<const char*>(data.data()), data.size());
@@ -150,6 +636,7 @@ auto TranslationUnit::serialize(std::ostream& out) -> bool {
 auto TranslationUnit::serialize(
     const std::function<void(std::span<const std::uint8_t>)>& block) -> bool {
 #ifndef CXX_NO_FLATBUFFERS
+  ScopedStopwatch stopwatch(stats_.serializeTime);
   ASTEncoder encode;
   auto data = encode(this);
   block(data);
@@ -159,24 +646,39 @@ auto TranslationUnit::serialize(
 #endif
 }
 
+auto TranslationUnit::serializeImage() -> std::vector<std::uint8_t> {
+  ScopedStopwatch stopwatch(stats_.serializeTime);
+  ASTImageWriter write{this};
+  return write(ast_);
+}
+
+auto TranslationUnit::flatten(AST* root) const -> std::vector<std::uint32_t> {
+  FlatASTWriter write{this};
+  return write(root ? root : ast_);
+}
+
+auto TranslationUnit::stats() const -> TranslationUnitStats {
+  auto stats = stats_;
+  if (parser_) {
+    stats.parser = parser_->stats();
+    stats.astCache = parser_->astCacheStats();
+  }
+  stats.arenaBytes = arena_->bytesAllocated();
+  return stats;
+}
+
 void TranslationUnit::replaceWithIdentifier(SourceLocation keywordLoc) {
   const auto kind = tokenKind(keywordLoc);
   if (kind != TokenKind::T_BUILTIN) return;
 
   const auto builtin = tokenAt(keywordLoc).value().intValue;
 
-  TokenValue value;
-  value.idValue =
+  const auto id =
       control_->getIdentifier(Token::spell(static_cast<BuiltinKind>(builtin)));
 
-  for (size_t i = keywordLoc.index(); i < tokens_.size(); ++i) {
-    auto& tk = tokens_[i];
-
-    if (tk.is(TokenKind::T_BUILTIN) && tk.value().intValue == builtin) {
-      tk.setKind(TokenKind::T_IDENTIFIER);
-      tk.setValue(value);
-    }
-  }
+  // the tokens appended by the edits are replaced too.
+  replacedBuiltins_.emplace_back(builtin, id);
+  replaceBuiltins(keywordLoc.index());
 }
 
 }  // namespace cxx
@@ -30,16 +30,39 @@
 #include <cxx/symbols_fwd.h>
 #include <cxx/token.h>
 
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <span>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 namespace cxx {
 
+// the time spent in each phase of a translation unit and the work done by
+// its parser.
+struct TranslationUnitStats {
+  std::chrono::nanoseconds preprocessTime{};
+  std::chrono::nanoseconds parseTime{};
+  std::chrono::nanoseconds serializeTime{};
+  ParserStats parser;
+  ASTCacheStats astCache;
+  // the bytes allocated in the arena of the AST.
+  std::size_t arenaBytes = 0;
+};
+
+class ASTImageReader;
+
 class TranslationUnit {
+  friend class ASTImageReader;
+
  public:
   explicit TranslationUnit(Control* control,
                            DiagnosticsClient* diagosticsClient);
@@ -94,25 +117,28 @@ class TranslationUnit {
 
   // tokens
   [[nodiscard]] inline auto tokenCount() const -> unsigned {
-    return static_cast<unsigned>(tokens_.size());
+    return static_cast<unsigned>(tokenKinds_.size());
   }
 
-  [[nodiscard]] inline auto tokenAt(SourceLocation loc) const -> const Token& {
-    return tokens_[loc.index()];
+  [[nodiscard]] inline auto tokenAt(SourceLocation loc) const -> Token {
+    return makeToken(loc.index());
   }
 
   void setTokenKind(SourceLocation loc, TokenKind kind) {
-    tokens_[loc.index()].setKind(kind);
+    tokenKinds_[loc.index()] = kind;
   }
 
   [[nodiscard]] inline auto tokenKind(SourceLocation loc) const -> TokenKind {
-    return tokenAt(loc).kind();
+    return tokenKinds_[loc.index()];
   }
 
-  void setTokenValue(SourceLocation loc, TokenValue value) {
-    tokens_[loc.index()].setValue(value);
+  [[nodiscard]] inline auto tokenValue(SourceLocation loc) const
+      -> TokenValue {
+    return tokenValue(loc.index());
   }
 
+  void setTokenValue(SourceLocation loc, TokenValue value);
+
   [[nodiscard]] auto tokenLength(SourceLocation loc) const -> int;
 
   [[nodiscard]] auto tokenText(SourceLocation loc) const -> const std::string&;
@@ -131,25 +157,169 @@ class TranslationUnit {
 
   auto parse(const ParserConfiguration& config = {}) -> bool;
 
+  // parses the body of a function definition skipped by a declarations-only
+  // parse, see ParserConfiguration::skipFunctionBodies, or loads it from the
+  // image of a lazy loadImage(). Returns false if the body was not skipped
+  // or it was already parsed.
+  auto parseFunctionBody(FunctionDefinitionAST* ast) -> bool;
+
+  // replaces length bytes at offset of the parsed source with text. Only the
+  // declarations of the innermost namespace damaged by the edit are relexed
+  // and reparsed, the other tokens and declarations are reused, and the
+  // variables and functions declared again with the same type keep their
+  // symbols. Returns the byte range of the source, before the edit, that was
+  // replaced by the reparsed declarations, or nothing if the edit cannot be
+  // applied incrementally, e.g. because it touches a directive or a macro,
+  // changes how the text after it is lexed, or changes a name used by the
+  // following declarations. In that case the unit may be partially updated
+  // and must be created again from the edited source. The unit must be
+  // parsed with ParserConfiguration::incremental.
+  [[nodiscard]] auto applyEdit(std::uint32_t offset, std::uint32_t length,
+                               std::string_view text)
+      -> std::optional<std::pair<std::uint32_t, std::uint32_t>>;
+
   [[nodiscard]] auto load(std::span<const std::uint8_t> data) -> bool;
 
+  // loads an AST written by serializeImage() with the same build, see
+  // ASTImage. When lazy, only the nodes outside the function bodies are
+  // loaded, the bodies are loaded on demand with parseFunctionBody(), and
+  // the data must outlive the unit.
+  [[nodiscard]] auto loadImage(std::span<const std::uint8_t> data,
+                               bool lazy = false) -> bool;
+
   auto serialize(std::ostream& out) -> bool;
 
   auto serialize(
       const std::function<void(std::span<const std::uint8_t>)>& onData) -> bool;
 
+  [[nodiscard]] auto serializeImage() -> std::vector<std::uint8_t>;
+
   void replaceWithIdentifier(SourceLocation loc);
 
+  // flattens the subtree of root, or the whole AST, in a single buffer, see
+  // FlatAST.
+  [[nodiscard]] auto flatten(AST* root = nullptr) const
+      -> std::vector<std::uint32_t>;
+
+  [[nodiscard]] auto stats() const -> TranslationUnitStats;
+
+ private:
+  void appendToken(const Token& tk);
+  void replaceBuiltins(std::size_t start);
+
+  [[nodiscard]] inline auto makeToken(std::size_t index) const -> Token;
+  [[nodiscard]] inline auto tokenValue(std::size_t index) const -> TokenValue;
+  [[nodiscard]] inline auto tokenValueSlot(std::size_t index) const
+      -> const TokenValue*;
+  [[nodiscard]] inline auto tokenValueSlot(std::size_t index) -> TokenValue*;
+  [[nodiscard]] inline auto tokenFileId(std::size_t index) const
+      -> std::uint32_t;
+
  private:
+  struct TokenLocation {
+    std::uint32_t offset;
+    std::uint32_t length : 22;
+    std::uint32_t startOfLine : 1;
+    std::uint32_t leadingSpace : 1;
+  };
+
+  // the positions of the tokens loaded from an image, they have no source.
+  // fileIndex is the index plus one of the name in tokenFileNames_.
+  struct TokenPosition {
+    std::uint32_t fileIndex;
+    std::uint32_t line;
+    std::uint32_t column;
+    std::uint32_t endLine;
+    std::uint32_t endColumn;
+  };
+
+  // the tokens with a value in a block of 64 tokens, and the index of the
+  // value of the first of them.
+  struct TokenValueBlock {
+    std::uint64_t mask = 0;
+    std::uint32_t firstValue = 0;
+  };
+
   Control* control_;
   std::unique_ptr<Arena> arena_;
-  std::vector<Token> tokens_;
+  // the tokens are stored as parallel arrays. Only the tokens with a value,
+  // see Token::hasValue(), have an entry in tokenValues_, and the file id is
+  // stored once for each run of tokens coming from the same file.
+  std::vector<TokenKind> tokenKinds_;
+  std::vector<TokenLocation> tokenLocations_;
+  std::vector<TokenValue> tokenValues_;
+  std::vector<TokenValueBlock> tokenValueBlocks_;
+  std::vector<std::pair<std::uint32_t, std::uint32_t>> tokenFileIds_;
+  // the run of tokenFileIds_ of the last token looked up.
+  mutable std::size_t lastFileRun_ = 0;
+  std::vector<std::pair<int, const Identifier*>> replacedBuiltins_;
+  std::vector<TokenPosition> tokenPositions_;
+  std::vector<std::string> tokenFileNames_;
   std::string fileName_;
   UnitAST* ast_ = nullptr;
   const char* yyptr = nullptr;
   DiagnosticsClient* diagnosticsClient_ = nullptr;
   NamespaceSymbol* globalNamespace_ = nullptr;
   std::unique_ptr<Preprocessor> preprocessor_;
+  // the parser is kept to parse the skipped function bodies and to reparse
+  // the declarations damaged by the edits.
+  std::unique_ptr<Parser> parser_;
+  // the reader of a lazily loaded image, it loads the function bodies.
+  std::unique_ptr<ASTImageReader> imageReader_;
+  // the end of file token of the unit. The tokens of the reparsed
+  // declarations are appended after it, and the replaced tokens are garbage.
+  std::uint32_t endOfFile_ = 0;
+  std::uint32_t garbageTokens_ = 0;
+  mutable TranslationUnitStats stats_;
 };
 
+inline auto TranslationUnit::tokenValueSlot(std::size_t index) const
+    -> const TokenValue* {
+  const auto& block = tokenValueBlocks_[index / 64];
+  const auto bit = std::uint64_t(1) << (index % 64);
+  if (!(block.mask & bit)) return nullptr;
+  return &tokenValues_[block.firstValue +
+                       std::popcount(block.mask & (bit - 1))];
+}
+
+inline auto TranslationUnit::tokenValueSlot(std::size_t index) -> TokenValue* {
+  return const_cast<TokenValue*>(std::as_const(*this).tokenValueSlot(index));
+}
+
+inline auto TranslationUnit::tokenValue(std::size_t index) const
+    -> TokenValue {
+  const auto slot = tokenValueSlot(index);
+  return slot ? *slot : TokenValue{};
+}
+
+inline auto TranslationUnit::tokenFileId(std::size_t index) const
+    -> std::uint32_t {
+  // the tokens are mostly read in order, so the run of the last token is
+  // tried first.
+  const auto inRun = [this, index](std::size_t run) {
+    return run < tokenFileIds_.size() && index >= tokenFileIds_[run].first &&
+           (run + 1 == tokenFileIds_.size() ||
+            index < tokenFileIds_[run + 1].first);
+  };
+
+  if (!inRun(lastFileRun_)) {
+    auto it = std::upper_bound(
+        tokenFileIds_.begin(), tokenFileIds_.end(), index,
+        [](std::size_t index, const auto& run) { return index < run.first; });
+    lastFileRun_ = static_cast<std::size_t>(it - tokenFileIds_.begin()) - 1;
+  }
+
+  return tokenFileIds_[lastFileRun_].second;
+}
+
+inline auto TranslationUnit::makeToken(std::size_t index) const -> Token {
+  const auto& location = tokenLocations_[index];
+  Token tk(tokenKinds_[index], location.offset, location.length,
+           tokenValue(index));
+  tk.setFileId(tokenFileId(index));
+  tk.setStartOfLine(location.startOfLine);
+  tk.setLeadingSpace(location.leadingSpace);
+  return tk;
+}
+
 }  // namespace cxx
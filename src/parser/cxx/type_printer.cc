@@ -300,7 +300,7 @@ class TypePrinter {
     }
     auto last = lastSourceLocation(type->unqualifiedId());
     for (auto loc = first; loc != last; loc = loc.next()) {
-      const auto& tk = unit->tokenAt(loc);
+      const auto tk = unit->tokenAt(loc);
       if (loc != first && (tk.leadingSpace() || tk.startOfLine()))
         specifiers_ += ' ';
       specifiers_ += tk.spell();
@@ -312,7 +312,7 @@ class TypePrinter {
     std::string buf;
     auto [first, last] = range;
     for (auto loc = first; loc != last; loc = loc.next()) {
-      const auto& tk = unit->tokenAt(loc);
+      const auto tk = unit->tokenAt(loc);
       if (loc != first && (tk.leadingSpace() || tk.startOfLine())) buf += ' ';
       buf += tk.spell();
     }
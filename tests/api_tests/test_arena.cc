@@ -0,0 +1,117 @@
+// Copyright (c) 2023 Roberto Raggi <roberto.raggi@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <cxx/arena.h>
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+using namespace cxx;
+
+TEST(Arena, allocate) {
+  Arena arena;
+  EXPECT_EQ(arena.blockCount(), 0);
+
+  auto first = static_cast<char*>(arena.allocate(10));
+  auto second = static_cast<char*>(arena.allocate(10));
+
+  EXPECT_EQ(std::uintptr_t(first) % alignof(std::max_align_t), 0);
+  EXPECT_EQ(std::uintptr_t(second) % alignof(std::max_align_t), 0);
+  EXPECT_GE(second - first, 10);
+
+  EXPECT_EQ(arena.blockCount(), 1);
+  EXPECT_EQ(arena.bytesAllocated(), 20);
+  EXPECT_EQ(arena.bytesWasted(), alignof(std::max_align_t) - 10);
+}
+
+TEST(Arena, large_allocations) {
+  Arena arena;
+
+  auto small = arena.allocate(16);
+
+  // larger than the biggest block, used to loop forever.
+  const auto size = 4 * Arena::kMaxBlockSize;
+  auto large = static_cast<char*>(arena.allocate(size));
+  std::memset(large, 0, size);
+
+  EXPECT_EQ(arena.blockCount(), 2);
+  EXPECT_EQ(arena.bytesAllocated(), size + 16);
+
+  // the current block is still used after a large allocation.
+  EXPECT_EQ(static_cast<char*>(arena.allocate(16)),
+            static_cast<char*>(small) + 16);
+  EXPECT_EQ(arena.blockCount(), 2);
+  EXPECT_EQ(arena.bytesWasted(), 0);
+}
+
+TEST(Arena, block_growth) {
+  Arena arena;
+
+  std::size_t blockSize = Arena::kMinBlockSize;
+  std::size_t totalSize = 0;
+
+  for (int i = 0; i < 10; ++i) {
+    totalSize += blockSize;
+    blockSize = std::min(blockSize * 2, Arena::kMaxBlockSize);
+  }
+
+  while (arena.bytesAllocated() < totalSize) arena.allocate(64);
+
+  EXPECT_EQ(arena.blockCount(), 10);
+  EXPECT_EQ(arena.bytesWasted(), 0);
+
+  arena.reset();
+  EXPECT_EQ(arena.blockCount(), 0);
+  EXPECT_EQ(arena.bytesAllocated(), 0);
+}
+
+TEST(Arena, mmap) {
+  Arena arena;
+  arena.setUseMmap(true);
+  EXPECT_TRUE(arena.useMmap());
+
+  const auto size = 2 * Arena::kMaxBlockSize;
+  auto data = static_cast<char*>(arena.allocate(size));
+  std::memset(data, 0xff, size);
+
+  EXPECT_EQ(arena.blockCount(), 1);
+  EXPECT_EQ(arena.bytesAllocated(), size);
+}
+
+TEST(Arena, rollback) {
+  Arena arena;
+
+  auto first = arena.allocate(16);
+  const auto mark = arena.mark();
+
+  arena.allocate(32);
+  arena.allocate(2 * Arena::kMaxBlockSize);
+  while (arena.blockCount() < 4) arena.allocate(1024);
+
+  arena.rollback(mark);
+
+  EXPECT_EQ(arena.blockCount(), 1);
+  EXPECT_EQ(arena.bytesAllocated(), 16);
+  EXPECT_EQ(arena.bytesWasted(), 0);
+
+  // the released memory is reused.
+  EXPECT_EQ(arena.allocate(16), static_cast<char*>(first) + 16);
+}
@@ -1,10 +1,15 @@
 
+#include <cxx/ast.h>
 #include <cxx/control.h>
 #include <cxx/literals.h>
 #include <cxx/name_printer.h>
 #include <cxx/names.h>
+#include <cxx/symbols.h>
+#include <cxx/types.h>
 #include <gtest/gtest.h>
 
+#include <thread>
+
 using namespace cxx;
 
 TEST(Control, integer_literals) {
@@ -131,3 +136,140 @@ TEST(Control, get_destructor_id) {
   EXPECT_EQ(control.getDestructorId(control.getIdentifier("foo")), id);
   EXPECT_NE(name_cast<DestructorId>(id), nullptr);
 }
+
+TEST(Control, get_template_id) {
+  Control control;
+
+  auto vector = control.getIdentifier("vector");
+
+  std::vector<TemplateArgument> args{control.getIntType()};
+
+  auto id = control.getTemplateId(vector, args);
+  EXPECT_EQ(id->name(), vector);
+  EXPECT_EQ(id->arguments(), args);
+
+  EXPECT_EQ(control.getTemplateId(vector, args), id);
+  EXPECT_NE(control.getTemplateId(vector, {control.getCharType()}), id);
+  EXPECT_NE(control.getTemplateId(vector, {}), id);
+  EXPECT_NE(name_cast<TemplateId>(id), nullptr);
+}
+
+TEST(Control, ast_reference_count) {
+  Control control;
+
+  IntLiteralExpressionAST size;
+  TypeIdAST typeId;
+
+  auto vector = control.getIdentifier("vector");
+  const std::vector<TemplateArgument> args{&size};
+
+  control.getTemplateId(vector, {control.getIntType()});
+  control.getBoundedArrayType(control.getIntType(), 2);
+  EXPECT_EQ(control.astReferenceCount(), 0);
+
+  control.getTemplateId(vector, args);
+  control.getUnresolvedBoundedArrayType(nullptr, control.getIntType(), &size);
+  control.getUnresolvedUnderlyingType(nullptr, &typeId);
+  EXPECT_EQ(control.astReferenceCount(), 3);
+
+  // the existing objects do not add references.
+  control.getTemplateId(vector, args);
+  control.getUnresolvedUnderlyingType(nullptr, &typeId);
+  EXPECT_EQ(control.astReferenceCount(), 3);
+}
+
+TEST(Control, get_function_type) {
+  Control control;
+
+  auto intType = control.getIntType();
+  auto charPtrType = control.getPointerType(control.getCharType());
+
+  auto type = control.getFunctionType(intType, {intType, charPtrType});
+  EXPECT_EQ(type->returnType(), intType);
+  EXPECT_EQ(type->parameterTypes().size(), 2);
+
+  EXPECT_EQ(control.getFunctionType(intType, {intType, charPtrType}), type);
+  EXPECT_NE(control.getFunctionType(intType, {intType}), type);
+  EXPECT_NE(control.getFunctionType(intType, {intType, charPtrType}, true),
+            type);
+  EXPECT_NE(control.getFunctionType(charPtrType, {intType, charPtrType}),
+            type);
+}
+
+TEST(Control, concurrent_interning) {
+  Control control;
+  control.setConcurrent(true);
+  EXPECT_TRUE(control.concurrent());
+
+  constexpr int kThreadCount = 8;
+  constexpr int kNameCount = 500;
+
+  struct Result {
+    std::vector<const Identifier*> identifiers;
+    std::vector<const IntegerLiteral*> literals;
+    std::vector<const Type*> types;
+    std::vector<VariableSymbol*> symbols;
+  };
+
+  std::vector<Result> results(kThreadCount);
+
+  auto intern = [&](int threadIndex) {
+    auto& result = results[threadIndex];
+    result.identifiers.resize(kNameCount);
+    result.literals.resize(kNameCount);
+    result.types.resize(kNameCount);
+
+    // each thread walks the shared vocabulary from a different start.
+    for (int i = 0; i < kNameCount; ++i) {
+      const auto index = (i + threadIndex * 61) % kNameCount;
+      const auto spelling = std::to_string(index);
+
+      auto id = control.getIdentifier("id_" + spelling);
+      auto literal = control.integerLiteral(spelling);
+
+      auto classType = control.getClassType(control.newClassSymbol(nullptr));
+      auto pointerType = control.getPointerType(control.getPointerType(
+          control.getUnboundedArrayType(control.getIntType())));
+      auto functionType = control.getFunctionType(
+          control.getIntType(),
+          {control.getBoundedArrayType(control.getCharType(), index)});
+
+      auto symbol = control.newVariableSymbol(nullptr);
+      symbol->setName(id);
+      symbol->setType(classType);
+
+      result.identifiers[index] = id;
+      result.literals[index] = literal;
+      result.types[index] = functionType;
+      result.symbols.push_back(symbol);
+
+      EXPECT_EQ(pointerType->elementType(),
+                control.getPointerType(control.getUnboundedArrayType(
+                    control.getIntType())));
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreadCount; ++i) threads.emplace_back(intern, i);
+  for (auto& thread : threads) thread.join();
+
+  for (int index = 0; index < kNameCount; ++index) {
+    const auto spelling = std::to_string(index);
+    EXPECT_EQ(results[0].identifiers[index]->name(), "id_" + spelling);
+    EXPECT_EQ(results[0].literals[index]->value(), spelling);
+    EXPECT_EQ(results[0].literals[index]->integerValue(),
+              static_cast<std::uint64_t>(index));
+
+    for (const auto& result : results) {
+      EXPECT_EQ(result.identifiers[index], results[0].identifiers[index]);
+      EXPECT_EQ(result.literals[index], results[0].literals[index]);
+      EXPECT_EQ(result.types[index], results[0].types[index]);
+    }
+  }
+
+  for (const auto& result : results) {
+    for (auto symbol : result.symbols) {
+      EXPECT_NE(type_cast<ClassType>(symbol->type()), nullptr);
+    }
+  }
+}
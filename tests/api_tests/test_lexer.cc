@@ -0,0 +1,214 @@
+// Copyright (c) 2023 Roberto Raggi <roberto.raggi@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cxx/lexer.h>
+#include <cxx/token.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+using namespace cxx;
+
+namespace {
+
+// the kind, the offset, the length and the text of a token.
+using Tok = std::tuple<TokenKind, int, std::uint32_t, std::string>;
+
+auto tokenize(std::string_view source, bool keepComments = false)
+    -> std::vector<Tok> {
+  // the lexer must not read past the end of an exactly sized buffer.
+  Lexer lexer{std::string(source)};
+  lexer.setKeepComments(keepComments);
+
+  std::vector<Tok> tokens;
+
+  while (lexer() != TokenKind::T_EOF_SYMBOL) {
+    tokens.emplace_back(lexer.tokenKind(), lexer.tokenPos(),
+                        lexer.tokenLength(), std::string(lexer.tokenText()));
+  }
+
+  return tokens;
+}
+
+// the bounds of the ranges of identifier characters come first.
+auto identifier(int n) -> std::string {
+  static constexpr std::string_view chars =
+      "aZ_09zAbcYdefghijklmnopqrstuvwxyBCDEFGHIJKLMNOPQRSTUVWX12345678";
+  std::string s;
+  for (int i = 0; i < n; ++i) s += chars[i % chars.size()];
+  return s;
+}
+
+auto whitespace(int n) -> std::string {
+  static constexpr std::string_view chars = " \t\v\f\r";
+  std::string s;
+  for (int i = 0; i < n; ++i) s += chars[i % chars.size()];
+  return s;
+}
+
+// the lengths around the 16 bytes processed at a time by the scans.
+const int kLengths[] = {0, 1, 14, 15, 16, 17, 18, 30, 31, 32, 33, 47, 48, 49};
+
+// follows the bytes that stop a scan, so that they are seen at any
+// position of a 16 bytes vector and not only by the scalar loop.
+const std::string kTail = identifier(20);
+
+auto tail(int pos) -> Tok { return {TokenKind::T_IDENTIFIER, pos, 20, kTail}; }
+
+}  // namespace
+
+TEST(Lexer, identifiers) {
+  for (int n : kLengths) {
+    if (!n) continue;
+
+    const auto name = identifier(n);
+    const Tok token{TokenKind::T_IDENTIFIER, 0, n, name};
+
+    // ending at the end of the input, or at a byte that stops the scan.
+    EXPECT_EQ(tokenize(name), std::vector<Tok>{token});
+
+    for (char stop : std::string_view("@[`{/:-")) {
+      const auto tokens = tokenize(name + stop + " " + kTail);
+      ASSERT_EQ(tokens.size(), 3) << n << stop;
+      EXPECT_EQ(tokens.front(), token) << n << stop;
+      EXPECT_EQ(tokens.back(), tail(n + 2)) << n << stop;
+    }
+  }
+}
+
+TEST(Lexer, whitespace) {
+  for (int n : kLengths) {
+    EXPECT_EQ(tokenize(whitespace(n) + kTail), std::vector<Tok>{tail(n)});
+
+    // the newlines stop the scan of the horizontal spaces.
+    Lexer lexer{"x" + whitespace(n) + "\n" + whitespace(3) + kTail};
+    ASSERT_EQ(lexer(), TokenKind::T_IDENTIFIER);
+    ASSERT_EQ(lexer(), TokenKind::T_IDENTIFIER);
+    EXPECT_EQ(lexer.tokenPos(), n + 5);
+    EXPECT_TRUE(lexer.tokenStartOfLine()) << n;
+    EXPECT_TRUE(lexer.tokenLeadingSpace()) << n;
+  }
+}
+
+TEST(Lexer, comments) {
+  for (int n : kLengths) {
+    const auto text = identifier(n);
+
+    const auto lineComment = "//" + text;
+    const Tok lineCommentToken{TokenKind::T_COMMENT, 0, n + 2, lineComment};
+    EXPECT_EQ(tokenize(lineComment + "\n" + kTail, /*keepComments=*/true),
+              (std::vector<Tok>{lineCommentToken, tail(n + 3)}));
+    EXPECT_EQ(tokenize(lineComment + "\n" + kTail),
+              std::vector<Tok>{tail(n + 3)});
+
+    const auto blockComment = "/*" + text + "*/";
+    const Tok blockCommentToken{TokenKind::T_COMMENT, 0, n + 4, blockComment};
+    EXPECT_EQ(tokenize(blockComment + kTail, /*keepComments=*/true),
+              (std::vector<Tok>{blockCommentToken, tail(n + 4)}));
+    EXPECT_EQ(tokenize(blockComment + kTail), std::vector<Tok>{tail(n + 4)});
+
+    // a star that does not end the comment.
+    const auto star = "/*" + text + "*" + kTail + "*/";
+    const Tok starToken{TokenKind::T_COMMENT, 0, n + 25, star};
+    EXPECT_EQ(tokenize(star + kTail, /*keepComments=*/true),
+              (std::vector<Tok>{starToken, tail(n + 25)}));
+  }
+}
+
+TEST(Lexer, line_splices) {
+  for (int n : kLengths) {
+    if (!n) continue;
+
+    const auto name = identifier(n);
+
+    for (std::string splice : {"\\\n", "\\\r\n"}) {
+      const auto size = n + static_cast<int>(splice.size());
+
+      // the identifier continues on the next line.
+      const auto tokens = tokenize(name + splice + "more " + kTail);
+      ASSERT_EQ(tokens.size(), 2) << n;
+      EXPECT_EQ(tokens[0],
+                (Tok{TokenKind::T_IDENTIFIER, 0, size + 4, name + "more"}))
+          << n;
+      EXPECT_EQ(tokens[1], tail(size + 5)) << n;
+
+      // and so do the line comments.
+      const auto lineComment = "//" + name + splice + "more";
+      EXPECT_EQ(tokenize(lineComment + "\n" + kTail, /*keepComments=*/true),
+                (std::vector<Tok>{
+                    {TokenKind::T_COMMENT, 0, size + 6, lineComment},
+                    tail(size + 7)}));
+
+      // a star and a slash separated by a splice end a block comment.
+      const auto blockComment = "/*" + name + "*" + splice + "/";
+      EXPECT_EQ(tokenize(blockComment + kTail, /*keepComments=*/true),
+                (std::vector<Tok>{
+                    {TokenKind::T_COMMENT, 0, size + 4, blockComment},
+                    tail(size + 4)}));
+
+      // the spaces continue on the next line.
+      EXPECT_EQ(tokenize(whitespace(n) + splice + "  " + kTail),
+                std::vector<Tok>{tail(size + 2)});
+    }
+  }
+}
+
+TEST(Lexer, non_ascii) {
+  const std::string e = "\xc3\xa9";
+
+  const auto reference = tokenize("a" + e + " " + kTail);
+  ASSERT_GE(reference.size(), 3);
+
+  for (int n : kLengths) {
+    if (!n) continue;
+
+    const auto name = identifier(n);
+
+    // the identifier stops at the first non-ASCII byte, the other tokens
+    // only move.
+    const auto tokens = tokenize(name + e + " " + kTail);
+    ASSERT_EQ(tokens.size(), reference.size()) << n;
+    EXPECT_EQ(tokens.front(), (Tok{TokenKind::T_IDENTIFIER, 0, n, name}));
+
+    for (std::size_t i = 1; i < tokens.size(); ++i) {
+      auto [kind, pos, length, text] = reference[i];
+      EXPECT_EQ(tokens[i], (Tok{kind, pos + n - 1, length, text})) << n;
+    }
+
+    // the comments and the spaces continue over the non-ASCII bytes.
+    const auto lineComment = "//" + name + e + "b";
+    EXPECT_EQ(tokenize(lineComment + "\n" + kTail, /*keepComments=*/true),
+              (std::vector<Tok>{{TokenKind::T_COMMENT, 0, n + 5, lineComment},
+                                tail(n + 6)}));
+
+    const auto blockComment = "/*" + name + e + "*/";
+    EXPECT_EQ(tokenize(blockComment + kTail, /*keepComments=*/true),
+              (std::vector<Tok>{{TokenKind::T_COMMENT, 0, n + 6, blockComment},
+                                tail(n + 6)}));
+
+    const auto spaced = tokenize(whitespace(n) + e + " " + kTail);
+    ASSERT_EQ(spaced.size(), reference.size() - 1);
+    EXPECT_EQ(std::get<1>(spaced.front()), n);
+  }
+}
@@ -0,0 +1,143 @@
+// Copyright (c) 2023 Roberto Raggi <roberto.raggi@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cxx/private/memory_mapped_file.h>
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+
+using namespace cxx;
+
+namespace {
+
+// a file in the temporary directory, removed at the end of the test.
+struct TempFile {
+  std::filesystem::path path;
+
+  explicit TempFile(const std::string& name, const std::string& content) {
+    path = std::filesystem::temp_directory_path() /
+           ("cxx_test_memory_mapped_file_" + name);
+    std::ofstream(path, std::ios::binary) << content;
+  }
+
+  ~TempFile() { std::filesystem::remove(path); }
+};
+
+}  // namespace
+
+TEST(MemoryMappedFile, open_regular_file) {
+  TempFile temp("regular.cc", "int x;\n");
+
+  MemoryMappedFile file;
+  ASSERT_TRUE(file.open(temp.path.string()));
+  ASSERT_TRUE(file.isOpen());
+  ASSERT_EQ(file.text(), "int x;\n");
+  ASSERT_EQ(file.size(), 7);
+
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(__EMSCRIPTEN__)
+  ASSERT_TRUE(file.isMapped());
+#endif
+
+  file.close();
+  ASSERT_FALSE(file.isOpen());
+  ASSERT_FALSE(file.isMapped());
+  ASSERT_EQ(file.size(), 0);
+}
+
+TEST(MemoryMappedFile, open_empty_file) {
+  TempFile temp("empty.cc", "");
+
+  // the empty files can't be mapped, they are read.
+  MemoryMappedFile file;
+  ASSERT_TRUE(file.open(temp.path.string()));
+  ASSERT_TRUE(file.isOpen());
+  ASSERT_FALSE(file.isMapped());
+  ASSERT_TRUE(file.text().empty());
+}
+
+TEST(MemoryMappedFile, open_missing_file) {
+  TempFile temp("missing.cc", "");
+  std::filesystem::remove(temp.path);
+
+  MemoryMappedFile file;
+  ASSERT_FALSE(file.open(temp.path.string()));
+  ASSERT_FALSE(file.isOpen());
+  ASSERT_EQ(file.data(), nullptr);
+
+  ASSERT_FALSE(file.open(std::filesystem::temp_directory_path().string()));
+  ASSERT_FALSE(file.isOpen());
+}
+
+TEST(MemoryMappedFile, move) {
+  TempFile temp("move.cc", "int x;\n");
+  TempFile empty("move_empty.cc", "");
+
+  // moving a file that was not opened.
+  {
+    MemoryMappedFile file;
+    MemoryMappedFile moved(std::move(file));
+    ASSERT_FALSE(moved.isOpen());
+    ASSERT_EQ(moved.data(), nullptr);
+
+    MemoryMappedFile assigned;
+    ASSERT_TRUE(assigned.open(temp.path.string()));
+    assigned = std::move(moved);
+    ASSERT_FALSE(assigned.isOpen());
+    ASSERT_EQ(assigned.data(), nullptr);
+    ASSERT_TRUE(assigned.text().empty());
+  }
+
+  // moving a mapped file.
+  {
+    MemoryMappedFile file;
+    ASSERT_TRUE(file.open(temp.path.string()));
+
+    MemoryMappedFile moved(std::move(file));
+    ASSERT_FALSE(file.isOpen());
+    ASSERT_EQ(moved.text(), "int x;\n");
+
+    MemoryMappedFile assigned;
+    assigned = std::move(moved);
+    ASSERT_FALSE(moved.isOpen());
+    ASSERT_EQ(assigned.text(), "int x;\n");
+  }
+
+  // moving a file that was read, the data follows the buffer.
+  {
+    MemoryMappedFile file;
+    ASSERT_TRUE(file.open(empty.path.string()));
+
+    MemoryMappedFile moved(std::move(file));
+    ASSERT_FALSE(file.isOpen());
+    ASSERT_TRUE(moved.isOpen());
+    ASSERT_TRUE(moved.text().empty());
+
+    MemoryMappedFile assigned;
+    ASSERT_TRUE(assigned.open(temp.path.string()));
+    assigned = std::move(moved);
+    ASSERT_FALSE(moved.isOpen());
+    ASSERT_TRUE(assigned.isOpen());
+    ASSERT_FALSE(assigned.isMapped());
+    ASSERT_TRUE(assigned.text().empty());
+  }
+}
@@ -0,0 +1,263 @@
+// Copyright (c) 2023 Roberto Raggi <roberto.raggi@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <cxx/ast.h>
+#include <cxx/control.h>
+#include <cxx/diagnostics_client.h>
+#include <cxx/names.h>
+#include <cxx/parser.h>
+#include <cxx/recursive_ast_visitor.h>
+#include <cxx/scope.h>
+#include <cxx/symbols.h>
+#include <cxx/translation_unit.h>
+#include <cxx/type_printer.h>
+#include <cxx/types.h>
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace cxx;
+
+namespace {
+
+// the casts and the template ids are parsed more than once.
+const char* kSource = R"(
+template <typename T> struct S { using type = T; };
+
+int f(int x) {
+  int a = (int) x;
+  int b = (S<int>::type) a;
+  return (a) + (b) * (int) (S<S<int>>::type) 1;
+}
+)";
+
+struct ParseResult {
+  std::string diagnostics;
+  ASTCacheStats stats;
+  std::uint32_t tokenCount = 0;
+  bool parsed = false;
+};
+
+auto parse(std::string source, const ParserConfiguration& config)
+    -> ParseResult {
+  Control control;
+  DiagnosticsClient diagnosticsClient;
+
+  std::ostringstream diagnostics;
+  diagnosticsClient.setOutput(diagnostics);
+
+  TranslationUnit unit(&control, &diagnosticsClient);
+  unit.setSource(std::move(source), "main.cc");
+
+  Parser parser(&unit);
+  parser.setConfig(config);
+
+  UnitAST* ast = nullptr;
+  parser(ast);
+
+  return {diagnostics.str(), parser.astCacheStats(), unit.tokenCount(),
+          ast != nullptr};
+}
+
+auto parse(const ParserConfiguration& config) -> ParseResult {
+  return parse(kSource, config);
+}
+
+auto repeat(std::string_view s, int n) -> std::string {
+  std::string result;
+  for (int i = 0; i < n; ++i) result += s;
+  return result;
+}
+
+// nests the template ids, the casts and the calls of the
+// arguments n times.
+auto nestedSource(int n) -> std::string {
+  return "template <typename T> struct A { using type = T; };\n"
+         "int g(int);\n"
+         "int f(int x) {\n"
+         "  return (" +
+         repeat("A<", n) + "int" + repeat(">", n) + "::type) " +
+         repeat("g((int) (", n) + "x" + repeat("))", n) + ";\n}\n";
+}
+
+}  // namespace
+
+TEST(Parser, ast_cache_stats) {
+  auto result = parse(ParserConfiguration{});
+
+  ASSERT_TRUE(result.parsed);
+  ASSERT_EQ(result.diagnostics, "");
+
+  EXPECT_GT(result.stats.hits, 0);
+  EXPECT_GT(result.stats.misses, 0);
+  EXPECT_EQ(result.stats.evictions, 0);
+}
+
+TEST(Parser, ast_cache_capacity) {
+  ParserConfiguration config;
+  config.astCacheCapacity = 1;
+
+  auto small = parse(config);
+
+  ASSERT_TRUE(small.parsed);
+  ASSERT_EQ(small.diagnostics, "");
+  EXPECT_GT(small.stats.evictions, 0);
+
+  config.astCacheCapacity = 0;
+
+  auto disabled = parse(config);
+
+  ASSERT_TRUE(disabled.parsed);
+  ASSERT_EQ(disabled.diagnostics, "");
+  EXPECT_EQ(disabled.stats.hits, 0);
+  EXPECT_EQ(disabled.stats.evictions, 0);
+}
+
+TEST(Parser, packrat) {
+  ParserConfiguration config;
+  config.packrat = true;
+
+  // the unbounded memo tables miss at most once per start token, so the
+  // misses grow linearly with the input.
+  constexpr std::size_t kMemoTables = 7;
+
+  std::size_t previousMisses = 0;
+
+  for (int n : {25, 50, 100}) {
+    auto result = parse(nestedSource(n), config);
+
+    ASSERT_TRUE(result.parsed);
+    ASSERT_EQ(result.diagnostics, "");
+
+    EXPECT_EQ(result.stats.evictions, 0);
+    EXPECT_GT(result.stats.hits, 0);
+    EXPECT_LE(result.stats.misses, kMemoTables * result.tokenCount);
+
+    if (previousMisses) {
+      EXPECT_LE(result.stats.misses, 2 * previousMisses + 16);
+    }
+
+    previousMisses = result.stats.misses;
+  }
+}
+
+TEST(Parser, speculative_nodes_survive) {
+  // the array bound, the member function bodies and the memoized
+  // template ids are parsed inside lookaheads that fail first, and stay
+  // referenced from the types, the pending definitions and the caches.
+  const char* source = R"(
+template <int N> struct B { int data[N]; };
+
+struct C {
+  auto get() -> int { return (int) value + B<2>{}.data[0]; }
+  int value;
+};
+
+int f(int x) {
+  if (auto y = (int) x) return y;
+  return B<1>{}.data[0];
+}
+)";
+
+  for (bool packrat : {false, true}) {
+    Control control;
+    DiagnosticsClient diagnosticsClient;
+    TranslationUnit unit(&control, &diagnosticsClient);
+    unit.setSource(source, "main.cc");
+
+    unit.parse(ParserConfiguration{.checkTypes = true, .packrat = packrat});
+    ASSERT_NE(unit.ast(), nullptr);
+
+    auto lookup = [&](Scope* scope, std::string_view name) -> Symbol* {
+      auto symbols = scope->get(control.getIdentifier(name));
+      return symbols.empty() ? nullptr : *std::ranges::begin(symbols);
+    };
+
+    auto classB = symbol_cast<ClassSymbol>(lookup(unit.globalScope(), "B"));
+    ASSERT_NE(classB, nullptr);
+
+    auto data = lookup(classB->scope(), "data");
+    ASSERT_NE(data, nullptr);
+
+    auto arrayType = type_cast<UnresolvedBoundedArrayType>(data->type());
+    ASSERT_NE(arrayType, nullptr);
+    EXPECT_EQ(to_string(arrayType), "int [N]");
+
+    struct CollectIdExpressions : RecursiveASTVisitor {
+      TranslationUnit* unit = nullptr;
+      std::vector<std::string> names;
+
+      void visit(IdExpressionAST* ast) override {
+        auto id = ast_cast<NameIdAST>(ast->unqualifiedId);
+        if (id) names.push_back(unit->identifier(id->identifierLoc)->name());
+        RecursiveASTVisitor::visit(ast);
+      }
+    } collect;
+
+    collect.unit = &unit;
+    collect.accept(unit.ast());
+
+    EXPECT_EQ(collect.names, (std::vector<std::string>{"N", "value", "data",
+                                                        "x", "y", "data"}));
+  }
+}
+
+TEST(Parser, reclaim_failed_lookaheads) {
+  // the conditions are parsed as declarations first, the failed attempts
+  // are released and the expressions parsed next must stay intact.
+  const char* source = R"(
+int f(int x) {
+  if (int(x) + 1) return x;
+  while (int(x) < 3) x = x + 1;
+  return x;
+}
+)";
+
+  Control control;
+  DiagnosticsClient diagnosticsClient;
+  TranslationUnit unit(&control, &diagnosticsClient);
+  unit.setSource(source, "main.cc");
+
+  unit.parse(ParserConfiguration{.checkTypes = true});
+  ASSERT_NE(unit.ast(), nullptr);
+
+  EXPECT_GT(unit.stats().parser.reclaimedBytes, 0);
+
+  struct CollectIdExpressions : RecursiveASTVisitor {
+    TranslationUnit* unit = nullptr;
+    std::vector<std::string> names;
+
+    void visit(IdExpressionAST* ast) override {
+      auto id = ast_cast<NameIdAST>(ast->unqualifiedId);
+      if (id) names.push_back(unit->identifier(id->identifierLoc)->name());
+      RecursiveASTVisitor::visit(ast);
+    }
+  } collect;
+
+  collect.unit = &unit;
+  collect.accept(unit.ast());
+
+  EXPECT_EQ(collect.names,
+            (std::vector<std::string>{"x", "x", "x", "x", "x", "x"}));
+}
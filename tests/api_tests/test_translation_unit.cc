@@ -0,0 +1,1529 @@
+// Copyright (c) 2023 Roberto Raggi <roberto.raggi@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <cxx/ast.h>
+#include <cxx/ast_image.h>
+#include <cxx/ast_slot.h>
+#include <cxx/control.h>
+#include <cxx/flat_ast.h>
+#include <cxx/literals.h>
+#include <cxx/names.h>
+#include <cxx/preprocessor.h>
+#include <cxx/recursive_ast_visitor.h>
+#include <cxx/scope.h>
+#include <cxx/symbols.h>
+#include <cxx/translation_unit.h>
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace cxx;
+
+namespace {
+
+auto tokenKinds(TranslationUnit& unit) -> std::vector<TokenKind> {
+  std::vector<TokenKind> kinds;
+  for (SourceLocation loc(1);; loc = loc.next()) {
+    kinds.push_back(unit.tokenKind(loc));
+    if (kinds.back() == TokenKind::T_EOF_SYMBOL) break;
+  }
+  return kinds;
+}
+
+// the bodies use template ids and a member of a local class.
+const char* kFunctionsSource = R"(
+template <typename T> struct S { static T value; };
+
+struct C {
+  int f() { return S<int>::value + g(); }
+  int g() { return 1; }
+};
+
+int h(int x) {
+  struct L { int m() { return 2; } };
+  return (S<int>::value) + L().m() * x;
+}
+)";
+
+struct CollectFunctionDefinitions : RecursiveASTVisitor {
+  std::vector<FunctionDefinitionAST*> functions;
+
+  void visit(FunctionDefinitionAST* ast) override {
+    functions.push_back(ast);
+    RecursiveASTVisitor::visit(ast);
+  }
+};
+
+auto functionDefinitions(TranslationUnit& unit)
+    -> std::vector<FunctionDefinitionAST*> {
+  CollectFunctionDefinitions collect;
+  collect.accept(unit.ast());
+  return collect.functions;
+}
+
+auto functionBody(FunctionDefinitionAST* ast) -> CompoundStatementAST* {
+  auto body = ast_cast<CompoundStatementFunctionBodyAST>(ast->functionBody);
+  return body ? body->statement : nullptr;
+}
+
+// prints the kinds of the nodes and the spelling and source offset of the
+// tokens, the token indices of an incrementally parsed unit differ.
+void dump(TranslationUnit& unit, AST* ast, std::ostream& out) {
+  if (!ast) {
+    out << " null";
+    return;
+  }
+
+  ASTSlot getSlot;
+
+  out << " (" << static_cast<int>(ast->kind());
+
+  for (int slot = 0, count = 1; slot < count; ++slot) {
+    const auto info = getSlot(ast, slot);
+    count = info.slotCount;
+
+    switch (info.kind) {
+      case ASTSlotKind::kToken: {
+        const SourceLocation loc(static_cast<std::uint32_t>(info.handle));
+        if (!loc) break;
+        out << " " << Token::spell(unit.tokenKind(loc)) << "@"
+            << unit.tokenAt(loc).offset();
+        break;
+      }
+
+      case ASTSlotKind::kNode:
+        dump(unit, reinterpret_cast<AST*>(info.handle), out);
+        break;
+
+      case ASTSlotKind::kNodeList:
+        for (auto it = reinterpret_cast<List<AST*>*>(info.handle); it;
+             it = it->next) {
+          dump(unit, it->value, out);
+        }
+        break;
+
+      case ASTSlotKind::kIdentifierAttribute:
+        if (auto id = reinterpret_cast<const Identifier*>(info.handle)) {
+          out << " " << id->name();
+        }
+        break;
+
+      case ASTSlotKind::kLiteralAttribute:
+        if (auto literal = reinterpret_cast<const Literal*>(info.handle)) {
+          out << " " << literal->value();
+        }
+        break;
+
+      default:
+        out << " " << info.handle;
+        break;
+    }  // switch
+  }
+
+  out << ")";
+}
+
+auto dump(TranslationUnit& unit) -> std::string {
+  std::ostringstream out;
+  dump(unit, unit.ast(), out);
+  return out.str();
+}
+
+// the flattened AST with the source offsets of the tokens instead of their
+// indices, which change with the edits.
+auto flatten(TranslationUnit& unit) -> std::vector<std::uint32_t> {
+  auto data = unit.flatten();
+
+  for (std::uint32_t i = 0; i < data[FlatAST::kRecordCount]; ++i) {
+    auto record = &data[FlatAST::kHeaderSize + i * FlatAST::kRecordSize];
+
+    if (record[FlatAST::kSlotKind] ==
+        static_cast<std::uint32_t>(ASTSlotKind::kToken)) {
+      const SourceLocation loc(record[FlatAST::kValue]);
+      record[FlatAST::kValue] = unit.tokenAt(loc).offset();
+    }
+
+    record[FlatAST::kFirstToken] = 0;
+    record[FlatAST::kLastToken] = 0;
+  }
+
+  return data;
+}
+
+struct CountingDiagnosticsClient final : DiagnosticsClient {
+  int count = 0;
+
+  void report(const Diagnostic&) override { ++count; }
+};
+
+// parses the source and applies the edit, or parses the edited source.
+struct EditTest {
+  Control control;
+  CountingDiagnosticsClient diagnosticsClient;
+  std::string source;
+  ParserConfiguration config;
+  TranslationUnit unit{&control, &diagnosticsClient};
+
+  explicit EditTest(std::string source, ParserConfiguration config = {})
+      : source(std::move(source)), config(config) {
+    this->config.incremental = true;
+    unit.setSource(this->source, "main.cc");
+    unit.parse(this->config);
+  }
+
+  auto edit(std::string_view text, std::string_view replacement)
+      -> std::optional<std::pair<std::uint32_t, std::uint32_t>> {
+    const auto offset = static_cast<std::uint32_t>(source.find(text));
+    const auto length = static_cast<std::uint32_t>(text.size());
+    source.replace(offset, length, replacement);
+    return unit.applyEdit(offset, length, replacement);
+  }
+
+  auto parsed() -> std::string {
+    Control control;
+    TranslationUnit unit(&control, &diagnosticsClient);
+    unit.setSource(source, "main.cc");
+    unit.parse(config);
+    return dump(unit);
+  }
+
+  auto parsedFlat() -> std::vector<std::uint32_t> {
+    Control control;
+    CountingDiagnosticsClient diagnosticsClient;
+    TranslationUnit unit(&control, &diagnosticsClient);
+    unit.setSource(source, "main.cc");
+    unit.parse(config);
+    return flatten(unit);
+  }
+
+  auto lookup(std::string_view name) -> std::size_t {
+    auto symbols = unit.globalScope()->get(control.getIdentifier(name));
+    return std::ranges::distance(symbols);
+  }
+};
+
+const char* kEditSource = R"(
+struct A { int x; };
+
+int f(int x) { return x + 1; }
+
+void g(int);
+void g(double);
+
+int h() { return A().x; }
+)";
+
+}  // namespace
+
+TEST(TranslationUnit, token_values) {
+  Control control;
+  DiagnosticsClient diagnosticsClient;
+
+  std::string source;
+  for (int i = 0; i < 100; ++i) {
+    source += "int x" + std::to_string(i) + " = " + std::to_string(i) + ";\n";
+  }
+
+  TranslationUnit unit(&control, &diagnosticsClient);
+  unit.setSource(source, "main.cc");
+
+  ASSERT_EQ(unit.tokenCount(), 100 * 5 + 2);
+
+  for (int i = 0; i < 100; ++i) {
+    SourceLocation loc(1 + i * 5);
+
+    ASSERT_EQ(unit.tokenKind(loc), TokenKind::T_INT);
+    ASSERT_TRUE(unit.tokenAt(loc).startOfLine());
+    ASSERT_EQ(unit.identifier(loc.next())->name(),
+              "x" + std::to_string(i));
+    ASSERT_TRUE(unit.tokenAt(loc.next()).leadingSpace());
+    ASSERT_EQ(unit.literal(SourceLocation(loc.index() + 3))->value(),
+              std::to_string(i));
+    ASSERT_EQ(unit.tokenAt(SourceLocation(loc.index() + 4)).value().ptrValue,
+              nullptr);
+  }
+
+  unsigned line = 0;
+  unsigned column = 0;
+  unit.getTokenStartPosition(SourceLocation(1 + 99 * 5 + 3), &line, &column);
+  ASSERT_EQ(line, 100);
+  ASSERT_EQ(column, 11);
+}
+
+TEST(TranslationUnit, skip_function_bodies) {
+  Control control;
+  DiagnosticsClient diagnosticsClient;
+
+  std::ostringstream diagnostics;
+  diagnosticsClient.setOutput(diagnostics);
+
+  TranslationUnit unit(&control, &diagnosticsClient);
+  unit.setSource(kFunctionsSource, "main.cc");
+  unit.parse(ParserConfiguration{.skipFunctionBodies = true});
+
+  ASSERT_NE(unit.ast(), nullptr);
+
+  auto functions = functionDefinitions(unit);
+  ASSERT_EQ(functions.size(), 3);
+
+  // the token range of the skipped bodies is known, the statements are not.
+  for (auto function : functions) {
+    auto body = functionBody(function);
+    ASSERT_NE(body, nullptr);
+    ASSERT_TRUE(body->lbraceLoc);
+    ASSERT_TRUE(body->rbraceLoc);
+    ASSERT_EQ(body->statementList, nullptr);
+  }
+
+  for (auto function : functions) {
+    ASSERT_TRUE(unit.parseFunctionBody(function));
+    ASSERT_NE(functionBody(function)->statementList, nullptr);
+    ASSERT_FALSE(unit.parseFunctionBody(function));
+  }
+
+  ASSERT_EQ(diagnostics.str(), "");
+
+  // the member function of the local class is parsed with the body of h.
+  ASSERT_EQ(functionDefinitions(unit).size(), 4);
+}
+
+TEST(TranslationUnit, parse_function_bodies_eagerly) {
+  Control control;
+  DiagnosticsClient diagnosticsClient;
+
+  TranslationUnit unit(&control, &diagnosticsClient);
+  unit.setSource(kFunctionsSource, "main.cc");
+  unit.parse();
+
+  auto functions = functionDefinitions(unit);
+  ASSERT_EQ(functions.size(), 4);
+
+  for (auto function : functions) {
+    ASSERT_NE(functionBody(function)->statementList, nullptr);
+    ASSERT_FALSE(unit.parseFunctionBody(function));
+  }
+}
+
+TEST(TranslationUnit, apply_edit) {
+  EditTest test(kEditSource);
+
+  // only the edited function is reparsed.
+  const auto body = "return x + 1;";
+  const auto start = test.source.find("int f");
+  const auto end = test.source.find("}", start) + 1;
+  const auto range = test.edit(body, "return A().x * (x + 2);");
+  ASSERT_TRUE(range);
+  ASSERT_EQ(range->first, start);
+  ASSERT_EQ(range->second, end);
+  ASSERT_EQ(dump(test.unit), test.parsed());
+
+  // the following tokens are moved.
+  unsigned line = 0;
+  unsigned column = 0;
+  auto unit = ast_cast<TranslationUnitAST>(test.unit.ast());
+  auto last = unit->declarationList;
+  while (last->next) last = last->next;
+  test.unit.getTokenStartPosition(last->value->firstSourceLocation(), &line,
+                                  &column);
+  ASSERT_EQ(line, 9);
+  ASSERT_EQ(column, 1);
+
+  // insert and remove declarations.
+  ASSERT_TRUE(test.edit("void g(double);", "void g(double);\nint y = 0;"));
+  ASSERT_EQ(dump(test.unit), test.parsed());
+  ASSERT_EQ(test.lookup("y"), 1);
+
+  ASSERT_TRUE(test.edit("void g(int);\n", ""));
+  ASSERT_EQ(dump(test.unit), test.parsed());
+  ASSERT_EQ(test.lookup("g"), 1);
+
+  // the edits of the classes used after them need a full parse.
+  ASSERT_FALSE(test.edit("struct A", "struct B"));
+
+  // the edits changing how the following text is lexed need a full parse.
+  ASSERT_FALSE(EditTest("int a; int b;\nint c;").edit("int a;", "// int a;"));
+  ASSERT_FALSE(
+      EditTest("int a;\nint b;\nint c;").edit("int a;", "/* int a;"));
+  ASSERT_FALSE(EditTest("int a;\nint b;\nint c;").edit("int a;", "int a\\"));
+  ASSERT_FALSE(
+      EditTest("int a;\n#define X\nint b;").edit("int a;", "int a; \\"));
+
+  // the declarations left unterminated by the edit continue with the
+  // following declarations, which are reparsed too.
+  for (auto [text, replacement] :
+       {std::pair{"static int b;", "static"},
+        std::pair{"const char* s = \"s\";", "const // char* s"}}) {
+    std::string source = "int a;\nstatic int b;\nconst char* s = \"s\";\n";
+    for (int i = 0; i < 10; ++i) source += "int v" + std::to_string(i) + ";\n";
+    EditTest test(source);
+    ASSERT_TRUE(test.edit(text, replacement));
+    ASSERT_EQ(test.diagnosticsClient.count, 0);
+    ASSERT_EQ(flatten(test.unit), test.parsedFlat());
+  }
+
+  // the edits whose reparse reports errors need a full parse, the errors
+  // are not reported.
+  EditTest errors("int a;\nint b;\nint c;\n");
+  ASSERT_FALSE(errors.edit("int b;", "int b; int"));
+  ASSERT_EQ(errors.diagnosticsClient.count, 0);
+
+  // the comments closed after the edit are fine.
+  EditTest comment("int a; /* b */ int c;");
+  ASSERT_TRUE(comment.edit("int a;", "int a; /*"));
+  ASSERT_EQ(dump(comment.unit), comment.parsed());
+
+  // the units not parsed for editing need a full parse.
+  Control control;
+  DiagnosticsClient diagnosticsClient;
+  TranslationUnit plain(&control, &diagnosticsClient);
+  plain.setSource("int a;\nint b;\n", "main.cc");
+  plain.parse();
+  ASSERT_FALSE(plain.applyEdit(4, 1, "c"));
+}
+
+TEST(TranslationUnit, apply_edit_keeps_symbols) {
+  std::string source = R"(
+struct S { int a; };
+S s;
+int f() { return 1; }
+int k() { return 3; }
+)";
+
+  for (int i = 0; i < 40; ++i) source += "int v" + std::to_string(i) + ";\n";
+
+  source += "int g() { return s.a + f(); }\n";
+
+  // the names used by the declarations after the edit are bound to the
+  // symbols of the global scope.
+  auto checkSymbols = [](EditTest& test) {
+    struct CollectIdExpressions : RecursiveASTVisitor {
+      std::vector<IdExpressionAST*> ids;
+
+      void visit(IdExpressionAST* ast) override {
+        ids.push_back(ast);
+        RecursiveASTVisitor::visit(ast);
+      }
+    } collect;
+
+    collect.accept(test.unit.ast());
+
+    std::vector<const Name*> names;
+
+    for (auto id : collect.ids) {
+      if (!id->symbol) continue;
+      names.push_back(id->symbol->name());
+      auto symbols = test.unit.globalScope()->get(id->symbol->name());
+      ASSERT_EQ(std::ranges::distance(symbols), 1);
+      ASSERT_EQ(*std::ranges::begin(symbols), id->symbol);
+    }
+
+    const std::vector<const Name*> expected{test.control.getIdentifier("s"),
+                                            test.control.getIdentifier("f")};
+    ASSERT_EQ(names, expected);
+  };
+
+  EditTest test(source, ParserConfiguration{.checkTypes = true});
+  checkSymbols(test);
+
+  ASSERT_TRUE(test.edit("return 3;", "return 4;"));
+  ASSERT_EQ(dump(test.unit), test.parsed());
+  checkSymbols(test);
+
+  // the functions declared again with the same type keep their symbols.
+  ASSERT_TRUE(test.edit("return 1;", "return 2;"));
+  ASSERT_EQ(dump(test.unit), test.parsed());
+  checkSymbols(test);
+
+  // the edits changing the declarations used after them need a full parse.
+  ASSERT_FALSE(EditTest(source).edit("int a;", "char a;"));
+  ASSERT_FALSE(EditTest(source).edit("S s;", "const S s;"));
+  ASSERT_FALSE(EditTest(source).edit("int f()", "int f2()"));
+  ASSERT_FALSE(
+      EditTest(source + "int w = v0;\n").edit("int v0;", "typedef int v0;"));
+
+  // the names not used after the edit can declare classes and typedefs.
+  for (auto replacement : {"typedef int v0;", "struct v0 { int x; };",
+                           "extern \"C\" { struct v0 {}; }"}) {
+    EditTest edited(source);
+    ASSERT_TRUE(edited.edit("int v0;", replacement));
+    ASSERT_EQ(dump(edited.unit), edited.parsed());
+  }
+
+  // the edits declaring templates, namespaces and using directives can
+  // change how the following declarations are parsed.
+  ASSERT_FALSE(EditTest(source).edit("int v0;", "template <typename T> T v0;"));
+  ASSERT_FALSE(EditTest(source).edit("int v0;", "namespace v0 {}"));
+  ASSERT_FALSE(EditTest(source).edit("int v0;", "using namespace std;"));
+
+  // the classes local to a function do not.
+  ASSERT_TRUE(
+      EditTest(source).edit("return 3;", "struct L { int x; }; return 3;"));
+}
+
+TEST(TranslationUnit, apply_edit_in_namespaces) {
+  EditTest test(R"(
+namespace n {
+int f() { return 1; }
+extern "C" {
+int k() { return 0; }
+}
+int g() { return f(); }
+}
+int h() { return n::g(); }
+)",
+                ParserConfiguration{.checkTypes = true});
+
+  // only the edited member of the namespace is reparsed.
+  const auto start = test.source.find("int f");
+  const auto range = test.edit("return 1;", "return 2;");
+  ASSERT_TRUE(range);
+  ASSERT_EQ(range->first, start);
+  ASSERT_EQ(dump(test.unit), test.parsed());
+
+  ASSERT_TRUE(test.edit("return 0;", "return f();"));
+  ASSERT_EQ(dump(test.unit), test.parsed());
+
+  // the following declarations keep referring to the members of the
+  // namespace.
+  struct CollectIdExpressions : RecursiveASTVisitor {
+    std::vector<IdExpressionAST*> ids;
+
+    void visit(IdExpressionAST* ast) override {
+      ids.push_back(ast);
+      RecursiveASTVisitor::visit(ast);
+    }
+  } collect;
+
+  collect.accept(test.unit.ast());
+
+  auto namespaces =
+      test.unit.globalScope()->get(test.control.getIdentifier("n"));
+  ASSERT_EQ(std::ranges::distance(namespaces), 1);
+  auto ns = symbol_cast<NamespaceSymbol>(*std::ranges::begin(namespaces));
+  ASSERT_TRUE(ns);
+
+  auto symbols = ns->scope()->get(test.control.getIdentifier("f"));
+  ASSERT_EQ(std::ranges::distance(symbols), 1);
+
+  auto references = std::ranges::count_if(collect.ids, [&](auto id) {
+    return id->symbol == *std::ranges::begin(symbols);
+  });
+  ASSERT_EQ(references, 2);
+
+  ASSERT_FALSE(test.edit("int f()", "int f2()"));
+}
+
+TEST(TranslationUnit, apply_edit_with_macros) {
+  EditTest test(R"(
+#define N 10
+int a = N;
+int b = 2;
+)");
+
+  ASSERT_TRUE(test.edit("2", "3"));
+  ASSERT_EQ(dump(test.unit), test.parsed());
+
+  // the edits of expanded macros, and introducing macros or directives,
+  // need a full parse.
+  ASSERT_FALSE(test.edit("int a", "long a"));
+  ASSERT_FALSE(EditTest(R"(
+#define N 10
+int a = N;
+int b = 2;
+)").edit("2", "N"));
+  ASSERT_FALSE(EditTest("int a;\nint b;\n").edit("int b;", "#define X\n"));
+}
+
+TEST(TranslationUnit, include_resolution_cache) {
+  Control control;
+  DiagnosticsClient diagnosticsClient;
+
+  std::ostringstream diagnostics;
+  diagnosticsClient.setOutput(diagnostics);
+
+  std::vector<std::string> probes;
+
+  TranslationUnit unit(&control, &diagnosticsClient);
+  auto preprocessor = unit.preprocessor();
+  preprocessor->addSystemIncludePath("/a");
+  preprocessor->addSystemIncludePath("/b");
+  preprocessor->setFileExistsFunction([&](std::string fileName) {
+    probes.push_back(fileName);
+    return fileName == "/a/x.h";
+  });
+  preprocessor->setReadFileFunction([](std::string) { return "int x;\n"; });
+
+  unit.setSource(R"(
+#if __has_include(<y.h>) || __has_include(<y.h>)
+#error "y.h found"
+#endif
+#if __has_include_next(<x.h>)
+#error "x.h found twice"
+#endif
+#include <x.h>
+#include <x.h>
+)",
+                 "main.cc");
+
+  ASSERT_EQ(diagnostics.str(), "");
+
+  // every candidate is probed once, the second lookups are cache hits.
+  ASSERT_EQ(probes, (std::vector<std::string>{"/b/y.h", "/a/y.h", "/b/x.h",
+                                              "/a/x.h"}));
+
+  const auto& stats = preprocessor->includeCacheStats();
+  ASSERT_EQ(stats.misses, 3);
+  ASSERT_EQ(stats.hits, 2);
+  ASSERT_EQ(stats.fileExistsCalls, 4);
+
+  // the file system cache can be shared by the translation units.
+  TranslationUnit other(&control, &diagnosticsClient);
+  other.preprocessor()->addSystemIncludePath("/a");
+  other.preprocessor()->addSystemIncludePath("/b");
+  other.preprocessor()->setFileExistsFunction([&](std::string fileName) {
+    probes.push_back(fileName);
+    return fileName == "/a/x.h";
+  });
+  other.preprocessor()->setFileSystemCache(preprocessor->fileSystemCache());
+  other.preprocessor()->setReadFileFunction(
+      [](std::string) { return "int x;\n"; });
+  other.setSource("#include <x.h>\n", "other.cc");
+
+  ASSERT_EQ(probes.size(), 4);
+  ASSERT_EQ(other.preprocessor()->includeCacheStats().fileExistsCalls, 0);
+}
+
+TEST(TranslationUnit, precompiled_header_validation) {
+  std::map<std::string, std::string> files{
+      {"/inc/a.h", "#define A 1\n#undef NDEBUG\n"},
+      {"prefix.h", "#include <a.h>\n"},
+  };
+
+  auto configure = [&](Preprocessor* preprocessor) {
+    preprocessor->addSystemIncludePath("/inc");
+    preprocessor->defineMacro("NDEBUG", "1");
+    preprocessor->setFileExistsFunction(
+        [&](std::string fileName) { return files.contains(fileName); });
+    preprocessor->setReadFileFunction(
+        [&](std::string fileName) { return files.at(fileName); });
+  };
+
+  std::ostringstream out;
+  {
+    Control control;
+    DiagnosticsClient diagnosticsClient;
+    TranslationUnit unit(&control, &diagnosticsClient);
+    configure(unit.preprocessor());
+    unit.preprocessor()->precompileHeader(files["prefix.h"], "prefix.h", out);
+  }
+
+  const auto pch = out.str();
+
+  auto include = [&](auto setup) -> std::optional<std::vector<TokenKind>> {
+    Control control;
+    DiagnosticsClient diagnosticsClient;
+    TranslationUnit unit(&control, &diagnosticsClient);
+    configure(unit.preprocessor());
+    setup(unit.preprocessor());
+    if (!unit.preprocessor()->includePrecompiledHeader(pch)) {
+      return std::nullopt;
+    }
+    unit.setSource("A NDEBUG\n", "main.cc");
+    return tokenKinds(unit);
+  };
+
+  auto same = [](Preprocessor*) {};
+
+  // the macros undefined by the prefix header stay undefined.
+  ASSERT_EQ(include(same),
+            (std::vector<TokenKind>{TokenKind::T_INTEGER_LITERAL,
+                                    TokenKind::T_IDENTIFIER,
+                                    TokenKind::T_EOF_SYMBOL}));
+
+  // the header is rejected with other include paths or macros.
+  ASSERT_FALSE(include(
+      [](Preprocessor* preprocessor) { preprocessor->defineMacro("B", "1"); }));
+  ASSERT_FALSE(include(
+      [](Preprocessor* preprocessor) { preprocessor->undefMacro("NDEBUG"); }));
+  ASSERT_FALSE(include([](Preprocessor* preprocessor) {
+    preprocessor->addSystemIncludePath("/other");
+  }));
+
+  // or when the restored files changed.
+  files["/inc/a.h"] = "#define A 2\n#undef NDEBUG\n";
+  ASSERT_FALSE(include(same));
+
+  files["/inc/a.h"] = "#define A 10\n#undef NDEBUG\n";
+  ASSERT_FALSE(include(same));
+
+  files.erase("/inc/a.h");
+  ASSERT_FALSE(include(same));
+}
+
+TEST(TranslationUnit, precompiled_header_paths) {
+  namespace fs = std::filesystem;
+
+  const auto root = fs::temp_directory_path() / "cxx_test_precompiled_header";
+  fs::remove_all(root);
+  fs::create_directories(root / "inc");
+  fs::create_directories(root / "other");
+
+  std::ofstream(root / "inc" / "a.h") << "int a;\n";
+  std::ofstream(root / "prefix.h") << "#include \"inc/a.h\"\n";
+
+  struct CurrentPath {
+    fs::path saved = fs::current_path();
+    ~CurrentPath() { fs::current_path(saved); }
+  } currentPath;
+
+  // the header is precompiled with names relative to its directory.
+  fs::current_path(root);
+
+  std::ostringstream out;
+  {
+    Control control;
+    DiagnosticsClient diagnosticsClient;
+    TranslationUnit unit(&control, &diagnosticsClient);
+    unit.preprocessor()->precompileHeader("#include \"inc/a.h\"\n",
+                                          "prefix.h", out);
+  }
+
+  const auto pch = out.str();
+
+  // only the hashes of the files are stored, not their content.
+  ASSERT_EQ(pch.find("int a;"), std::string::npos);
+
+  auto include = [&]() -> std::optional<std::vector<TokenKind>> {
+    Control control;
+    DiagnosticsClient diagnosticsClient;
+    TranslationUnit unit(&control, &diagnosticsClient);
+    if (!unit.preprocessor()->includePrecompiledHeader(pch)) {
+      return std::nullopt;
+    }
+    unit.setSource("int x;\n", "main.cc");
+    return tokenKinds(unit);
+  };
+
+  // the files are found from another directory.
+  fs::current_path(root / "other");
+
+  const std::vector<TokenKind> tokens{
+      TokenKind::T_INT,       TokenKind::T_IDENTIFIER, TokenKind::T_SEMICOLON,
+      TokenKind::T_INT,       TokenKind::T_IDENTIFIER, TokenKind::T_SEMICOLON,
+      TokenKind::T_EOF_SYMBOL};
+
+  ASSERT_EQ(include(), tokens);
+
+  // a file whose content changed is detected, even if its size is the same.
+  std::ofstream(root / "inc" / "a.h") << "int b;\n";
+  ASSERT_FALSE(include());
+
+  std::ofstream(root / "inc" / "a.h") << "int a;\n";
+  ASSERT_EQ(include(), tokens);
+
+  fs::current_path(currentPath.saved);
+  fs::remove_all(root);
+}
+
+TEST(TranslationUnit, precompiled_header_reinclude) {
+  std::map<std::string, std::string> files{
+      {"un.h", "int u;\n"},
+      {"prefix.h", "#include \"un.h\"\n"},
+  };
+
+  auto configure = [&](Preprocessor* preprocessor) {
+    preprocessor->setFileExistsFunction(
+        [&](std::string fileName) { return files.contains(fileName); });
+    preprocessor->setReadFileFunction(
+        [&](std::string fileName) { return files.at(fileName); });
+  };
+
+  std::ostringstream out;
+  {
+    Control control;
+    DiagnosticsClient diagnosticsClient;
+    TranslationUnit unit(&control, &diagnosticsClient);
+    configure(unit.preprocessor());
+    unit.preprocessor()->precompileHeader(files["prefix.h"], "prefix.h", out);
+  }
+
+  Control control;
+  DiagnosticsClient diagnosticsClient;
+  TranslationUnit unit(&control, &diagnosticsClient);
+  configure(unit.preprocessor());
+  ASSERT_TRUE(unit.preprocessor()->includePrecompiledHeader(out.str()));
+
+  // the unguarded header restored from the precompiled header is expanded
+  // again.
+  unit.setSource("int x;\n#include \"un.h\"\nint y;\n", "main.cc");
+
+  std::vector<std::string> names;
+  for (std::uint32_t i = 0; i < unit.tokenCount(); ++i) {
+    if (auto id = unit.identifier(SourceLocation(i))) {
+      names.push_back(id->name());
+    }
+  }
+
+  ASSERT_EQ(names, (std::vector<std::string>{"u", "x", "u", "y"}));
+}
+
+TEST(TranslationUnit, skip_guarded_includes) {
+  Control control;
+  DiagnosticsClient diagnosticsClient;
+
+  std::ostringstream diagnostics;
+  diagnosticsClient.setOutput(diagnostics);
+
+  int probes = 0;
+  int reads = 0;
+
+  TranslationUnit unit(&control, &diagnosticsClient);
+  auto preprocessor = unit.preprocessor();
+  preprocessor->addSystemIncludePath("/include");
+  preprocessor->setFileExistsFunction([&](std::string) {
+    ++probes;
+    return true;
+  });
+  preprocessor->setReadFileFunction([&](std::string fileName) {
+    ++reads;
+    if (fileName == "/include/once.h") return "#pragma once\nint once;\n";
+    return "#ifndef GUARD_H\n#define GUARD_H\nint guarded;\n#endif\n";
+  });
+
+  unit.setSource(R"(
+#include <once.h>
+#include <guard.h>
+#include <once.h>
+#include <guard.h>
+#undef GUARD_H
+#include <guard.h>
+)",
+                 "main.cc");
+
+  ASSERT_EQ(diagnostics.str(), "");
+  ASSERT_EQ(probes, 2);
+  ASSERT_EQ(reads, 2);
+
+  const auto& stats = preprocessor->includeCacheStats();
+  ASSERT_EQ(stats.misses, 2);
+  ASSERT_EQ(stats.hits, 3);
+  ASSERT_EQ(stats.skippedIncludes, 2);
+
+  int guarded = 0;
+  for (SourceLocation loc(1); loc.index() < unit.tokenCount();
+       loc = loc.next()) {
+    if (unit.tokenText(loc) == "guarded") ++guarded;
+  }
+  ASSERT_EQ(guarded, 2);
+}
+
+TEST(TranslationUnit, many_source_files) {
+  Control control;
+  DiagnosticsClient diagnosticsClient;
+
+  std::ostringstream diagnostics;
+  diagnosticsClient.setOutput(diagnostics);
+
+  TranslationUnit unit(&control, &diagnosticsClient);
+  auto preprocessor = unit.preprocessor();
+  preprocessor->addSystemIncludePath("/include");
+  preprocessor->setFileExistsFunction([](std::string) { return true; });
+  preprocessor->setReadFileFunction([](std::string) { return "int x;\n"; });
+
+  // the file ids of the tokens are not limited to 12 bits.
+  std::string source;
+  for (int i = 0; i < 4100; ++i) {
+    source += "#include <h" + std::to_string(i) + ".h>\n";
+  }
+
+  unit.setSource(source, "main.cc");
+
+  ASSERT_EQ(diagnostics.str(), "");
+  ASSERT_EQ(unit.tokenCount(), 4100 * 3 + 2);
+
+  std::string_view fileName;
+  unit.getTokenStartPosition(SourceLocation(unit.tokenCount() - 2), nullptr,
+                             nullptr, &fileName);
+  ASSERT_EQ(fileName, "/include/h4099.h");
+}
+
+TEST(TranslationUnit, token_cache) {
+  namespace fs = std::filesystem;
+
+  // a directory in the temporary directory, removed at the end of the test.
+  struct TempDirectory {
+    fs::path path = fs::temp_directory_path() / "cxx_test_token_cache";
+
+    TempDirectory() { fs::remove_all(path); }
+    ~TempDirectory() { fs::remove_all(path); }
+  } cacheDirectory;
+
+  // the spliced lines and the block comment are not plain slices of the
+  // source, and move the line table away from the token offsets.
+  const std::string header =
+      "// a comment\n"
+      "#define NAME spli\\\n"
+      "ced\n"
+      "int NAME = 1; /* a\n"
+      "block */ const char* s = \"a\\\n"
+      "b\";\n";
+
+  std::map<std::string, std::string> files{{"/inc/a.h", header}};
+
+  struct Result {
+    std::vector<std::tuple<TokenKind, std::string, std::string, unsigned,
+                           unsigned>>
+        tokens;
+    std::size_t hits = 0;
+    std::size_t misses = 0;
+  };
+
+  auto include = [&](bool cached) -> Result {
+    Control control;
+    DiagnosticsClient diagnosticsClient;
+
+    std::ostringstream diagnostics;
+    diagnosticsClient.setOutput(diagnostics);
+
+    TranslationUnit unit(&control, &diagnosticsClient);
+    auto preprocessor = unit.preprocessor();
+    preprocessor->addSystemIncludePath("/inc");
+    preprocessor->setFileExistsFunction(
+        [&](std::string fileName) { return files.contains(fileName); });
+    preprocessor->setReadFileFunction(
+        [&](std::string fileName) { return files.at(fileName); });
+
+    if (cached) {
+      preprocessor->setTokenCacheDirectory(cacheDirectory.path.string());
+    }
+
+    unit.setSource("#include <a.h>\nint after = 2;\n", "main.cc");
+
+    EXPECT_EQ(diagnostics.str(), "");
+
+    Result result;
+    result.hits = preprocessor->stats().tokenCacheHits;
+    result.misses = preprocessor->stats().tokenCacheMisses;
+
+    for (SourceLocation loc(1); loc.index() < unit.tokenCount();
+         loc = loc.next()) {
+      unsigned line = 0;
+      unsigned column = 0;
+      std::string_view fileName;
+      unit.getTokenStartPosition(loc, &line, &column, &fileName);
+      result.tokens.emplace_back(unit.tokenKind(loc), unit.tokenText(loc),
+                                 fileName, line, column);
+    }
+
+    return result;
+  };
+
+  auto cacheFiles = [&] {
+    std::vector<fs::path> paths;
+    for (const auto& entry : fs::directory_iterator(cacheDirectory.path)) {
+      paths.push_back(entry.path());
+    }
+    return paths;
+  };
+
+  auto readCache = [&] {
+    const auto paths = cacheFiles();
+    if (paths.size() != 1) return std::string();
+    std::ifstream in(paths.front(), std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), {});
+  };
+
+  auto writeCache = [&](const std::string& data) {
+    std::ofstream(cacheFiles().front(), std::ios::binary) << data;
+  };
+
+  const auto fresh = include(/*cached=*/false);
+  ASSERT_GT(fresh.tokens.size(), 10);
+
+  // the first include misses and writes the cache.
+  const auto miss = include(/*cached=*/true);
+  ASSERT_EQ(miss.misses, 1);
+  ASSERT_EQ(miss.hits, 0);
+  ASSERT_EQ(miss.tokens, fresh.tokens);
+  ASSERT_EQ(cacheFiles().size(), 1);
+
+  const auto cache = readCache();
+  ASSERT_FALSE(cache.empty());
+
+  // the second include restores the same tokens and lines from the cache.
+  const auto hit = include(/*cached=*/true);
+  ASSERT_EQ(hit.hits, 1);
+  ASSERT_EQ(hit.misses, 0);
+  ASSERT_EQ(hit.tokens, fresh.tokens);
+  ASSERT_EQ(readCache(), cache);
+
+  // the content changed under the same path and modification time.
+  files["/inc/a.h"] = "int NAME = 1;\n" + header;
+
+  const auto changedFresh = include(/*cached=*/false);
+  const auto changed = include(/*cached=*/true);
+  ASSERT_EQ(changed.misses, 1);
+  ASSERT_EQ(changed.hits, 0);
+  ASSERT_EQ(changed.tokens, changedFresh.tokens);
+  ASSERT_NE(changed.tokens, fresh.tokens);
+
+  files["/inc/a.h"] = header;
+
+  ASSERT_EQ(include(/*cached=*/true).misses, 1);
+  ASSERT_EQ(readCache(), cache);
+
+  // the truncated or corrupt files are rejected, re-lexed and replaced.
+  auto badMagic = cache;
+  badMagic[0] = 'X';
+
+  for (const auto& corrupt :
+       {cache.substr(0, 8), cache.substr(0, cache.size() / 2),
+        cache.substr(0, cache.size() - 1), badMagic, std::string()}) {
+    writeCache(corrupt);
+
+    const auto relexed = include(/*cached=*/true);
+    ASSERT_EQ(relexed.misses, 1);
+    ASSERT_EQ(relexed.hits, 0);
+    ASSERT_EQ(relexed.tokens, fresh.tokens);
+    ASSERT_EQ(readCache(), cache);
+  }
+}
+
+TEST(TranslationUnit, stats) {
+  Control control;
+  DiagnosticsClient diagnosticsClient;
+  TranslationUnit unit(&control, &diagnosticsClient);
+
+  unit.setSource(R"(
+#define ONE 1
+#define ADD(a, b) ((a) + (b))
+int x = ADD(ONE, 2);
+int y = ONE;
+)",
+                 "main.cc");
+
+  const auto& preprocessorStats = unit.preprocessor()->stats();
+  ASSERT_EQ(preprocessorStats.tokens, 18);
+  ASSERT_EQ(preprocessorStats.macroExpansions, 3);
+  ASSERT_GT(preprocessorStats.hidesets, 0);
+
+  unit.parse();
+
+  const auto stats = unit.stats();
+  ASSERT_GT(stats.parser.lookaheads, 0);
+  ASSERT_LE(stats.parser.rewinds, stats.parser.lookaheads);
+  ASSERT_GT(stats.arenaBytes, 0);
+
+  const auto controlStats = control.stats();
+  ASSERT_GE(controlStats.names, 2);
+  ASSERT_EQ(controlStats.symbols, 3);
+  ASSERT_GT(controlStats.bytes, 0);
+}
+
+TEST(TranslationUnit, flatten) {
+  Control control;
+  DiagnosticsClient diagnosticsClient;
+  TranslationUnit unit(&control, &diagnosticsClient);
+
+  unit.setSource("int x = 1;\nint y = x;\n", "main.cc");
+  unit.parse();
+
+  const auto data = unit.flatten();
+  ASSERT_EQ(data[FlatAST::kVersionWord], FlatAST::kVersion);
+
+  const auto recordCount = data[FlatAST::kRecordCount];
+  auto record = [&](std::uint32_t index) {
+    return &data[FlatAST::kHeaderSize + index * FlatAST::kRecordSize];
+  };
+
+  // the root spans all the records and the tokens of the unit.
+  ASSERT_GT(recordCount, 0);
+  ASSERT_EQ(record(0)[FlatAST::kSlotKind], ASTSlotKind::kNode);
+  ASSERT_EQ(record(0)[FlatAST::kKind],
+            static_cast<std::uint32_t>(ASTKind::TranslationUnit));
+  ASSERT_EQ(record(0)[FlatAST::kParent], FlatAST::kNone);
+  ASSERT_EQ(record(0)[FlatAST::kValue], recordCount);
+  ASSERT_EQ(record(0)[FlatAST::kFirstToken], 1);
+  ASSERT_EQ(record(0)[FlatAST::kLastToken], unit.tokenCount() - 1);
+
+  const auto stringCount = data[FlatAST::kStringCount];
+  const auto offsets = &data[data[FlatAST::kStringTable]];
+  const auto text = reinterpret_cast<const char*>(offsets + stringCount + 1);
+
+  std::vector<std::string> identifiers;
+  int tokens = 0;
+
+  for (std::uint32_t i = 1; i < recordCount; ++i) {
+    ASSERT_LT(record(i)[FlatAST::kParent], i);
+
+    const auto parent = record(record(i)[FlatAST::kParent]);
+    ASSERT_EQ(parent[FlatAST::kSlotKind], ASTSlotKind::kNode);
+    ASSERT_LT(i, parent[FlatAST::kValue]);
+
+    switch (record(i)[FlatAST::kSlotKind]) {
+      case ASTSlotKind::kToken: {
+        const SourceLocation loc(record(i)[FlatAST::kValue]);
+        ASSERT_EQ(record(i)[FlatAST::kKind],
+                  static_cast<std::uint32_t>(unit.tokenKind(loc)));
+        ++tokens;
+        break;
+      }
+
+      case ASTSlotKind::kIdentifierAttribute: {
+        const auto id = record(i)[FlatAST::kValue];
+        ASSERT_LT(id, stringCount);
+        identifiers.emplace_back(text + offsets[id],
+                                 offsets[id + 1] - offsets[id]);
+        break;
+      }
+
+      default:
+        break;
+    }  // switch
+  }
+
+  // every token of the unit, except the end of file, is in the AST.
+  ASSERT_EQ(tokens, unit.tokenCount() - 2);
+  ASSERT_EQ(identifiers, (std::vector<std::string>{"x", "y", "x"}));
+
+  // a subtree is flattened on its own.
+  auto unitAST = ast_cast<TranslationUnitAST>(unit.ast());
+  const auto subtree = unit.flatten(unitAST->declarationList->next->value);
+  ASSERT_EQ(subtree[FlatAST::kHeaderSize + FlatAST::kKind],
+            static_cast<std::uint32_t>(ASTKind::SimpleDeclaration));
+  ASSERT_EQ(subtree[FlatAST::kHeaderSize + FlatAST::kFirstToken], 6);
+  ASSERT_EQ(subtree[FlatAST::kHeaderSize + FlatAST::kLastToken], 11);
+}
+
+TEST(TranslationUnit, ast_slots) {
+  Control control;
+  DiagnosticsClient diagnosticsClient;
+  TranslationUnit unit(&control, &diagnosticsClient);
+
+  unit.setSource("int x;\n", "main.cc");
+  unit.parse();
+
+  auto unitAST = ast_cast<TranslationUnitAST>(unit.ast());
+  ASSERT_NE(unitAST, nullptr);
+  ASSERT_NE(unitAST->declarationList, nullptr);
+
+  auto decl = ast_cast<SimpleDeclarationAST>(unitAST->declarationList->value);
+  ASSERT_NE(decl, nullptr);
+
+  const auto slots = getASTSlots(decl->kind());
+
+  std::vector<std::string_view> names;
+  for (const auto& slot : slots) names.push_back(to_string(slot.nameIndex));
+
+  ASSERT_EQ(names, (std::vector<std::string_view>{
+                       "attributeList", "declSpecifierList",
+                       "initDeclaratorList", "requiresClause",
+                       "semicolonLoc"}));
+
+  ASSERT_EQ(getASTSlotValue(decl, slots[1]),
+            reinterpret_cast<std::intptr_t>(decl->declSpecifierList));
+  ASSERT_EQ(getASTSlotValue(decl, slots[3]), 0);
+  ASSERT_EQ(slots[4].kind, ASTSlotKind::kToken);
+  ASSERT_EQ(getASTSlotValue(decl, slots[4]), decl->semicolonLoc.index());
+
+  // ASTSlot reports the same slots.
+  ASTSlot getSlot;
+  for (int slot = 0; slot < static_cast<int>(slots.size()); ++slot) {
+    const auto info = getSlot(decl, slot);
+    ASSERT_EQ(info.slotCount, slots.size());
+    ASSERT_EQ(info.kind, slots[slot].kind);
+    ASSERT_EQ(info.nameIndex, slots[slot].nameIndex);
+    ASSERT_EQ(info.handle, getASTSlotValue(decl, slots[slot]));
+  }
+
+  ASSERT_EQ(getSlot(decl, static_cast<int>(slots.size())).kind,
+            ASTSlotKind::kInvalid);
+}
+
+TEST(TranslationUnit, scope_lookup) {
+  std::string source;
+  for (int i = 0; i < 32; ++i) source += "int v" + std::to_string(i) + ";\n";
+  source += "struct stat {};\nint stat(const char*);\n";
+
+  Control control;
+  DiagnosticsClient diagnosticsClient;
+  TranslationUnit unit(&control, &diagnosticsClient);
+
+  unit.setSource(source, "main.cc");
+  unit.parse();
+
+  auto scope = unit.globalScope();
+  ASSERT_EQ(scope->symbols().size(), 34);
+
+  for (int i = 0; i < 32; ++i) {
+    auto name = control.getIdentifier("v" + std::to_string(i));
+    auto symbols = scope->get(name);
+    ASSERT_EQ(std::ranges::distance(symbols), 1);
+    ASSERT_EQ((*begin(symbols))->name(), name);
+  }
+
+  // the symbols with the same name are in declaration order.
+  auto stat = control.getIdentifier("stat");
+  std::vector<Symbol*> symbols;
+  for (auto symbol : scope->get(stat)) symbols.push_back(symbol);
+  ASSERT_EQ(symbols.size(), 2);
+  ASSERT_TRUE(symbols[0]->isClass());
+  ASSERT_TRUE(symbols[1]->isFunction());
+
+  scope->removeSymbol(symbols[0]);
+  ASSERT_EQ(std::ranges::distance(scope->get(stat)), 1);
+  ASSERT_EQ(*begin(scope->get(stat)), symbols[1]);
+
+  scope->removeSymbol(symbols[1]);
+  ASSERT_TRUE(scope->get(stat).empty());
+  ASSERT_EQ(scope->symbols().size(), 32);
+
+  ASSERT_TRUE(scope->get(control.getIdentifier("undeclared")).empty());
+}
+
+TEST(TranslationUnit, lookup_in_inline_namespaces) {
+  Control control;
+  DiagnosticsClient diagnosticsClient;
+  TranslationUnit unit(&control, &diagnosticsClient);
+
+  unit.setSource(R"(
+namespace ns {
+inline namespace v1 { int x; }
+int y = x;
+}
+int z = ns::y + x;
+)",
+                 "main.cc");
+
+  unit.parse(ParserConfiguration{.checkTypes = true});
+
+  struct CollectIdExpressions : RecursiveASTVisitor {
+    std::vector<IdExpressionAST*> ids;
+
+    void visit(IdExpressionAST* ast) override {
+      ids.push_back(ast);
+      RecursiveASTVisitor::visit(ast);
+    }
+  } collect;
+
+  collect.accept(unit.ast());
+
+  ASSERT_EQ(collect.ids.size(), 3);
+
+  // x is visible in ns through the inline namespace, but not in the global
+  // scope.
+  ASSERT_NE(collect.ids[0]->symbol, nullptr);
+  ASSERT_EQ(collect.ids[0]->symbol->name(), control.getIdentifier("x"));
+  ASSERT_EQ(collect.ids[2]->symbol, nullptr);
+}
+
+TEST(TranslationUnit, ast_image) {
+  Control control;
+  DiagnosticsClient diagnosticsClient;
+  TranslationUnit unit(&control, &diagnosticsClient);
+
+  unit.setSource(R"(
+#define ONE 1
+struct S { int x = ONE; const char* s = "s" "t"; };
+template <typename T> auto f(T t) -> T { return t + 'c' + 2.5; }
+)",
+                 "main.cc");
+  unit.parse();
+
+  const auto image = unit.serializeImage();
+  ASSERT_FALSE(image.empty());
+
+  Control otherControl;
+  TranslationUnit loaded(&otherControl, &diagnosticsClient);
+  ASSERT_TRUE(loaded.loadImage(image));
+  ASSERT_NE(loaded.ast(), nullptr);
+  ASSERT_EQ(loaded.fileName(), "main.cc");
+
+  ASSERT_EQ(loaded.flatten(), unit.flatten());
+
+  ASSERT_EQ(loaded.tokenCount(), unit.tokenCount());
+
+  for (unsigned i = 0; i < unit.tokenCount(); ++i) {
+    const SourceLocation loc(i);
+    ASSERT_EQ(loaded.tokenKind(loc), unit.tokenKind(loc));
+    ASSERT_EQ(loaded.tokenText(loc), unit.tokenText(loc));
+    ASSERT_EQ(loaded.tokenAt(loc).length(), unit.tokenAt(loc).length());
+
+    unsigned line = 0, column = 0, otherLine = 0, otherColumn = 0;
+    std::string_view fileName, otherFileName;
+    loaded.getTokenStartPosition(loc, &line, &column, &fileName);
+    unit.getTokenStartPosition(loc, &otherLine, &otherColumn, &otherFileName);
+    ASSERT_EQ(line, otherLine);
+    ASSERT_EQ(column, otherColumn);
+    ASSERT_EQ(fileName, otherFileName);
+  }
+
+  // the images with a wrong header or truncated are rejected.
+  auto corrupted = image;
+  corrupted[0] = 'X';
+  TranslationUnit rejected(&otherControl, &diagnosticsClient);
+  ASSERT_FALSE(rejected.loadImage(corrupted));
+  ASSERT_FALSE(rejected.loadImage(std::span(image).first(image.size() / 2)));
+  ASSERT_EQ(rejected.ast(), nullptr);
+}
+
+TEST(TranslationUnit, ast_image_validation) {
+  Control control;
+  DiagnosticsClient diagnosticsClient;
+  TranslationUnit unit(&control, &diagnosticsClient);
+  unit.setSource("int a;\nint b;\n", "main.cc");
+  unit.parse();
+
+  const auto image = unit.serializeImage();
+
+  ASTImage::Header header;
+  std::memcpy(&header, image.data(), sizeof(header));
+
+  // the offsets of the node table and of the list cells, see ASTImage.
+  auto align = [](std::size_t size) {
+    const auto alignment = ASTImage::kAlignment;
+    return (size + alignment - 1) / alignment * alignment;
+  };
+
+  // the offset of the section that follows the first `count` sections.
+  auto sectionOffset = [&](const ASTImage::Header& header, int count) {
+    std::size_t offset = sizeof(ASTImage::Header);
+    for (std::size_t size :
+         {std::size_t(header.atomCount),
+          (header.atomCount + 1) * sizeof(std::uint32_t),
+          std::size_t(header.atomTextSize), std::size_t(header.tokenCount),
+          std::size_t(header.tokenCount), std::size_t(header.tokenValuesSize),
+          std::size_t(header.tokenPositionsSize)}) {
+      if (!count--) break;
+      offset = align(offset) + size;
+    }
+    return align(offset);
+  };
+
+  auto nodeTableOffset = [&](const ASTImage::Header& header) {
+    return sectionOffset(header, 7);
+  };
+
+  const auto nodeTable = nodeTableOffset(header);
+
+  const auto nodes =
+      align(nodeTable + header.nodeCount * 2 * sizeof(std::uint32_t));
+  const auto lists = nodes + align(header.nodesSize);
+
+  auto rejected = [&](auto corrupt) {
+    auto corrupted = image;
+    corrupt(corrupted);
+    Control otherControl;
+    TranslationUnit eager(&otherControl, &diagnosticsClient);
+    TranslationUnit lazy(&otherControl, &diagnosticsClient);
+    return !eager.loadImage(corrupted) &&
+           !lazy.loadImage(corrupted, /*lazy=*/true);
+  };
+
+  auto setKind = [&](auto& data, std::uint32_t node, ASTKind kind) {
+    ASTImage::Header dataHeader;
+    std::memcpy(&dataHeader, data.data(), sizeof(dataHeader));
+    const auto value = static_cast<std::uint32_t>(kind);
+    std::memcpy(
+        data.data() + nodeTableOffset(dataHeader) + ((node - 1) * 2 + 1) * 4,
+        &value, sizeof(value));
+  };
+
+  ASSERT_EQ(header.root, 1);
+  ASSERT_FALSE(rejected([](auto&) {}));
+
+  // the first cell of the declarations links to itself.
+  ASSERT_TRUE(rejected([&](auto& data) {
+    const std::intptr_t next = 1;
+    std::memcpy(data.data() + lists + offsetof(List<AST*>, next), &next,
+                sizeof(next));
+  }));
+
+  // the root is not a unit.
+  ASSERT_TRUE(rejected([&](auto& data) {
+    setKind(data, header.root, ASTKind::SimpleDeclaration);
+  }));
+
+  // the first declaration is not a declaration.
+  ASSERT_TRUE(
+      rejected([&](auto& data) { setKind(data, 2, ASTKind::NameId); }));
+
+  // the bodies of the functions are checked when they are loaded, the
+  // bodies that are not valid are not linked to the AST.
+  TranslationUnit functions(&control, &diagnosticsClient);
+  functions.setSource("int f() { return 1; }\nint g() { return 2; }\n",
+                      "main.cc");
+  functions.parse();
+
+  auto corrupted = functions.serializeImage();
+  ASTImageView view(corrupted);
+  ASSERT_TRUE(view.isValid());
+
+  std::uint32_t literal = 0;
+  for (std::uint32_t node = 1; node <= view.nodeCount(); ++node) {
+    if (view.kind(node) != ASTKind::IntLiteralExpression) continue;
+    literal = node;
+    break;
+  }
+  ASSERT_NE(literal, 0);
+
+  setKind(corrupted, literal, ASTKind::NameId);
+
+  Control otherControl;
+  TranslationUnit eager(&otherControl, &diagnosticsClient);
+  ASSERT_FALSE(eager.loadImage(corrupted));
+
+  TranslationUnit lazy(&otherControl, &diagnosticsClient);
+  ASSERT_TRUE(lazy.loadImage(corrupted, /*lazy=*/true));
+
+  auto definitions = functionDefinitions(lazy);
+  ASSERT_EQ(definitions.size(), 2);
+
+  for (auto function : definitions) {
+    ASSERT_FALSE(lazy.parseFunctionBody(function));
+    ASSERT_EQ(functionBody(function)->statementList, nullptr);
+  }
+
+  ASSERT_FALSE(lazy.flatten().empty());
+
+  // the builtin tokens refer to a known builtin.
+  TranslationUnit builtins(&control, &diagnosticsClient);
+  builtins.setSource("bool b = __is_abstract(int);\n", "main.cc");
+  builtins.parse();
+
+  auto unknownBuiltin = builtins.serializeImage();
+  ASTImage::Header builtinsHeader;
+  std::memcpy(&builtinsHeader, unknownBuiltin.data(), sizeof(builtinsHeader));
+
+  // the value of the builtin is the last one of the token values.
+  const auto builtinValue = sectionOffset(builtinsHeader, 5) +
+                            builtinsHeader.tokenValuesSize - 1;
+  ASSERT_LT(unknownBuiltin[builtinValue], 0x7f);
+  unknownBuiltin[builtinValue] = 0x7f;
+
+  TranslationUnit eagerBuiltins(&otherControl, &diagnosticsClient);
+  ASSERT_FALSE(eagerBuiltins.loadImage(unknownBuiltin));
+
+  TranslationUnit lazyBuiltins(&otherControl, &diagnosticsClient);
+  ASSERT_FALSE(lazyBuiltins.loadImage(unknownBuiltin, /*lazy=*/true));
+
+  // the views of the images without a root.
+  ASTImageView empty;
+  ASSERT_EQ(empty.kind(empty.root()), ASTKind{});
+  ASSERT_EQ(empty.identifier(1), "");
+}
+
+TEST(TranslationUnit, lazy_ast_image) {
+  Control control;
+  DiagnosticsClient diagnosticsClient;
+  TranslationUnit unit(&control, &diagnosticsClient);
+  unit.setSource(kFunctionsSource, "main.cc");
+  unit.parse();
+
+  const auto image = unit.serializeImage();
+
+  Control eagerControl;
+  TranslationUnit eager(&eagerControl, &diagnosticsClient);
+  ASSERT_TRUE(eager.loadImage(image));
+
+  Control lazyControl;
+  TranslationUnit lazy(&lazyControl, &diagnosticsClient);
+  ASSERT_TRUE(lazy.loadImage(image, /*lazy=*/true));
+
+  // the statements of the function bodies are not loaded.
+  ASSERT_LT(lazy.stats().arenaBytes, eager.stats().arenaBytes);
+
+  auto functions = functionDefinitions(lazy);
+  ASSERT_EQ(functions.size(), 3);
+
+  for (auto function : functions) {
+    auto body = functionBody(function);
+    ASSERT_NE(body, nullptr);
+    ASSERT_TRUE(body->lbraceLoc);
+    ASSERT_TRUE(body->rbraceLoc);
+    ASSERT_EQ(body->statementList, nullptr);
+  }
+
+  for (auto function : functions) {
+    ASSERT_TRUE(lazy.parseFunctionBody(function));
+    ASSERT_NE(functionBody(function)->statementList, nullptr);
+    ASSERT_FALSE(lazy.parseFunctionBody(function));
+  }
+
+  // the member function of the local class is loaded with the body of h.
+  ASSERT_EQ(functionDefinitions(lazy).size(), 4);
+  ASSERT_EQ(lazy.flatten(), unit.flatten());
+}
+
+TEST(TranslationUnit, ast_image_view) {
+  Control control;
+  DiagnosticsClient diagnosticsClient;
+  TranslationUnit unit(&control, &diagnosticsClient);
+  unit.setSource("int x;\nnamespace ns { int f() { return 0; } }\n",
+                 "main.cc");
+  unit.parse();
+
+  const auto image = unit.serializeImage();
+
+  ASTImageView view(image);
+  ASSERT_TRUE(view.isValid());
+  ASSERT_NE(view.root(), 0);
+  ASSERT_EQ(view.kind(view.root()), ASTKind::TranslationUnit);
+
+  // the top level declarations, without loading them.
+  std::vector<ASTKind> declarations;
+  view.forEachChild(view.root(), [&](std::uint32_t node) {
+    declarations.push_back(view.kind(node));
+  });
+
+  ASSERT_EQ(declarations, (std::vector<ASTKind>{ASTKind::SimpleDeclaration,
+                                                ASTKind::NamespaceDefinition}));
+
+  // every node is reachable from the root, the names included.
+  std::uint32_t nodes = 0;
+  std::vector<std::string_view> names;
+
+  auto walk = [&](auto& walk, std::uint32_t node) -> void {
+    ++nodes;
+    if (auto name = view.identifier(node); !name.empty()) {
+      names.push_back(name);
+    }
+    view.forEachChild(node, [&](std::uint32_t child) { walk(walk, child); });
+  };
+
+  walk(walk, view.root());
+
+  ASSERT_EQ(nodes, view.nodeCount());
+  ASSERT_EQ(names, (std::vector<std::string_view>{"x", "ns", "f"}));
+
+  auto corrupted = image;
+  corrupted[0] = 'X';
+  ASSERT_FALSE(ASTImageView(corrupted).isValid());
+}
@@ -0,0 +1,377 @@
+// Copyright (c) 2023 Roberto Raggi <roberto.raggi@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Throughput benchmarks of the lexer, the preprocessor, the parser, the AST
+// serialization and the interning of names and types. The inputs are the
+// files of the synthetic corpus, a translation unit including the headers of
+// the wasi sysroot, when it is available, and the files given on the command
+// line. The results are printed as text or, with -json, in the JSON format of
+// Google Benchmark, so they can be compared across commits.
+//
+// usage: cxx-bench [-json] [-filter <text>] [-iterations <n>]
+//                  [-corpus <dir>] [-sysroot <dir>] [-I <dir>]... [<file>...]
+
+#include "benchmark.h"
+
+#include <cxx/control.h>
+#include <cxx/diagnostics_client.h>
+#include <cxx/gcc_linux_toolchain.h>
+#include <cxx/names.h>
+#include <cxx/preprocessor.h>
+#include <cxx/token.h>
+#include <cxx/toolchain.h>
+#include <cxx/translation_unit.h>
+#include <cxx/wasm32_wasi_toolchain.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <sstream>
+
+namespace cxx {
+
+namespace {
+
+constexpr int kDefaultIterations = 10;
+
+// the headers of the wasi sysroot translation unit.
+constexpr std::string_view kSysrootHeaders[] = {
+    "algorithm", "array", "bitset", "cassert", "cctype", "chrono", "cmath",
+    "cstddef", "cstdint", "cstdio", "cstdlib", "cstring", "deque", "functional",
+    "iterator", "limits", "list", "map", "memory", "numeric", "optional",
+    "queue", "set", "span", "sstream", "string", "string_view", "tuple",
+    "type_traits", "unordered_map", "unordered_set", "utility", "variant",
+    "vector"};
+
+auto readAll(const std::string& fileName) -> std::string {
+  std::ifstream in(fileName);
+  std::ostringstream out;
+  out << in.rdbuf();
+  return out.str();
+}
+
+auto escapeJSON(std::string_view text) -> std::string {
+  std::string result;
+  for (auto ch : text) {
+    if (ch == '"' || ch == '\\') {
+      result += '\\';
+      result += ch;
+    } else if (static_cast<unsigned char>(ch) < 0x20) {
+      std::ostringstream out;
+      out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+          << static_cast<int>(ch);
+      result += out.str();
+    } else {
+      result += ch;
+    }
+  }
+  return result;
+}
+
+// preprocesses and parses the input once, to collect the included headers,
+// the tokens and the identifiers used by the benchmarks.
+void prepare(BenchmarkInput& input) {
+  Control control;
+  std::ostringstream diagnostics;
+  DiagnosticsClient diagnosticsClient;
+  diagnosticsClient.setOutput(diagnostics);
+
+  TranslationUnit unit(&control, &diagnosticsClient);
+
+  std::vector<std::string> headers;
+
+  auto preprocessor = unit.preprocessor();
+  input.configure(control, *preprocessor);
+  preprocessor->setOnWillIncludeHeader(
+      [&](const std::string& header, int) { headers.push_back(header); });
+
+  unit.setSource(input.source, input.fileName);
+  unit.parse();
+
+  std::sort(headers.begin(), headers.end());
+  headers.erase(std::unique(headers.begin(), headers.end()), headers.end());
+
+  input.texts.push_back(input.source);
+  for (const auto& header : headers) input.texts.push_back(readAll(header));
+
+  for (const auto& text : input.texts) input.bytes += text.size();
+
+  input.tokens = unit.tokenCount();
+
+  for (SourceLocation loc(1); loc.index() < unit.tokenCount();
+       loc = loc.next()) {
+    if (unit.tokenKind(loc) != TokenKind::T_IDENTIFIER) continue;
+    input.identifiers.push_back(unit.identifier(loc)->name());
+  }
+
+  input.errors = !diagnostics.str().empty();
+}
+
+auto sysrootInput(const std::string& sysroot) -> std::optional<BenchmarkInput> {
+  namespace fs = std::filesystem;
+
+  if (!fs::exists(fs::path(sysroot) / "include/c++/v1/vector")) {
+    return std::nullopt;
+  }
+
+  auto toolchain = std::make_shared<Wasm32WasiToolchain>(nullptr);
+  toolchain->setSysroot(sysroot);
+  toolchain->setAppdir(CXX_BENCH_APPDIR);
+
+  BenchmarkInput input;
+  input.name = "wasi-sysroot";
+  input.fileName = "wasi-sysroot.cc";
+  input.toolchain = std::move(toolchain);
+
+  for (auto header : kSysrootHeaders) {
+    input.source += "#if __has_include(<" + std::string(header) + ">)\n";
+    input.source += "#include <" + std::string(header) + ">\n";
+    input.source += "#endif\n";
+  }
+
+  return input;
+}
+
+}  // namespace
+
+void BenchmarkInput::configure(Control& control,
+                               Preprocessor& preprocessor) const {
+  if (toolchain) {
+    toolchain->setPreprocessor(&preprocessor);
+    control.setMemoryLayout(toolchain->memoryLayout());
+    toolchain->addSystemIncludePaths();
+    toolchain->addSystemCppIncludePaths();
+    toolchain->addPredefinedMacros();
+    toolchain->setPreprocessor(nullptr);
+  }
+
+  for (const auto& path : includePaths) {
+    preprocessor.addSystemIncludePath(path);
+  }
+}
+
+auto Benchmark::enabled(std::string_view name) const -> bool {
+  return name.find(filter_) != std::string_view::npos;
+}
+
+void Benchmark::measure(std::string name, BenchmarkCounters counters,
+                        const std::function<double()>& iteration) {
+  if (!enabled(name)) return;
+
+  auto best = std::numeric_limits<double>::max();
+
+  for (int i = 0; i < iterations_; ++i) best = std::min(best, iteration());
+
+  results_.push_back(BenchmarkResult{.name = std::move(name),
+                                     .counters = counters,
+                                     .iterations = iterations_,
+                                     .seconds = best});
+}
+
+void Benchmark::skip(std::string name, std::string reason) {
+  if (!enabled(name)) return;
+
+  results_.push_back(
+      BenchmarkResult{.name = std::move(name), .error = std::move(reason)});
+}
+
+void Benchmark::printText(std::ostream& out) const {
+  for (const auto& result : results_) {
+    out << std::left << std::setw(44) << result.name << std::right;
+
+    if (!result.error.empty()) {
+      out << " skipped: " << result.error << "\n";
+      continue;
+    }
+
+    const auto& counters = result.counters;
+
+    out << std::fixed << std::setprecision(3) << std::setw(10)
+        << result.seconds * 1e3 << " ms";
+
+    if (counters.bytes) {
+      out << std::setw(10) << counters.bytes / result.seconds / 1e6
+          << " MB/s";
+    }
+
+    if (counters.items) {
+      out << std::setw(10) << result.seconds * 1e9 / counters.items
+          << " ns/item";
+    }
+
+    out << "\n";
+  }
+}
+
+void Benchmark::printJSON(std::ostream& out,
+                          std::string_view executable) const {
+  char date[32];
+  const auto now = std::time(nullptr);
+  std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+  out << "{\n";
+  out << "  \"context\": {\n";
+  out << "    \"date\": \"" << date << "\",\n";
+  out << "    \"executable\": \"" << escapeJSON(executable) << "\",\n";
+  out << "    \"iterations\": " << iterations_ << "\n";
+  out << "  },\n";
+  out << "  \"benchmarks\": [";
+
+  std::string_view separator = "\n";
+
+  for (const auto& result : results_) {
+    out << separator << "    {\n";
+    separator = ",\n";
+
+    out << "      \"name\": \"" << escapeJSON(result.name) << "\",\n";
+    out << "      \"run_name\": \"" << escapeJSON(result.name) << "\",\n";
+    out << "      \"run_type\": \"iteration\",\n";
+
+    if (!result.error.empty()) {
+      out << "      \"error_occurred\": true,\n";
+      out << "      \"error_message\": \"" << escapeJSON(result.error)
+          << "\"\n";
+      out << "    }";
+      continue;
+    }
+
+    const auto& counters = result.counters;
+    const auto nanoseconds = result.seconds * 1e9;
+
+    out << std::setprecision(17);
+    out << "      \"iterations\": " << result.iterations << ",\n";
+    out << "      \"real_time\": " << nanoseconds << ",\n";
+    out << "      \"cpu_time\": " << nanoseconds << ",\n";
+    out << "      \"time_unit\": \"ns\",\n";
+    out << "      \"bytes_per_second\": " << counters.bytes / result.seconds
+        << ",\n";
+    out << "      \"items_per_second\": " << counters.items / result.seconds
+        << "\n";
+    out << "    }";
+  }
+
+  out << "\n  ]\n";
+  out << "}\n";
+}
+
+}  // namespace cxx
+
+auto main(int argc, char* argv[]) -> int {
+  using namespace cxx;
+
+  std::string corpus = CXX_BENCH_CORPUS_DIR;
+  std::string sysroot = CXX_BENCH_SYSROOT_DIR;
+  std::string filter;
+  std::vector<std::string> includePaths;
+  std::vector<std::string> fileNames;
+  int iterations = kDefaultIterations;
+  bool json = false;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string_view arg(argv[i]);
+    if (arg == "-json") {
+      json = true;
+    } else if (arg == "-filter" && i + 1 < argc) {
+      filter = argv[++i];
+    } else if (arg == "-iterations" && i + 1 < argc) {
+      iterations = std::max(1, std::atoi(argv[++i]));
+    } else if (arg == "-corpus" && i + 1 < argc) {
+      corpus = argv[++i];
+    } else if (arg == "-sysroot" && i + 1 < argc) {
+      sysroot = argv[++i];
+    } else if (arg == "-I" && i + 1 < argc) {
+      includePaths.emplace_back(argv[++i]);
+    } else if (!arg.empty() && arg[0] != '-') {
+      fileNames.emplace_back(arg);
+    } else {
+      std::cerr << "usage: cxx-bench [-json] [-filter <text>] "
+                   "[-iterations <n>]\n"
+                   "                 [-corpus <dir>] [-sysroot <dir>] "
+                   "[-I <dir>]... [<file>...]\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::vector<BenchmarkInput> inputs;
+
+  std::vector<std::filesystem::path> corpusFiles;
+  std::error_code ec;
+  for (const auto& entry : std::filesystem::directory_iterator(corpus, ec)) {
+    if (entry.path().extension() == ".cc") corpusFiles.push_back(entry.path());
+  }
+  std::sort(corpusFiles.begin(), corpusFiles.end());
+
+  for (const auto& path : corpusFiles) {
+    BenchmarkInput input;
+    input.name = path.filename().string();
+    input.fileName = path.string();
+    input.source = readAll(input.fileName);
+    inputs.push_back(std::move(input));
+  }
+
+  if (auto input = sysrootInput(sysroot)) {
+    inputs.push_back(std::move(*input));
+  } else if (!json) {
+    std::cerr << "cxx-bench: no wasi sysroot in '" << sysroot << "'\n";
+  }
+
+  // the files given on the command line use the headers of the host.
+  auto hostToolchain = std::make_shared<GCCLinuxToolchain>(nullptr);
+
+  for (const auto& fileName : fileNames) {
+    BenchmarkInput input;
+    input.name = std::filesystem::path(fileName).filename().string();
+    input.fileName = fileName;
+    input.source = readAll(fileName);
+    input.toolchain = hostToolchain;
+    input.includePaths = includePaths;
+    inputs.push_back(std::move(input));
+  }
+
+  Benchmark benchmark(iterations, filter);
+
+  for (auto& input : inputs) {
+    prepare(input);
+
+    if (input.errors && !json) {
+      std::cerr << "cxx-bench: '" << input.name << "' has errors\n";
+    }
+
+    benchmarkLexer(benchmark, input);
+    benchmarkPreprocessor(benchmark, input);
+    benchmarkParser(benchmark, input);
+    benchmarkSerialization(benchmark, input);
+    benchmarkControl(benchmark, input);
+  }
+
+  if (json) {
+    benchmark.printJSON(std::cout, argv[0]);
+  } else {
+    benchmark.printText(std::cout);
+  }
+
+  return EXIT_SUCCESS;
+}
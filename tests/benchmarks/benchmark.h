@@ -0,0 +1,115 @@
+// Copyright (c) 2023 Roberto Raggi <roberto.raggi@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cxx/cxx_fwd.h>
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace cxx {
+
+class Control;
+class Preprocessor;
+class Toolchain;
+
+// A translation unit of the benchmark corpus, and the toolchain used to
+// preprocess it.
+struct BenchmarkInput {
+  std::string name;
+  std::string fileName;
+  std::string source;
+  std::shared_ptr<Toolchain> toolchain;
+  std::vector<std::string> includePaths;
+
+  // the texts of the source file and of the headers it includes.
+  std::vector<std::string> texts;
+  std::size_t bytes = 0;
+  std::size_t tokens = 0;
+  std::vector<std::string> identifiers;
+  bool errors = false;
+
+  void configure(Control& control, Preprocessor& preprocessor) const;
+};
+
+struct BenchmarkCounters {
+  std::size_t bytes = 0;
+  std::size_t items = 0;
+};
+
+struct BenchmarkResult {
+  std::string name;
+  BenchmarkCounters counters;
+  int iterations = 0;
+  double seconds = 0;
+  std::string error;
+};
+
+// Runs each benchmark a fixed number of times and keeps the best time.
+class Benchmark {
+ public:
+  explicit Benchmark(int iterations, std::string filter)
+      : iterations_(iterations), filter_(std::move(filter)) {}
+
+  [[nodiscard]] auto enabled(std::string_view name) const -> bool;
+
+  // iteration() returns the time, in seconds, of the measured work, so the
+  // setup of each iteration is not measured.
+  void measure(std::string name, BenchmarkCounters counters,
+               const std::function<double()>& iteration);
+
+  void skip(std::string name, std::string reason);
+
+  [[nodiscard]] auto results() const -> const std::vector<BenchmarkResult>& {
+    return results_;
+  }
+
+  void printText(std::ostream& out) const;
+  void printJSON(std::ostream& out, std::string_view executable) const;
+
+ private:
+  int iterations_;
+  std::string filter_;
+  std::vector<BenchmarkResult> results_;
+};
+
+template <typename F>
+auto elapsed(F f) -> double {
+  using namespace std::chrono;
+  const auto start = steady_clock::now();
+  f();
+  return duration<double>(steady_clock::now() - start).count();
+}
+
+void benchmarkLexer(Benchmark& benchmark, const BenchmarkInput& input);
+void benchmarkPreprocessor(Benchmark& benchmark, const BenchmarkInput& input);
+void benchmarkParser(Benchmark& benchmark, const BenchmarkInput& input);
+void benchmarkSerialization(Benchmark& benchmark, const BenchmarkInput& input);
+void benchmarkControl(Benchmark& benchmark, const BenchmarkInput& input);
+
+}  // namespace cxx
@@ -0,0 +1,121 @@
+// Copyright (c) 2023 Roberto Raggi <roberto.raggi@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Measures the throughput of Control::getIdentifier() and of the type
+// constructors, using the identifiers of the benchmark input.
+
+#include "benchmark.h"
+
+#include <cxx/control.h>
+#include <cxx/names.h>
+#include <cxx/symbols.h>
+#include <cxx/types.h>
+
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace cxx {
+
+namespace {
+
+void benchmarkIdentifiers(Benchmark& benchmark, const BenchmarkInput& input) {
+  const auto& identifiers = input.identifiers;
+  const BenchmarkCounters counters{.items = identifiers.size()};
+
+  benchmark.measure("control/identifiers/new/" + input.name, counters, [&] {
+    return elapsed([&] {
+      Control control;
+      for (const auto& name : identifiers) (void)control.getIdentifier(name);
+    });
+  });
+
+  Control control;
+  for (const auto& name : identifiers) (void)control.getIdentifier(name);
+
+  benchmark.measure("control/identifiers/interned/" + input.name, counters,
+                    [&] {
+                      return elapsed([&] {
+                        for (const auto& name : identifiers) {
+                          (void)control.getIdentifier(name);
+                        }
+                      });
+                    });
+}
+
+void benchmarkTypes(Benchmark& benchmark, const BenchmarkInput& input) {
+  std::unordered_set<std::string_view> names(input.identifiers.begin(),
+                                             input.identifiers.end());
+
+  // six types and one template id are created for each distinct name.
+  const BenchmarkCounters counters{.items = names.size() * 7};
+
+  auto constructTypes = [&](Control& control,
+                            const std::vector<const Type*>& classTypes) {
+    auto intType = control.getIntType();
+
+    for (auto classType : classTypes) {
+      auto pointerType = control.getPointerType(classType);
+      auto constType = control.getConstType(classType);
+      auto referenceType = control.getLvalueReferenceType(constType);
+
+      (void)control.getFunctionType(intType, {pointerType, referenceType});
+      (void)control.getBoundedArrayType(pointerType, 4);
+      (void)control.getRvalueReferenceType(classType);
+
+      (void)control.getTemplateId(control.getIdentifier("vector"),
+                                  {classType});
+    }
+  };
+
+  auto newClassTypes = [&](Control& control) {
+    std::vector<const Type*> classTypes;
+    for (auto name : names) {
+      auto symbol = control.newClassSymbol(nullptr);
+      symbol->setName(control.getIdentifier(name));
+      classTypes.push_back(symbol->type());
+    }
+    return classTypes;
+  };
+
+  benchmark.measure("control/types/new/" + input.name, counters, [&] {
+    return elapsed([&] {
+      Control control;
+      constructTypes(control, newClassTypes(control));
+    });
+  });
+
+  Control control;
+  const auto classTypes = newClassTypes(control);
+  constructTypes(control, classTypes);
+
+  benchmark.measure("control/types/interned/" + input.name, counters, [&] {
+    return elapsed([&] { constructTypes(control, classTypes); });
+  });
+}
+
+}  // namespace
+
+void benchmarkControl(Benchmark& benchmark, const BenchmarkInput& input) {
+  benchmarkIdentifiers(benchmark, input);
+  benchmarkTypes(benchmark, input);
+}
+
+}  // namespace cxx
@@ -0,0 +1,310 @@
+// Synthetic benchmark input: class templates, partial specializations,
+// variadic templates and constexpr functions, without system headers.
+
+namespace corpus {
+
+using size_t = decltype(sizeof(0));
+using ptrdiff_t = decltype(static_cast<int*>(nullptr) -
+                           static_cast<int*>(nullptr));
+
+template <typename T>
+struct remove_reference {
+  using type = T;
+};
+
+template <typename T>
+struct remove_reference<T&> {
+  using type = T;
+};
+
+template <typename T>
+struct remove_reference<T&&> {
+  using type = T;
+};
+
+template <typename T>
+using remove_reference_t = typename remove_reference<T>::type;
+
+template <typename T>
+constexpr auto move(T&& value) noexcept -> remove_reference_t<T>&& {
+  return static_cast<remove_reference_t<T>&&>(value);
+}
+
+template <typename T>
+constexpr auto forward(remove_reference_t<T>& value) noexcept -> T&& {
+  return static_cast<T&&>(value);
+}
+
+template <typename T, T v>
+struct integral_constant {
+  static constexpr T value = v;
+  using value_type = T;
+  using type = integral_constant;
+  constexpr operator value_type() const noexcept { return value; }
+};
+
+using true_type = integral_constant<bool, true>;
+using false_type = integral_constant<bool, false>;
+
+template <typename T, typename U>
+struct is_same : false_type {};
+
+template <typename T>
+struct is_same<T, T> : true_type {};
+
+template <bool B, typename T = void>
+struct enable_if {};
+
+template <typename T>
+struct enable_if<true, T> {
+  using type = T;
+};
+
+template <bool B, typename T, typename F>
+struct conditional {
+  using type = T;
+};
+
+template <typename T, typename F>
+struct conditional<false, T, F> {
+  using type = F;
+};
+
+template <typename... Ts>
+struct type_list {
+  static constexpr size_t size = sizeof...(Ts);
+};
+
+template <typename List, typename T>
+struct push_front;
+
+template <typename... Ts, typename T>
+struct push_front<type_list<Ts...>, T> {
+  using type = type_list<T, Ts...>;
+};
+
+template <size_t I, typename List>
+struct type_at;
+
+template <typename T, typename... Ts>
+struct type_at<0, type_list<T, Ts...>> {
+  using type = T;
+};
+
+template <size_t I, typename T, typename... Ts>
+struct type_at<I, type_list<T, Ts...>> {
+  using type = typename type_at<I - 1, type_list<Ts...>>::type;
+};
+
+template <typename T>
+class allocator {
+ public:
+  using value_type = T;
+  using pointer = T*;
+  using size_type = size_t;
+
+  constexpr allocator() noexcept = default;
+
+  template <typename U>
+  constexpr allocator(const allocator<U>&) noexcept {}
+
+  auto allocate(size_type n) -> pointer {
+    return static_cast<pointer>(::operator new(n * sizeof(T)));
+  }
+
+  void deallocate(pointer p, size_type) noexcept { ::operator delete(p); }
+};
+
+template <typename T, typename Alloc = allocator<T>>
+class vector {
+ public:
+  using value_type = T;
+  using size_type = size_t;
+  using reference = T&;
+  using const_reference = const T&;
+  using iterator = T*;
+  using const_iterator = const T*;
+
+  vector() = default;
+
+  explicit vector(size_type count, const T& value = T()) {
+    reserve(count);
+    for (size_type i = 0; i < count; ++i) push_back(value);
+  }
+
+  vector(const vector& other) {
+    reserve(other.size());
+    for (const auto& value : other) push_back(value);
+  }
+
+  vector(vector&& other) noexcept
+      : data_(other.data_), size_(other.size_), capacity_(other.capacity_) {
+    other.data_ = nullptr;
+    other.size_ = other.capacity_ = 0;
+  }
+
+  ~vector() {
+    clear();
+    if (data_) alloc_.deallocate(data_, capacity_);
+  }
+
+  auto operator=(vector other) noexcept -> vector& {
+    swap(other);
+    return *this;
+  }
+
+  [[nodiscard]] auto size() const noexcept -> size_type { return size_; }
+  [[nodiscard]] auto empty() const noexcept -> bool { return size_ == 0; }
+  [[nodiscard]] auto capacity() const noexcept -> size_type {
+    return capacity_;
+  }
+
+  auto begin() noexcept -> iterator { return data_; }
+  auto end() noexcept -> iterator { return data_ + size_; }
+  auto begin() const noexcept -> const_iterator { return data_; }
+  auto end() const noexcept -> const_iterator { return data_ + size_; }
+
+  auto operator[](size_type index) -> reference { return data_[index]; }
+  auto operator[](size_type index) const -> const_reference {
+    return data_[index];
+  }
+
+  auto front() -> reference { return data_[0]; }
+  auto back() -> reference { return data_[size_ - 1]; }
+
+  void reserve(size_type count) {
+    if (count <= capacity_) return;
+    auto data = alloc_.allocate(count);
+    for (size_type i = 0; i < size_; ++i) {
+      new (data + i) T(corpus::move(data_[i]));
+      data_[i].~T();
+    }
+    if (data_) alloc_.deallocate(data_, capacity_);
+    data_ = data;
+    capacity_ = count;
+  }
+
+  void push_back(const T& value) { emplace_back(value); }
+  void push_back(T&& value) { emplace_back(corpus::move(value)); }
+
+  template <typename... Args>
+  auto emplace_back(Args&&... args) -> reference {
+    if (size_ == capacity_) reserve(capacity_ ? capacity_ * 2 : 8);
+    new (data_ + size_) T(corpus::forward<Args>(args)...);
+    return data_[size_++];
+  }
+
+  void pop_back() { data_[--size_].~T(); }
+
+  void clear() noexcept {
+    while (size_ > 0) pop_back();
+  }
+
+  void swap(vector& other) noexcept {
+    auto data = data_;
+    data_ = other.data_;
+    other.data_ = data;
+    auto size = size_;
+    size_ = other.size_;
+    other.size_ = size;
+    auto capacity = capacity_;
+    capacity_ = other.capacity_;
+    other.capacity_ = capacity;
+  }
+
+ private:
+  T* data_ = nullptr;
+  size_type size_ = 0;
+  size_type capacity_ = 0;
+  [[no_unique_address]] Alloc alloc_;
+};
+
+template <typename K, typename V>
+struct pair {
+  K first;
+  V second;
+
+  constexpr auto operator==(const pair& other) const -> bool {
+    return first == other.first && second == other.second;
+  }
+};
+
+template <typename K, typename V, typename Hash>
+class hash_map {
+ public:
+  using value_type = pair<K, V>;
+
+  explicit hash_map(size_t bucketCount = 16) : buckets_(bucketCount) {}
+
+  auto find(const K& key) -> value_type* {
+    auto& bucket = buckets_[Hash{}(key) % buckets_.size()];
+    for (auto& entry : bucket) {
+      if (entry.first == key) return &entry;
+    }
+    return nullptr;
+  }
+
+  auto operator[](const K& key) -> V& {
+    if (auto entry = find(key)) return entry->second;
+    if (++size_ > buckets_.size() * 2) rehash(buckets_.size() * 2);
+    auto& bucket = buckets_[Hash{}(key) % buckets_.size()];
+    return bucket.emplace_back(value_type{key, V{}}).second;
+  }
+
+  [[nodiscard]] auto size() const -> size_t { return size_; }
+
+ private:
+  void rehash(size_t bucketCount) {
+    vector<vector<value_type>> buckets(bucketCount);
+    for (auto& bucket : buckets_) {
+      for (auto& entry : bucket) {
+        buckets[Hash{}(entry.first) % bucketCount].push_back(
+            corpus::move(entry));
+      }
+    }
+    buckets_.swap(buckets);
+  }
+
+  vector<vector<value_type>> buckets_;
+  size_t size_ = 0;
+};
+
+struct int_hash {
+  constexpr auto operator()(int value) const -> size_t {
+    auto x = static_cast<size_t>(value);
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdull;
+    x ^= x >> 33;
+    return x;
+  }
+};
+
+template <typename T, size_t N>
+struct array {
+  T elements[N];
+
+  constexpr auto size() const -> size_t { return N; }
+  constexpr auto operator[](size_t i) -> T& { return elements[i]; }
+  constexpr auto operator[](size_t i) const -> const T& { return elements[i]; }
+};
+
+template <typename T, size_t N>
+constexpr auto sum(const array<T, N>& values) -> T {
+  T result{};
+  for (size_t i = 0; i < N; ++i) result += values[i];
+  return result;
+}
+
+constexpr array<int, 5> primes{{2, 3, 5, 7, 11}};
+constexpr auto primeSum = sum(primes);
+
+using second_type = type_at<1, type_list<char, int, long>>::type;
+constexpr bool second_is_int = is_same<second_type, int>::value;
+
+auto histogram(const vector<int>& values) -> hash_map<int, int, int_hash> {
+  hash_map<int, int, int_hash> counts;
+  for (auto value : values) ++counts[value];
+  return counts;
+}
+
+}  // namespace corpus
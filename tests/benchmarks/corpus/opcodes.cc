@@ -0,0 +1,250 @@
+// Synthetic benchmark input for the preprocessor: X-macros, token pasting,
+// stringification, variadic macros and conditional compilation.
+
+#define CORPUS_VERSION 3
+#define CORPUS_CAT(a, b) CORPUS_CAT_I(a, b)
+#define CORPUS_CAT_I(a, b) a##b
+#define CORPUS_STR(x) CORPUS_STR_I(x)
+#define CORPUS_STR_I(x) #x
+#define CORPUS_COUNT(...) CORPUS_COUNT_I(__VA_ARGS__, 5, 4, 3, 2, 1, 0)
+#define CORPUS_COUNT_I(a, b, c, d, e, n, ...) n
+
+#if CORPUS_VERSION >= 3 && defined(CORPUS_CAT)
+#define CORPUS_HAS_WIDE_OPERANDS 1
+#else
+#define CORPUS_HAS_WIDE_OPERANDS 0
+#endif
+
+#define FOR_EACH_OPCODE(V)         \
+  V(Nop, 0, "no operation")        \
+  V(Load, 2, "load register")      \
+  V(Store, 2, "store register")    \
+  V(Move, 2, "move register")      \
+  V(Add, 3, "add")                 \
+  V(Sub, 3, "subtract")            \
+  V(Mul, 3, "multiply")            \
+  V(Div, 3, "divide")              \
+  V(Rem, 3, "remainder")           \
+  V(And, 3, "bitwise and")         \
+  V(Or, 3, "bitwise or")           \
+  V(Xor, 3, "bitwise xor")         \
+  V(Shl, 3, "shift left")          \
+  V(Shr, 3, "shift right")         \
+  V(Neg, 2, "negate")              \
+  V(Not, 2, "bitwise not")         \
+  V(Cmp, 2, "compare")             \
+  V(Jump, 1, "jump")               \
+  V(JumpIf, 2, "jump if true")     \
+  V(JumpIfNot, 2, "jump if false") \
+  V(Call, 1, "call")               \
+  V(Return, 0, "return")           \
+  V(Push, 1, "push")               \
+  V(Pop, 1, "pop")                 \
+  V(Halt, 0, "halt")
+
+#define FOR_EACH_REGISTER(V) \
+  V(R0) V(R1) V(R2) V(R3) V(R4) V(R5) V(R6) V(R7) V(SP) V(FP) V(PC)
+
+namespace vm {
+
+using u8 = unsigned char;
+using u32 = unsigned int;
+using i64 = long long;
+
+enum class Opcode : u8 {
+#define DECLARE_OPCODE(name, operands, description) name,
+  FOR_EACH_OPCODE(DECLARE_OPCODE)
+#undef DECLARE_OPCODE
+};
+
+enum class Register : u8 {
+#define DECLARE_REGISTER(name) name,
+  FOR_EACH_REGISTER(DECLARE_REGISTER)
+#undef DECLARE_REGISTER
+};
+
+constexpr int kOpcodeCount = 0
+#define COUNT_OPCODE(name, operands, description) +1
+    FOR_EACH_OPCODE(COUNT_OPCODE)
+#undef COUNT_OPCODE
+    ;
+
+constexpr int kRegisterCount = 0
+#define COUNT_REGISTER(name) +1
+    FOR_EACH_REGISTER(COUNT_REGISTER)
+#undef COUNT_REGISTER
+    ;
+
+constexpr const char* kOpcodeNames[] = {
+#define OPCODE_NAME(name, operands, description) #name,
+    FOR_EACH_OPCODE(OPCODE_NAME)
+#undef OPCODE_NAME
+};
+
+constexpr const char* kOpcodeDescriptions[] = {
+#define OPCODE_DESCRIPTION(name, operands, description) description,
+    FOR_EACH_OPCODE(OPCODE_DESCRIPTION)
+#undef OPCODE_DESCRIPTION
+};
+
+constexpr int kOperandCounts[] = {
+#define OPERAND_COUNT(name, operands, description) operands,
+    FOR_EACH_OPCODE(OPERAND_COUNT)
+#undef OPERAND_COUNT
+};
+
+constexpr const char* kRegisterNames[] = {
+#define REGISTER_NAME(name) CORPUS_STR(name),
+    FOR_EACH_REGISTER(REGISTER_NAME)
+#undef REGISTER_NAME
+};
+
+struct Instruction {
+  Opcode opcode = Opcode::Nop;
+#if CORPUS_HAS_WIDE_OPERANDS
+  i64 operands[3] = {};
+#else
+  u32 operands[3] = {};
+#endif
+};
+
+struct Machine {
+  i64 registers[kRegisterCount] = {};
+  i64 stack[256] = {};
+  bool flag = false;
+  bool halted = false;
+
+  auto reg(Register r) -> i64& { return registers[static_cast<int>(r)]; }
+
+#define DECLARE_HANDLER(name, operands, description) \
+  void CORPUS_CAT(execute, name)(const Instruction& instruction);
+  FOR_EACH_OPCODE(DECLARE_HANDLER)
+#undef DECLARE_HANDLER
+
+  void step(const Instruction& instruction);
+};
+
+#define OPERAND(i) instruction.operands[i]
+#define R(i) registers[OPERAND(i)]
+
+#define DEFINE_BINARY(name, op)                                             \
+  void Machine::CORPUS_CAT(execute, name)(const Instruction& instruction) { \
+    R(0) = R(1) op R(2);                                                    \
+  }
+
+DEFINE_BINARY(Add, +)
+DEFINE_BINARY(Sub, -)
+DEFINE_BINARY(Mul, *)
+DEFINE_BINARY(And, &)
+DEFINE_BINARY(Or, |)
+DEFINE_BINARY(Xor, ^)
+DEFINE_BINARY(Shl, <<)
+DEFINE_BINARY(Shr, >>)
+
+#undef DEFINE_BINARY
+
+#define DEFINE_CHECKED_BINARY(name, op)                                     \
+  void Machine::CORPUS_CAT(execute, name)(const Instruction& instruction) { \
+    if (R(2) == 0) {                                                        \
+      halted = true;                                                        \
+      return;                                                               \
+    }                                                                       \
+    R(0) = R(1) op R(2);                                                    \
+  }
+
+DEFINE_CHECKED_BINARY(Div, /)
+DEFINE_CHECKED_BINARY(Rem, %)
+
+#undef DEFINE_CHECKED_BINARY
+
+#define DEFINE_UNARY(name, op)                                              \
+  void Machine::CORPUS_CAT(execute, name)(const Instruction& instruction) { \
+    R(0) = op R(1);                                                         \
+  }
+
+DEFINE_UNARY(Neg, -)
+DEFINE_UNARY(Not, ~)
+DEFINE_UNARY(Move, +)
+
+#undef DEFINE_UNARY
+
+void Machine::executeNop(const Instruction&) {}
+
+void Machine::executeLoad(const Instruction& instruction) {
+  R(0) = stack[OPERAND(1) % 256];
+}
+
+void Machine::executeStore(const Instruction& instruction) {
+  stack[OPERAND(1) % 256] = R(0);
+}
+
+void Machine::executeCmp(const Instruction& instruction) {
+  flag = R(0) == R(1);
+}
+
+void Machine::executeJump(const Instruction& instruction) {
+  reg(Register::PC) = OPERAND(0);
+}
+
+void Machine::executeJumpIf(const Instruction& instruction) {
+  if (flag) reg(Register::PC) = OPERAND(1);
+}
+
+void Machine::executeJumpIfNot(const Instruction& instruction) {
+  if (!flag) reg(Register::PC) = OPERAND(1);
+}
+
+void Machine::executeCall(const Instruction& instruction) {
+  stack[reg(Register::SP)++ % 256] = reg(Register::PC);
+  reg(Register::PC) = OPERAND(0);
+}
+
+void Machine::executeReturn(const Instruction&) {
+  reg(Register::PC) = stack[--reg(Register::SP) % 256];
+}
+
+void Machine::executePush(const Instruction& instruction) {
+  stack[reg(Register::SP)++ % 256] = R(0);
+}
+
+void Machine::executePop(const Instruction& instruction) {
+  R(0) = stack[--reg(Register::SP) % 256];
+}
+
+void Machine::executeHalt(const Instruction&) { halted = true; }
+
+#undef R
+#undef OPERAND
+
+void Machine::step(const Instruction& instruction) {
+  switch (instruction.opcode) {
+#define DISPATCH(name, operands, description) \
+  case Opcode::name:                          \
+    CORPUS_CAT(execute, name)(instruction);   \
+    break;
+    FOR_EACH_OPCODE(DISPATCH)
+#undef DISPATCH
+  }  // switch
+}
+
+auto operandCount(Opcode opcode) -> int {
+  return kOperandCounts[static_cast<int>(opcode)];
+}
+
+auto variadicArity() -> int {
+  return CORPUS_COUNT(a) + CORPUS_COUNT(a, b) + CORPUS_COUNT(a, b, c) +
+         CORPUS_COUNT(a, b, c, d) + CORPUS_COUNT(a, b, c, d, e);
+}
+
+auto run(Machine& machine, const Instruction* program, int size) -> int {
+  int steps = 0;
+  while (!machine.halted && steps < 100000) {
+    const auto pc = machine.reg(Register::PC)++;
+    if (pc < 0 || pc >= size) break;
+    machine.step(program[pc]);
+    ++steps;
+  }
+  return steps;
+}
+
+}  // namespace vm
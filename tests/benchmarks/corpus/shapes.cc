@@ -0,0 +1,324 @@
+// Synthetic benchmark input: class hierarchies, virtual functions, operator
+// overloading, enums, lambdas and statements, without system headers.
+
+namespace geometry {
+
+enum class Kind { kCircle, kRectangle, kTriangle, kPolygon, kGroup };
+
+struct Point {
+  double x = 0;
+  double y = 0;
+
+  constexpr auto operator+(const Point& other) const -> Point {
+    return {x + other.x, y + other.y};
+  }
+
+  constexpr auto operator-(const Point& other) const -> Point {
+    return {x - other.x, y - other.y};
+  }
+
+  constexpr auto operator*(double scale) const -> Point {
+    return {x * scale, y * scale};
+  }
+
+  constexpr auto operator==(const Point& other) const -> bool {
+    return x == other.x && y == other.y;
+  }
+};
+
+constexpr auto dot(const Point& a, const Point& b) -> double {
+  return a.x * b.x + a.y * b.y;
+}
+
+constexpr auto cross(const Point& a, const Point& b) -> double {
+  return a.x * b.y - a.y * b.x;
+}
+
+constexpr auto abs(double value) -> double {
+  return value < 0 ? -value : value;
+}
+
+auto sqrt(double value) -> double {
+  if (value <= 0) return 0;
+  double x = value;
+  for (int i = 0; i < 32; ++i) x = 0.5 * (x + value / x);
+  return x;
+}
+
+struct Box {
+  Point min;
+  Point max;
+
+  [[nodiscard]] auto width() const -> double { return max.x - min.x; }
+  [[nodiscard]] auto height() const -> double { return max.y - min.y; }
+
+  [[nodiscard]] auto contains(const Point& p) const -> bool {
+    return p.x >= min.x && p.x <= max.x && p.y >= min.y && p.y <= max.y;
+  }
+
+  auto merge(const Box& other) -> Box& {
+    if (other.min.x < min.x) min.x = other.min.x;
+    if (other.min.y < min.y) min.y = other.min.y;
+    if (other.max.x > max.x) max.x = other.max.x;
+    if (other.max.y > max.y) max.y = other.max.y;
+    return *this;
+  }
+};
+
+class Visitor;
+
+class Shape {
+ public:
+  explicit Shape(Kind kind) : kind_(kind) {}
+  virtual ~Shape() = default;
+
+  [[nodiscard]] auto kind() const -> Kind { return kind_; }
+
+  [[nodiscard]] virtual auto area() const -> double = 0;
+  [[nodiscard]] virtual auto perimeter() const -> double = 0;
+  [[nodiscard]] virtual auto bounds() const -> Box = 0;
+  virtual void translate(const Point& offset) = 0;
+  virtual void accept(Visitor& visitor) = 0;
+
+ private:
+  Kind kind_;
+};
+
+class Circle;
+class Rectangle;
+class Triangle;
+class Group;
+
+class Visitor {
+ public:
+  virtual ~Visitor() = default;
+  virtual void visit(Circle& circle) = 0;
+  virtual void visit(Rectangle& rectangle) = 0;
+  virtual void visit(Triangle& triangle) = 0;
+  virtual void visit(Group& group) = 0;
+};
+
+class Circle final : public Shape {
+ public:
+  Circle(Point center, double radius)
+      : Shape(Kind::kCircle), center_(center), radius_(radius) {}
+
+  [[nodiscard]] auto area() const -> double override {
+    return 3.14159265358979 * radius_ * radius_;
+  }
+
+  [[nodiscard]] auto perimeter() const -> double override {
+    return 2 * 3.14159265358979 * radius_;
+  }
+
+  [[nodiscard]] auto bounds() const -> Box override {
+    const Point extent{radius_, radius_};
+    return {center_ - extent, center_ + extent};
+  }
+
+  void translate(const Point& offset) override { center_ = center_ + offset; }
+  void accept(Visitor& visitor) override { visitor.visit(*this); }
+
+ private:
+  Point center_;
+  double radius_;
+};
+
+class Rectangle final : public Shape {
+ public:
+  explicit Rectangle(Box box) : Shape(Kind::kRectangle), box_(box) {}
+
+  [[nodiscard]] auto area() const -> double override {
+    return box_.width() * box_.height();
+  }
+
+  [[nodiscard]] auto perimeter() const -> double override {
+    return 2 * (box_.width() + box_.height());
+  }
+
+  [[nodiscard]] auto bounds() const -> Box override { return box_; }
+
+  void translate(const Point& offset) override {
+    box_.min = box_.min + offset;
+    box_.max = box_.max + offset;
+  }
+
+  void accept(Visitor& visitor) override { visitor.visit(*this); }
+
+ private:
+  Box box_;
+};
+
+class Triangle final : public Shape {
+ public:
+  Triangle(Point a, Point b, Point c)
+      : Shape(Kind::kTriangle), points_{a, b, c} {}
+
+  [[nodiscard]] auto area() const -> double override {
+    return abs(cross(points_[1] - points_[0], points_[2] - points_[0])) / 2;
+  }
+
+  [[nodiscard]] auto perimeter() const -> double override {
+    double result = 0;
+    for (int i = 0; i < 3; ++i) {
+      const auto d = points_[(i + 1) % 3] - points_[i];
+      result += sqrt(dot(d, d));
+    }
+    return result;
+  }
+
+  [[nodiscard]] auto bounds() const -> Box override {
+    Box box{points_[0], points_[0]};
+    for (const auto& p : points_) box.merge(Box{p, p});
+    return box;
+  }
+
+  void translate(const Point& offset) override {
+    for (auto& p : points_) p = p + offset;
+  }
+
+  void accept(Visitor& visitor) override { visitor.visit(*this); }
+
+ private:
+  Point points_[3];
+};
+
+class Group final : public Shape {
+ public:
+  static constexpr int kCapacity = 64;
+
+  Group() : Shape(Kind::kGroup) {}
+
+  ~Group() override {
+    for (int i = 0; i < count_; ++i) delete shapes_[i];
+  }
+
+  auto add(Shape* shape) -> bool {
+    if (count_ == kCapacity) return false;
+    shapes_[count_++] = shape;
+    return true;
+  }
+
+  template <typename F>
+  void forEach(F f) const {
+    for (int i = 0; i < count_; ++i) f(*shapes_[i]);
+  }
+
+  [[nodiscard]] auto area() const -> double override {
+    double result = 0;
+    forEach([&](const Shape& shape) { result += shape.area(); });
+    return result;
+  }
+
+  [[nodiscard]] auto perimeter() const -> double override {
+    double result = 0;
+    forEach([&result](const Shape& shape) { result += shape.perimeter(); });
+    return result;
+  }
+
+  [[nodiscard]] auto bounds() const -> Box override {
+    if (count_ == 0) return {};
+    auto box = shapes_[0]->bounds();
+    forEach([&](const Shape& shape) { box.merge(shape.bounds()); });
+    return box;
+  }
+
+  void translate(const Point& offset) override {
+    for (int i = 0; i < count_; ++i) shapes_[i]->translate(offset);
+  }
+
+  void accept(Visitor& visitor) override { visitor.visit(*this); }
+
+ private:
+  Shape* shapes_[kCapacity] = {};
+  int count_ = 0;
+};
+
+class Statistics final : public Visitor {
+ public:
+  void visit(Circle& circle) override {
+    ++circles;
+    totalArea += circle.area();
+  }
+
+  void visit(Rectangle& rectangle) override {
+    ++rectangles;
+    totalArea += rectangle.area();
+  }
+
+  void visit(Triangle& triangle) override {
+    ++triangles;
+    totalArea += triangle.area();
+  }
+
+  void visit(Group& group) override {
+    ++groups;
+    group.forEach([this](const Shape& shape) {
+      const_cast<Shape&>(shape).accept(*this);
+    });
+  }
+
+  int circles = 0;
+  int rectangles = 0;
+  int triangles = 0;
+  int groups = 0;
+  double totalArea = 0;
+};
+
+auto kindName(Kind kind) -> const char* {
+  switch (kind) {
+    case Kind::kCircle:
+      return "circle";
+    case Kind::kRectangle:
+      return "rectangle";
+    case Kind::kTriangle:
+      return "triangle";
+    case Kind::kPolygon:
+      return "polygon";
+    case Kind::kGroup:
+      return "group";
+  }  // switch
+  return "unknown";
+}
+
+auto makeScene(int rows, int columns) -> Group* {
+  auto scene = new Group();
+  for (int row = 0; row < rows; ++row) {
+    auto line = new Group();
+    for (int column = 0; column < columns; ++column) {
+      const Point origin{column * 10.0, row * 10.0};
+      Shape* shape = nullptr;
+      switch ((row + column) % 3) {
+        case 0:
+          shape = new Circle(origin, 1 + column % 4);
+          break;
+        case 1:
+          shape = new Rectangle(Box{origin, origin + Point{4, 2}});
+          break;
+        default:
+          shape = new Triangle(origin, origin + Point{3, 0},
+                               origin + Point{0, 3});
+          break;
+      }  // switch
+      if (!line->add(shape)) {
+        delete shape;
+        break;
+      }
+    }
+    if (!scene->add(line)) {
+      delete line;
+      break;
+    }
+  }
+  return scene;
+}
+
+auto summarize(Group& scene) -> double {
+  Statistics statistics;
+  scene.accept(statistics);
+  const auto box = scene.bounds();
+  const auto density = statistics.totalArea / (box.width() * box.height());
+  return statistics.circles > statistics.triangles ? density : -density;
+}
+
+}  // namespace geometry
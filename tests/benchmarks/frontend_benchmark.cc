@@ -0,0 +1,191 @@
+// Copyright (c) 2023 Roberto Raggi <roberto.raggi@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Measures the lexer, the preprocessor, the parser and the round trip of the
+// AST through the serialized formats.
+
+#include "benchmark.h"
+
+#include <cxx/control.h>
+#include <cxx/diagnostics_client.h>
+#include <cxx/lexer.h>
+#include <cxx/preprocessor.h>
+#include <cxx/token.h>
+#include <cxx/translation_unit.h>
+
+#include <cstdint>
+#include <sstream>
+#include <vector>
+
+namespace cxx {
+
+namespace {
+
+// a translation unit with its own control and quiet diagnostics.
+struct Unit {
+  Control control;
+  std::ostringstream diagnostics;
+  DiagnosticsClient diagnosticsClient;
+  TranslationUnit unit{&control, &diagnosticsClient};
+
+  explicit Unit(const BenchmarkInput& input) {
+    diagnosticsClient.setOutput(diagnostics);
+    input.configure(control, *unit.preprocessor());
+  }
+};
+
+// the AST image, written and loaded back, and loaded alone, eagerly and
+// without the function bodies. The size of the image is reported as the
+// processed bytes, to compare it with the size of the flatbuffers of
+// ast-roundtrip.
+void benchmarkImage(Benchmark& benchmark, const BenchmarkInput& input) {
+  const auto roundtrip = "ast-image-roundtrip/" + input.name;
+  const auto load = "ast-image-load/" + input.name;
+  const auto lazyLoad = "ast-image-lazy-load/" + input.name;
+
+  if (!benchmark.enabled(roundtrip) && !benchmark.enabled(load) &&
+      !benchmark.enabled(lazyLoad))
+    return;
+
+  Unit parsed(input);
+  parsed.unit.setSource(input.source, input.fileName);
+  parsed.unit.parse();
+
+  auto image = parsed.unit.serializeImage();
+
+  benchmark.measure(roundtrip, {image.size(), input.tokens}, [&] {
+    Control control;
+    DiagnosticsClient diagnosticsClient;
+    TranslationUnit loaded(&control, &diagnosticsClient);
+
+    return elapsed([&] {
+      image = parsed.unit.serializeImage();
+      (void)loaded.loadImage(image);
+    });
+  });
+
+  benchmark.measure(load, {image.size(), input.tokens}, [&] {
+    Control control;
+    DiagnosticsClient diagnosticsClient;
+    TranslationUnit loaded(&control, &diagnosticsClient);
+
+    return elapsed([&] { (void)loaded.loadImage(image); });
+  });
+
+  benchmark.measure(lazyLoad, {image.size(), input.tokens}, [&] {
+    Control control;
+    DiagnosticsClient diagnosticsClient;
+    TranslationUnit loaded(&control, &diagnosticsClient);
+
+    return elapsed([&] { (void)loaded.loadImage(image, /*lazy=*/true); });
+  });
+}
+
+}  // namespace
+
+void benchmarkLexer(Benchmark& benchmark, const BenchmarkInput& input) {
+  std::size_t tokens = 0;
+
+  for (const auto& text : input.texts) {
+    Lexer lexer(std::string_view{text});
+    lexer.setPreprocessing(true);
+    while (lexer() != TokenKind::T_EOF_SYMBOL) ++tokens;
+  }
+
+  benchmark.measure("lexer/" + input.name, {input.bytes, tokens}, [&] {
+    return elapsed([&] {
+      for (const auto& text : input.texts) {
+        Lexer lexer(std::string_view{text});
+        lexer.setPreprocessing(true);
+        while (lexer() != TokenKind::T_EOF_SYMBOL) {
+        }
+      }
+    });
+  });
+}
+
+void benchmarkPreprocessor(Benchmark& benchmark, const BenchmarkInput& input) {
+  auto iteration = [&] {
+    Control control;
+    std::ostringstream diagnostics;
+    DiagnosticsClient diagnosticsClient;
+    diagnosticsClient.setOutput(diagnostics);
+
+    Preprocessor preprocessor(&control, &diagnosticsClient);
+    diagnosticsClient.setPreprocessor(&preprocessor);
+    input.configure(control, preprocessor);
+
+    std::vector<Token> tokens;
+
+    return elapsed([&] {
+      preprocessor.preprocess(input.source, input.fileName, tokens);
+    });
+  };
+
+  benchmark.measure("preprocess/" + input.name, {input.bytes, input.tokens},
+                    iteration);
+}
+
+void benchmarkParser(Benchmark& benchmark, const BenchmarkInput& input) {
+  benchmark.measure("parse/" + input.name, {input.bytes, input.tokens}, [&] {
+    Unit u(input);
+    u.unit.setSource(input.source, input.fileName);
+    return elapsed([&] { u.unit.parse(); });
+  });
+}
+
+void benchmarkSerialization(Benchmark& benchmark,
+                            const BenchmarkInput& input) {
+  benchmarkImage(benchmark, input);
+
+  const auto name = "ast-roundtrip/" + input.name;
+
+  if (!benchmark.enabled(name)) return;
+
+  Unit parsed(input);
+  parsed.unit.setSource(input.source, input.fileName);
+  parsed.unit.parse();
+
+  std::vector<std::uint8_t> data;
+
+  if (!parsed.unit.serialize([&](auto bytes) {
+        data.assign(bytes.begin(), bytes.end());
+      })) {
+    benchmark.skip(name, "built without flatbuffers");
+    return;
+  }
+
+  // the size of the serialized AST is reported as the processed bytes.
+  benchmark.measure(name, {data.size(), input.tokens}, [&] {
+    Control control;
+    DiagnosticsClient diagnosticsClient;
+    TranslationUnit loaded(&control, &diagnosticsClient);
+
+    return elapsed([&] {
+      (void)parsed.unit.serialize([&](auto bytes) {
+        data.assign(bytes.begin(), bytes.end());
+      });
+
+      (void)loaded.load(data);
+    });
+  });
+}
+
+}  // namespace cxx
@@ -0,0 +1,196 @@
+// Copyright (c) 2023 Roberto Raggi <roberto.raggi@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Regression benchmark for the backtracking productions of the parser. Each
+// input nests an ambiguous construct n times; the parse time and the number
+// of memo table misses should grow linearly with n. Deeper inputs can
+// exhaust the stack of the recursive descent parser.
+//
+// usage: cxx-parser-bench [-packrat] [-capacity <n>] [<n>]
+
+#include <cxx/control.h>
+#include <cxx/diagnostics_client.h>
+#include <cxx/parser.h>
+#include <cxx/translation_unit.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace cxx;
+
+namespace {
+
+constexpr int kIterations = 3;
+
+struct Generator {
+  std::string_view name;
+  std::function<std::string(int)> generate;
+};
+
+auto repeat(std::string_view s, int n) -> std::string {
+  std::string result;
+  for (int i = 0; i < n; ++i) result += s;
+  return result;
+}
+
+// each generator returns a translation unit nesting a construct n times.
+const std::vector<Generator> generators{
+    {"parens",
+     [](int n) {
+       return "int x; int f() { return " + repeat("(", n) + "x" +
+              repeat(")", n) + "; }\n";
+     }},
+    {"casts",
+     [](int n) {
+       return "int x; int f() { return " + repeat("(int)", n) + "x; }\n";
+     }},
+    {"template-ids",
+     [](int n) {
+       return "template <typename T> struct A {};\n" + repeat("A<", n) +
+              "int" + repeat(">", n) + " a;\n";
+     }},
+    {"unknown-template-calls",
+     [](int n) {
+       return "int f() { return " + repeat("g<a>(", n) + "0" +
+              repeat(")", n) + "; }\n";
+     }},
+    {"less-than",
+     [](int n) {
+       return "int a, b; bool f() { return " + repeat("a < (b < ", n) +
+              "a" + repeat(")", n) + "; }\n";
+     }},
+    {"lambdas",
+     [](int n) {
+       return "int f() { return " + repeat("[] { return ", n) + "0" +
+              repeat("; }()", n) + "; }\n";
+     }},
+    {"parenthesized-declarators",
+     [](int n) {
+       return "int " + repeat("(*", n) + "p" + repeat(")", n) + ";\n";
+     }},
+    {"function-pointers",
+     [](int n) {
+       return "typedef void " + repeat("(*", n) + "fp" +
+              repeat(")(int)", n) + ";\n";
+     }},
+    {"sizeof",
+     [](int n) {
+       return "int x; int f() { return " + repeat("sizeof(", n) + "x" +
+              repeat(")", n) + "; }\n";
+     }},
+};
+
+struct Measurement {
+  double seconds = 0;
+  std::size_t tokens = 0;
+  ASTCacheStats stats;
+  bool errors = false;
+};
+
+auto measure(const std::string& source, const ParserConfiguration& config)
+    -> Measurement {
+  using namespace std::chrono;
+
+  Measurement result;
+  auto best = duration<double>::max();
+
+  for (int i = 0; i < kIterations; ++i) {
+    Control control;
+    DiagnosticsClient diagnosticsClient;
+    std::ostringstream diagnostics;
+    diagnosticsClient.setOutput(diagnostics);
+
+    TranslationUnit unit(&control, &diagnosticsClient);
+    unit.setSource(source, "adversarial.cc");
+
+    const auto start = steady_clock::now();
+
+    Parser parser(&unit);
+    parser.setConfig(config);
+    UnitAST* ast = nullptr;
+    parser(ast);
+
+    best = std::min(best, duration<double>(steady_clock::now() - start));
+
+    result.tokens = unit.tokenCount();
+    result.stats = parser.astCacheStats();
+    result.errors = !diagnostics.str().empty();
+  }
+
+  result.seconds = best.count();
+  return result;
+}
+
+}  // namespace
+
+auto main(int argc, char* argv[]) -> int {
+  ParserConfiguration config;
+  int size = 400;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string_view arg(argv[i]);
+    if (arg == "-packrat") {
+      config.packrat = true;
+    } else if (arg == "-capacity" && i + 1 < argc) {
+      config.astCacheCapacity = std::strtoul(argv[++i], nullptr, 10);
+    } else if (!arg.empty() && arg[0] != '-') {
+      size = std::atoi(argv[i]);
+    } else {
+      std::cerr << "usage: cxx-parser-bench [-packrat] [-capacity <n>] "
+                   "[<n>]\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  auto status = EXIT_SUCCESS;
+
+  // the input size doubles between the two runs, so the ratios of a linear
+  // parser are close to 2. The misses are deterministic, the timings are not.
+  for (const auto& generator : generators) {
+    const auto small = measure(generator.generate(size / 2), config);
+    const auto large = measure(generator.generate(size), config);
+
+    const auto timeRatio = large.seconds / std::max(small.seconds, 1e-9);
+    const auto missRatio = double(large.stats.misses) /
+                           std::max<std::size_t>(small.stats.misses, 1);
+    const auto superlinear = missRatio > 2.5;
+
+    std::cout << std::left << std::setw(28) << generator.name << std::right
+              << std::fixed << std::setprecision(3) << std::setw(10)
+              << large.seconds * 1e3 << " ms, " << std::setw(8)
+              << large.seconds * 1e9 / large.tokens << " ns/token, "
+              << std::setw(8) << large.stats.misses << " misses, time x"
+              << std::setprecision(2) << timeRatio << ", misses x"
+              << missRatio << (large.errors ? " (errors)" : "")
+              << (superlinear ? " (superlinear)" : "") << "\n";
+
+    if (large.errors || superlinear) status = EXIT_FAILURE;
+  }
+
+  return status;
+}
@@ -0,0 +1,628 @@
+// Macro expansion stress test: token pasting, recursion through
+// deferred expansion and deeply nested argument pre-expansion, in the
+// style of Boost.PP. Run with: cxx -Eonly tests/manual/macro_stress.cc
+
+#define PP_CAT(a, b) PP_CAT_I(a, b)
+#define PP_CAT_I(a, b) a##b
+#define PP_EMPTY()
+#define PP_DEFER(id) id PP_EMPTY()
+#define PP_EXPAND(...) __VA_ARGS__
+
+#define PP_EVAL(...) PP_EVAL1(PP_EVAL1(PP_EVAL1(__VA_ARGS__)))
+#define PP_EVAL1(...) PP_EVAL2(PP_EVAL2(PP_EVAL2(__VA_ARGS__)))
+#define PP_EVAL2(...) PP_EVAL3(PP_EVAL3(PP_EVAL3(__VA_ARGS__)))
+#define PP_EVAL3(...) __VA_ARGS__
+
+#define PP_INC(n) PP_CAT(PP_INC_, n)
+#define PP_INC_0 1
+#define PP_INC_1 2
+#define PP_INC_2 3
+#define PP_INC_3 4
+#define PP_INC_4 5
+#define PP_INC_5 6
+#define PP_INC_6 7
+#define PP_INC_7 8
+#define PP_INC_8 9
+#define PP_INC_9 10
+#define PP_INC_10 11
+#define PP_INC_11 12
+#define PP_INC_12 13
+#define PP_INC_13 14
+#define PP_INC_14 15
+#define PP_INC_15 16
+#define PP_INC_16 17
+#define PP_INC_17 18
+#define PP_INC_18 19
+#define PP_INC_19 20
+#define PP_INC_20 21
+#define PP_INC_21 22
+#define PP_INC_22 23
+#define PP_INC_23 24
+#define PP_INC_24 25
+#define PP_INC_25 26
+#define PP_INC_26 27
+#define PP_INC_27 28
+#define PP_INC_28 29
+#define PP_INC_29 30
+#define PP_INC_30 31
+#define PP_INC_31 32
+#define PP_INC_32 33
+#define PP_INC_33 34
+#define PP_INC_34 35
+#define PP_INC_35 36
+#define PP_INC_36 37
+#define PP_INC_37 38
+#define PP_INC_38 39
+#define PP_INC_39 40
+#define PP_INC_40 41
+#define PP_INC_41 42
+#define PP_INC_42 43
+#define PP_INC_43 44
+#define PP_INC_44 45
+#define PP_INC_45 46
+#define PP_INC_46 47
+#define PP_INC_47 48
+#define PP_INC_48 49
+#define PP_INC_49 50
+#define PP_INC_50 51
+#define PP_INC_51 52
+#define PP_INC_52 53
+#define PP_INC_53 54
+#define PP_INC_54 55
+#define PP_INC_55 56
+#define PP_INC_56 57
+#define PP_INC_57 58
+#define PP_INC_58 59
+#define PP_INC_59 60
+#define PP_INC_60 61
+#define PP_INC_61 62
+#define PP_INC_62 63
+#define PP_INC_63 64
+
+#define PP_DEC(n) PP_CAT(PP_DEC_, n)
+#define PP_DEC_1 0
+#define PP_DEC_2 1
+#define PP_DEC_3 2
+#define PP_DEC_4 3
+#define PP_DEC_5 4
+#define PP_DEC_6 5
+#define PP_DEC_7 6
+#define PP_DEC_8 7
+#define PP_DEC_9 8
+#define PP_DEC_10 9
+#define PP_DEC_11 10
+#define PP_DEC_12 11
+#define PP_DEC_13 12
+#define PP_DEC_14 13
+#define PP_DEC_15 14
+#define PP_DEC_16 15
+#define PP_DEC_17 16
+#define PP_DEC_18 17
+#define PP_DEC_19 18
+#define PP_DEC_20 19
+#define PP_DEC_21 20
+#define PP_DEC_22 21
+#define PP_DEC_23 22
+#define PP_DEC_24 23
+#define PP_DEC_25 24
+#define PP_DEC_26 25
+#define PP_DEC_27 26
+#define PP_DEC_28 27
+#define PP_DEC_29 28
+#define PP_DEC_30 29
+#define PP_DEC_31 30
+#define PP_DEC_32 31
+#define PP_DEC_33 32
+#define PP_DEC_34 33
+#define PP_DEC_35 34
+#define PP_DEC_36 35
+#define PP_DEC_37 36
+#define PP_DEC_38 37
+#define PP_DEC_39 38
+#define PP_DEC_40 39
+#define PP_DEC_41 40
+#define PP_DEC_42 41
+#define PP_DEC_43 42
+#define PP_DEC_44 43
+#define PP_DEC_45 44
+#define PP_DEC_46 45
+#define PP_DEC_47 46
+#define PP_DEC_48 47
+#define PP_DEC_49 48
+#define PP_DEC_50 49
+#define PP_DEC_51 50
+#define PP_DEC_52 51
+#define PP_DEC_53 52
+#define PP_DEC_54 53
+#define PP_DEC_55 54
+#define PP_DEC_56 55
+#define PP_DEC_57 56
+#define PP_DEC_58 57
+#define PP_DEC_59 58
+#define PP_DEC_60 59
+#define PP_DEC_61 60
+#define PP_DEC_62 61
+#define PP_DEC_63 62
+#define PP_DEC_64 63
+
+#define PP_BOOL(n) PP_CAT(PP_BOOL_, n)
+#define PP_BOOL_0 0
+#define PP_BOOL_1 1
+#define PP_BOOL_2 1
+#define PP_BOOL_3 1
+#define PP_BOOL_4 1
+#define PP_BOOL_5 1
+#define PP_BOOL_6 1
+#define PP_BOOL_7 1
+#define PP_BOOL_8 1
+#define PP_BOOL_9 1
+#define PP_BOOL_10 1
+#define PP_BOOL_11 1
+#define PP_BOOL_12 1
+#define PP_BOOL_13 1
+#define PP_BOOL_14 1
+#define PP_BOOL_15 1
+#define PP_BOOL_16 1
+#define PP_BOOL_17 1
+#define PP_BOOL_18 1
+#define PP_BOOL_19 1
+#define PP_BOOL_20 1
+#define PP_BOOL_21 1
+#define PP_BOOL_22 1
+#define PP_BOOL_23 1
+#define PP_BOOL_24 1
+#define PP_BOOL_25 1
+#define PP_BOOL_26 1
+#define PP_BOOL_27 1
+#define PP_BOOL_28 1
+#define PP_BOOL_29 1
+#define PP_BOOL_30 1
+#define PP_BOOL_31 1
+#define PP_BOOL_32 1
+#define PP_BOOL_33 1
+#define PP_BOOL_34 1
+#define PP_BOOL_35 1
+#define PP_BOOL_36 1
+#define PP_BOOL_37 1
+#define PP_BOOL_38 1
+#define PP_BOOL_39 1
+#define PP_BOOL_40 1
+#define PP_BOOL_41 1
+#define PP_BOOL_42 1
+#define PP_BOOL_43 1
+#define PP_BOOL_44 1
+#define PP_BOOL_45 1
+#define PP_BOOL_46 1
+#define PP_BOOL_47 1
+#define PP_BOOL_48 1
+#define PP_BOOL_49 1
+#define PP_BOOL_50 1
+#define PP_BOOL_51 1
+#define PP_BOOL_52 1
+#define PP_BOOL_53 1
+#define PP_BOOL_54 1
+#define PP_BOOL_55 1
+#define PP_BOOL_56 1
+#define PP_BOOL_57 1
+#define PP_BOOL_58 1
+#define PP_BOOL_59 1
+#define PP_BOOL_60 1
+#define PP_BOOL_61 1
+#define PP_BOOL_62 1
+#define PP_BOOL_63 1
+#define PP_BOOL_64 1
+
+#define PP_IIF(c) PP_CAT(PP_IIF_, c)
+#define PP_IIF_0(t, f) f
+#define PP_IIF_1(t, f) t
+#define PP_IF(c, t, f) PP_IIF(PP_BOOL(c))(t, f)
+
+#define PP_REPEAT(n, m) PP_IF(n, PP_REPEAT_I, PP_REPEAT_END)(n, m)
+#define PP_REPEAT_INDIRECT() PP_REPEAT_II
+#define PP_REPEAT_II(n, m) PP_IF(n, PP_REPEAT_I, PP_REPEAT_END)(n, m)
+#define PP_REPEAT_I(n, m) PP_DEFER(PP_REPEAT_INDIRECT)()(PP_DEC(n), m) m(n)
+#define PP_REPEAT_END(n, m)
+
+#define DECLARE(n) int PP_CAT(var_, n) = PP_INC(n);
+#define FIELD(n) PP_CAT(int field_, n);
+
+namespace ns0 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns1 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns2 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns3 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns4 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns5 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns6 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns7 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns8 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns9 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns10 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns11 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns12 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns13 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns14 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns15 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns16 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns17 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns18 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns19 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns20 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns21 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns22 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns23 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns24 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns25 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns26 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns27 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns28 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns29 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns30 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns31 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns32 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns33 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns34 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns35 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns36 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns37 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns38 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns39 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns40 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns41 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns42 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns43 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns44 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns45 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns46 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns47 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns48 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns49 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns50 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns51 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns52 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns53 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns54 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns55 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns56 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns57 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns58 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns59 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns60 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns61 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns62 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns63 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns64 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns65 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns66 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns67 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns68 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns69 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns70 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns71 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns72 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns73 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns74 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns75 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns76 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns77 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns78 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns79 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns80 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns81 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns82 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns83 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns84 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns85 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns86 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns87 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns88 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns89 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns90 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns91 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns92 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns93 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns94 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns95 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns96 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns97 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns98 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
+namespace ns99 {
+PP_EVAL(PP_REPEAT(48, DECLARE))
+struct S { PP_EVAL(PP_REPEAT(32, FIELD)) };
+}
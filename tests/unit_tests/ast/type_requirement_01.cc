@@ -0,0 +1,34 @@
+// RUN: %cxx -verify -ast-dump %s | %filecheck %s --match-full-lines
+
+template <typename T, typename U>
+concept Rebindable = requires { typename T::template rebind<U>; };
+
+// clang-format off
+//      CHECK:translation-unit
+// CHECK-NEXT:  declaration-list
+// CHECK-NEXT:    template-declaration
+// CHECK-NEXT:      template-parameter-list
+// CHECK-NEXT:        typename-type-parameter
+// CHECK-NEXT:          depth: 0
+// CHECK-NEXT:          index: 0
+// CHECK-NEXT:          identifier: T
+// CHECK-NEXT:        typename-type-parameter
+// CHECK-NEXT:          depth: 0
+// CHECK-NEXT:          index: 1
+// CHECK-NEXT:          identifier: U
+// CHECK-NEXT:      declaration: concept-definition
+// CHECK-NEXT:        identifier: Rebindable
+// CHECK-NEXT:        expression: requires-expression
+// CHECK-NEXT:          requirement-list
+// CHECK-NEXT:            type-requirement
+// CHECK-NEXT:              nested-name-specifier: simple-nested-name-specifier
+// CHECK-NEXT:                identifier: T
+// CHECK-NEXT:              unqualified-id: simple-template-id
+// CHECK-NEXT:                identifier: rebind
+// CHECK-NEXT:                template-argument-list
+// CHECK-NEXT:                  type-template-argument
+// CHECK-NEXT:                    type-id: type-id
+// CHECK-NEXT:                      type-specifier-list
+// CHECK-NEXT:                        named-type-specifier
+// CHECK-NEXT:                          unqualified-id: name-id
+// CHECK-NEXT:                            identifier: U
@@ -0,0 +1,2 @@
+#error "b failed"
+int b;
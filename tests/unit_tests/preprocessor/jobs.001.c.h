@@ -0,0 +1 @@
+static int c;
@@ -0,0 +1,22 @@
+// RUN: not %cxx -j 4 -E -P %S/jobs.001.a.h %S/jobs.001.b.h %S/jobs.001.c.h %S/jobs.001.d.h -o %t.out 2> %t.err
+// RUN: %filecheck %s --check-prefix=OUT --input-file %t.out
+// RUN: %filecheck %s --check-prefix=ERR --input-file %t.err
+// RUN: %cxx -j 4 -dump-symbols %S/jobs.001.a.h %S/jobs.001.c.h | %filecheck %s --check-prefix=PASS
+// RUN: not %cxx -j foo %s 2>&1 | %filecheck %s --check-prefix=JOBS
+
+// the output and the diagnostics of the input files are in command line
+// order, and the exit status reports the files that failed.
+
+// OUT: int a;
+// OUT-NEXT: int b;
+// OUT-NEXT: static int c;
+// OUT-NEXT: int d;
+
+// ERR: jobs.001.b.h:1:2: #error "b failed"
+// ERR-NOT: jobs.001.b.h
+// ERR: jobs.001.d.h:1:2: #error "d failed"
+
+// PASS: variable int a
+// PASS: variable static int c
+
+// JOBS: cxx: invalid number of jobs 'foo'
@@ -0,0 +1,2 @@
+#error "d failed"
+int d;